@@ -35,6 +35,8 @@
 #include "level_set/indicator_function_constrain_dofs.h"
 #include "level_set/level_set_constrain_dofs.h"
 #include "level_set/level_set_intersection.h"
+#include "level_set/level_set_intersection_cache.h"
+#include "level_set/level_set_topology_gradient.h"
 #include "level_set/filter_base.h"
 #include "level_set/level_set_parameter.h"
 #include "elasticity/structural_nonlinear_assembly.h"
@@ -1753,6 +1755,15 @@ public:
         modal_elem_ops.set_discipline_and_system(*_discipline, *_sys_init);
         //nonlinear_assembly.plot_sub_elems(true, false, true);
         
+        // the intersections are computed once for this design and shared
+        // between all assemblies, outputs and the interface dof handler
+        // on each mesh.
+        MAST::LevelSetIntersectionCache str_intersections, level_set_intersections;
+        nonlinear_assembly.get_intersection().attach_cache(str_intersections);
+        eigen_assembly.get_intersection().attach_cache(str_intersections);
+        stress_assembly.get_intersection().attach_cache(str_intersections);
+        level_set_assembly.get_intersection().attach_cache(level_set_intersections);
+        
         
         libMesh::MeshRefinement refine(*_mesh);
         
@@ -1785,8 +1796,10 @@ public:
                 refine.refine_fraction()  = 1.;
                 refine.coarsen_fraction() = 0.5;
                 refine.flag_elements_by (flag);
-                if (refine.refine_and_coarsen_elements())
+                if (refine.refine_and_coarsen_elements()) {
                     _eq_sys->reinit ();
+                    str_intersections.increment_version();
+                }
 
                 _mesh->print_info();
                 
@@ -1795,6 +1808,11 @@ public:
             else
                 continue_refining = false;
         }
+        
+        // the boundary velocity on the structural mesh needs the level-set
+        // dofs in the region of the local structural elements
+        _level_set_vel->clear();
+        _level_set_vel->add_evaluation_mesh(*_level_set_sys_init, *_mesh);
 
         
         MAST::LevelSetVolume                            volume(level_set_assembly.get_intersection());
@@ -1949,61 +1967,40 @@ public:
         std::fill(grad.begin(), grad.end(), 0.);
         
         //
-        // iterate over each DV, create a sensitivity vector and calculate the
-        // volume sensitivity explicitly
+        // the shape derivative is computed for all level-set dofs in one
+        // sweep, and mapped to the DVs by the filter transpose
         //
-        std::unique_ptr<libMesh::NumericVector<Real>>
-        dphi_base(_level_set_sys->solution->zero_clone().release()),
-        dphi_filtered(_level_set_sys->solution->zero_clone().release());
+        MAST::LevelSetTopologyGradient topology_grad(*_level_set_sys_init, *_filter);
+        topology_grad.init(*_level_set_sys->solution);
         
-        ElementParameterDependence dep(*_filter);
-        assembly.attach_elem_parameter_dependence_object(dep);
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        dq_ddv(_level_set_sys->solution->zero_clone().release());
+        std::vector<Real> dq_ddv_local;
         
-        for (unsigned int i=0; i<_n_vars; i++) {
-            
-            dphi_base->zero();
-            dphi_filtered->zero();
-            //
-            // set the value only if the dof corresponds to a local node
-            //
-            if (_dv_params[i].first >=  dphi_base->first_local_index() &&
-                _dv_params[i].first <   dphi_base->last_local_index())
-                dphi_base->set(_dv_params[i].first, 1.);
-            dphi_base->close();
-            _filter->compute_filtered_values(*dphi_base, *dphi_filtered);
+        // if the volume output was specified then compute the sensitivity
+        // and add to the grad vector
+        if (volume) {
             
-            _level_set_vel->init(*_level_set_sys_init, *_level_set_sys->solution, *dphi_filtered);
-
-            // if the volume output was specified then compute the sensitivity
-            // and add to the grad vector
-            if (volume) {
-                
-                assembly.set_evaluate_output_on_negative_phi(false);
-                assembly.calculate_output_direct_sensitivity(*_level_set_sys->solution,
-                                                             dphi_filtered.get(),
-                                                             *_dv_params[i].second,
-                                                             *volume);
-                
-                grad[i] = _obj_scaling * volume->output_sensitivity_total(*_dv_params[i].second);
-                //grad[i] = volume->output_sensitivity_total(*_dv_params[i].second)/_length/_height;
-            }
+            assembly.set_evaluate_output_on_negative_phi(false);
+            topology_grad.output_gradient(assembly, *_level_set_sys->solution, *volume, *dq_ddv);
+            dq_ddv->localize(dq_ddv_local);
             
-            // if the perimeter output was specified then compute the sensitivity
-            // and add to the grad vector
-            if (perimeter) {
-                assembly.set_evaluate_output_on_negative_phi(true);
-                assembly.calculate_output_direct_sensitivity(*_level_set_sys->solution,
-                                                             dphi_filtered.get(),
-                                                             *_dv_params[i].second,
-                                                             *perimeter);
-                assembly.set_evaluate_output_on_negative_phi(false);
-                
-                grad[i] += _obj_scaling * _perimeter_penalty *
-                perimeter->output_sensitivity_total(*_dv_params[i].second);
-            }
+            for (unsigned int i=0; i<_n_vars; i++)
+                grad[i] = _obj_scaling * dq_ddv_local[_dv_params[i].first];
         }
         
-        assembly.clear_elem_parameter_dependence_object();
+        // if the perimeter output was specified then compute the sensitivity
+        // and add to the grad vector
+        if (perimeter) {
+            
+            assembly.set_evaluate_output_on_negative_phi(true);
+            topology_grad.output_gradient(assembly, *_level_set_sys->solution, *perimeter, *dq_ddv);
+            assembly.set_evaluate_output_on_negative_phi(false);
+            dq_ddv->localize(dq_ddv_local);
+            
+            for (unsigned int i=0; i<_n_vars; i++)
+                grad[i] += _obj_scaling * _perimeter_penalty * dq_ddv_local[_dv_params[i].first];
+        }
     }
     
     
@@ -2092,47 +2089,31 @@ public:
         
         // Adjoint solution for compliance = - X
         
+        MAST::LevelSetTopologyGradient topology_grad(*_level_set_sys_init, *_filter);
+        topology_grad.add_evaluation_mesh(*_mesh);
+        topology_grad.init(*_level_set_sys->solution);
+        
         std::unique_ptr<libMesh::NumericVector<Real>>
-        dphi_base(_level_set_sys->solution->zero_clone().release()),
-        dphi_filtered(_level_set_sys->solution->zero_clone().release());
+        dq_ddv(_level_set_sys->solution->zero_clone().release());
+        std::vector<Real> dq_ddv_local;
+        
+        //////////////////////////////////////////////////////////////////////
+        // compliance sensitivity
+        //////////////////////////////////////////////////////////////////////
+        topology_grad.output_adjoint_gradient(nonlinear_assembly,
+                                              *_sys->solution,
+                                              *_sys->solution,
+                                              nonlinear_elem_ops,
+                                              compliance,
+                                              *dq_ddv);
+        dq_ddv->localize(dq_ddv_local);
         
-        ElementParameterDependence dep(*_filter);
-        nonlinear_assembly.attach_elem_parameter_dependence_object(dep);
-
         //////////////////////////////////////////////////////////////////
         // indices used by GCMMA follow this rule:
         // grad_k = dfi/dxj  ,  where k = j*NFunc + i
         //////////////////////////////////////////////////////////////////
-        for (unsigned int i=0; i<_n_vars; i++) {
-            
-            dphi_base->zero();
-            dphi_filtered->zero();
-            //
-            // set the value only if the dof corresponds to a local node
-            //
-            if (_dv_params[i].first >=  dphi_base->first_local_index() &&
-                _dv_params[i].first <   dphi_base->last_local_index())
-                dphi_base->set(_dv_params[i].first, 1.);
-            dphi_base->close();
-            _filter->compute_filtered_values(*dphi_base, *dphi_filtered);
-            
-            //
-            // initialize the level set perturbation function to create a velocity
-            // field
-            _level_set_vel->init(*_level_set_sys_init, *_level_set_sys->solution, *dphi_filtered);
-            
-            //////////////////////////////////////////////////////////////////////
-            // compliance sensitivity
-            //////////////////////////////////////////////////////////////////////
-            grads[i] = -1. *
-            nonlinear_assembly.calculate_output_adjoint_sensitivity(*_sys->solution,
-                                                                    *_sys->solution,
-                                                                    *_dv_params[i].second,
-                                                                    nonlinear_elem_ops,
-                                                                    compliance);
-        }
-        
-        nonlinear_assembly.clear_elem_parameter_dependence_object();
+        for (unsigned int i=0; i<_n_vars; i++)
+            grads[i] = -1. * dq_ddv_local[_dv_params[i].first];
     }
 
     //
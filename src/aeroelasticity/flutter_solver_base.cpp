@@ -27,10 +27,13 @@
 #include "base/physics_discipline_base.h"
 #include "base/boundary_condition_base.h"
 #include "numerics/lapack_dggev_interface.h"
+#include "numerics/lapack_zggev_interface.h"
 #include "base/parameter.h"
+#include "base/nonlinear_system.h"
 
 
 MAST::FlutterSolverBase::FlutterSolverBase():
+_if_parallel_sweep(false),
 _assembly(nullptr),
 _basis_vectors(nullptr),
 _output(nullptr),
@@ -106,3 +109,64 @@ initialize(std::vector<libMesh::NumericVector<Real> *>& basis) {
 
 
 
+template <typename SolverType, typename MatType>
+void
+MAST::FlutterSolverBase::_sweep_eigensolve(const std::vector<MatType>& A,
+                                           const std::vector<MatType>& B,
+                                           std::vector<SolverType>&    ges) const {
+    
+    libmesh_assert_equal_to(A.size(), B.size());
+    
+    const unsigned int
+    n_pts   = (unsigned int)A.size();
+    
+    ges.resize(n_pts);
+    
+    if (!_if_parallel_sweep) {
+        
+        for (unsigned int i=0; i<n_pts; i++) {
+            
+            ges[i].compute(A[i], B[i]);
+            ges[i].scale_eigenvectors_to_identity_innerproduct();
+        }
+        
+        return;
+    }
+    
+    libmesh_assert(_assembly);
+    
+    const libMesh::Parallel::Communicator&
+    comm    = _assembly->system().comm();
+    
+    const unsigned int
+    n_procs = comm.size(),
+    rank    = comm.rank();
+    
+    // first, each processor solves the eigenproblems assigned to it
+    for (unsigned int i=0; i<n_pts; i++)
+        if (i % n_procs == rank) {
+            
+            ges[i].compute(A[i], B[i]);
+            ges[i].scale_eigenvectors_to_identity_innerproduct();
+        }
+    
+    // next, the solutions are broadcast from the processors that
+    // computed them
+    for (unsigned int i=0; i<n_pts; i++)
+        ges[i].broadcast(comm, i % n_procs);
+}
+
+
+
+// explicit instantiations
+template void
+MAST::FlutterSolverBase::_sweep_eigensolve<MAST::LAPACK_ZGGEV, ComplexMatrixX>
+(const std::vector<ComplexMatrixX>& A,
+ const std::vector<ComplexMatrixX>& B,
+ std::vector<MAST::LAPACK_ZGGEV>&   ges) const;
+
+template void
+MAST::FlutterSolverBase::_sweep_eigensolve<MAST::LAPACK_DGGEV, RealMatrixX>
+(const std::vector<RealMatrixX>& A,
+ const std::vector<RealMatrixX>& B,
+ std::vector<MAST::LAPACK_DGGEV>& ges) const;
@@ -24,6 +24,7 @@
 #include <string>
 #include <fstream>
 #include <iomanip>
+#include <vector>
 
 
 // MAST includes
@@ -130,6 +131,25 @@ namespace MAST {
         }
         
         
+        /*!
+         *   if \p f is true, scan_for_roots() distributes the eigenproblems
+         *   of the sweep points over the processors of the communicator of
+         *   the structural system. The reduced-order matrices are assembled
+         *   on all processors, since the assembly is collective. The dense
+         *   eigenproblems are then solved concurrently, with the sweep
+         *   points assigned cyclically to the processors, and each
+         *   eigensolution is broadcast from the processor that computed it.
+         *   Hence, all processors have identical solutions, which are
+         *   sorted in the sweep order. If \p f is false, each sweep point is
+         *   analyzed as it is reached, so that only the matrices of one
+         *   point are stored at a time. This is false by default.
+         */
+        void set_parallel_sweep(bool f) {
+            
+            _if_parallel_sweep = f;
+        }
+        
+        
         /*!
          *   Prints the sorted roots to the \p output
          */
@@ -146,6 +166,25 @@ namespace MAST {
     protected:
         
         
+        /*!
+         *   computes the eigensolutions of \f$ A_i x = \lambda B_i x \f$ for
+         *   the sweep points, and returns them in \p ges with eigenvectors
+         *   scaled to identity inner product with respect to \f$ B_i \f$.
+         *   The eigenproblems are distributed over the processors if
+         *   set_parallel_sweep() was used.
+         */
+        template <typename SolverType, typename MatType>
+        void _sweep_eigensolve(const std::vector<MatType>& A,
+                               const std::vector<MatType>& B,
+                               std::vector<SolverType>&    ges) const;
+        
+        
+        /*!
+         *   flag to distribute the sweep eigenproblems over the processors
+         */
+        bool                                            _if_parallel_sweep;
+        
+        
         /*!
          *   structural assembly that provides the assembly of the system
          *   matrices.
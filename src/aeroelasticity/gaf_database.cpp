@@ -0,0 +1,656 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <fstream>
+#include <cstring>
+
+// MAST includes
+#include "aeroelasticity/gaf_database.h"
+#include "base/parameter.h"
+#include "numerics/utility.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   identifier and version of the binary GAF file
+     */
+    const char         gaf_file_identifier[8] = {'M','A','S','T','_','G','A','F'};
+    const unsigned int gaf_file_version       = 1;
+}
+
+
+
+MAST::GAFDatabase::GAFDatabase(const unsigned int n_modes,
+                               MAST::Parameter&   kr_param):
+MAST::FSIGeneralizedAeroForceAssembly(),
+_n_modes      (n_modes),
+_kr_param     (kr_param),
+_if_evaluate  (true)
+{ }
+
+
+
+MAST::GAFDatabase::~GAFDatabase() { }
+
+
+
+void
+MAST::GAFDatabase::set_evaluate_mode(bool f) {
+    
+    if (!f && !this->if_approximation())
+        libmesh_error_msg("GAFDatabase: approximation must be fitted before it is used");
+    
+    _if_evaluate = f;
+}
+
+
+
+void
+MAST::GAFDatabase::add_kr_mat(const Real kr,
+                              const ComplexMatrixX& mat) {
+    
+    libmesh_assert_equal_to(mat.rows(), _n_modes);
+    libmesh_assert_equal_to(mat.cols(), _n_modes);
+    
+    _kr_to_gaf_map[kr] = mat;
+}
+
+
+
+void
+MAST::GAFDatabase::clear_database() {
+    
+    _kr_to_gaf_map.clear();
+    
+    _A0.resize(0, 0);
+    _A1.resize(0, 0);
+    _A2.resize(0, 0);
+    _D.resize(0, 0);
+    _E.resize(0, 0);
+    _lag_roots.resize(0);
+}
+
+
+
+void
+MAST::GAFDatabase::write_gaf_file(const std::string& nm,
+                                  const libMesh::Parallel::Communicator& comm) const {
+    
+    if (comm.rank() != 0)
+        return;
+    
+    libMesh::out
+    << " **** Writing GAF database to : " << nm
+    << "   ....  ";
+    
+    std::ofstream out(nm.c_str(), std::ofstream::out | std::ofstream::binary);
+    
+    if (!out)
+        libmesh_error_msg("GAFDatabase: unable to open file " << nm);
+    
+    // the header is followed by the reduced frequency and the complex
+    // matrix in column-major order for each tabulated value. The values
+    // are written in the native byte order.
+    const unsigned int
+    n_kr = (unsigned int)_kr_to_gaf_map.size();
+    
+    out.write(MAST::gaf_file_identifier, 8);
+    out.write(reinterpret_cast<const char*>(&MAST::gaf_file_version), sizeof(unsigned int));
+    out.write(reinterpret_cast<const char*>(&_n_modes), sizeof(unsigned int));
+    out.write(reinterpret_cast<const char*>(&n_kr), sizeof(unsigned int));
+    
+    std::map<Real, ComplexMatrixX>::const_iterator
+    it  = _kr_to_gaf_map.begin(),
+    end = _kr_to_gaf_map.end();
+    
+    for ( ; it != end; it++) {
+        
+        out.write(reinterpret_cast<const char*>(&it->first), sizeof(Real));
+        out.write(reinterpret_cast<const char*>(it->second.data()),
+                  sizeof(Complex)*_n_modes*_n_modes);
+    }
+    
+    if (!out)
+        libmesh_error_msg("GAFDatabase: error writing file " << nm);
+    
+    libMesh::out
+    << "   Done! " << std::endl;
+}
+
+
+
+void
+MAST::GAFDatabase::read_gaf_file(const std::string& nm,
+                                 const libMesh::Parallel::Communicator& comm) {
+    
+    libMesh::out
+    << " **** Reading GAF database from : " << nm
+    << "   ....  ";
+    
+    this->clear_database();
+    
+    unsigned int
+    n_kr    = 0;
+    
+    if (comm.rank() == 0) {
+        
+        std::ifstream input(nm.c_str(), std::ifstream::in | std::ifstream::binary);
+        
+        if (!input)
+            libmesh_error_msg("GAFDatabase: unable to open file " << nm);
+        
+        char
+        identifier[8];
+        
+        unsigned int
+        version = 0,
+        n_modes = 0;
+        
+        input.read(identifier, 8);
+        input.read(reinterpret_cast<char*>(&version), sizeof(unsigned int));
+        input.read(reinterpret_cast<char*>(&n_modes), sizeof(unsigned int));
+        input.read(reinterpret_cast<char*>(&n_kr), sizeof(unsigned int));
+        
+        if (!input ||
+            std::strncmp(identifier, MAST::gaf_file_identifier, 8))
+            libmesh_error_msg("GAFDatabase: " << nm << " is not a GAF file");
+        
+        if (version != MAST::gaf_file_version)
+            libmesh_error_msg("GAFDatabase: unsupported version " << version
+                              << " of GAF file " << nm);
+        
+        if (n_modes != _n_modes)
+            libmesh_error_msg("GAFDatabase: GAF file " << nm << " has "
+                              << n_modes << " modes, expected "
+                              << _n_modes);
+        
+        Real
+        kr  = 0.;
+        
+        ComplexMatrixX
+        mat = ComplexMatrixX::Zero(_n_modes, _n_modes);
+        
+        for (unsigned int i=0; i<n_kr; i++) {
+            
+            input.read(reinterpret_cast<char*>(&kr), sizeof(Real));
+            input.read(reinterpret_cast<char*>(mat.data()),
+                       sizeof(Complex)*_n_modes*_n_modes);
+            
+            if (!input)
+                libmesh_error_msg("GAFDatabase: GAF file " << nm << " is truncated");
+            
+            _kr_to_gaf_map[kr] = mat;
+        }
+    }
+    
+    // now broadcast the table to the other processors
+    comm.broadcast(n_kr);
+    
+    std::map<Real, ComplexMatrixX>::const_iterator
+    it  = _kr_to_gaf_map.begin();
+    
+    Real
+    kr  = 0.;
+    
+    ComplexMatrixX
+    mat;
+    
+    for (unsigned int i=0; i<n_kr; i++) {
+        
+        if (comm.rank() == 0) {
+            
+            kr  = it->first;
+            mat = it->second;
+            it++;
+        }
+        
+        comm.broadcast(kr);
+        MAST::parallel_broadcast(comm, mat, 0);
+        
+        if (comm.rank() != 0)
+            _kr_to_gaf_map[kr] = mat;
+    }
+    
+    libMesh::out
+    << "   Done! " << std::endl;
+}
+
+
+
+Real
+MAST::GAFDatabase::fit_roger_approximation(const std::vector<Real>& lag_roots) {
+    
+    this->_fit_roger(lag_roots);
+    
+    return this->_approximation_error();
+}
+
+
+
+Real
+MAST::GAFDatabase::
+fit_minimum_state_approximation(const std::vector<Real>& lag_roots,
+                                const unsigned int max_iters) {
+    
+    // Roger's approximation provides the starting values
+    this->_fit_roger(lag_roots);
+    
+    const unsigned int
+    n      = _n_modes,
+    n_lag  = (unsigned int)lag_roots.size(),
+    n_kr   = (unsigned int)_kr_to_gaf_map.size(),
+    n_unk  = 3*n + n_lag;
+    
+    // the initial D and E are the dominant singular vectors of each of
+    // the lag matrices of Roger's approximation
+    RealMatrixX
+    D      = RealMatrixX::Zero(n, n_lag),
+    E      = RealMatrixX::Zero(n_lag, n);
+    
+    for (unsigned int l=0; l<n_lag; l++) {
+        
+        Eigen::JacobiSVD<RealMatrixX>
+        svd(_E.block(l*n, 0, n, n), Eigen::ComputeThinU | Eigen::ComputeThinV);
+        
+        D.col(l) = svd.matrixU().col(0);
+        E.row(l) = svd.singularValues()(0) * svd.matrixV().col(0).transpose();
+    }
+    
+    _D = D;
+    _E = E;
+    _lag_roots.resize(n_lag);
+    for (unsigned int l=0; l<n_lag; l++)
+        _lag_roots(l) = lag_roots[l];
+    
+    // the polynomial terms, phi, and the lag terms, g, at each frequency
+    ComplexMatrixX
+    phi    = ComplexMatrixX::Zero(n_kr, 3),
+    g      = ComplexMatrixX::Zero(n_kr, n_lag);
+    
+    std::vector<const ComplexMatrixX*>
+    q(n_kr, nullptr);
+    
+    std::map<Real, ComplexMatrixX>::const_iterator
+    it     = _kr_to_gaf_map.begin(),
+    end    = _kr_to_gaf_map.end();
+    
+    for (unsigned int j=0; it != end; it++, j++) {
+        
+        const Complex p(0., it->first);
+        
+        phi(j, 0) = 1.;
+        phi(j, 1) = p;
+        phi(j, 2) = p*p;
+        for (unsigned int l=0; l<n_lag; l++)
+            g(j, l) = p/(p + lag_roots[l]);
+        
+        q[j] = &it->second;
+    }
+    
+    RealMatrixX
+    mat    = RealMatrixX::Zero(2*n_kr*n, n_unk),
+    rhs    = RealMatrixX::Zero(2*n_kr*n, n),
+    sol;
+    
+    RealMatrixX*
+    A[3]   = {&_A0, &_A1, &_A2};
+    
+    Complex
+    val    = 0.;
+    
+    Real
+    err    = this->_approximation_error(),
+    err0   = err;
+    
+    for (unsigned int iter=0; iter<max_iters; iter++) {
+        
+        // with E fixed, row i of A0, A1, A2 and D is obtained from the
+        // equations for all frequencies and columns
+        mat.setZero();
+        for (unsigned int j=0; j<n_kr; j++)
+            for (unsigned int c=0; c<n; c++) {
+                
+                const unsigned int r = 2*(j*n + c);
+                
+                for (unsigned int m=0; m<3; m++) {
+                    
+                    mat(r,   m*n+c) = phi(j, m).real();
+                    mat(r+1, m*n+c) = phi(j, m).imag();
+                }
+                
+                for (unsigned int l=0; l<n_lag; l++) {
+                    
+                    val = g(j, l) * _E(l, c);
+                    mat(r,   3*n+l) = val.real();
+                    mat(r+1, 3*n+l) = val.imag();
+                }
+                
+                for (unsigned int i=0; i<n; i++) {
+                    
+                    rhs(r,   i) = (*q[j])(i, c).real();
+                    rhs(r+1, i) = (*q[j])(i, c).imag();
+                }
+            }
+        
+        sol = mat.colPivHouseholderQr().solve(rhs);
+        
+        for (unsigned int i=0; i<n; i++) {
+            
+            for (unsigned int m=0; m<3; m++)
+                for (unsigned int c=0; c<n; c++)
+                    (*A[m])(i, c) = sol(m*n+c, i);
+            
+            for (unsigned int l=0; l<n_lag; l++)
+                _D(i, l) = sol(3*n+l, i);
+        }
+        
+        // D and E are defined up to a scaling of each lag state
+        for (unsigned int l=0; l<n_lag; l++) {
+            
+            const Real s = _D.col(l).norm();
+            if (s > 0.) {
+                
+                _D.col(l) /= s;
+                _E.row(l) *= s;
+            }
+        }
+        
+        // with D fixed, column c of A0, A1, A2 and E is obtained from the
+        // equations for all frequencies and rows
+        mat.setZero();
+        for (unsigned int j=0; j<n_kr; j++)
+            for (unsigned int i=0; i<n; i++) {
+                
+                const unsigned int r = 2*(j*n + i);
+                
+                for (unsigned int m=0; m<3; m++) {
+                    
+                    mat(r,   m*n+i) = phi(j, m).real();
+                    mat(r+1, m*n+i) = phi(j, m).imag();
+                }
+                
+                for (unsigned int l=0; l<n_lag; l++) {
+                    
+                    val = g(j, l) * _D(i, l);
+                    mat(r,   3*n+l) = val.real();
+                    mat(r+1, 3*n+l) = val.imag();
+                }
+                
+                for (unsigned int c=0; c<n; c++) {
+                    
+                    rhs(r,   c) = (*q[j])(i, c).real();
+                    rhs(r+1, c) = (*q[j])(i, c).imag();
+                }
+            }
+        
+        sol = mat.colPivHouseholderQr().solve(rhs);
+        
+        for (unsigned int c=0; c<n; c++) {
+            
+            for (unsigned int m=0; m<3; m++)
+                for (unsigned int i=0; i<n; i++)
+                    (*A[m])(i, c) = sol(m*n+i, c);
+            
+            for (unsigned int l=0; l<n_lag; l++)
+                _E(l, c) = sol(3*n+l, c);
+        }
+        
+        // stop when the error no longer decreases
+        err0 = err;
+        err  = this->_approximation_error();
+        
+        if (err0 - err <= 1.e-8 * err0)
+            break;
+    }
+    
+    return err;
+}
+
+
+
+void
+MAST::GAFDatabase::gaf(const Real kr, ComplexMatrixX& mat) const {
+    
+    libmesh_assert(this->if_approximation());
+    
+    const Complex
+    p  = Complex(0., kr);
+    
+    ComplexVectorX
+    g  = ComplexVectorX::Zero(_lag_roots.size());
+    
+    for (unsigned int i=0; i<_lag_roots.size(); i++)
+        g(i) = p/(p + _lag_roots(i));
+    
+    mat =
+    _A0.cast<Complex>() +
+    p   * _A1.cast<Complex>() +
+    p*p * _A2.cast<Complex>() +
+    _D.cast<Complex>() * g.asDiagonal() * _E.cast<Complex>();
+}
+
+
+
+void
+MAST::GAFDatabase::gaf_kr_derivative(const Real kr, ComplexMatrixX& mat) const {
+    
+    libmesh_assert(this->if_approximation());
+    
+    // dp/dk = i
+    const Complex
+    iota = Complex(0., 1.),
+    p    = Complex(0., kr);
+    
+    ComplexVectorX
+    dg   = ComplexVectorX::Zero(_lag_roots.size());
+    
+    for (unsigned int i=0; i<_lag_roots.size(); i++)
+        dg(i) = iota * _lag_roots(i)/pow(p + _lag_roots(i), 2);
+    
+    mat =
+    iota       * _A1.cast<Complex>() +
+    2.*iota*p  * _A2.cast<Complex>() +
+    _D.cast<Complex>() * dg.asDiagonal() * _E.cast<Complex>();
+}
+
+
+
+void
+MAST::GAFDatabase::state_space_matrices(const Real V,
+                                        const Real b_ref,
+                                        RealMatrixX& Q0,
+                                        RealMatrixX& Q1,
+                                        RealMatrixX& Q2,
+                                        RealMatrixX& D,
+                                        RealMatrixX& E,
+                                        RealMatrixX& R) const {
+    
+    libmesh_assert(this->if_approximation());
+    libmesh_assert_greater(V, 0.);
+    
+    // the reduced Laplace variable is p = s b/V
+    const Real
+    r   = b_ref/V;
+    
+    Q0  = _A0;
+    Q1  = r * _A1;
+    Q2  = r * r * _A2;
+    D   = _D;
+    E   = _E;
+    
+    R   = RealMatrixX::Zero(_lag_roots.size(), _lag_roots.size());
+    R.diagonal() = -_lag_roots/r;
+}
+
+
+
+void
+MAST::GAFDatabase::assemble_generalized_aerodynamic_force_matrix
+(std::vector<libMesh::NumericVector<Real>*>& basis,
+ ComplexMatrixX& mat,
+ MAST::Parameter* p) {
+    
+    if (_if_evaluate) {
+        
+        MAST::FSIGeneralizedAeroForceAssembly::
+        assemble_generalized_aerodynamic_force_matrix(basis, mat, p);
+        
+        // only the GAF is tabulated, and not its sensitivity
+        if (!p)
+            this->add_kr_mat(_kr_param(), mat);
+        
+        return;
+    }
+    
+    libmesh_assert_equal_to(basis.size(), _n_modes);
+    
+    if (!p)
+        this->gaf(_kr_param(), mat);
+    else if (p == &_kr_param)
+        this->gaf_kr_derivative(_kr_param(), mat);
+    else
+        libmesh_error_msg("GAFDatabase: GAF sensitivity is available only with respect to reduced frequency");
+}
+
+
+
+void
+MAST::GAFDatabase::_fit_roger(const std::vector<Real>& lag_roots) {
+    
+    const unsigned int
+    n       = _n_modes,
+    n_lag   = (unsigned int)lag_roots.size(),
+    n_kr    = (unsigned int)_kr_to_gaf_map.size(),
+    n_terms = 3 + n_lag;
+    
+    if (2*n_kr < n_terms)
+        libmesh_error_msg("GAFDatabase: " << n_kr
+                          << " tabulated frequencies are not sufficient for "
+                          << n_lag << " lag roots");
+    
+    for (unsigned int l=0; l<n_lag; l++)
+        if (!(lag_roots[l] > 0.))
+            libmesh_error_msg("GAFDatabase: lag roots must be positive");
+    
+    // each element of the GAF is fitted with the same terms, so that
+    // the real and imaginary parts at all frequencies give one least
+    // squares problem with n^2 right-hand sides
+    RealMatrixX
+    mat     = RealMatrixX::Zero(2*n_kr, n_terms),
+    rhs     = RealMatrixX::Zero(2*n_kr, n*n),
+    coeffs;
+    
+    Complex
+    phi     = 0.;
+    
+    std::map<Real, ComplexMatrixX>::const_iterator
+    it      = _kr_to_gaf_map.begin(),
+    end     = _kr_to_gaf_map.end();
+    
+    for (unsigned int j=0; it != end; it++, j++) {
+        
+        const Complex p(0., it->first);
+        
+        for (unsigned int m=0; m<n_terms; m++) {
+            
+            switch (m) {
+                case 0:
+                    phi = 1.;
+                    break;
+                    
+                case 1:
+                    phi = p;
+                    break;
+                    
+                case 2:
+                    phi = p*p;
+                    break;
+                    
+                default:
+                    phi = p/(p + lag_roots[m-3]);
+            }
+            
+            mat(2*j,   m) = phi.real();
+            mat(2*j+1, m) = phi.imag();
+        }
+        
+        // column-major order of the matrix entries
+        for (unsigned int c=0; c<n*n; c++) {
+            
+            rhs(2*j,   c) = it->second.data()[c].real();
+            rhs(2*j+1, c) = it->second.data()[c].imag();
+        }
+    }
+    
+    coeffs = mat.colPivHouseholderQr().solve(rhs);
+    
+    _A0.setZero(n, n);
+    _A1.setZero(n, n);
+    _A2.setZero(n, n);
+    _D.setZero(n, n*n_lag);
+    _E.setZero(n*n_lag, n);
+    _lag_roots.setZero(n*n_lag);
+    
+    for (unsigned int c=0; c<n*n; c++) {
+        
+        _A0(c%n, c/n) = coeffs(0, c);
+        _A1(c%n, c/n) = coeffs(1, c);
+        _A2(c%n, c/n) = coeffs(2, c);
+        
+        for (unsigned int l=0; l<n_lag; l++)
+            _E(l*n + c%n, c/n) = coeffs(3+l, c);
+    }
+    
+    // each lag matrix has n lag states with the same root
+    for (unsigned int l=0; l<n_lag; l++) {
+        
+        _D.block(0, l*n, n, n)        = RealMatrixX::Identity(n, n);
+        _lag_roots.segment(l*n, n).setConstant(lag_roots[l]);
+    }
+}
+
+
+
+Real
+MAST::GAFDatabase::_approximation_error() const {
+    
+    Real
+    err    = 0.,
+    scale  = 0.;
+    
+    ComplexMatrixX
+    mat;
+    
+    std::map<Real, ComplexMatrixX>::const_iterator
+    it     = _kr_to_gaf_map.begin(),
+    end    = _kr_to_gaf_map.end();
+    
+    for ( ; it != end; it++) {
+        
+        this->gaf(it->first, mat);
+        
+        err    = std::max(err,   (mat - it->second).norm());
+        scale  = std::max(scale, it->second.norm());
+    }
+    
+    return (scale > 0.)? err/scale : err;
+}
@@ -0,0 +1,238 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__gaf_database_h__
+#define __mast__gaf_database_h__
+
+// C++ includes
+#include <vector>
+#include <map>
+#include <string>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "elasticity/fsi_generalized_aero_force_assembly.h"
+
+// libMesh includes
+#include "libmesh/parallel.h"
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class Parameter;
+    
+    /*!
+     *   Database of generalized aerodynamic force (GAF) matrices tabulated
+     *   in reduced frequency. In evaluate mode, the GAF is computed by the
+     *   frequency-domain fluid solution of the parent class and added to
+     *   the table at the reduced frequency in \p kr_param. Otherwise, the
+     *   GAF is obtained from a rational function approximation fitted to
+     *   the table, so that the flutter solvers can use this object as
+     *   their assembly without any fluid solutions.
+     *
+     *   The approximation in the reduced Laplace variable
+     *   \f$ \bar{p} = i k \f$ is
+     *   \f[ Q(\bar{p}) = A_0 + \bar{p} A_1 + \bar{p}^2 A_2 +
+     *       D (\bar{p} I - R)^{-1} E \bar{p}, \f]
+     *   with \f$ R = -{\rm diag}(\beta) \f$ for the lag roots \f$ \beta \f$.
+     *   Roger's approximation uses an independent matrix for each lag
+     *   root, and the minimum-state approximation uses one lag state for
+     *   each lag root. The tabulated and approximated matrices use the
+     *   sign convention of the parent class.
+     */
+    class GAFDatabase:
+    public MAST::FSIGeneralizedAeroForceAssembly {
+        
+    public:
+        
+        /*!
+         *   \p kr_param is the reduced frequency parameter used by the
+         *   flutter solver.
+         */
+        GAFDatabase(const unsigned int n_modes,
+                    MAST::Parameter&   kr_param);
+        
+        
+        virtual ~GAFDatabase();
+        
+        
+        /*!
+         *   if \p f is true, the GAF is computed by the fluid solution
+         *   and tabulated. Otherwise, the rational function approximation
+         *   is used.
+         */
+        void set_evaluate_mode(bool f);
+        
+        
+        /*!
+         *   adds the GAF \p mat at reduced frequency \p kr to the table,
+         *   replacing any existing value at \p kr
+         */
+        void add_kr_mat(const Real kr,
+                        const ComplexMatrixX& mat);
+        
+        
+        /*!
+         *   @returns the tabulated GAF matrices
+         */
+        const std::map<Real, ComplexMatrixX>& tabulated_values() const {
+            
+            return _kr_to_gaf_map;
+        }
+        
+        
+        /*!
+         *   clears the table and the approximation
+         */
+        void clear_database();
+        
+        
+        /*!
+         *   writes the table to the binary file \p nm from the first
+         *   processor of \p comm
+         */
+        void write_gaf_file(const std::string& nm,
+                            const libMesh::Parallel::Communicator& comm) const;
+        
+        
+        /*!
+         *   reads the table from the binary file \p nm on the first
+         *   processor of \p comm and broadcasts it to all processors. The
+         *   current table and approximation are cleared.
+         */
+        void read_gaf_file(const std::string& nm,
+                           const libMesh::Parallel::Communicator& comm);
+        
+        
+        /*!
+         *   fits Roger's approximation with lag roots \p lag_roots to the
+         *   table by least squares, and sets the object to use it.
+         *   @returns the largest error at the tabulated frequencies,
+         *   relative to the largest tabulated GAF norm
+         */
+        Real fit_roger_approximation(const std::vector<Real>& lag_roots);
+        
+        
+        /*!
+         *   fits the minimum-state approximation with lag roots
+         *   \p lag_roots to the table by alternating least squares for
+         *   \f$ D \f$ and \f$ E \f$, starting from Roger's approximation,
+         *   with up to \p max_iters iterations. @returns the largest error
+         *   at the tabulated frequencies, relative to the largest
+         *   tabulated GAF norm
+         */
+        Real fit_minimum_state_approximation(const std::vector<Real>& lag_roots,
+                                             const unsigned int max_iters = 100);
+        
+        
+        /*!
+         *   @returns true if an approximation has been fitted
+         */
+        bool if_approximation() const {
+            
+            return _lag_roots.size() > 0;
+        }
+        
+        
+        /*!
+         *   GAF from the approximation at reduced frequency \p kr
+         */
+        void gaf(const Real kr, ComplexMatrixX& mat) const;
+        
+        
+        /*!
+         *   derivative of the GAF from the approximation with respect to
+         *   the reduced frequency at \p kr
+         */
+        void gaf_kr_derivative(const Real kr, ComplexMatrixX& mat) const;
+        
+        
+        /*!
+         *   matrices of the time-domain state-space form of the
+         *   approximation for flight velocity \p V and reference length
+         *   \p b_ref. The aerodynamic force is
+         *   \f$ q_\infty (Q_0 x + Q_1 \dot{x} + Q_2 \ddot{x} + D x_a) \f$,
+         *   where the lag states follow
+         *   \f$ \dot{x}_a = R x_a + E \dot{x} \f$.
+         */
+        void state_space_matrices(const Real V,
+                                  const Real b_ref,
+                                  RealMatrixX& Q0,
+                                  RealMatrixX& Q1,
+                                  RealMatrixX& Q2,
+                                  RealMatrixX& D,
+                                  RealMatrixX& E,
+                                  RealMatrixX& R) const;
+        
+        
+        /*!
+         *   computes the GAF at the reduced frequency in \p kr_param. In
+         *   evaluate mode this uses the fluid solution and tabulates the
+         *   result. Otherwise, the approximation is used, and the only
+         *   sensitivity parameter supported is \p kr_param.
+         */
+        virtual void
+        assemble_generalized_aerodynamic_force_matrix
+        (std::vector<libMesh::NumericVector<Real>*>& basis,
+         ComplexMatrixX& mat,
+         MAST::Parameter* p = nullptr);
+        
+        
+    protected:
+        
+        
+        /*!
+         *   fits \f$ A_0, A_1, A_2 \f$ and the lag matrices of Roger's
+         *   approximation, and stores them in the state-space form
+         */
+        void _fit_roger(const std::vector<Real>& lag_roots);
+        
+        
+        /*!
+         *   @returns the largest error of the approximation at the
+         *   tabulated frequencies, relative to the largest tabulated
+         *   GAF norm
+         */
+        Real _approximation_error() const;
+        
+        
+        unsigned int                        _n_modes;
+        
+        MAST::Parameter&                    _kr_param;
+        
+        bool                                _if_evaluate;
+        
+        std::map<Real, ComplexMatrixX>      _kr_to_gaf_map;
+        
+        /*!
+         *   matrices of the approximation
+         */
+        RealMatrixX                         _A0, _A1, _A2, _D, _E;
+        
+        /*!
+         *   lag root of each lag state
+         */
+        RealVectorX                         _lag_roots;
+    };
+}
+
+
+#endif  // __mast__gaf_database_h__
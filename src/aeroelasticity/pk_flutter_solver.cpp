@@ -18,6 +18,11 @@
  */
 
 
+// C++ includes
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
 // MAST includes
 #include "aeroelasticity/pk_flutter_solver.h"
 #include "aeroelasticity/pk_flutter_solution.h"
@@ -36,7 +41,15 @@ _bref_param(nullptr),
 _V_range(std::pair<Real, Real>(0., 0.)),
 _n_V_divs(0),
 _kr_range(std::pair<Real, Real>(0., 0.)),
-_n_k_red_divs(0)
+_n_k_red_divs(0),
+_if_interpolate_gaf(false),
+_gaf_interp_max_dk(0.),
+_if_structural_cached(false),
+_n_structural_assemblies(0),
+_n_structural_reused(0),
+_n_gaf_assemblies(0),
+_n_gaf_reused(0),
+_n_gaf_interpolated(0)
 { }
 
 
@@ -61,6 +74,8 @@ MAST::PKFlutterSolver::clear() {
     _n_V_divs         = 0;
     _n_k_red_divs     = 0;
     
+    this->clear_matrix_cache();
+    
     MAST::FlutterSolverBase::clear();
 }
 
@@ -92,6 +107,9 @@ initialize(MAST::Parameter&                             V_param,
     _kr_range.second    = kr_upper;
     _n_k_red_divs       = n_kr_divs;
     
+    // the matrices from a previous initialization may use a different basis
+    this->clear_matrix_cache();
+    
     MAST::FlutterSolverBase::initialize(basis);
 
 }
@@ -116,11 +134,35 @@ MAST::PKFlutterSolver::clear_solutions() {
     
     _flutter_solutions.clear();
     _flutter_crossovers.clear();
+    
+    // the structure may be modified before the next analysis, for example
+    // by a design update. The aerodynamic matrices depend only on the
+    // reduced frequency and are kept.
+    _if_structural_cached    = false;
+    _mass.resize(0, 0);
+    _stiffness.resize(0, 0);
 }
 
 
 
 
+void
+MAST::PKFlutterSolver::clear_matrix_cache() {
+    
+    _if_structural_cached    = false;
+    _mass.resize(0, 0);
+    _stiffness.resize(0, 0);
+    _gaf.clear();
+    
+    _n_structural_assemblies = 0;
+    _n_structural_reused     = 0;
+    _n_gaf_assemblies        = 0;
+    _n_gaf_reused            = 0;
+    _n_gaf_interpolated      = 0;
+}
+
+
+
 unsigned int
 MAST::PKFlutterSolver::n_roots_found() const {
     
@@ -156,6 +198,49 @@ MAST::PKFlutterSolver::scan_for_roots() {
         }
         k_red_vals[_n_k_red_divs] = _kr_range.first; // to get around finite-precision arithmetic
         
+        // march from the upper limit to the lower to find the roots
+        Real current_v_ref = _V_range.first,
+        delta_v_ref = (_V_range.second-_V_range.first)/_n_V_divs;
+        
+        std::vector<Real> v_ref_vals(_n_V_divs+1);
+        for (unsigned int i=0; i<_n_V_divs+1; i++) {
+            v_ref_vals[i] = current_v_ref;
+            current_v_ref += delta_v_ref;
+        }
+        v_ref_vals[_n_V_divs] = _V_range.second; // to get around finite-precision arithmetic
+        
+        //
+        // for a parallel sweep the matrices are assembled on all
+        // processors for all points, and the eigenproblems are then solved
+        // together. The points are ordered with velocity varying fastest.
+        // Otherwise, each point is analyzed as it is reached, so that only
+        // the matrices of one point are stored at a time.
+        //
+        std::vector<MAST::LAPACK_ZGGEV> ges;
+        std::vector<RealMatrixX>        stiff;
+        
+        if (_if_parallel_sweep) {
+            
+            const unsigned int
+            n_pts = (_n_k_red_divs+1)*(_n_V_divs+1);
+            
+            std::vector<ComplexMatrixX>
+            L(n_pts),
+            R(n_pts);
+            
+            stiff.resize(_n_k_red_divs+1);
+            
+            for (unsigned int j=0; j<_n_k_red_divs+1; j++)
+                for (unsigned int i=0; i<_n_V_divs+1; i++)
+                    _initialize_matrices(k_red_vals[j],
+                                         v_ref_vals[i],
+                                         L[j*(_n_V_divs+1)+i],
+                                         R[j*(_n_V_divs+1)+i],
+                                         stiff[j]);
+            
+            this->_sweep_eigensolve(L, R, ges);
+        }
+        
         //
         //  outer loop is on reduced frequency
         //
@@ -163,29 +248,32 @@ MAST::PKFlutterSolver::scan_for_roots() {
             
             current_k_red = k_red_vals[j];
             
-            // march from the upper limit to the lower to find the roots
-            Real current_v_ref = _V_range.first,
-            delta_v_ref = (_V_range.second-_V_range.first)/_n_V_divs;
-            
-            std::vector<Real> v_ref_vals(_n_V_divs+1);
-            for (unsigned int i=0; i<_n_V_divs+1; i++) {
-                v_ref_vals[i] = current_v_ref;
-                current_v_ref += delta_v_ref;
-            }
-            v_ref_vals[_n_V_divs] = _V_range.second; // to get around finite-precision arithmetic
-            
             MAST::FlutterSolutionBase* prev_sol = nullptr;
             
             //
-            // inner loop is on reduced frequencies
+            // inner loop is on velocity
             //
             for (unsigned int i=0; i<_n_V_divs+1; i++) {
                 current_v_ref = v_ref_vals[i];
-                std::unique_ptr<MAST::FlutterSolutionBase> sol =
-                _analyze(current_k_red,
-                         current_v_ref,
-                         prev_sol);
                 
+                std::unique_ptr<MAST::FlutterSolutionBase> sol;
+                
+                if (_if_parallel_sweep) {
+                    
+                    MAST::PKFlutterSolution* root = new MAST::PKFlutterSolution;
+                    root->init(*this,
+                               current_k_red, current_v_ref,
+                               (*_bref_param)(),
+                               stiff[j], ges[j*(_n_V_divs+1)+i]);
+                    if (prev_sol)
+                        root->sort(*prev_sol);
+                    
+                    sol.reset(root);
+                }
+                else
+                    sol = _analyze(current_k_red,
+                                   current_v_ref,
+                                   prev_sol);
                 
                 if (_output)
                     sol->print(*_output);
@@ -278,6 +366,31 @@ MAST::PKFlutterSolver::print_sorted_roots()
             << std::setw(3)  << " ";
         *_output << std::endl << std::endl;
     }
+    
+    this->print_matrix_cache_summary();
+}
+
+
+
+void
+MAST::PKFlutterSolver::print_matrix_cache_summary()
+{
+    // print only if the output was set
+    if (!_output)
+        return;
+    
+    *_output
+    << "Reduced-order matrix assemblies: " << std::endl
+    << "  structural M/K   : "
+    << std::setw(8) << _n_structural_assemblies << " assembled, "
+    << std::setw(8) << _n_structural_reused << " saved" << std::endl
+    << "  aerodynamic GAF  : "
+    << std::setw(8) << _n_gaf_assemblies << " assembled, "
+    << std::setw(8) << _n_gaf_reused + _n_gaf_interpolated << " saved ("
+    << _n_gaf_reused << " tabulated, "
+    << _n_gaf_interpolated << " interpolated)" << std::endl
+    << "  tabulated reduced frequencies: " << _gaf.size() << std::endl
+    << std::endl;
 }
 
 
@@ -984,29 +1097,150 @@ MAST::PKFlutterSolver::_initialize_matrices(const Real k_red,
     const unsigned int n = (unsigned int)_basis_vectors->size();
 
     RealMatrixX
-    m      =  RealMatrixX::Zero(n, n),
-    k      =  RealMatrixX::Zero(n, n);
+    m,
+    k;
     
     ComplexMatrixX
-    a      =  ComplexMatrixX::Zero(n, n);
-
-    
-    // now prepare a map of the quantities and ask the assembly object to
-    // calculate the quantities of interest.
-    std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
-    qty_map[MAST::MASS]       = &m;
-    qty_map[MAST::STIFFNESS]  = &k;
+    a;
 
     
     // set the velocity value in the parameter that was provided
     (*_kred_param)      = k_red;
     (*_velocity_param)  = v_ref;
     
-    _assembly->assemble_reduced_order_quantity(*_basis_vectors, qty_map);
+    // M and K are independent of (k_red, V), and A depends only on k_red.
+    // Hence, these are obtained from the cache and assembled only if needed.
+    this->_structural_matrices(m, k);
+    this->_aerodynamic_matrix(k_red, a);
 
+    A = ComplexMatrixX::Zero(2*n, 2*n);
+    B = ComplexMatrixX::Zero(2*n, 2*n);
+    
+    A.topRightCorner    (n, n)    =  ComplexMatrixX::Identity(n, n);
+    A.bottomLeftCorner  (n, n)    = -k.cast<Complex>() + _rho/2.*v_ref*v_ref*a;
+    B.topLeftCorner     (n, n)    = ComplexMatrixX::Identity(n, n);
+    B.bottomRightCorner (n, n)    = m.cast<Complex>();
+    
+    stiff = k;
+}
+
+
+
+void
+MAST::PKFlutterSolver::_structural_matrices(RealMatrixX& m,
+                                            RealMatrixX& k) {
+    
+    if (!_if_structural_cached) {
+        
+        const unsigned int n = (unsigned int)_basis_vectors->size();
+        
+        _mass       =  RealMatrixX::Zero(n, n);
+        _stiffness  =  RealMatrixX::Zero(n, n);
+        
+        // now prepare a map of the quantities and ask the assembly object to
+        // calculate the quantities of interest.
+        std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
+        qty_map[MAST::MASS]       = &_mass;
+        qty_map[MAST::STIFFNESS]  = &_stiffness;
+        
+        _assembly->assemble_reduced_order_quantity(*_basis_vectors, qty_map);
+        
+        _if_structural_cached = true;
+        _n_structural_assemblies++;
+    }
+    else
+        _n_structural_reused++;
+    
+    m = _mass;
+    k = _stiffness;
+}
+
+
+
+void
+MAST::PKFlutterSolver::_aerodynamic_matrix(const Real k_red,
+                                           ComplexMatrixX& a) {
+    
+    const Real
+    tol = 1.e-12 * std::max(1., std::fabs(k_red));
+    
+    // first entry with reduced frequency not less than k_red
+    std::map<Real, ComplexMatrixX>::const_iterator
+    upper = _gaf.lower_bound(k_red - tol);
+    
+    // use the tabulated value, if available
+    if (upper != _gaf.end() &&
+        std::fabs(upper->first - k_red) <= tol) {
+        
+        a = upper->second;
+        _n_gaf_reused++;
+        return;
+    }
+    
+    // interpolate if k_red lies between two tabulated values that are
+    // within the allowable spacing
+    bool
+    if_interpolate = (_if_interpolate_gaf &&
+                      upper != _gaf.end() &&
+                      upper != _gaf.begin());
+    
+    std::map<Real, ComplexMatrixX>::const_iterator
+    lower = upper;
+    
+    if (if_interpolate) {
+        
+        lower--;
+        
+        if (_gaf_interp_max_dk > 0. &&
+            upper->first - lower->first > _gaf_interp_max_dk)
+            if_interpolate = false;
+    }
+    
+    if (if_interpolate) {
+        
+        // the two nearest values on each side, if available
+        std::vector<std::map<Real, ComplexMatrixX>::const_iterator> pts;
+        
+        if (lower != _gaf.begin()) {
+            
+            std::map<Real, ComplexMatrixX>::const_iterator it = lower;
+            it--;
+            pts.push_back(it);
+        }
+        pts.push_back(lower);
+        pts.push_back(upper);
+        
+        std::map<Real, ComplexMatrixX>::const_iterator
+        next = upper;
+        next++;
+        if (next != _gaf.end())
+            pts.push_back(next);
+        
+        a = ComplexMatrixX::Zero(upper->second.rows(), upper->second.cols());
+        
+        for (unsigned int i=0; i<pts.size(); i++) {
+            
+            Real w = 1.;
+            
+            for (unsigned int j=0; j<pts.size(); j++)
+                if (j != i)
+                    w *= (k_red - pts[j]->first)/(pts[i]->first - pts[j]->first);
+            
+            a += w * pts[i]->second;
+        }
+        
+        _n_gaf_interpolated++;
+        return;
+    }
+    
+    // otherwise, assemble the matrix and add it to the table
+    const unsigned int n = (unsigned int)_basis_vectors->size();
+    
+    a  =  ComplexMatrixX::Zero(n, n);
+    
     dynamic_cast<MAST::FSIGeneralizedAeroForceAssembly*>(_assembly)->
     assemble_generalized_aerodynamic_force_matrix(*_basis_vectors, a);
-
+    
     // scale the force vector by -1 since MAST calculates all quantities
     // for a R(X)=0 equation so that matrix/vector quantity is assumed
     // to be on the left of the equality. This is not consistent with
@@ -1014,12 +1248,9 @@ MAST::PKFlutterSolver::_initialize_matrices(const Real k_red,
     // vector to be defined on the RHS. Hence, we multiply the quantity
     // here to maintain consistency.
     a  *= -1.;
-
-    A.topRightCorner    (n, n)    =  ComplexMatrixX::Identity(n, n);
-    A.bottomLeftCorner  (n, n)    = -k.cast<Complex>() + _rho/2.*v_ref*v_ref*a;
-    B.topLeftCorner     (n, n)    = ComplexMatrixX::Identity(n, n);
-    B.bottomRightCorner (n, n)    = m.cast<Complex>();
     
+    _gaf[k_red] = a;
+    _n_gaf_assemblies++;
 }
 
 
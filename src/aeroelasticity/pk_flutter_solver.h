@@ -22,6 +22,7 @@
 
 // C++ includes
 #include <memory>
+#include <map>
 
 
 // MAST includes
@@ -49,7 +50,10 @@ namespace MAST {
         
         
         /*!
-         *   clears the solutions stored from a previous analysis.
+         *   clears the solutions stored from a previous analysis, along
+         *   with the cached structural mass and stiffness matrices, which
+         *   are reassembled for the next analysis. The tabulated
+         *   aerodynamic matrices are kept.
          */
         virtual void clear_solutions();
         
@@ -135,9 +139,109 @@ namespace MAST {
                                            const MAST::FunctionBase& f);
         
         
+        /*!
+         *   if \p f is true, the generalized aerodynamic force matrix at a
+         *   reduced frequency that lies between the tabulated reduced
+         *   frequencies is interpolated from the tabulated matrices, instead
+         *   of being assembled. If \p max_dk is positive, the matrix is
+         *   interpolated only if the two tabulated reduced frequencies that
+         *   bracket it are no more than \p max_dk apart, and is assembled
+         *   otherwise. The interpolation error depends on the variation of
+         *   the aerodynamic matrices between the tabulated values, so this
+         *   is false by default.
+         */
+        void set_interpolate_aerodynamic_matrices(bool f,
+                                                  const Real max_dk = 0.) {
+            
+            _if_interpolate_gaf  = f;
+            _gaf_interp_max_dk   = max_dk;
+        }
+        
+        
+        /*!
+         *   clears the cached structural mass and stiffness matrices and the
+         *   tabulated generalized aerodynamic force matrices. This must be
+         *   called if the structural or fluid model is changed after the
+         *   matrices were assembled.
+         */
+        void clear_matrix_cache();
+        
+        
+        /*!
+         *   Prints the number of assemblies of the reduced-order matrices
+         *   that were performed and that were avoided by the cache.
+         */
+        void print_matrix_cache_summary();
+        
+        
+        /*!
+         *   @returns the number of assemblies of the structural mass and
+         *   stiffness matrices since the cache was last cleared
+         */
+        unsigned int n_structural_matrix_assemblies() const {
+            
+            return _n_structural_assemblies;
+        }
+        
+        
+        /*!
+         *   @returns the number of assemblies of the generalized
+         *   aerodynamic force matrix since the cache was last cleared
+         */
+        unsigned int n_aerodynamic_matrix_assemblies() const {
+            
+            return _n_gaf_assemblies;
+        }
+        
+        
+        /*!
+         *   @returns the number of generalized aerodynamic force matrices
+         *   that were obtained from the tabulated values since the cache
+         *   was last cleared
+         */
+        unsigned int n_aerodynamic_matrix_reuses() const {
+            
+            return _n_gaf_reused;
+        }
+        
+        
+        /*!
+         *   @returns the number of generalized aerodynamic force matrices
+         *   that were interpolated from the tabulated values since the
+         *   cache was last cleared
+         */
+        unsigned int n_aerodynamic_matrix_interpolations() const {
+            
+            return _n_gaf_interpolated;
+        }
+        
+        
     protected:
         
         
+        /*!
+         *   provides the reduced-order structural mass and stiffness
+         *   matrices. These are independent of the reduced frequency and
+         *   velocity, and are assembled only once until
+         *   clear_solutions() or clear_matrix_cache() is called.
+         */
+        void _structural_matrices(RealMatrixX& m,
+                                  RealMatrixX& k);
+        
+        
+        /*!
+         *   provides the generalized aerodynamic force matrix at reduced
+         *   frequency \p k_red. The matrix is assembled only once for each
+         *   reduced frequency. If interpolation is enabled, the matrix for a
+         *   reduced frequency between tabulated values that are close
+         *   enough (see set_interpolate_aerodynamic_matrices()) is
+         *   interpolated using a Lagrange polynomial through the two nearest
+         *   tabulated values on each side.
+         */
+        void _aerodynamic_matrix(const Real k_red,
+                                 ComplexMatrixX& a);
+        
+        
         void _insert_new_solution(const Real k_red_ref,
                                   MAST::FlutterSolutionBase* sol);
         
@@ -255,6 +359,44 @@ namespace MAST {
          */
         std::multimap<Real, MAST::FlutterRootCrossoverBase*> _flutter_crossovers;
 
+        /*!
+         *   interpolate the generalized aerodynamic force matrices between
+         *   the tabulated reduced frequencies if true.
+         */
+        bool                                            _if_interpolate_gaf;
+        
+        /*!
+         *   maximum spacing of the tabulated reduced frequencies for which
+         *   the aerodynamic matrices are interpolated. Zero places no limit.
+         */
+        Real                                            _gaf_interp_max_dk;
+        
+        /*!
+         *   true if the structural matrices have been assembled and cached
+         */
+        bool                                            _if_structural_cached;
+        
+        /*!
+         *   cached reduced-order structural mass and stiffness matrices
+         */
+        RealMatrixX                                     _mass,
+                                                        _stiffness;
+        
+        /*!
+         *   generalized aerodynamic force matrices tabulated versus the
+         *   reduced frequency
+         */
+        std::map<Real, ComplexMatrixX>                  _gaf;
+        
+        /*!
+         *   number of structural and aerodynamic assemblies performed, and
+         *   number of requests that were served from the cache
+         */
+        unsigned int                                    _n_structural_assemblies,
+                                                        _n_structural_reused,
+                                                        _n_gaf_assemblies,
+                                                        _n_gaf_reused,
+                                                        _n_gaf_interpolated;
         
     };
 }
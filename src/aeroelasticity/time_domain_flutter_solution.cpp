@@ -81,6 +81,43 @@ MAST::TimeDomainFlutterSolution::init (const MAST::TimeDomainFlutterSolver& solv
 
 
 
+void
+MAST::TimeDomainFlutterSolution::init (const MAST::TimeDomainFlutterSolver& solver,
+                                       const Real v_ref,
+                                       const RealMatrixX& A,
+                                       const RealMatrixX& B,
+                                       const ComplexVectorX& eig_vals,
+                                       const ComplexMatrixX& VR,
+                                       const ComplexMatrixX& VL) {
+    
+    // make sure that it hasn't already been initialized
+    libmesh_assert(!_roots.size());
+    libmesh_assert_equal_to(eig_vals.size(), VR.cols());
+    libmesh_assert_equal_to(eig_vals.size(), VL.cols());
+    
+    _ref_val           = v_ref;
+    _Amat              = A;
+    _Bmat              = B;
+    
+    const unsigned int nvals = (unsigned int)eig_vals.size();
+    
+    _roots.resize(nvals);
+    for (unsigned int i=0; i<nvals; i++) {
+        
+        MAST::TimeDomainFlutterRoot* root = new MAST::TimeDomainFlutterRoot;
+        root->init(v_ref,
+                   eig_vals(i),
+                   1.,
+                   _Bmat,
+                   VR.col(i),
+                   VL.col(i));
+        
+        _roots[i] = root;
+    }
+}
+
+
+
 unsigned int
 MAST::TimeDomainFlutterSolution::
 n_unstable_roots_in_upper_complex_half (Real tol) const {
@@ -54,6 +54,21 @@ namespace MAST {
                    const Real v_ref,
                    const MAST::LAPACK_DGGEV& eig_sol);
         
+        /*!
+         *   initializes the root from eigenpairs of \f$ A x = p B x \f$
+         *   that were computed without a QZ solution, for example by
+         *   tracking from a previous solution. The columns of \p VR and
+         *   \p VL are the right and left eigenvectors of the eigenvalues
+         *   in \p eig_vals, scaled so that \f$ VL^H B VR = I \f$.
+         */
+        void init (const MAST::TimeDomainFlutterSolver& solver,
+                   const Real v_ref,
+                   const RealMatrixX& A,
+                   const RealMatrixX& B,
+                   const ComplexVectorX& eig_vals,
+                   const ComplexMatrixX& VR,
+                   const ComplexMatrixX& VL);
+        
         /*!
          *   number of unstable roots in this solution. Only roots with damping
          *   greater than \p tol will be considered unstable.
@@ -30,12 +30,24 @@
 #include "base/parameter.h"
 #include "base/nonlinear_system.h"
 
+// C++ includes
+#include <limits>
+
 
 MAST::TimeDomainFlutterSolver::TimeDomainFlutterSolver():
 MAST::FlutterSolverBase(),
 _velocity_param(nullptr),
 _V_range(),
-_n_V_divs(0.) {
+_n_V_divs(0.),
+_if_affine(false),
+_affine_degree(2),
+_affine_V_range(0., 0.),
+_n_assemblies(0),
+_if_track_roots(false),
+_tracking_tol(1.e-10),
+_tracking_max_iters(8),
+_n_qz_solves(0),
+_n_tracked_solves(0) {
     
 }
 
@@ -56,6 +68,11 @@ MAST::TimeDomainFlutterSolver::clear() {
     _velocity_param   = nullptr;
     _V_range          = std::pair<Real, Real>(0.,0.);
     _n_V_divs         = 0;
+    _n_assemblies     = 0;
+    _n_qz_solves      = 0;
+    _n_tracked_solves = 0;
+    
+    this->clear_affine_velocity_decomposition();
     
     MAST::FlutterSolverBase::clear();
 }
@@ -75,6 +92,12 @@ initialize(MAST::Parameter&                             velocity_param,
     _V_range.first  = V_lower;
     _V_range.second = V_upper;
     _n_V_divs       = n_V_divs;
+    _n_assemblies   = 0;
+    _n_qz_solves    = 0;
+    _n_tracked_solves = 0;
+    
+    // the basis and velocity range may have changed
+    this->clear_affine_velocity_decomposition();
     
     MAST::FlutterSolverBase::initialize(basis);
 }
@@ -82,6 +105,45 @@ initialize(MAST::Parameter&                             velocity_param,
 
 
 
+void
+MAST::TimeDomainFlutterSolver::
+set_affine_velocity_decomposition(bool f, unsigned int degree) {
+    
+    _if_affine     = f;
+    _affine_degree = degree;
+    
+    this->clear_affine_velocity_decomposition();
+}
+
+
+
+void
+MAST::TimeDomainFlutterSolver::set_eigenvalue_tracking(bool f,
+                                                       Real tol,
+                                                       unsigned int max_iters) {
+    
+    libmesh_assert_greater(tol, 0.);
+    libmesh_assert_greater(max_iters, 0);
+    
+    _if_track_roots     = f;
+    _tracking_tol       = tol;
+    _tracking_max_iters = max_iters;
+}
+
+
+
+void
+MAST::TimeDomainFlutterSolver::clear_affine_velocity_decomposition() {
+    
+    _m_coeffs.clear();
+    _c_coeffs.clear();
+    _k_coeffs.clear();
+    _affine_V_range = std::pair<Real, Real>(0., 0.);
+}
+
+
+
+
 void
 MAST::TimeDomainFlutterSolver::clear_solutions() {
     
@@ -172,8 +234,15 @@ MAST::TimeDomainFlutterSolver::find_next_root(const Real g_tol,
                                 g_tol,
                                 n_bisection_iters);
             if (!sol.first)*/
-            sol =   _bisection_search(cross->crossover_solutions,
-                                      root_num, g_tol, n_bisection_iters);
+            if (_if_track_roots)
+                sol = _tracked_crossover_search(cross->crossover_solutions,
+                                                root_num, g_tol, n_bisection_iters);
+            
+            // the bisection search is used if tracking was not requested,
+            // or if the crossover point does not provide a bracket
+            if (!_if_track_roots || !sol.second)
+                sol =   _bisection_search(cross->crossover_solutions,
+                                          root_num, g_tol, n_bisection_iters);
             
             cross->root = &(sol.second->get_root(root_num));
             
@@ -226,8 +295,15 @@ MAST::TimeDomainFlutterSolver::find_critical_root(const Real g_tol,
                                 g_tol,
                                 n_bisection_iters);
             if (!sol.first)*/
-            sol =   _bisection_search(cross->crossover_solutions,
-                                     root_num, g_tol, n_bisection_iters);
+            if (_if_track_roots)
+                sol = _tracked_crossover_search(cross->crossover_solutions,
+                                                root_num, g_tol, n_bisection_iters);
+            
+            // the bisection search is used if tracking was not requested,
+            // or if the crossover point does not provide a bracket
+            if (!_if_track_roots || !sol.second)
+                sol =   _bisection_search(cross->crossover_solutions,
+                                         root_num, g_tol, n_bisection_iters);
             
             cross->root = &(sol.second->get_root(root_num));
             
@@ -424,6 +500,13 @@ analyze_and_find_critical_root_without_tracking(const Real g_tol,
 void
 MAST::TimeDomainFlutterSolver::scan_for_roots() {
     
+    // the roots are tracked from the lower velocity if requested
+    if (!_flutter_solutions.size() && _if_track_roots) {
+        
+        _tracked_scan();
+        return;
+    }
+    
     // if the initial scanning has not been done, then do it now
     if (!_flutter_solutions.size()) {
         // march from the upper limit to the lower to find the roots
@@ -437,11 +520,38 @@ MAST::TimeDomainFlutterSolver::scan_for_roots() {
         }
         V_vals[_n_V_divs] = _V_range.second; // to get around finite-precision arithmetic
         
+        // for a parallel sweep the matrices are assembled on all processors
+        // for all points, and the eigenproblems are then solved together.
+        // Otherwise, each point is analyzed as it is reached.
+        std::vector<MAST::LAPACK_DGGEV> ges;
+        
+        if (_if_parallel_sweep) {
+            
+            std::vector<RealMatrixX>
+            A(_n_V_divs+1),
+            B(_n_V_divs+1);
+            
+            for (unsigned int i=0; i<_n_V_divs+1; i++)
+                _initialize_matrices(V_vals[i], A[i], B[i]);
+            
+            this->_sweep_eigensolve(A, B, ges);
+            _n_qz_solves += (unsigned int)ges.size();
+        }
+        
         MAST::FlutterSolutionBase* prev_sol = nullptr;
         for (unsigned int i=0; i<_n_V_divs+1; i++) {
             current_V = V_vals[i];
-            std::unique_ptr<MAST::TimeDomainFlutterSolution>
-            sol = _analyze(current_V, prev_sol);
+            std::unique_ptr<MAST::TimeDomainFlutterSolution> sol;
+            
+            if (_if_parallel_sweep) {
+                
+                sol.reset(new MAST::TimeDomainFlutterSolution);
+                sol->init(*this, current_V, ges[i]);
+                if (prev_sol)
+                    sol->sort(*prev_sol);
+            }
+            else
+                sol = _analyze(current_V, prev_sol);
             
             prev_sol = sol.get();
             
@@ -636,6 +746,511 @@ _bisection_search(const std::pair<MAST::FlutterSolutionBase*,
 
 
 
+void
+MAST::TimeDomainFlutterSolver::_tracked_scan() {
+    
+    libmesh_assert(!_flutter_solutions.size());
+    
+    // the spacing of the velocity divisions is the largest step, and
+    // a QZ solution is used if the tracking fails with the smallest step
+    const Real
+    dV_max  = (_V_range.second - _V_range.first)/_n_V_divs,
+    dV_min  = dV_max/64.;
+    
+    RealMatrixX
+    A,
+    B;
+    
+    // the roots are initialized with a QZ solution at the lower velocity
+    MAST::FlutterSolutionBase
+    *sol      = _analyze(_V_range.first).release(),
+    *prev_sol = nullptr;
+    
+    if (_output)
+        sol->print(*_output);
+    
+    bool if_success =
+    _flutter_solutions.insert(std::pair<Real, MAST::FlutterSolutionBase*>
+                              (_V_range.first, sol)).second;
+    
+    libmesh_assert(if_success);
+    
+    const unsigned int
+    nvals    = sol->n_roots();
+    
+    unsigned int
+    n_iters  = 0;
+    
+    ComplexVectorX
+    p_pred   = ComplexVectorX::Zero(nvals);
+    
+    Real
+    V        = _V_range.first,
+    dV       = dV_max,
+    new_V    = 0.;
+    
+    while (V < _V_range.second) {
+        
+        // land on the upper limit without a small last step
+        new_V = V + dV;
+        if (new_V > _V_range.second - 1.e-8 * dV_max)
+            new_V = _V_range.second;
+        
+        _initialize_matrices(new_V, A, B);
+        
+        // secant predictor from the two previous solutions
+        for (unsigned int i=0; i<nvals; i++) {
+            
+            p_pred(i) = sol->get_root(i).root;
+            
+            if (prev_sol)
+                p_pred(i) +=
+                (sol->get_root(i).root - prev_sol->get_root(i).root) *
+                (new_V - V) / (V - prev_sol->ref_val());
+        }
+        
+        std::unique_ptr<MAST::TimeDomainFlutterSolution>
+        new_sol = _track(new_V, A, B, *sol, p_pred, n_iters);
+        
+        if (!new_sol) {
+            
+            // retry with a smaller step
+            if (dV > dV_min) {
+                
+                dV *= 0.5;
+                continue;
+            }
+            
+            libMesh::out
+            << "Root tracking failed at V_ref = " << new_V
+            << ", using QZ eigensolution" << std::endl;
+            
+            MAST::LAPACK_DGGEV ges;
+            ges.compute(A, B);
+            ges.scale_eigenvectors_to_identity_innerproduct();
+            _n_qz_solves++;
+            
+            new_sol.reset(new MAST::TimeDomainFlutterSolution);
+            new_sol->init(*this, new_V, ges);
+            new_sol->sort(*sol);
+        }
+        else if (n_iters <= 3)
+            // increase the step if the corrections converged quickly
+            dV = std::min(2.*dV, dV_max);
+        
+        if (_output)
+            new_sol->print(*_output);
+        
+        prev_sol = sol;
+        sol      = new_sol.release();
+        V        = new_V;
+        
+        if_success =
+        _flutter_solutions.insert(std::pair<Real, MAST::FlutterSolutionBase*>
+                                  (V, sol)).second;
+        
+        libmesh_assert(if_success);
+    }
+    
+    _identify_crossover_points();
+}
+
+
+
+
+std::pair<bool, MAST::FlutterSolutionBase*>
+MAST::TimeDomainFlutterSolver::
+_tracked_crossover_search(const std::pair<MAST::FlutterSolutionBase*,
+                          MAST::FlutterSolutionBase*>& ref_sol_range,
+                          const unsigned int root_num,
+                          const Real g_tol,
+                          const unsigned int max_iters) {
+    
+    std::pair<bool, MAST::FlutterSolutionBase*> rval(false, nullptr);
+    
+    MAST::FlutterSolutionBase
+    *lower   = ref_sol_range.first,
+    *upper   = ref_sol_range.second;
+    
+    // divergence points are identified from a single solution, which
+    // does not provide a bracket
+    if (lower == upper)
+        return rval;
+    
+    // assumes that the upper V has +ve g val and lower V has -ve g val
+    Real
+    lower_V  = lower->ref_val(),
+    lower_g  = lower->get_root(root_num).root.real(),
+    upper_V  = upper->ref_val(),
+    upper_g  = upper->get_root(root_num).root.real(),
+    V        = lower_V + (upper_V-lower_V)/(upper_g-lower_g)*(0.-lower_g),
+    new_V    = 0.,
+    w        = 0.;
+    
+    const unsigned int
+    nvals    = lower->n_roots();
+    
+    unsigned int
+    n_iters  = 0,
+    n_newton = 0;
+    
+    RealMatrixX
+    A,
+    B,
+    dA,
+    dB;
+    
+    ComplexVectorX
+    p_pred   = ComplexVectorX::Zero(nvals);
+    
+    Complex
+    dp_dV    = 0.;
+    
+    MAST::FlutterSolutionBase* new_sol = nullptr;
+    
+    while (n_iters < max_iters) {
+        
+        _initialize_matrices(V, A, B);
+        
+        // the eigenvalues are predicted by linear interpolation within
+        // the bracket, and the eigenvectors are taken from the nearer end
+        w = (V - lower_V) / (upper_V - lower_V);
+        for (unsigned int i=0; i<nvals; i++)
+            p_pred(i) =
+            (1.-w) * lower->get_root(i).root + w * upper->get_root(i).root;
+        
+        std::unique_ptr<MAST::TimeDomainFlutterSolution>
+        sol = _track(V, A, B, (w < .5)? *lower : *upper, p_pred, n_newton);
+        
+        // the search continues with bisection from the current bracket,
+        // whose ends are the solutions already added to this solver
+        if (!sol) {
+            
+            libMesh::out
+            << "Root tracking failed at V_ref = " << V
+            << ", continuing with bisection search" << std::endl;
+            
+            return _bisection_search(std::pair<MAST::FlutterSolutionBase*,
+                                     MAST::FlutterSolutionBase*>(lower, upper),
+                                     root_num, g_tol, max_iters - n_iters);
+        }
+        
+        if (_output)
+            sol->print(*_output);
+        
+        new_sol = sol.release();
+        
+        // add the solution to this solver
+        bool if_success =
+        _flutter_solutions.insert(std::pair<Real, MAST::FlutterSolutionBase*>
+                                  (V, new_sol)).second;
+        
+        libmesh_assert(if_success);
+        
+        const MAST::FlutterRootBase& root = new_sol->get_root(root_num);
+        
+        // check the new damping value
+        if (fabs(root.root.real()) <= g_tol) {
+            
+            rval.first  = true;
+            rval.second = new_sol;
+            return rval;
+        }
+        
+        // update the bracket
+        if (root.root.real() < 0.) {
+            
+            lower   = new_sol;
+            lower_V = V;
+            lower_g = root.root.real();
+        }
+        else {
+            
+            upper   = new_sol;
+            upper_V = V;
+            upper_g = root.root.real();
+        }
+        
+        // Newton update from the sensitivity of the eigenvalue with
+        // respect to velocity,
+        //   dp/dV = [y^H (dA/dV - p dB/dV) x]/(y^H B x)
+        _velocity_derivative_matrices(V, A, B, dA, dB);
+        
+        dp_dV   =
+        root.eig_vec_left.dot((dA.cast<Complex>() -
+                               root.root*dB.cast<Complex>())*root.eig_vec_right) /
+        root.eig_vec_left.dot(B.cast<Complex>()*root.eig_vec_right);
+        
+        new_V   = V - root.root.real() / dp_dV.real();
+        
+        // the Newton update is accepted only within the bracket, and
+        // linear interpolation of the bracket is used otherwise
+        if (!(new_V > lower_V && new_V < upper_V))
+            new_V = lower_V + (upper_V-lower_V)/(upper_g-lower_g)*(0.-lower_g);
+        
+        V = new_V;
+        n_iters++;
+    }
+    
+    // return false, along with the latest sol
+    rval.first  = false;
+    rval.second = new_sol;
+    
+    return rval;
+}
+
+
+
+
+std::unique_ptr<MAST::TimeDomainFlutterSolution>
+MAST::TimeDomainFlutterSolver::_track(const Real v_ref,
+                                      const RealMatrixX& A,
+                                      const RealMatrixX& B,
+                                      const MAST::FlutterSolutionBase& prev_sol,
+                                      const ComplexVectorX& p_pred,
+                                      unsigned int& n_iters) {
+    
+    const unsigned int
+    nvals    = prev_sol.n_roots(),
+    n        = (unsigned int)A.rows();
+    
+    libmesh_assert_equal_to(nvals, n);
+    libmesh_assert_equal_to(p_pred.size(), nvals);
+    
+    ComplexVectorX
+    eig      = ComplexVectorX::Zero(nvals),
+    vr,
+    vl;
+    
+    ComplexMatrixX
+    VR       = ComplexMatrixX::Zero(n, nvals),
+    VL       = ComplexMatrixX::Zero(n, nvals);
+    
+    Complex
+    p        = 0.;
+    
+    Real
+    d_min    = 0.;
+    
+    unsigned int
+    it       = 0;
+    
+    n_iters  = 0;
+    
+    std::unique_ptr<MAST::TimeDomainFlutterSolution> sol;
+    
+    for (unsigned int i=0; i<nvals; i++) {
+        
+        const MAST::FlutterRootBase& root = prev_sol.get_root(i);
+        
+        p  = p_pred(i);
+        vr = root.eig_vec_right;
+        vl = root.eig_vec_left;
+        
+        if (!_newton_eigenpair(A, B, p, vr, vl, it))
+            return sol;
+        
+        // a correction larger than half the distance to the predictions
+        // of the other roots may have converged to a different root
+        d_min = std::numeric_limits<Real>::max();
+        for (unsigned int j=0; j<nvals; j++)
+            if (j != i)
+                d_min = std::min(d_min, std::abs(p_pred(j) - p_pred(i)));
+        
+        if (std::abs(p - p_pred(i)) > 0.5 * d_min)
+            return sol;
+        
+        n_iters   = std::max(n_iters, it);
+        eig(i)    = p;
+        VR.col(i) = vr;
+        VL.col(i) = vl;
+    }
+    
+    // two roots converged to the same eigenvalue
+    for (unsigned int i=0; i<nvals; i++)
+        for (unsigned int j=i+1; j<nvals; j++)
+            if (std::abs(eig(i) - eig(j)) <= 1.e-8 * (1. + std::abs(eig(i))))
+                return sol;
+    
+    _n_tracked_solves++;
+    
+    sol.reset(new MAST::TimeDomainFlutterSolution);
+    sol->init(*this, v_ref, A, B, eig, VR, VL);
+    
+    return sol;
+}
+
+
+
+
+bool
+MAST::TimeDomainFlutterSolver::_newton_eigenpair(const RealMatrixX& A,
+                                                 const RealMatrixX& B,
+                                                 Complex& p,
+                                                 ComplexVectorX& vr,
+                                                 ComplexVectorX& vl,
+                                                 unsigned int& n_iters) const {
+    
+    const unsigned int
+    n        = (unsigned int)A.rows();
+    
+    const Real
+    A_norm   = A.norm(),
+    B_norm   = B.norm();
+    
+    const ComplexMatrixX
+    Ac       = A.cast<Complex>(),
+    Bc       = B.cast<Complex>();
+    
+    // the right eigenvector is normalized with respect to the starting
+    // value, c^H x = 1
+    const ComplexVectorX
+    c        = vr / vr.squaredNorm(),
+    cl       = vl / vl.squaredNorm();
+    
+    // Newton iterations on the bordered system
+    //   [ A - p B   -B x ] [ dx ]     [ (A - p B) x ]
+    //   [   c^H       0  ] [ dp ] = - [  c^H x - 1  ]
+    ComplexMatrixX
+    jac      = ComplexMatrixX::Zero(n+1, n+1);
+    
+    ComplexVectorX
+    res      = ComplexVectorX::Zero(n+1),
+    dx;
+    
+    bool
+    if_converged = false;
+    
+    n_iters  = 0;
+    
+    while (true) {
+        
+        res.topRows(n) = (Ac - p*Bc) * vr;
+        res(n)         = c.dot(vr) - 1.;
+        
+        if (res.topRows(n).norm() <=
+            _tracking_tol * (A_norm + std::abs(p) * B_norm) * vr.norm()) {
+            
+            if_converged = true;
+            break;
+        }
+        
+        if (n_iters == _tracking_max_iters)
+            break;
+        
+        jac.topLeftCorner(n, n)     = Ac - p*Bc;
+        jac.topRightCorner(n, 1)    = -Bc * vr;
+        jac.bottomLeftCorner(1, n)  = c.adjoint();
+        jac(n, n)                   = 0.;
+        
+        dx  = jac.partialPivLu().solve(-res);
+        vr += dx.topRows(n);
+        p  += dx(n);
+        
+        n_iters++;
+    }
+    
+    if (!if_converged)
+        return false;
+    
+    // the left eigenvector is the null vector of (A - p B)^H. The bordered
+    // system is nonsingular for a simple eigenvalue, since x is not in the
+    // range of (A - p B)^H.
+    jac.topLeftCorner(n, n)     = (Ac - p*Bc).adjoint();
+    jac.topRightCorner(n, 1)    = vr;
+    jac.bottomLeftCorner(1, n)  = cl.adjoint();
+    jac(n, n)                   = 0.;
+    
+    res.setZero();
+    res(n) = 1.;
+    
+    dx  = jac.partialPivLu().solve(res);
+    vl  = dx.topRows(n);
+    
+    if (!vl.allFinite())
+        return false;
+    
+    vl /= vl.norm();
+    
+    // scale the right eigenvector so that y^H B x = 1, consistent with
+    // LAPACK_DGGEV::scale_eigenvectors_to_identity_innerproduct(). A small
+    // inner product indicates a nearly defective eigenvalue, for example
+    // at the coalescence of two roots.
+    const Complex
+    den = vl.dot(Bc * vr);
+    
+    if (std::abs(den) <=
+        std::sqrt(std::numeric_limits<Real>::epsilon()) * B_norm * vr.norm())
+        return false;
+    
+    vr /= den;
+    
+    return true;
+}
+
+
+
+
+void
+MAST::TimeDomainFlutterSolver::
+_velocity_derivative_matrices(Real U_inf,
+                              const RealMatrixX& A,
+                              const RealMatrixX& B,
+                              RealMatrixX& dA,
+                              RealMatrixX& dB) {
+    
+    if (_if_affine && !_m_coeffs.empty()) {
+        
+        const unsigned int
+        n     = (unsigned int)_basis_vectors->size();
+        
+        const Real
+        V0    = _affine_V_range.first,
+        V1    = _affine_V_range.second,
+        s     = (2.*U_inf - (V0+V1)) / (V1-V0),
+        ds_dV = 2. / (V1-V0);
+        
+        RealMatrixX
+        dm    = RealMatrixX::Zero(n, n),
+        dc    = RealMatrixX::Zero(n, n),
+        dk    = RealMatrixX::Zero(n, n);
+        
+        Real
+        s_pow = 1.;
+        
+        for (unsigned int i=1; i<_m_coeffs.size(); i++) {
+            
+            dm    += (i * s_pow * ds_dV) * _m_coeffs[i];
+            dc    += (i * s_pow * ds_dV) * _c_coeffs[i];
+            dk    += (i * s_pow * ds_dV) * _k_coeffs[i];
+            s_pow *= s;
+        }
+        
+        dA.setZero(2*n, 2*n);
+        dB.setZero(2*n, 2*n);
+        
+        dB.bottomRightCorner(n, n)  = dm;
+        dA.bottomLeftCorner(n, n)   = -dk;
+        dA.bottomRightCorner(n, n)  = -dc;
+    }
+    else {
+        
+        // forward difference, which also includes the change in the
+        // steady solution if a steady solver is attached
+        const Real
+        delta = 1.e-6 * std::max(std::fabs(U_inf),
+                                 _V_range.second - _V_range.first);
+        
+        _initialize_matrices(U_inf + delta, dA, dB);
+        
+        dA  = (dA - A) / delta;
+        dB  = (dB - B) / delta;
+    }
+}
+
+
+
+
 std::unique_ptr<MAST::TimeDomainFlutterSolution>
 MAST::TimeDomainFlutterSolver::_analyze(const Real v_ref,
                                        const MAST::FlutterSolutionBase* prev_sol) {
@@ -655,6 +1270,7 @@ MAST::TimeDomainFlutterSolver::_analyze(const Real v_ref,
     MAST::LAPACK_DGGEV ges;
     ges.compute(A, B);
     ges.scale_eigenvectors_to_identity_innerproduct();
+    _n_qz_solves++;
     
     MAST::TimeDomainFlutterSolution* root = new MAST::TimeDomainFlutterSolution;
     root->init(*this, v_ref, ges);
@@ -696,6 +1312,54 @@ MAST::TimeDomainFlutterSolver::_initialize_matrices(Real U_inf,
     //
 
     
+    const unsigned int n = (unsigned int)_basis_vectors->size();
+
+    RealMatrixX
+    m      =  RealMatrixX::Zero(n, n),
+    c      =  RealMatrixX::Zero(n, n),
+    k      =  RealMatrixX::Zero(n, n);
+
+    if (_if_affine) {
+        
+        if (_m_coeffs.empty())
+            _init_affine_velocity_decomposition();
+        
+        _affine_reduced_order_matrices(U_inf, m, c, k);
+        
+        // keep the parameter consistent with the direct path, since
+        // the caller may use it after this call
+        (*_velocity_param) = U_inf;
+    }
+    else
+        _assemble_reduced_order_matrices(U_inf, m, c, k);
+    
+    
+    // put the matrices back in the system matrices
+    A.setZero(2*n, 2*n);
+    B.setZero(2*n, 2*n);
+    
+    
+    B.topLeftCorner(n, n)      = RealMatrixX::Identity(n,n );
+    B.bottomRightCorner(n, n)  = m;
+    
+    
+    A.topRightCorner(n, n)     = RealMatrixX::Identity(n, n);
+    A.bottomLeftCorner(n, n)   = -k;
+    A.bottomRightCorner(n, n)  = -c;
+}
+
+
+
+
+
+
+void
+MAST::TimeDomainFlutterSolver::
+_assemble_reduced_order_matrices(Real U_inf,
+                                 RealMatrixX& m,
+                                 RealMatrixX& c,
+                                 RealMatrixX& k) {
+    
     // set the velocity value in the parameter that was provided
     (*_velocity_param) = U_inf;
     
@@ -712,11 +1376,9 @@ MAST::TimeDomainFlutterSolver::_initialize_matrices(Real U_inf,
     
     const unsigned int n = (unsigned int)_basis_vectors->size();
 
-    RealMatrixX
-    m      =  RealMatrixX::Zero(n, n),
-    c      =  RealMatrixX::Zero(n, n),
-    k      =  RealMatrixX::Zero(n, n);
-
+    m.setZero(n, n);
+    c.setZero(n, n);
+    k.setZero(n, n);
     
     // now prepare a map of the quantities and ask the assembly object to
     // calculate the quantities of interest.
@@ -728,25 +1390,148 @@ MAST::TimeDomainFlutterSolver::_initialize_matrices(Real U_inf,
     
     _assembly->assemble_reduced_order_quantity(*_basis_vectors,
                                                qty_map);
+    _n_assemblies++;
+}
+
+
+
+
+void
+MAST::TimeDomainFlutterSolver::_init_affine_velocity_decomposition() {
     
+    // the steady solution, and hence the linearized aerodynamic operator,
+    // is not a polynomial in velocity
+    if (_steady_solver)
+        libmesh_error_msg("Affine velocity decomposition cannot be used with a steady solver");
     
-    // put the matrices back in the system matrices
-    A.setZero(2*n, 2*n);
-    B.setZero(2*n, 2*n);
+    libmesh_assert(_velocity_param);
     
+    const Real
+    V0  = _V_range.first,
+    V1  = _V_range.second;
     
-    B.topLeftCorner(n, n)      = RealMatrixX::Identity(n,n );
-    B.bottomRightCorner(n, n)  = m;
+    if (!(V1 > V0))
+        libmesh_error_msg("Affine velocity decomposition requires V_upper > V_lower");
     
+    _affine_V_range = _V_range;
     
-    A.topRightCorner(n, n)     = RealMatrixX::Identity(n, n);
-    A.bottomLeftCorner(n, n)   = -k;
-    A.bottomRightCorner(n, n)  = -c;
+    const unsigned int
+    n_pts  = _affine_degree+1,
+    n      = (unsigned int)_basis_vectors->size();
+    
+    // Chebyshev points in the scaled velocity s in [-1, 1] keep the
+    // Vandermonde matrix well conditioned
+    RealVectorX
+    s      = RealVectorX::Zero(n_pts);
+    RealMatrixX
+    vand   = RealMatrixX::Zero(n_pts, n_pts);
+    
+    std::vector<RealMatrixX>
+    m_vals(n_pts),
+    c_vals(n_pts),
+    k_vals(n_pts);
+    
+    for (unsigned int i=0; i<n_pts; i++) {
+        
+        s(i) = cos(M_PI * (2.*i+1.) / (2.*n_pts));
+        for (unsigned int j=0; j<n_pts; j++)
+            vand(i, j) = pow(s(i), j);
+        
+        _assemble_reduced_order_matrices(.5*(V0+V1) + .5*(V1-V0)*s(i),
+                                         m_vals[i],
+                                         c_vals[i],
+                                         k_vals[i]);
+    }
+    
+    // the coefficient matrices are obtained from the inverse of the
+    // Vandermonde matrix
+    const RealMatrixX
+    vand_inv = vand.inverse();
+    
+    _m_coeffs.assign(n_pts, RealMatrixX::Zero(n, n));
+    _c_coeffs.assign(n_pts, RealMatrixX::Zero(n, n));
+    _k_coeffs.assign(n_pts, RealMatrixX::Zero(n, n));
+    
+    for (unsigned int j=0; j<n_pts; j++)
+        for (unsigned int i=0; i<n_pts; i++) {
+            
+            _m_coeffs[j] += vand_inv(j, i) * m_vals[i];
+            _c_coeffs[j] += vand_inv(j, i) * c_vals[i];
+            _k_coeffs[j] += vand_inv(j, i) * k_vals[i];
+        }
+    
+    // verify the decomposition at a velocity that is not one of the
+    // sample points
+    const Real
+    s_chk = 0.3141592653589793,
+    V_chk = .5*(V0+V1) + .5*(V1-V0)*s_chk,
+    tol   = 1.e-8;
+    
+    RealMatrixX
+    m_chk, c_chk, k_chk,
+    m_fit, c_fit, k_fit;
+    
+    _assemble_reduced_order_matrices(V_chk, m_chk, c_chk, k_chk);
+    _affine_reduced_order_matrices(V_chk, m_fit, c_fit, k_fit);
+    
+    // the error is measured relative to the largest matrix norm in the
+    // samples, so that quantities that are identically zero are handled
+    Real
+    scale = std::max(std::max(m_chk.norm(), c_chk.norm()), k_chk.norm());
+    for (unsigned int i=0; i<n_pts; i++)
+        scale = std::max(scale,
+                         std::max(std::max(m_vals[i].norm(),
+                                           c_vals[i].norm()),
+                                  k_vals[i].norm()));
+    
+    const Real
+    err = std::max(std::max((m_fit-m_chk).norm(),
+                            (c_fit-c_chk).norm()),
+                   (k_fit-k_chk).norm());
+    
+    if (err > tol * std::max(scale, 1.)) {
+        
+        this->clear_affine_velocity_decomposition();
+        libmesh_error_msg("Aerodynamic operator is not affine in velocity with degree "
+                          << _affine_degree
+                          << ": relative error = " << err/std::max(scale, 1.));
+    }
 }
 
 
 
 
+void
+MAST::TimeDomainFlutterSolver::
+_affine_reduced_order_matrices(Real U_inf,
+                               RealMatrixX& m,
+                               RealMatrixX& c,
+                               RealMatrixX& k) const {
+    
+    libmesh_assert(!_m_coeffs.empty());
+    
+    const Real
+    V0  = _affine_V_range.first,
+    V1  = _affine_V_range.second,
+    s   = (2.*U_inf - (V0+V1)) / (V1-V0);
+    
+    m = _m_coeffs[0];
+    c = _c_coeffs[0];
+    k = _k_coeffs[0];
+    
+    Real
+    s_pow = 1.;
+    
+    for (unsigned int i=1; i<_m_coeffs.size(); i++) {
+        
+        s_pow *= s;
+        m     += s_pow * _m_coeffs[i];
+        c     += s_pow * _c_coeffs[i];
+        k     += s_pow * _k_coeffs[i];
+    }
+}
+
+
 
 
 void
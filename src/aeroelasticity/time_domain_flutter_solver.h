@@ -22,6 +22,7 @@
 
 // C++ includes
 #include <memory>
+#include <vector>
 
 
 // MAST includes
@@ -166,6 +167,84 @@ namespace MAST {
         virtual void scan_for_roots();
         
         
+        /*!
+         *   if \p f is true, the reduced-order mass, damping and stiffness
+         *   matrices are computed from an affine decomposition in velocity,
+         *   \f$ K(V) = \sum_{i=0}^{d} s^i K_i \f$, where \f$ s \f$ is the
+         *   velocity scaled to \f$ [-1, 1] \f$ over the velocity range and
+         *   \f$ d \f$ is \p degree. The coefficient matrices are obtained
+         *   from assemblies at \f$ d+1 \f$ velocities, and each velocity is
+         *   then evaluated with a dense matrix sum. This applies to
+         *   aerodynamic operators that are polynomial in velocity at a
+         *   fixed Mach number and density, for example piston theory. The
+         *   decomposition is verified by an assembly at one more velocity,
+         *   and an error is raised if the operator is not a polynomial of
+         *   degree \p degree. This cannot be used with a steady solver, since
+         *   the steady solution is not polynomial in velocity.
+         */
+        void set_affine_velocity_decomposition(bool f,
+                                               unsigned int degree = 2);
+        
+        
+        /*!
+         *   clears the coefficient matrices of the affine decomposition,
+         *   which are then assembled again when needed. This must be called
+         *   if the structural model is changed.
+         */
+        void clear_affine_velocity_decomposition();
+        
+        
+        /*!
+         *   @returns the number of assemblies of the reduced-order matrices
+         *   since the last call to initialize()
+         */
+        unsigned int n_reduced_order_assemblies() const {
+            
+            return _n_assemblies;
+        }
+        
+        
+        /*!
+         *   if \p f is true, the roots are tracked along the velocity axis
+         *   instead of computing a QZ solution at each velocity in
+         *   scan_for_roots(). Each eigenpair is predicted from the previous
+         *   velocities and corrected by Newton iterations on
+         *   \f$ (A - p B) x = 0 \f$, so that the roots retain their order
+         *   without the modal participation sorting. The velocity step is
+         *   reduced if the correction does not converge in \p max_iters
+         *   iterations to the relative residual \p tol, or if two roots
+         *   converge to the same eigenvalue, and a QZ solution is used
+         *   only if the step becomes too small. The spacing of the velocity
+         *   divisions is the maximum step. The crossover points are then
+         *   found by a Newton search in velocity within the bracket of the
+         *   crossover, with the eigenpairs corrected in the same manner.
+         *   The tracking is sequential and does not use the parallel sweep.
+         */
+        void set_eigenvalue_tracking(bool f,
+                                     Real tol = 1.e-10,
+                                     unsigned int max_iters = 8);
+        
+        
+        /*!
+         *   @returns the number of QZ eigensolutions since the last call to
+         *   initialize()
+         */
+        unsigned int n_qz_solves() const {
+            
+            return _n_qz_solves;
+        }
+        
+        
+        /*!
+         *   @returns the number of solutions computed by tracking since the
+         *   last call to initialize()
+         */
+        unsigned int n_tracked_solves() const {
+            
+            return _n_tracked_solves;
+        }
+        
+        
     protected:
         
         
@@ -191,6 +270,76 @@ namespace MAST {
                           const unsigned int max_iters);
 
         
+        /*!
+         *    scans the velocity range by tracking the roots from the
+         *    solution at the lower velocity
+         */
+        void _tracked_scan();
+        
+        
+        /*!
+         *    Newton search for the velocity at which root \p root_num has
+         *    zero damping, within the bracket \p ref_sol_range. The
+         *    eigenpairs at each velocity are obtained by tracking. If the
+         *    tracking fails, the search continues with
+         *    \p _bisection_search() from the bracket narrowed so far, so
+         *    that the solutions added to this solver are kept. The returned
+         *    solution is nullptr if \p ref_sol_range is not a bracket.
+         */
+        std::pair<bool, MAST::FlutterSolutionBase*>
+        _tracked_crossover_search(const std::pair<MAST::FlutterSolutionBase*,
+                                  MAST::FlutterSolutionBase*>& ref_sol_range,
+                                  const unsigned int root_num,
+                                  const Real g_tol,
+                                  const unsigned int max_iters);
+        
+        
+        /*!
+         *    computes the solution at velocity \p v_ref with matrices
+         *    \p A and \p B by correcting each root of \p prev_sol, starting
+         *    from the eigenvalues in \p p_pred. \p n_iters returns the
+         *    largest number of Newton iterations over all roots. Returns
+         *    nullptr if any root did not converge, or if the roots are not
+         *    distinct.
+         */
+        std::unique_ptr<MAST::TimeDomainFlutterSolution>
+        _track(const Real v_ref,
+               const RealMatrixX& A,
+               const RealMatrixX& B,
+               const MAST::FlutterSolutionBase& prev_sol,
+               const ComplexVectorX& p_pred,
+               unsigned int& n_iters);
+        
+        
+        /*!
+         *    Newton iterations for eigenpair \p p, \p vr of
+         *    \f$ A x = p B x \f$ starting from the given values. The left
+         *    eigenvector \p vl is then updated with the converged
+         *    eigenvalue, and \p vr is scaled so that \f$ vl^H B vr = 1 \f$.
+         *    Returns false if the iterations do not converge, or if the
+         *    eigenvalue is ill-conditioned.
+         */
+        bool _newton_eigenpair(const RealMatrixX& A,
+                               const RealMatrixX& B,
+                               Complex& p,
+                               ComplexVectorX& vr,
+                               ComplexVectorX& vl,
+                               unsigned int& n_iters) const;
+        
+        
+        /*!
+         *    derivative of the matrices \p A and \p B with respect to
+         *    velocity at \p U_inf. This is computed from the affine
+         *    decomposition if available, and by a forward difference
+         *    otherwise.
+         */
+        void _velocity_derivative_matrices(Real U_inf,
+                                           const RealMatrixX& A,
+                                           const RealMatrixX& B,
+                                           RealMatrixX& dA,
+                                           RealMatrixX& dB);
+        
+        
         /*!
          *    Assembles the reduced order system structural and aerodynmaic 
          *    matrices for specified flight velocity \p U_inf.
@@ -200,6 +349,33 @@ namespace MAST {
                                   RealMatrixX& B);
 
         
+        /*!
+         *    assembles the reduced-order mass, damping and stiffness
+         *    matrices at flight velocity \p U_inf.
+         */
+        void _assemble_reduced_order_matrices(Real U_inf,
+                                              RealMatrixX& m,
+                                              RealMatrixX& c,
+                                              RealMatrixX& k);
+        
+        
+        /*!
+         *    computes and verifies the coefficient matrices of the affine
+         *    velocity decomposition.
+         */
+        void _init_affine_velocity_decomposition();
+        
+        
+        /*!
+         *    computes the reduced-order mass, damping and stiffness matrices
+         *    at flight velocity \p U_inf from the affine decomposition.
+         */
+        void _affine_reduced_order_matrices(Real U_inf,
+                                            RealMatrixX& m,
+                                            RealMatrixX& c,
+                                            RealMatrixX& k) const;
+        
+        
         /*!
          *    Assembles the reduced order system structural and aerodynmaic
          *    matrices for specified flight velocity \p U_inf.
@@ -249,6 +425,60 @@ namespace MAST {
          */
         std::multimap<Real, MAST::FlutterRootCrossoverBase*> _flutter_crossovers;
 
+        
+        /*!
+         *   use the affine velocity decomposition if true
+         */
+        bool                                            _if_affine;
+        
+        
+        /*!
+         *   polynomial degree in velocity of the affine decomposition
+         */
+        unsigned int                                    _affine_degree;
+        
+        
+        /*!
+         *   velocity range used to scale the velocity in the affine
+         *   decomposition
+         */
+        std::pair<Real, Real>                           _affine_V_range;
+        
+        
+        /*!
+         *   coefficient matrices of the affine decomposition of the
+         *   reduced-order mass, damping and stiffness matrices
+         */
+        std::vector<RealMatrixX>                        _m_coeffs,
+                                                        _c_coeffs,
+                                                        _k_coeffs;
+        
+        
+        /*!
+         *   number of assemblies of the reduced-order matrices
+         */
+        unsigned int                                    _n_assemblies;
+        
+        
+        /*!
+         *   track the roots along the velocity axis if true
+         */
+        bool                                            _if_track_roots;
+        
+        
+        /*!
+         *   relative residual tolerance and maximum number of iterations
+         *   of the Newton correction of tracked eigenpairs
+         */
+        Real                                            _tracking_tol;
+        unsigned int                                    _tracking_max_iters;
+        
+        
+        /*!
+         *   number of QZ solutions and of tracked solutions
+         */
+        unsigned int                                    _n_qz_solves,
+                                                        _n_tracked_solves;
     };
 }
 
@@ -275,12 +275,41 @@ MAST::UGFlutterSolver::scan_for_roots() {
         }
         k_vals[_n_kr_divs] = _kr_range.first; // to get around finite-precision arithmetic
         
+        // for a parallel sweep the matrices are assembled on all processors
+        // for all points, and the eigenproblems are then solved together.
+        // Otherwise, each point is analyzed as it is reached.
+        std::vector<MAST::LAPACK_ZGGEV> ges;
+        
+        if (_if_parallel_sweep) {
+            
+            std::vector<ComplexMatrixX>
+            A(_n_kr_divs+1),
+            B(_n_kr_divs+1);
+            
+            for (unsigned int i=0; i< _n_kr_divs+1; i++)
+                _initialize_matrices(k_vals[i], A[i], B[i]);
+            
+            this->_sweep_eigensolve(A, B, ges);
+        }
+        
         MAST::FlutterSolutionBase* prev_sol = nullptr;
         for (unsigned int i=0; i< _n_kr_divs+1; i++) {
             
             current_kr = k_vals[i];
-            std::unique_ptr<MAST::FlutterSolutionBase> sol =
-            _analyze(current_kr, prev_sol);
+            
+            std::unique_ptr<MAST::FlutterSolutionBase> sol;
+            
+            if (_if_parallel_sweep) {
+                
+                MAST::UGFlutterSolution* root = new MAST::UGFlutterSolution;
+                root->init(*this, current_kr, (*_bref_param)(), ges[i]);
+                if (prev_sol)
+                    root->sort(*prev_sol);
+                
+                sol.reset(root);
+            }
+            else
+                sol = _analyze(current_kr, prev_sol);
             
             prev_sol = sol.get();
             
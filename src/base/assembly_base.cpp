@@ -22,6 +22,7 @@
 #include "base/system_initialization.h"
 #include "base/mesh_field_function.h"
 #include "base/elem_base.h"
+#include "base/elem_workspace.h"
 #include "base/physics_discipline_base.h"
 #include "base/nonlinear_system.h"
 #include "base/assembly_elem_operation.h"
@@ -29,6 +30,7 @@
 #include "mesh/fe_base.h"
 #include "mesh/geom_elem.h"
 #include "numerics/utility.h"
+#include "utility/perf_log.h"
 
 
 // libMesh includes
@@ -179,6 +181,8 @@ clear_discipline_and_system() {
     _discipline       = nullptr;
     _system           = nullptr;
     _param_dependence = nullptr;
+    
+    this->clear_elem_workspaces();
 }
 
 
@@ -206,6 +210,76 @@ MAST::AssemblyBase::clear_elem_operation_object() {
 
 
 
+MAST::ElemWorkspace&
+MAST::AssemblyBase::elem_workspace() {
+    
+    libMesh::Threads::spin_mutex::scoped_lock lock(_elem_workspace_mutex);
+    
+    MAST::ElemWorkspace*&
+    ws = _elem_workspaces[std::this_thread::get_id()];
+    
+    if (!ws)
+        ws = new MAST::ElemWorkspace;
+    
+    return *ws;
+}
+
+
+
+void
+MAST::AssemblyBase::clear_elem_workspaces() {
+    
+    libMesh::Threads::spin_mutex::scoped_lock lock(_elem_workspace_mutex);
+    
+    std::map<std::thread::id, MAST::ElemWorkspace*>::iterator
+    it  = _elem_workspaces.begin(),
+    end = _elem_workspaces.end();
+    
+    for ( ; it != end; it++)
+        delete it->second;
+    
+    _elem_workspaces.clear();
+}
+
+
+
+unsigned long
+MAST::AssemblyBase::n_elem_workspace_allocations() const {
+    
+    libMesh::Threads::spin_mutex::scoped_lock lock(_elem_workspace_mutex);
+    
+    unsigned long n = 0;
+    
+    std::map<std::thread::id, MAST::ElemWorkspace*>::const_iterator
+    it  = _elem_workspaces.begin(),
+    end = _elem_workspaces.end();
+    
+    for ( ; it != end; it++)
+        n += it->second->n_allocations();
+    
+    return n;
+}
+
+
+
+bool
+MAST::AssemblyBase::
+sensitivity_assemble (const std::vector<const MAST::FunctionBase*>& f,
+                      std::vector<libMesh::NumericVector<Real>*>& sensitivity_rhs) {
+    
+    libmesh_assert_equal_to(f.size(), sensitivity_rhs.size());
+    
+    bool
+    rval = true;
+    
+    for (unsigned int i=0; i<f.size(); i++)
+        rval = this->sensitivity_assemble(*f[i], *sensitivity_rhs[i]) && rval;
+    
+    return rval;
+}
+
+
+
 std::unique_ptr<libMesh::NumericVector<Real> >
 MAST::AssemblyBase::
 build_localized_vector(const libMesh::System& sys,
@@ -254,6 +328,8 @@ void
 MAST::AssemblyBase::calculate_output(const libMesh::NumericVector<Real>& X,
                                      MAST::OutputAssemblyElemOperations& output) {
     
+    MAST_PERF_SCOPE("AssemblyBase::calculate_output");
+    
     libmesh_assert(_discipline);
     libmesh_assert(_system);
     
@@ -329,6 +405,8 @@ calculate_output_derivative(const libMesh::NumericVector<Real>& X,
                             MAST::OutputAssemblyElemOperations& output,
                             libMesh::NumericVector<Real>& dq_dX) {
     
+    MAST_PERF_SCOPE("AssemblyBase::calculate_output_derivative");
+    
     libmesh_assert(_discipline);
     libmesh_assert(_system);
 
@@ -413,6 +491,8 @@ calculate_output_direct_sensitivity(const libMesh::NumericVector<Real>& X,
                                     const libMesh::NumericVector<Real>* dXdp,
                                     const MAST::FunctionBase& p,
                                     MAST::OutputAssemblyElemOperations& output) {
+    
+    MAST_PERF_SCOPE("AssemblyBase::calculate_output_direct_sensitivity");
 
     libmesh_assert(_discipline);
     libmesh_assert(_system);
@@ -514,6 +594,8 @@ calculate_output_adjoint_sensitivity(const libMesh::NumericVector<Real>& X,
                                      MAST::AssemblyElemOperations&       elem_ops,
                                      MAST::OutputAssemblyElemOperations& output,
                                      const bool include_partial_sens) {
+    
+    MAST_PERF_SCOPE("AssemblyBase::calculate_output_adjoint_sensitivity");
 
     libmesh_assert(_discipline);
     libmesh_assert(_system);
@@ -542,3 +624,27 @@ calculate_output_adjoint_sensitivity(const libMesh::NumericVector<Real>& X,
     return dq_dp;
 }
 
+
+
+
+void
+MAST::AssemblyBase::
+calculate_output_adjoint_sensitivity(const libMesh::NumericVector<Real>& X,
+                                     const libMesh::NumericVector<Real>& dq_dX,
+                                     const std::vector<const MAST::FunctionBase*>& p,
+                                     MAST::AssemblyElemOperations&       elem_ops,
+                                     MAST::OutputAssemblyElemOperations& output,
+                                     std::vector<Real>&                  dq_dp,
+                                     const bool include_partial_sens) {
+    
+    dq_dp.resize(p.size());
+    
+    for (unsigned int i=0; i<p.size(); i++)
+        dq_dp[i] = this->calculate_output_adjoint_sensitivity(X,
+                                                              dq_dX,
+                                                              *p[i],
+                                                              elem_ops,
+                                                              output,
+                                                              include_partial_sens);
+}
+
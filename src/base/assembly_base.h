@@ -23,6 +23,8 @@
 // C++ includes
 #include <map>
 #include <memory>
+#include <thread>
+#include <vector>
 
 
 // MAST includes
@@ -33,6 +35,7 @@
 #include "libmesh/system.h"
 #include "libmesh/nonlinear_implicit_system.h"
 #include "libmesh/sparse_matrix.h"
+#include "libmesh/threads.h"
 
 
 namespace MAST {
@@ -47,6 +50,7 @@ namespace MAST {
     class AssemblyElemOperations;
     class OutputAssemblyElemOperations;
     class FunctionBase;
+    class ElemWorkspace;
     
     class AssemblyBase:
     public libMesh::NonlinearImplicitSystem::ComputeResidualandJacobian {
@@ -200,6 +204,27 @@ namespace MAST {
          */
         void clear_solver_monitor();
         
+        /*!
+         *   @returns the element scratch workspace for the calling thread.
+         *   The workspace is created on the first call from each thread and
+         *   is reused by all elements assembled on that thread.
+         */
+        MAST::ElemWorkspace& elem_workspace();
+        
+        /*!
+         *   deletes the element workspaces of all threads. This is called
+         *   when the system is cleared and must be called by the user if
+         *   the element property cards are modified or destroyed.
+         */
+        void clear_elem_workspaces();
+        
+        /*!
+         *   @returns the total number of allocations performed by the
+         *   element workspaces of all threads. This stays constant once
+         *   the assembly has reached a steady state.
+         */
+        unsigned long n_elem_workspace_allocations() const;
+        
         /*!
          *   tells the assembly object that this function is will
          *   need to be initialized before each residual evaluation
@@ -241,6 +266,18 @@ namespace MAST {
             libmesh_assert(false); // implemented in the derived class
         }
 
+        
+        /*!
+         *   assembles the sensitivity right-hand side for each parameter in
+         *   \p f into the corresponding vector in \p sensitivity_rhs. The
+         *   default implementation calls \p sensitivity_assemble once per
+         *   parameter. Derived classes may override this to compute all
+         *   parameters in a single sweep over the elements.
+         */
+        virtual bool
+        sensitivity_assemble (const std::vector<const MAST::FunctionBase*>& f,
+                              std::vector<libMesh::NumericVector<Real>*>& sensitivity_rhs);
+
         /*!
          *   calculates the value of quantity \f$ q(X,p) \f$.
          */
@@ -288,6 +325,23 @@ namespace MAST {
                                              const bool include_partial_sens = true);
 
         
+        /*!
+         *   Evaluates the total sensitivity of \p output wrt each parameter
+         *   in \p p using the adjoint solution provided in \p dq_dX for a
+         *   linearization about solution \p X. The sensitivities are
+         *   returned in \p dq_dp. The default implementation calls the single
+         *   parameter version for each parameter.
+         */
+        virtual void
+        calculate_output_adjoint_sensitivity(const libMesh::NumericVector<Real>& X,
+                                             const libMesh::NumericVector<Real>& dq_dX,
+                                             const std::vector<const MAST::FunctionBase*>& p,
+                                             MAST::AssemblyElemOperations&       elem_ops,
+                                             MAST::OutputAssemblyElemOperations& output,
+                                             std::vector<Real>&                  dq_dp,
+                                             const bool include_partial_sens = true);
+
+        
         /*!
          *   localizes the parallel vector so that the local copy
          *   stores all values necessary for calculation of the
@@ -334,6 +388,17 @@ namespace MAST {
          *   an element. This can be used to enhance computational efficiency.
          */
         MAST::AssemblyBase::ElemParameterDependence *_param_dependence;
+        
+        /*!
+         *   element scratch workspaces for each thread that has called
+         *   \p elem_workspace()
+         */
+        std::map<std::thread::id, MAST::ElemWorkspace*> _elem_workspaces;
+        
+        /*!
+         *   mutex for access to \p _elem_workspaces
+         */
+        mutable libMesh::Threads::spin_mutex _elem_workspace_mutex;
     };
         
 }
@@ -78,3 +78,25 @@ MAST::ConstantFieldFunction::derivative (        const MAST::FunctionBase& f,
     v = _p.depends_on(f)?1:0;
 }
 
+
+
+
+void
+MAST::ConstantFieldFunction::evaluate (const std::vector<libMesh::Point>& p,
+                                       const Real t,
+                                       std::vector<Real>& v) const {
+    
+    v.assign(p.size(), _p());
+}
+
+
+
+
+void
+MAST::ConstantFieldFunction::evaluate_derivative (const MAST::FunctionBase& f,
+                                                  const std::vector<libMesh::Point>& p,
+                                                  const Real t,
+                                                  std::vector<Real>& v) const {
+    
+    v.assign(p.size(), _p.depends_on(f)?1.:0.);
+}
@@ -76,6 +76,25 @@ namespace MAST {
                                  Real& v) const;
 
         
+        /*!
+         *    the value is independent of the point, so it is computed once
+         *    and copied to all entries of \p v.
+         */
+        virtual void evaluate (const std::vector<libMesh::Point>& p,
+                               const Real t,
+                               std::vector<Real>& v) const;
+        
+        
+        /*!
+         *    the derivative is independent of the point, so it is computed
+         *    once and copied to all entries of \p v.
+         */
+        virtual void evaluate_derivative (const MAST::FunctionBase& f,
+                                          const std::vector<libMesh::Point>& p,
+                                          const Real t,
+                                          std::vector<Real>& v) const;
+
+        
         
     protected:
 
@@ -21,7 +21,9 @@
 #include "base/elem_base.h"
 #include "base/system_initialization.h"
 #include "base/nonlinear_system.h"
+#include "base/assembly_base.h"
 #include "mesh/fe_base.h"
+#include "mesh/geom_elem.h"
 
 
 MAST::ElementBase::ElementBase(MAST::SystemInitialization& sys,
@@ -29,6 +31,7 @@ MAST::ElementBase::ElementBase(MAST::SystemInitialization& sys,
                                const MAST::GeomElem& elem):
 _system                 (sys),
 _assembly               (assembly),
+_workspace              (assembly.elem_workspace()),
 _elem                   (elem),
 _active_sol_function    (nullptr),
 _time                   (_system.system().time) {
@@ -161,4 +164,19 @@ MAST::ElementBase::detach_active_solution_function() {
 }
 
 
-
+void
+MAST::ElementBase::boundary_velocity(const MAST::FieldFunction<RealVectorX>& vel_f,
+                                     const MAST::FEBase& fe,
+                                     const unsigned int qp,
+                                     RealVectorX& vel) const {
+    
+    const libMesh::Point&
+    p = fe.get_xyz()[qp];
+    
+    // the points of a locally defined element are not in the coordinate
+    // system of the reference element, which cannot be used as a hint
+    if (!_elem.use_local_elem())
+        vel_f(p, _elem.get_reference_elem(), _time, vel);
+    else
+        vel_f(p, _time, vel);
+}
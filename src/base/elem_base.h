@@ -42,6 +42,8 @@ namespace MAST {
     class NonlinearSystem;
     class FEBase;
     class AssemblyBase;
+    class ElemWorkspace;
+    template <typename ValType> class FieldFunction;
     
     /*!
      *    This is the base class for elements that implement calculation of
@@ -105,6 +107,15 @@ namespace MAST {
         }
 
         
+        /*!
+         *   @returns a reference to the scratch workspace used by this
+         *   element. This is the workspace of the thread that created the
+         *   element.
+         */
+        MAST::ElemWorkspace& workspace() {
+            return _workspace;
+        }
+        
         /*!
          *   @returns a reference to the libMesh::System object
          */
@@ -198,6 +209,20 @@ namespace MAST {
          */
         void detach_active_solution_function();
         
+        
+        /*!
+         *   computes the boundary velocity \p vel_f at quadrature point
+         *   \p qp of \p fe, which has been initialized on this element.
+         *   The reference element is passed to \p vel_f as a hint, so that
+         *   functions such as MAST::LevelSetBoundaryVelocity do not have
+         *   to search for the element containing the point. Locally defined
+         *   elements are evaluated at the location of the point only.
+         */
+        void boundary_velocity(const MAST::FieldFunction<RealVectorX>& vel_f,
+                               const MAST::FEBase& fe,
+                               const unsigned int qp,
+                               RealVectorX& vel) const;
+        
     
     protected:
         
@@ -212,6 +237,12 @@ namespace MAST {
          */
         MAST::AssemblyBase&        _assembly;
         
+        /*!
+         *   scratch workspace for element calculations, obtained from
+         *   \p _assembly for the thread that creates this element
+         */
+        MAST::ElemWorkspace&       _workspace;
+        
         /*!
          *   geometric element for which the computations are performed
          */
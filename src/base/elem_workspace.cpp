@@ -0,0 +1,344 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <utility>
+
+// MAST includes
+#include "base/elem_workspace.h"
+#include "base/field_function_base.h"
+#include "numerics/fem_operator_matrix.h"
+#include "mesh/fe_base.h"
+#include "property_cards/element_property_card_base.h"
+
+
+MAST::ElemWorkspace::ElemWorkspace():
+_n_vectors_in_use     (0),
+_n_matrices_in_use    (0),
+_n_matrix_arrays_in_use (0),
+_n_operators_in_use   (0),
+_n_fes_in_use         (0),
+_n_allocations        (0) {
+    
+}
+
+
+MAST::ElemWorkspace::~ElemWorkspace() {
+    
+    this->clear();
+}
+
+
+
+const MAST::FieldFunction<RealMatrixX>&
+MAST::ElemWorkspace::property_matrix(const MAST::ElementPropertyCardBase& p,
+                                     MAST::ElemPropertyMatrixType t,
+                                     const MAST::ElementBase& e) {
+    
+    std::pair<const MAST::ElementPropertyCardBase*, MAST::ElemPropertyMatrixType>
+    key(&p, t);
+    
+    std::map<std::pair<const MAST::ElementPropertyCardBase*, MAST::ElemPropertyMatrixType>,
+    MAST::FieldFunction<RealMatrixX>*>::const_iterator
+    it = _property_matrices.find(key);
+    
+    if (it != _property_matrices.end())
+        return *it->second;
+    
+    std::unique_ptr<MAST::FieldFunction<RealMatrixX> > f;
+    
+    switch (t) {
+            
+        case MAST::STIFFNESS_A_MATRIX:
+            f = p.stiffness_A_matrix(e);
+            break;
+            
+        case MAST::STIFFNESS_B_MATRIX:
+            f = p.stiffness_B_matrix(e);
+            break;
+            
+        case MAST::STIFFNESS_D_MATRIX:
+            f = p.stiffness_D_matrix(e);
+            break;
+            
+        case MAST::DAMPING_MATRIX:
+            f = p.damping_matrix(e);
+            break;
+            
+        case MAST::INERTIA_MATRIX:
+            f = p.inertia_matrix(e);
+            break;
+            
+        case MAST::THERMAL_EXPANSION_A_MATRIX:
+            f = p.thermal_expansion_A_matrix(e);
+            break;
+            
+        case MAST::THERMAL_EXPANSION_B_MATRIX:
+            f = p.thermal_expansion_B_matrix(e);
+            break;
+            
+        case MAST::TRANSVERSE_SHEAR_STIFFNESS_MATRIX:
+            f = p.transverse_shear_stiffness_matrix(e);
+            break;
+            
+        default:
+            libmesh_error(); // should not get here
+    }
+    
+    _n_allocations++;
+    MAST::FieldFunction<RealMatrixX>* rval = f.release();
+    _property_matrices[key] = rval;
+    
+    return *rval;
+}
+
+
+
+void
+MAST::ElemWorkspace::clear() {
+    
+    // the buffers should not be cleared while they are in use
+    libmesh_assert_equal_to(_n_vectors_in_use,   0);
+    libmesh_assert_equal_to(_n_matrices_in_use,  0);
+    libmesh_assert_equal_to(_n_matrix_arrays_in_use, 0);
+    libmesh_assert_equal_to(_n_operators_in_use, 0);
+    libmesh_assert_equal_to(_n_fes_in_use,       0);
+    libmesh_assert(_adopted_fes.empty());
+    
+    for (unsigned int i=0; i<_vectors.size(); i++)
+        delete _vectors[i];
+    
+    for (unsigned int i=0; i<_matrices.size(); i++)
+        delete _matrices[i];
+    
+    for (unsigned int i=0; i<_matrix_arrays.size(); i++)
+        delete _matrix_arrays[i];
+    
+    for (unsigned int i=0; i<_operators.size(); i++)
+        delete _operators[i];
+    
+    for (unsigned int i=0; i<_fes.size(); i++)
+        delete _fes[i];
+    
+    std::map<std::pair<const MAST::ElementPropertyCardBase*, MAST::ElemPropertyMatrixType>,
+    MAST::FieldFunction<RealMatrixX>*>::iterator
+    it  = _property_matrices.begin(),
+    end = _property_matrices.end();
+    
+    for ( ; it != end; it++)
+        delete it->second;
+    
+    _vectors.clear();
+    _matrices.clear();
+    _matrix_arrays.clear();
+    _operators.clear();
+    _fes.clear();
+    _property_matrices.clear();
+}
+
+
+
+MAST::ElemWorkspace::Frame::Frame(MAST::ElemWorkspace& ws):
+_ws          (ws),
+_vec_begin   (ws._n_vectors_in_use),
+_mat_begin   (ws._n_matrices_in_use),
+_mat_array_begin (ws._n_matrix_arrays_in_use),
+_op_begin    (ws._n_operators_in_use),
+_fe_begin    (ws._n_fes_in_use),
+_adopted_fe_begin ((unsigned int)ws._adopted_fes.size()) {
+    
+}
+
+
+
+MAST::ElemWorkspace::Frame::~Frame() {
+    
+    // frames are expected to be released in the reverse order of creation
+    libmesh_assert_greater_equal(_ws._n_vectors_in_use,   _vec_begin);
+    libmesh_assert_greater_equal(_ws._n_matrices_in_use,  _mat_begin);
+    libmesh_assert_greater_equal(_ws._n_matrix_arrays_in_use, _mat_array_begin);
+    libmesh_assert_greater_equal(_ws._n_operators_in_use, _op_begin);
+    libmesh_assert_greater_equal(_ws._n_fes_in_use,       _fe_begin);
+    libmesh_assert_greater_equal(_ws._adopted_fes.size(), _adopted_fe_begin);
+    
+    _ws._n_vectors_in_use   = _vec_begin;
+    _ws._n_matrices_in_use  = _mat_begin;
+    _ws._n_matrix_arrays_in_use = _mat_array_begin;
+    _ws._n_operators_in_use = _op_begin;
+    _ws._n_fes_in_use       = _fe_begin;
+    
+    for (unsigned int i=_adopted_fe_begin; i<_ws._adopted_fes.size(); i++)
+        delete _ws._adopted_fes[i];
+    
+    _ws._adopted_fes.resize(_adopted_fe_begin);
+}
+
+
+
+RealVectorX&
+MAST::ElemWorkspace::Frame::vector(unsigned int n) {
+    
+    if (_ws._n_vectors_in_use == _ws._vectors.size()) {
+        
+        _ws._vectors.push_back(new RealVectorX);
+        _ws._n_allocations++;
+    }
+    
+    RealVectorX& v = *_ws._vectors[_ws._n_vectors_in_use++];
+    
+    if (v.size() != n) {
+        
+        v.resize(n);
+        _ws._n_allocations++;
+    }
+    
+    v.setZero();
+    
+    return v;
+}
+
+
+
+RealMatrixX&
+MAST::ElemWorkspace::Frame::matrix(unsigned int m, unsigned int n) {
+    
+    if (_ws._n_matrices_in_use == _ws._matrices.size()) {
+        
+        _ws._matrices.push_back(new RealMatrixX);
+        _ws._n_allocations++;
+    }
+    
+    RealMatrixX& mat = *_ws._matrices[_ws._n_matrices_in_use++];
+    
+    // Eigen reallocates only if the total size changes
+    if (mat.size() != m*n)
+        _ws._n_allocations++;
+    
+    mat.resize(m, n);
+    mat.setZero();
+    
+    return mat;
+}
+
+
+
+std::vector<RealMatrixX>&
+MAST::ElemWorkspace::Frame::matrix_array(unsigned int n) {
+    
+    if (_ws._n_matrix_arrays_in_use == _ws._matrix_arrays.size()) {
+        
+        _ws._matrix_arrays.push_back(new std::vector<RealMatrixX>);
+        _ws._n_allocations++;
+    }
+    
+    std::vector<RealMatrixX>& v = *_ws._matrix_arrays[_ws._n_matrix_arrays_in_use++];
+    
+    if (v.capacity() < n)
+        _ws._n_allocations++;
+    
+    v.resize(n);
+    
+    return v;
+}
+
+
+
+MAST::FEMOperatorMatrix&
+MAST::ElemWorkspace::Frame::operator_matrix(unsigned int n_interpolated_vars,
+                                            unsigned int n_discrete_vars,
+                                            unsigned int n_discrete_dofs_per_var) {
+    
+    if (_ws._n_operators_in_use == _ws._operators.size()) {
+        
+        _ws._operators.push_back(new MAST::FEMOperatorMatrix);
+        _ws._n_allocations++;
+    }
+    
+    MAST::FEMOperatorMatrix& op = *_ws._operators[_ws._n_operators_in_use++];
+    
+    // the operator keeps its storage if the dimensions are unchanged
+    if (op.m() != n_interpolated_vars ||
+        op.n() != n_discrete_vars*n_discrete_dofs_per_var)
+        _ws._n_allocations++;
+    
+    op.reinit(n_interpolated_vars, n_discrete_vars, n_discrete_dofs_per_var);
+    
+    return op;
+}
+
+
+
+const MAST::FEBase&
+MAST::ElemWorkspace::Frame::fe(const MAST::SystemInitialization& sys,
+                               const MAST::GeomElem& elem,
+                               bool init_grads,
+                               bool init_second_order_derivative,
+                               int extra_quadrature_order) {
+    
+    // a free finite element created for the same system and options is
+    // preferred, so that routines integrating with different quadrature
+    // orders do not recreate each other's objects. Otherwise, a new one
+    // is added to the pool.
+    unsigned int
+    i = _ws._n_fes_in_use,
+    j = i;
+    
+    for ( ; j<_ws._fes.size(); j++)
+        if (&_ws._fes[j]->system_initialization() == &sys &&
+            _ws._fes[j]->can_reinit(elem,
+                                    init_grads,
+                                    init_second_order_derivative,
+                                    extra_quadrature_order))
+            break;
+    
+    if (j == _ws._fes.size()) {
+        
+        _ws._fes.push_back(new MAST::FEBase(sys));
+        _ws._n_allocations++;
+    }
+    
+    std::swap(_ws._fes[i], _ws._fes[j]);
+    _ws._n_fes_in_use++;
+    
+    MAST::FEBase* fe = _ws._fes[i];
+    
+    fe->set_extra_quadrature_order(extra_quadrature_order);
+    fe->set_evaluate_second_order_derivatives(init_second_order_derivative);
+    
+    if (fe->reinit(elem, init_grads))
+        _ws._n_allocations++;
+    
+    return *fe;
+}
+
+
+
+const MAST::FEBase&
+MAST::ElemWorkspace::Frame::adopt_fe(std::unique_ptr<MAST::FEBase> fe) {
+    
+    libmesh_assert(fe.get());
+    
+    if (_ws._adopted_fes.size() == _ws._adopted_fes.capacity())
+        _ws._n_allocations++;
+    
+    _ws._adopted_fes.push_back(fe.release());
+    
+    return *_ws._adopted_fes.back();
+}
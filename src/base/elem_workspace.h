@@ -0,0 +1,233 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__elem_workspace_h__
+#define __mast__elem_workspace_h__
+
+// C++ includes
+#include <map>
+#include <memory>
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class ElementBase;
+    class ElementPropertyCardBase;
+    class FEBase;
+    class FEMOperatorMatrix;
+    class GeomElem;
+    class SystemInitialization;
+    template <typename ValType> class FieldFunction;
+    
+    
+    /*!
+     *   property matrices of an element property card that do not depend
+     *   on the element and can therefore be shared between elements
+     *   through the \p ElemWorkspace.
+     */
+    enum ElemPropertyMatrixType {
+        STIFFNESS_A_MATRIX,
+        STIFFNESS_B_MATRIX,
+        STIFFNESS_D_MATRIX,
+        DAMPING_MATRIX,
+        INERTIA_MATRIX,
+        THERMAL_EXPANSION_A_MATRIX,
+        THERMAL_EXPANSION_B_MATRIX,
+        TRANSVERSE_SHEAR_STIFFNESS_MATRIX
+    };
+    
+    
+    /*!
+     *   Scratch storage for element level calculations. Elements borrow
+     *   vectors, matrices, operator matrices and finite elements from the
+     *   workspace through a \p Frame, which returns them when it goes out of scope. The
+     *   buffers are kept for the next element, so once the workspace has
+     *   seen each element type and routine the assembly does not allocate
+     *   any more element scratch storage. The workspace also stores the
+     *   property matrix functions built by the property cards, which are
+     *   otherwise created and destroyed for each element.
+     *
+     *   A workspace must only be used by one thread at a time.
+     *   \p MAST::AssemblyBase::elem_workspace() provides one per thread.
+     */
+    class ElemWorkspace {
+        
+    public:
+        
+        ElemWorkspace();
+        
+        virtual ~ElemWorkspace();
+        
+        
+        /*!
+         *   Scope over which buffers are borrowed from the workspace. Frames
+         *   must be destroyed in the reverse order of their creation, which
+         *   is naturally satisfied when they are created on the stack.
+         *   References returned by a frame are valid until the frame is
+         *   destroyed.
+         */
+        class Frame {
+            
+        public:
+            
+            Frame(MAST::ElemWorkspace& ws);
+            
+            ~Frame();
+            
+            /*!
+             *   @returns a zero vector of size \p n
+             */
+            RealVectorX& vector(unsigned int n);
+            
+            /*!
+             *   @returns a zero matrix of size \p m x \p n
+             */
+            RealMatrixX& matrix(unsigned int m, unsigned int n);
+            
+            /*!
+             *   @returns a vector of \p n matrices, for example to store a
+             *   property matrix at all quadrature points of an element. The
+             *   matrices retain their previous values and sizes.
+             */
+            std::vector<RealMatrixX>& matrix_array(unsigned int n);
+            
+            /*!
+             *   @returns an operator matrix initialized with the specified
+             *   dimensions. The shape functions must be set by the caller.
+             */
+            MAST::FEMOperatorMatrix&
+            operator_matrix(unsigned int n_interpolated_vars,
+                            unsigned int n_discrete_vars,
+                            unsigned int n_discrete_dofs_per_var);
+            
+            /*!
+             *   @returns a finite element of system \p sys initialized for
+             *   volume integration over \p elem. A free finite element of
+             *   the workspace created for the same system, element
+             *   dimension, quadrature order and derivatives is reinitialized
+             *   without heap allocation. A new one is created only if no
+             *   such finite element is available.
+             */
+            const MAST::FEBase&
+            fe(const MAST::SystemInitialization& sys,
+               const MAST::GeomElem& elem,
+               bool init_grads,
+               bool init_second_order_derivative,
+               int extra_quadrature_order);
+            
+            /*!
+             *   takes ownership of \p fe, which is deleted when the frame is
+             *   destroyed. This is used for finite elements that are
+             *   specific to an element and cannot be reused.
+             */
+            const MAST::FEBase&
+            adopt_fe(std::unique_ptr<MAST::FEBase> fe);
+            
+        protected:
+            
+            MAST::ElemWorkspace&  _ws;
+            
+            /*!
+             *   number of buffers in use by enclosing frames when this
+             *   frame was created
+             */
+            unsigned int          _vec_begin;
+            unsigned int          _mat_begin;
+            unsigned int          _mat_array_begin;
+            unsigned int          _op_begin;
+            unsigned int          _fe_begin;
+            unsigned int          _adopted_fe_begin;
+        };
+        
+        
+        /*!
+         *   @returns the property matrix function of type \p t from the
+         *   property card \p p. The function is built using element \p e
+         *   the first time it is requested and reused for all subsequent
+         *   elements with the same property card.
+         */
+        const MAST::FieldFunction<RealMatrixX>&
+        property_matrix(const MAST::ElementPropertyCardBase& p,
+                        MAST::ElemPropertyMatrixType t,
+                        const MAST::ElementBase& e);
+        
+        
+        /*!
+         *   @returns the number of heap allocations performed by the
+         *   workspace since construction or the last call to
+         *   \p reset_allocation_count(). This remains unchanged in steady
+         *   state assembly and can be used to verify that the element
+         *   routines do not need new storage.
+         */
+        unsigned long n_allocations() const {
+            return _n_allocations;
+        }
+        
+        /*!
+         *   resets the allocation counter to zero
+         */
+        void reset_allocation_count() {
+            _n_allocations = 0;
+        }
+        
+        /*!
+         *   deletes all buffers and property functions. This must be
+         *   called if the property cards are modified or destroyed.
+         */
+        void clear();
+        
+    protected:
+        
+        friend class MAST::ElemWorkspace::Frame;
+        
+        std::vector<RealVectorX*>               _vectors;
+        std::vector<RealMatrixX*>               _matrices;
+        std::vector<std::vector<RealMatrixX>*>  _matrix_arrays;
+        std::vector<MAST::FEMOperatorMatrix*>   _operators;
+        std::vector<MAST::FEBase*>              _fes;
+        
+        /*!
+         *   finite elements owned by the frames that are currently in scope
+         */
+        std::vector<MAST::FEBase*>              _adopted_fes;
+        
+        /*!
+         *   number of buffers of each kind currently borrowed by frames
+         */
+        unsigned int _n_vectors_in_use;
+        unsigned int _n_matrices_in_use;
+        unsigned int _n_matrix_arrays_in_use;
+        unsigned int _n_operators_in_use;
+        unsigned int _n_fes_in_use;
+        
+        std::map<std::pair<const MAST::ElementPropertyCardBase*, MAST::ElemPropertyMatrixType>,
+        MAST::FieldFunction<RealMatrixX>*>       _property_matrices;
+        
+        unsigned long _n_allocations;
+    };
+}
+
+
+#endif // __mast__elem_workspace_h__
@@ -23,6 +23,7 @@
 
 // C++ includes
 #include <memory>
+#include <vector>
 
 // MAST includes
 #include "base/function_base.h"
@@ -32,6 +33,11 @@
 #include "libmesh/function_base.h"
 
 
+namespace libMesh {
+    class Elem;
+}
+
+
 namespace MAST {
     
     /*!
@@ -94,6 +100,22 @@ namespace MAST {
         }
         
         
+        /*!
+         *    calculates the value of the function at the point, \p p, and
+         *    time, \p t, and returns it in \p v. \p e is an element that
+         *    contains \p p, which derived classes can use to avoid
+         *    searching for the point. The default implementation ignores
+         *    \p e and calls the point-only operator.
+         */
+        virtual void operator() (const libMesh::Point& p,
+                                 const libMesh::Elem& e,
+                                 const Real t,
+                                 ValType& v) const {
+            
+            (*this)(p, t, v);
+        }
+        
+        
         /*!
          *    calculates the value of a perturbation in function at the 
          *    specified point, \p p, and time, \p t, and returns it
@@ -120,6 +142,52 @@ namespace MAST {
             libmesh_error(); // must be implemented in derived class
         }
         
+        
+        /*!
+         *    calculates the value of the function at each point in \p p
+         *    at time \p t, and returns them in \p v. The default
+         *    implementation calls the single-point operator for each point.
+         *    Derived classes can override this to share work between points.
+         */
+        virtual void evaluate (const std::vector<libMesh::Point>& p,
+                               const Real t,
+                               std::vector<ValType>& v) const {
+            
+            v.resize(p.size());
+            for (unsigned int i=0; i<p.size(); i++)
+                (*this)(p[i], t, v[i]);
+        }
+        
+        
+        /*!
+         *    calculates the perturbation of the function at each point in
+         *    \p p at time \p t, and returns them in \p v.
+         */
+        virtual void evaluate_perturbation (const std::vector<libMesh::Point>& p,
+                                            const Real t,
+                                            std::vector<ValType>& v) const {
+            
+            v.resize(p.size());
+            for (unsigned int i=0; i<p.size(); i++)
+                this->perturbation(p[i], t, v[i]);
+        }
+        
+        
+        /*!
+         *    calculates the derivative of the function with respect to
+         *    \p f at each point in \p p at time \p t, and returns them
+         *    in \p v.
+         */
+        virtual void evaluate_derivative (const MAST::FunctionBase& f,
+                                          const std::vector<libMesh::Point>& p,
+                                          const Real t,
+                                          std::vector<ValType>& v) const {
+            
+            v.resize(p.size());
+            for (unsigned int i=0; i<p.size(); i++)
+                this->derivative(f, p[i], t, v[i]);
+        }
+        
     protected:
     
     };
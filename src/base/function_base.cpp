@@ -42,5 +42,12 @@ _is_topology_parameter     (f._is_topology_parameter) {
 
 
 
-
+void
+MAST::FunctionBase::get_parameters(std::set<const MAST::Parameter*>& p) const {
+    
+    std::set<const MAST::FunctionBase*>::const_iterator
+    it = _functions.begin(), end = _functions.end();
+    for ( ; it != end; it++)
+        (*it)->get_parameters(p);
+}
 
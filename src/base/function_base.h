@@ -30,6 +30,9 @@
 
 namespace MAST
 {
+    // Forward declerations
+    class Parameter;
+    
     
     
     class FunctionBase {
@@ -82,6 +85,12 @@ namespace MAST
         }
         
         
+        /*!
+         *  adds to \p p the parameters that this function depends on
+         */
+        virtual void get_parameters(std::set<const MAST::Parameter*>& p) const;
+        
+        
         /*!
          *  @returns true if the function is a shape parameter. False by
          *  default.
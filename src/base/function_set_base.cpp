@@ -72,3 +72,15 @@ MAST::FunctionSetBase::depends_on(const MAST::FunctionBase& f) const {
     // if it gets here, then there is no dependency
     return false;
 }
+
+
+
+void
+MAST::FunctionSetBase::get_parameters(std::set<const MAST::Parameter*>& p) const {
+    
+    std::map<std::string, MAST::FunctionBase*>::const_iterator
+    it = _properties.begin(), end = _properties.end();
+    for ( ; it!=end; it++)
+        it->second->get_parameters(p);
+}
+
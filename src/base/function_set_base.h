@@ -96,6 +96,12 @@ namespace MAST {
          *  returns true if the property card depends on the function \p f
          */
         virtual bool depends_on(const MAST::FunctionBase& f) const;
+        
+        /*!
+         *  adds to \p p the parameters that the functions in this card
+         *  depend on
+         */
+        virtual void get_parameters(std::set<const MAST::Parameter*>& p) const;
 
         
     protected:
@@ -24,6 +24,9 @@
 
 // libMesh includes
 #include "libmesh/dof_map.h"
+#include "libmesh/elem.h"
+#include "libmesh/fe_interface.h"
+#include "libmesh/fe_map.h"
 
 
 MAST::MeshFieldFunction::
@@ -31,6 +34,7 @@ MeshFieldFunction(MAST::SystemInitialization& sys,
                   const std::string& nm):
 MAST::FieldFunction<RealVectorX>(nm),
 _use_qp_sol(false),
+_ghosted(false),
 _qp_sol(),
 _sys(&sys.system()),
 _sol(nullptr),
@@ -46,6 +50,7 @@ MeshFieldFunction(libMesh::System& sys,
                   const std::string& nm):
 MAST::FieldFunction<RealVectorX>(nm),
 _use_qp_sol(false),
+_ghosted(false),
 _qp_sol(),
 _sys(&sys),
 _sol(nullptr),
@@ -169,6 +174,143 @@ MAST::MeshFieldFunction::perturbation(const libMesh::Point& p,
 
 
 
+void
+MAST::MeshFieldFunction::operator() (const libMesh::Elem& e,
+                                     const libMesh::Point& xi,
+                                     const Real t,
+                                     RealVectorX& v) const {
+    
+    // if the element has provided a quadrature point solution,
+    // then use it
+    if (_use_qp_sol) {
+        v = _qp_sol;
+        return;
+    }
+    
+    // make sure that the object was initialized
+    libmesh_assert(_sol);
+    
+    MAST::MeshFieldFunction::interpolate(*_sys, *_sol, e, xi, v, nullptr);
+}
+
+
+
+void
+MAST::MeshFieldFunction::gradient (const libMesh::Elem& e,
+                                   const libMesh::Point& xi,
+                                   const Real t,
+                                   RealMatrixX& g) const {
+    
+    // if the element has provided a quadrature point solution,
+    // then use it
+    if (_use_qp_sol) {
+        g = _qp_sol;
+        return;
+    }
+    
+    // make sure that the object was initialized
+    libmesh_assert(_sol);
+    
+    RealVectorX v;
+    MAST::MeshFieldFunction::interpolate(*_sys, *_sol, e, xi, v, &g);
+}
+
+
+
+void
+MAST::MeshFieldFunction::perturbation(const libMesh::Elem& e,
+                                      const libMesh::Point& xi,
+                                      const Real t,
+                                      RealVectorX& v) const {
+    
+    // if the element has provided a quadrature point solution,
+    // then use it
+    if (_use_qp_sol) {
+        v = _qp_sol;
+        return;
+    }
+    
+    // make sure that the object was initialized
+    libmesh_assert(_dsol);
+    
+    MAST::MeshFieldFunction::interpolate(*_sys, *_dsol, e, xi, v, nullptr);
+}
+
+
+
+void
+MAST::MeshFieldFunction::interpolate(const libMesh::System& sys,
+                                     const libMesh::NumericVector<Real>& vec,
+                                     const libMesh::Elem& e,
+                                     const libMesh::Point& xi,
+                                     RealVectorX& v,
+                                     RealMatrixX* g) {
+    
+    const libMesh::DofMap&
+    dof_map = sys.get_dof_map();
+    
+    const unsigned int
+    n_vars  = sys.n_vars(),
+    dim     = e.dim();
+    
+    v = RealVectorX::Zero(n_vars);
+    
+    // the gradient of the shape functions is obtained from the derivatives
+    // in the reference coordinates using the Jacobian of the element map,
+    // J = dx/dxi. For an element in a higher dimensional space,
+    // dN/dx = J (J^T J)^{-1} dN/dxi gives the gradient in the tangent space.
+    RealMatrixX
+    jac      = RealMatrixX::Zero(3, dim),
+    map;
+    
+    RealVectorX
+    dN_dxi   = RealVectorX::Zero(dim);
+    
+    if (g) {
+        
+        *g = RealMatrixX::Zero(n_vars, 3); // assume 3-dimensional by default
+        
+        for (unsigned int j=0; j<dim; j++) {
+            
+            const libMesh::Point
+            dx = libMesh::FEMap::map_deriv(dim, &e, j, xi);
+            
+            for (unsigned int i=0; i<3; i++)
+                jac(i, j) = dx(i);
+        }
+        
+        map = jac * (jac.transpose() * jac).inverse();
+    }
+    
+    std::vector<libMesh::dof_id_type> dof_indices;
+    
+    for (unsigned int i=0; i<n_vars; i++) {
+        
+        const libMesh::FEType
+        fe_type = dof_map.variable_type(i);
+        
+        dof_map.dof_indices(&e, dof_indices, i);
+        
+        for (unsigned int j=0; j<dof_indices.size(); j++) {
+            
+            const Real
+            val = vec(dof_indices[j]);
+            
+            v(i) += val * libMesh::FEInterface::shape(dim, fe_type, &e, j, xi);
+            
+            if (g) {
+                
+                for (unsigned int k=0; k<dim; k++)
+                    dN_dxi(k) = libMesh::FEInterface::shape_deriv(dim, fe_type, &e, j, k, xi);
+                
+                g->row(i) += val * (map * dN_dxi).transpose();
+            }
+        }
+    }
+}
+
+
+
 void
 MAST::MeshFieldFunction::derivative (const MAST::FunctionBase& f,
                                      const libMesh::Point& p,
@@ -192,18 +334,27 @@ init(const libMesh::NumericVector<Real>& sol,
     // first make sure that the object is not already initialized
     libmesh_assert(!_function);
     
+    const std::vector<libMesh::dof_id_type>&
+    send_list = _sys->get_dof_map().get_send_list();
+    
     // next, clone this solution and localize to the sendlist
     _sol = libMesh::NumericVector<Real>::build(_sys->comm()).release();
 
     // initialize and then localize the vector with the provided solution
-    /*_sol->init(system.n_dofs(),
-                       system.n_local_dofs(),
-                       send_list,
-                       false,
-                       libMesh::GHOSTED);
-    sol.localize(*_sol, send_list);*/
-    _sol->init(sol.size(), true, libMesh::SERIAL);
-    sol.localize(*_sol);
+    if (_ghosted) {
+        
+        _sol->init(_sys->n_dofs(),
+                   _sys->n_local_dofs(),
+                   send_list,
+                   false,
+                   libMesh::GHOSTED);
+        sol.localize(*_sol, send_list);
+    }
+    else {
+        
+        _sol->init(sol.size(), true, libMesh::SERIAL);
+        sol.localize(*_sol);
+    }
 
     // finally, create the mesh interpolation function
     std::vector<unsigned int> vars;
@@ -219,14 +370,20 @@ init(const libMesh::NumericVector<Real>& sol,
 
         _dsol = libMesh::NumericVector<Real>::build(_sys->comm()).release();
 
-        /*_dsol->init(system.n_dofs(),
-                            system.n_local_dofs(),
-                            send_list,
-                            false,
-                            libMesh::GHOSTED);
-         dsol->localize(*_dsol, send_list);*/
-        _dsol->init(dsol->size(), true, libMesh::SERIAL);
-        dsol->localize(*_dsol);
+        if (_ghosted) {
+            
+            _dsol->init(_sys->n_dofs(),
+                        _sys->n_local_dofs(),
+                        send_list,
+                        false,
+                        libMesh::GHOSTED);
+            dsol->localize(*_dsol, send_list);
+        }
+        else {
+            
+            _dsol->init(dsol->size(), true, libMesh::SERIAL);
+            dsol->localize(*_dsol);
+        }
         
         
         // finally, create the mesh interpolation function
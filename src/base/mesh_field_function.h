@@ -91,6 +91,53 @@ namespace MAST {
                                    RealVectorX& v) const;
 
         
+        /*!
+         *    calculates the value of the function at the reference
+         *    coordinate \p xi of element \p e, and time, \p t, and returns
+         *    it in \p v. This does not search for the element, and should
+         *    be used when the element is known. \p e must be an element of
+         *    the mesh of the system that is local or ghosted on this
+         *    processor.
+         */
+        void operator() (const libMesh::Elem& e,
+                         const libMesh::Point& xi,
+                         const Real t,
+                         RealVectorX& v) const;
+        
+        /*!
+         *    calculates the gradient of the function at the reference
+         *    coordinate \p xi of element \p e, and time, \p t, and returns
+         *    it in \p g.
+         */
+        void gradient(const libMesh::Elem& e,
+                      const libMesh::Point& xi,
+                      const Real t,
+                      RealMatrixX& g) const;
+        
+        /*!
+         *    calculates the value of perturbation in the function at the
+         *    reference coordinate \p xi of element \p e, and time, \p t,
+         *    and returns it in \p v.
+         */
+        void perturbation(const libMesh::Elem& e,
+                          const libMesh::Point& xi,
+                          const Real t,
+                          RealVectorX& v) const;
+        
+        /*!
+         *    interpolates the variables of \p sys from \p vec at the
+         *    reference coordinate \p xi of element \p e, and returns
+         *    them in \p v. The gradient is returned in \p g if it is
+         *    provided, with g(i,j) = dv(i)/dx(j). \p vec must have the
+         *    values of all dofs of \p e.
+         */
+        static void interpolate(const libMesh::System& sys,
+                                const libMesh::NumericVector<Real>& vec,
+                                const libMesh::Elem& e,
+                                const libMesh::Point& xi,
+                                RealVectorX& v,
+                                RealMatrixX* g);
+        
         /*!
          *    calculates the value of the function at the specified point,
          *    \p p, and time, \p t, and returns it in \p v.
@@ -101,6 +148,20 @@ namespace MAST {
                                  RealVectorX& v) const;
         
         
+        /*!
+         *   if \p f is true, init() localizes the solution only to the
+         *   send-list of the system instead of a serial copy on each
+         *   processor. The function can then be evaluated only on elements
+         *   that are local or ghosted on this processor. This must be
+         *   called before init().
+         */
+        void set_ghosted_localization(bool f) {
+            
+            libmesh_assert(!_function);
+            _ghosted = f;
+        }
+        
+        
         /*!
          *   initializes the data structures to perform the interpolation 
          *   function of \p sol. If \p dsol is provided, then it is used
@@ -161,6 +222,13 @@ namespace MAST {
         bool _use_qp_sol;
         
         
+        /*!
+         *  flag is set to true if the solution is localized to the
+         *  send-list of the system, and not serialized.
+         */
+        bool _ghosted;
+        
+        
         /*!
          *   quadrature point solution of the element
          */
@@ -24,20 +24,164 @@
 #include "base/mesh_field_function.h"
 #include "base/nonlinear_system.h"
 #include "base/nonlinear_implicit_assembly_elem_operations.h"
+#include "base/output_assembly_elem_operations.h"
 #include "boundary_condition/point_load_condition.h"
 #include "numerics/utility.h"
 #include "mesh/geom_elem.h"
+#include "utility/perf_log.h"
 
 // libMesh includes
 #include "libmesh/nonlinear_solver.h"
 #include "libmesh/numeric_vector.h"
 #include "libmesh/sparse_matrix.h"
 #include "libmesh/dof_map.h"
+#include "libmesh/threads.h"
+#include "libmesh/libmesh.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   stores the constrained element quantities computed by a thread
+     *   until they are added to the global residual and Jacobian.
+     */
+    struct ThreadedElemQuantities {
+        std::vector<libMesh::dof_id_type> dof_indices;
+        DenseRealVector v;
+        DenseRealMatrix m;
+    };
+    
+    
+    /*!
+     *   body of the threaded element loop. Each invocation on a range of
+     *   elements borrows an element operation object from the pool, so
+     *   that no two threads use the same object simultaneously.
+     */
+    class NonlinearImplicitAssemblyThreadBody {
+    public:
+        NonlinearImplicitAssemblyThreadBody
+        (const std::vector<const libMesh::Elem*>&                      elems,
+         const libMesh::NumericVector<Real>&                           sol,
+         const libMesh::DofMap&                                        dof_map,
+         MAST::SystemInitialization&                                   sys,
+         std::vector<MAST::NonlinearImplicitAssemblyElemOperations*>&  pool,
+         libMesh::Threads::spin_mutex&                                 mutex,
+         std::vector<MAST::ThreadedElemQuantities>*                    storage,
+         libMesh::NumericVector<Real>*                                 R,
+         libMesh::SparseMatrix<Real>*                                  J):
+        _elems    (elems),
+        _sol      (sol),
+        _dof_map  (dof_map),
+        _sys      (sys),
+        _pool     (pool),
+        _mutex    (mutex),
+        _storage  (storage),
+        _R        (R),
+        _J        (J) { }
+        
+        
+        void operator() (const libMesh::Threads::BlockedRange<std::size_t>& range) const {
+            
+            // borrow an element operation object from the pool
+            MAST::NonlinearImplicitAssemblyElemOperations* ops = nullptr;
+            {
+                libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+                libmesh_assert(_pool.size());
+                ops = _pool.back();
+                _pool.pop_back();
+            }
+            
+            RealVectorX vec, sol;
+            RealMatrixX mat;
+            MAST::ThreadedElemQuantities q;
+            MAST_PERF_STOPWATCH(sw);
+            
+            for (std::size_t i=range.begin(); i<range.end(); i++) {
+                
+                const libMesh::Elem* elem = _elems[i];
+                
+                MAST_PERF_COUNT_ELEM("NonlinearImplicitAssembly::n_elems", elem->type(), 1);
+                
+                // write directly into the storage slot of this element if
+                // the reduction is to be deterministic
+                MAST::ThreadedElemQuantities& eq = _storage?(*_storage)[i]:q;
+                
+                MAST_PERF_PHASE(sw, "NonlinearImplicitAssembly::dof_indices");
+                _dof_map.dof_indices (elem, eq.dof_indices);
+                
+                MAST_PERF_PHASE(sw, "NonlinearImplicitAssembly::geom_elem_init");
+                MAST::GeomElem geom_elem;
+                ops->set_elem_data(elem->dim(), *elem, geom_elem);
+                geom_elem.init(*elem, _sys);
+                
+                MAST_PERF_PHASE_ELEM(sw, "NonlinearImplicitAssembly::elem_init", elem->type());
+                ops->init(geom_elem);
+                
+                // get the solution
+                unsigned int ndofs = (unsigned int)eq.dof_indices.size();
+                sol.setZero(ndofs);
+                vec.setZero(ndofs);
+                mat.setZero(ndofs, ndofs);
+                
+                for (unsigned int j=0; j<ndofs; j++)
+                    sol(j) = _sol(eq.dof_indices[j]);
+                
+                ops->set_elem_solution(sol);
+                MAST_PERF_PHASE_ELEM(sw, "NonlinearImplicitAssembly::elem_calculations", elem->type());
+                ops->elem_calculations(_J!=nullptr?true:false, vec, mat);
+                ops->clear_elem();
+                
+                MAST_PERF_PHASE(sw, "NonlinearImplicitAssembly::constrain_element");
+                
+                if (_R)
+                    MAST::copy(eq.v, vec);
+                if (_J)
+                    MAST::copy(eq.m, mat);
+                
+                // constrain the quantities to account for hanging dofs,
+                // Dirichlet constraints, etc.
+                if (_R && _J)
+                    _dof_map.constrain_element_matrix_and_vector(eq.m, eq.v, eq.dof_indices);
+                else if (_R)
+                    _dof_map.constrain_element_vector(eq.v, eq.dof_indices);
+                else
+                    _dof_map.constrain_element_matrix(eq.m, eq.dof_indices);
+                
+                if (!_storage) {
+                    
+                    // the global data-structures are not thread-safe
+                    MAST_PERF_PHASE(sw, "NonlinearImplicitAssembly::add_to_global");
+                    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+                    if (_R) _R->add_vector(eq.v, eq.dof_indices);
+                    if (_J) _J->add_matrix(eq.m, eq.dof_indices);
+                }
+                MAST_PERF_STOP(sw);
+            }
+            
+            // return the object to the pool
+            libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+            _pool.push_back(ops);
+        }
+        
+    protected:
+        
+        const std::vector<const libMesh::Elem*>&                      _elems;
+        const libMesh::NumericVector<Real>&                           _sol;
+        const libMesh::DofMap&                                        _dof_map;
+        MAST::SystemInitialization&                                   _sys;
+        std::vector<MAST::NonlinearImplicitAssemblyElemOperations*>&  _pool;
+        libMesh::Threads::spin_mutex&                                 _mutex;
+        std::vector<MAST::ThreadedElemQuantities>*                    _storage;
+        libMesh::NumericVector<Real>*                                 _R;
+        libMesh::SparseMatrix<Real>*                                  _J;
+    };
+}
 
 
 
 MAST::NonlinearImplicitAssembly::
 NonlinearImplicitAssembly():MAST::AssemblyBase(),
+deterministic_reduction  (true),
 _post_assembly           (nullptr),
 _res_l2_norm             (0.),
 _first_iter_res_l2_norm  (-1.) {
@@ -48,6 +192,7 @@ _first_iter_res_l2_norm  (-1.) {
 
 MAST::NonlinearImplicitAssembly::~NonlinearImplicitAssembly() {
     
+    this->clear_thread_elem_operation_objects();
 }
 
 
@@ -61,6 +206,33 @@ set_post_assembly_operation(MAST::NonlinearImplicitAssembly::PostAssemblyOperati
 
 
 
+void
+MAST::NonlinearImplicitAssembly::
+set_thread_elem_operation_objects
+(const std::vector<MAST::NonlinearImplicitAssemblyElemOperations*>& ops) {
+    
+    libmesh_assert_msg(_thread_elem_ops.empty(),
+                       "Error: Thread element operations should be cleared before attaching.");
+    libmesh_assert_greater_equal(ops.size(), libMesh::n_threads());
+    
+    _thread_elem_ops = ops;
+    for (unsigned int i=0; i<_thread_elem_ops.size(); i++)
+        _thread_elem_ops[i]->set_assembly(*this);
+}
+
+
+
+void
+MAST::NonlinearImplicitAssembly::clear_thread_elem_operation_objects() {
+    
+    for (unsigned int i=0; i<_thread_elem_ops.size(); i++)
+        _thread_elem_ops[i]->clear_assembly();
+    
+    _thread_elem_ops.clear();
+}
+
+
+
 void
 MAST::NonlinearImplicitAssembly::
 residual_and_jacobian (const libMesh::NumericVector<Real>& X,
@@ -68,6 +240,8 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
                        libMesh::SparseMatrix<Real>*  J,
                        libMesh::NonlinearImplicitSystem& S) {
     
+    MAST_PERF_SCOPE("NonlinearImplicitAssembly::residual_and_jacobian");
+    
     libmesh_assert(_system);
     libmesh_assert(_discipline);
     libmesh_assert(_elem_ops);
@@ -108,16 +282,32 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     MAST::NonlinearImplicitAssemblyElemOperations&
     ops = dynamic_cast<MAST::NonlinearImplicitAssemblyElemOperations&>(*_elem_ops);
 
+    // use the threaded element loop if per-thread element operation
+    // objects are available
+    if (libMesh::n_threads() > 1 && _thread_elem_ops.size()) {
+        
+        this->_threaded_residual_and_jacobian(*localized_solution, R, J);
+        this->_finalize_residual_and_jacobian(X, R, J, S);
+        return;
+    }
+    
+    MAST_PERF_STOPWATCH(sw);
+    
     for ( ; el != end_el; ++el) {
         
         const libMesh::Elem* elem = *el;
         
+        MAST_PERF_COUNT_ELEM("NonlinearImplicitAssembly::n_elems", elem->type(), 1);
+        
+        MAST_PERF_PHASE(sw, "NonlinearImplicitAssembly::dof_indices");
         dof_map.dof_indices (elem, dof_indices);
         
+        MAST_PERF_PHASE(sw, "NonlinearImplicitAssembly::geom_elem_init");
         MAST::GeomElem geom_elem;
         ops.set_elem_data(elem->dim(), *elem, geom_elem);
         geom_elem.init(*elem, *_system);
         
+        MAST_PERF_PHASE_ELEM(sw, "NonlinearImplicitAssembly::elem_init", elem->type());
         ops.init(geom_elem);
 
         // get the solution
@@ -138,6 +328,7 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         //_check_element_numerical_jacobian(*physics_elem, sol);
         
         // perform the element level calculations
+        MAST_PERF_PHASE_ELEM(sw, "NonlinearImplicitAssembly::elem_calculations", elem->type());
         ops.elem_calculations(J!=nullptr?true:false,
                                               vec, mat);
         
@@ -145,6 +336,8 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
 
         ops.clear_elem();
         
+        MAST_PERF_PHASE(sw, "NonlinearImplicitAssembly::constrain_element");
+        
         // copy to the libMesh matrix for further processing
         DenseRealVector v;
         DenseRealMatrix m;
@@ -163,11 +356,30 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
             dof_map.constrain_element_matrix(m, dof_indices);
         
         // add to the global matrices
+        MAST_PERF_PHASE(sw, "NonlinearImplicitAssembly::add_to_global");
         if (R) R->add_vector(v, dof_indices);
         if (J) J->add_matrix(m, dof_indices);
         dof_indices.clear();
+        MAST_PERF_STOP(sw);
     }
 
+    this->_finalize_residual_and_jacobian(X, R, J, S);
+}
+
+
+
+void
+MAST::NonlinearImplicitAssembly::
+_finalize_residual_and_jacobian(const libMesh::NumericVector<Real>& X,
+                                libMesh::NumericVector<Real>* R,
+                                libMesh::SparseMatrix<Real>*  J,
+                                libMesh::NonlinearImplicitSystem& S) {
+    
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
+    const libMesh::DofMap& dof_map    = nonlin_sys.get_dof_map();
+    
+    RealVectorX vec;
+    std::vector<libMesh::dof_id_type> dof_indices;
     
     // add the point loads if any in the discipline
     if (R && _discipline->point_loads().size()) {
@@ -250,6 +462,69 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
 
 
 
+void
+MAST::NonlinearImplicitAssembly::
+_threaded_residual_and_jacobian(const libMesh::NumericVector<Real>& localized_solution,
+                                libMesh::NumericVector<Real>* R,
+                                libMesh::SparseMatrix<Real>*  J) {
+    
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
+    const libMesh::DofMap& dof_map    = nonlin_sys.get_dof_map();
+    
+    // the elements are stored in the order of the serial loop so that the
+    // deterministic reduction can add them in the same order
+    std::vector<const libMesh::Elem*> elems;
+    elems.reserve(nonlin_sys.get_mesh().n_active_local_elem());
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    nonlin_sys.get_mesh().active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    nonlin_sys.get_mesh().active_local_elements_end();
+    
+    for ( ; el != end_el; ++el)
+        elems.push_back(*el);
+    
+    std::unique_ptr<std::vector<MAST::ThreadedElemQuantities> > storage;
+    if (deterministic_reduction)
+        storage.reset(new std::vector<MAST::ThreadedElemQuantities>(elems.size()));
+    
+    std::vector<MAST::NonlinearImplicitAssemblyElemOperations*>
+    pool(_thread_elem_ops);
+    libMesh::Threads::spin_mutex mutex;
+    
+    // the scheduler splits this range and redistributes the sub-ranges
+    // among the threads as they become idle.
+    const std::size_t grainsize = 64;
+    libMesh::Threads::parallel_for
+    (libMesh::Threads::BlockedRange<std::size_t>(0, elems.size(), grainsize),
+     MAST::NonlinearImplicitAssemblyThreadBody(elems,
+                                               localized_solution,
+                                               dof_map,
+                                               *_system,
+                                               pool,
+                                               mutex,
+                                               storage.get(),
+                                               R,
+                                               J));
+    
+    libmesh_assert_equal_to(pool.size(), _thread_elem_ops.size());
+    
+    if (storage) {
+        
+        MAST_PERF_SCOPE("NonlinearImplicitAssembly::add_to_global");
+        
+        // add to the global matrices in the order of the serial loop
+        for (std::size_t i=0; i<storage->size(); i++) {
+            
+            MAST::ThreadedElemQuantities& eq = (*storage)[i];
+            if (R) R->add_vector(eq.v, eq.dof_indices);
+            if (J) J->add_matrix(eq.m, eq.dof_indices);
+        }
+    }
+}
+
+
+
 
 void
 MAST::NonlinearImplicitAssembly::
@@ -480,13 +755,35 @@ MAST::NonlinearImplicitAssembly::
 sensitivity_assemble (const MAST::FunctionBase& f,
                       libMesh::NumericVector<Real>& sensitivity_rhs) {
     
+    std::vector<const MAST::FunctionBase*>
+    f_vec   (1, &f);
+    std::vector<libMesh::NumericVector<Real>*>
+    rhs_vec (1, &sensitivity_rhs);
+    
+    return MAST::NonlinearImplicitAssembly::sensitivity_assemble(f_vec, rhs_vec);
+}
+
+
+
+bool
+MAST::NonlinearImplicitAssembly::
+sensitivity_assemble (const std::vector<const MAST::FunctionBase*>& f,
+                      std::vector<libMesh::NumericVector<Real>*>& sensitivity_rhs) {
+    
+    MAST_PERF_SCOPE("NonlinearImplicitAssembly::sensitivity_assemble");
+    
     libmesh_assert(_system);
     libmesh_assert(_discipline);
     libmesh_assert(_elem_ops);
+    libmesh_assert_equal_to(f.size(), sensitivity_rhs.size());
 
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
-    sensitivity_rhs.zero();
+    const unsigned int
+    n_params = (unsigned int)f.size();
+    
+    for (unsigned int i=0; i<n_params; i++)
+        sensitivity_rhs[i]->zero();
     
     // iterate over each element, initialize it and get the relevant
     // analysis quantities
@@ -495,6 +792,9 @@ sensitivity_assemble (const MAST::FunctionBase& f,
     std::vector<libMesh::dof_id_type> dof_indices;
     const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
     
+    // parameters that the current element depends on
+    std::vector<unsigned int> elem_params;
+    elem_params.reserve(n_params);
     
     std::unique_ptr<libMesh::NumericVector<Real> > localized_solution;
     localized_solution.reset(build_localized_vector(nonlin_sys,
@@ -516,10 +816,15 @@ sensitivity_assemble (const MAST::FunctionBase& f,
         
         const libMesh::Elem* elem = *el;
         
-        // no sensitivity computation assembly is neeed in these cases
-        if (_param_dependence &&
-            // if object is specified and elem does not depend on it
-            !_param_dependence->if_elem_depends_on_parameter(*elem, f))
+        // no sensitivity computation assembly is neeed for parameters
+        // that the element does not depend on
+        elem_params.clear();
+        for (unsigned int i=0; i<n_params; i++)
+            if (!_param_dependence ||
+                _param_dependence->if_elem_depends_on_parameter(*elem, *f[i]))
+                elem_params.push_back(i);
+        
+        if (elem_params.empty())
             continue;
 
         dof_map.dof_indices (elem, dof_indices);
@@ -528,12 +833,12 @@ sensitivity_assemble (const MAST::FunctionBase& f,
         ops.set_elem_data(elem->dim(), *elem, geom_elem);
         geom_elem.init(*elem, *_system);
         
+        // the element is initialized once and reused for all parameters
         ops.init(geom_elem);
 
         // get the solution
         unsigned int ndofs = (unsigned int)dof_indices.size();
         sol.setZero(ndofs);
-        vec.setZero(ndofs);
         
         for (unsigned int i=0; i<dof_indices.size(); i++)
             sol(i) = (*localized_solution)(dof_indices[i]);
@@ -543,21 +848,31 @@ sensitivity_assemble (const MAST::FunctionBase& f,
 //        if (_sol_function)
 //            physics_elem->attach_active_solution_function(*_sol_function);
         
-        ops.elem_sensitivity_calculations(f, vec);
+        for (unsigned int i=0; i<elem_params.size(); i++) {
+            
+            vec.setZero(ndofs);
+            {
+                MAST_PERF_SCOPE_ELEM("NonlinearImplicitAssembly::elem_sensitivity_calculations",
+                                     elem->type());
+                ops.elem_sensitivity_calculations(*f[elem_params[i]], vec);
+            }
+            
+            // copy to the libMesh matrix for further processing
+            DenseRealVector v;
+            MAST::copy(v, vec);
+            
+            // constrain the quantities to account for hanging dofs,
+            // Dirichlet constraints, etc. The constraint may expand the
+            // dof list, so a copy is used for each parameter.
+            std::vector<libMesh::dof_id_type> dofs = dof_indices;
+            dof_map.constrain_element_vector(v, dofs);
+            
+            // add to the global matrices
+            sensitivity_rhs[elem_params[i]]->add_vector(v, dofs);
+        }
         
 //        physics_elem->detach_active_solution_function();
         ops.clear_elem();
-
-        // copy to the libMesh matrix for further processing
-        DenseRealVector v;
-        MAST::copy(v, vec);
-
-        // constrain the quantities to account for hanging dofs,
-        // Dirichlet constraints, etc.
-        dof_map.constrain_element_vector(v, dof_indices);
-        
-        // add to the global matrices
-        sensitivity_rhs.add_vector(v, dof_indices);
         dof_indices.clear();
     }
     
@@ -593,27 +908,31 @@ sensitivity_assemble (const MAST::FunctionBase& f,
             
             for (; n_it != n_end; n_it++) {
                 
-                // load at the node
-                vec.setZero();
-                func.derivative(f, **n_it, nonlin_sys.time, vec);
-                vec *= -1.;
-                
                 dof_map.dof_indices(*n_it, dof_indices);
                 
                 libmesh_assert_equal_to(dof_indices.size(), vec.rows());
 
-                // zero the components of the vector if they do not
-                // belong to this processor
-                for (unsigned int i=0; i<dof_indices.size(); i++)
-                    if (dof_indices[i] <   first_dof  ||
-                        dof_indices[i] >=  last_dof)
-                        vec(i) = 0.;
-
-                DenseRealVector v;
-                MAST::copy(v, vec);
-                
-                dof_map.constrain_element_vector(v, dof_indices);
-                sensitivity_rhs.add_vector(v, dof_indices);
+                for (unsigned int j=0; j<n_params; j++) {
+                    
+                    // load at the node
+                    vec.setZero();
+                    func.derivative(*f[j], **n_it, nonlin_sys.time, vec);
+                    vec *= -1.;
+                    
+                    // zero the components of the vector if they do not
+                    // belong to this processor
+                    for (unsigned int i=0; i<dof_indices.size(); i++)
+                        if (dof_indices[i] <   first_dof  ||
+                            dof_indices[i] >=  last_dof)
+                            vec(i) = 0.;
+                    
+                    DenseRealVector v;
+                    MAST::copy(v, vec);
+                    
+                    std::vector<libMesh::dof_id_type> dofs = dof_indices;
+                    dof_map.constrain_element_vector(v, dofs);
+                    sensitivity_rhs[j]->add_vector(v, dofs);
+                }
                 dof_indices.clear();
             }
         }
@@ -623,9 +942,232 @@ sensitivity_assemble (const MAST::FunctionBase& f,
     if (_sol_function)
         _sol_function->clear();
     
-    sensitivity_rhs.close();
+    for (unsigned int i=0; i<n_params; i++)
+        sensitivity_rhs[i]->close();
     
     return true;
 }
 
 
+
+void
+MAST::NonlinearImplicitAssembly::
+calculate_output_adjoint_sensitivity(const libMesh::NumericVector<Real>& X,
+                                     const libMesh::NumericVector<Real>& dq_dX,
+                                     const std::vector<const MAST::FunctionBase*>& p,
+                                     MAST::AssemblyElemOperations&       elem_ops,
+                                     MAST::OutputAssemblyElemOperations& output,
+                                     std::vector<Real>&                  dq_dp,
+                                     const bool include_partial_sens) {
+    
+    MAST_PERF_SCOPE("NonlinearImplicitAssembly::calculate_output_adjoint_sensitivity(multiple)");
+    
+    libmesh_assert(_system);
+    libmesh_assert(_discipline);
+    
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
+    
+    const unsigned int
+    n_params = (unsigned int)p.size();
+    
+    dq_dp.assign(n_params, 0.);
+    
+    this->set_elem_operation_object(elem_ops);
+    
+    MAST::NonlinearImplicitAssemblyElemOperations&
+    ops = dynamic_cast<MAST::NonlinearImplicitAssemblyElemOperations&>(*_elem_ops);
+    
+    RealVectorX vec, sol;
+    
+    std::vector<libMesh::dof_id_type>
+    dof_indices,
+    dofs;
+    const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
+    
+    // parameters that the current element depends on
+    std::vector<unsigned int> elem_params;
+    std::vector<const MAST::FunctionBase*> elem_p;
+    elem_params.reserve(n_params);
+    elem_p.reserve(n_params);
+    
+    // the partial sensitivity of outputs that are a sum of element
+    // contributions is computed in the same element loop
+    const bool
+    if_elem_partial_sens = include_partial_sens && output.if_additive_over_elems();
+    
+    RealVectorX dq_dp_elem;
+    
+    if (if_elem_partial_sens) {
+        
+        output.zero_for_sensitivity();
+        output.set_assembly(*this);
+    }
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    localized_solution,
+    localized_adjoint;
+    localized_solution.reset(build_localized_vector(nonlin_sys, X).release());
+    localized_adjoint.reset(build_localized_vector(nonlin_sys, dq_dX).release());
+    
+    // if a solution function is attached, initialize it
+    if (_sol_function)
+        _sol_function->init(X);
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    nonlin_sys.get_mesh().active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    nonlin_sys.get_mesh().active_local_elements_end();
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        
+        elem_params.clear();
+        elem_p.clear();
+        for (unsigned int i=0; i<n_params; i++)
+            if (!_param_dependence ||
+                _param_dependence->if_elem_depends_on_parameter(*elem, *p[i])) {
+                elem_params.push_back(i);
+                elem_p.push_back(p[i]);
+            }
+        
+        if (elem_params.empty())
+            continue;
+        
+        dof_map.dof_indices (elem, dof_indices);
+        
+        MAST::GeomElem geom_elem;
+        ops.set_elem_data(elem->dim(), *elem, geom_elem);
+        geom_elem.init(*elem, *_system);
+        
+        ops.init(geom_elem);
+        
+        unsigned int ndofs = (unsigned int)dof_indices.size();
+        sol.setZero(ndofs);
+        
+        for (unsigned int i=0; i<dof_indices.size(); i++)
+            sol(i) = (*localized_solution)(dof_indices[i]);
+        
+        ops.set_elem_solution(sol);
+        
+        for (unsigned int i=0; i<elem_params.size(); i++) {
+            
+            vec.setZero(ndofs);
+            ops.elem_sensitivity_calculations(*p[elem_params[i]], vec);
+            
+            // apply the constraints before the dot product so that the
+            // result matches the assembled residual sensitivity
+            DenseRealVector v;
+            MAST::copy(v, vec);
+            dofs = dof_indices;
+            dof_map.constrain_element_vector(v, dofs);
+            
+            Real
+            val = 0.;
+            for (unsigned int j=0; j<dofs.size(); j++)
+                val += v(j) * (*localized_adjoint)(dofs[j]);
+            
+            dq_dp[elem_params[i]] += val;
+        }
+        
+        if (if_elem_partial_sens) {
+            
+            // the solution sensitivity is zero for the partial sensitivity
+            vec.setZero(ndofs);
+            
+            output.init(geom_elem);
+            output.set_elem_solution(sol);
+            output.set_elem_solution_sensitivity(vec);
+            output.partial_sensitivity_for_elem(elem_p, dq_dp_elem);
+            output.clear_elem();
+            
+            for (unsigned int i=0; i<elem_params.size(); i++)
+                dq_dp[elem_params[i]] += dq_dp_elem(i);
+        }
+        
+        ops.clear_elem();
+        dof_indices.clear();
+    }
+    
+    // add the point loads if any in the discipline
+    if (_discipline->point_loads().size()) {
+        
+        const MAST::PointLoadSetType&
+        loads = _discipline->point_loads();
+        
+        vec = RealVectorX::Zero(_system->n_vars());
+        
+        MAST::PointLoadSetType::const_iterator
+        it    = loads.begin(),
+        end   = loads.end();
+        
+        const libMesh::dof_id_type
+        first_dof  = dof_map.first_dof(nonlin_sys.comm().rank()),
+        last_dof   = dof_map.last_dof(nonlin_sys.comm().rank());
+        
+        for ( ; it != end; it++) {
+            
+            const MAST::FieldFunction<RealVectorX>
+            &func = (*it)->get<MAST::FieldFunction<RealVectorX>>("load");
+            
+            const std::set<const libMesh::Node*>
+            nodes = (*it)->get_nodes();
+            
+            std::set<const libMesh::Node*>::const_iterator
+            n_it    = nodes.begin(),
+            n_end   = nodes.end();
+            
+            for (; n_it != n_end; n_it++) {
+                
+                dof_map.dof_indices(*n_it, dof_indices);
+                
+                libmesh_assert_equal_to(dof_indices.size(), vec.rows());
+                
+                for (unsigned int j=0; j<n_params; j++) {
+                    
+                    vec.setZero();
+                    func.derivative(*p[j], **n_it, nonlin_sys.time, vec);
+                    vec *= -1.;
+                    
+                    // only the processor that owns the dof contributes
+                    for (unsigned int i=0; i<dof_indices.size(); i++)
+                        if (dof_indices[i] <   first_dof  ||
+                            dof_indices[i] >=  last_dof)
+                            vec(i) = 0.;
+                    
+                    DenseRealVector v;
+                    MAST::copy(v, vec);
+                    dofs = dof_indices;
+                    dof_map.constrain_element_vector(v, dofs);
+                    
+                    for (unsigned int i=0; i<dofs.size(); i++)
+                        dq_dp[j] += v(i) * (*localized_adjoint)(dofs[i]);
+                }
+                dof_indices.clear();
+            }
+        }
+    }
+    
+    if (if_elem_partial_sens)
+        output.clear_assembly();
+    
+    if (_sol_function)
+        _sol_function->clear();
+    
+    this->clear_elem_operation_object();
+    
+    // sum the contributions from all processors
+    nonlin_sys.comm().sum(dq_dp);
+    
+    // the partial sensitivity of the output, which is computed with zero
+    // solution sensitivity. Outputs such as stress functionals are not
+    // additive over elements, so this is evaluated for each parameter.
+    if (include_partial_sens && !if_elem_partial_sens)
+        for (unsigned int i=0; i<n_params; i++) {
+            
+            this->calculate_output_direct_sensitivity(X, nullptr, *p[i], output);
+            dq_dp[i] += output.output_sensitivity_total(*p[i]);
+        }
+}
+
+
@@ -20,6 +20,9 @@
 #ifndef __mast__nonlinear_implicit_assembly__
 #define __mast__nonlinear_implicit_assembly__
 
+// C++ includes
+#include <vector>
+
 // MAST includes
 #include "base/assembly_base.h"
 
@@ -92,6 +95,36 @@ namespace MAST {
         void
         set_post_assembly_operation(MAST::NonlinearImplicitAssembly::PostAssemblyOperation& post);
         
+        /*!
+         *    attaches one element operation object per thread for use in the
+         *    shared-memory assembly in \p residual_and_jacobian. The objects
+         *    should be of the same type as the primary element operation
+         *    object and should be attached to the same discipline and system.
+         *    At least \p libMesh::n_threads() objects must be provided.
+         *    Threaded assembly is used only if more than one libMesh thread
+         *    is available. Each object is used by only one thread at a time.
+         */
+        void
+        set_thread_elem_operation_objects
+        (const std::vector<MAST::NonlinearImplicitAssemblyElemOperations*>& ops);
+        
+        /*!
+         *    clears the per-thread element operation objects. Subsequent
+         *    assembly will use the serial element loop.
+         */
+        void clear_thread_elem_operation_objects();
+        
+        /*!
+         *    if \p true, the threaded assembly stores the constrained
+         *    element quantities and adds them to the global residual and
+         *    Jacobian in the same order as the serial element loop, so that
+         *    the result is identical to the serial assembly. If \p false,
+         *    each thread adds its element quantities as soon as they are
+         *    computed, which requires less memory but does not guarantee
+         *    the same order of floating-point summation. Default is \p true.
+         */
+        bool deterministic_reduction;
+        
         /*!
          *    function that assembles the matrices and vectors quantities for
          *    nonlinear solution
@@ -143,9 +176,67 @@ namespace MAST {
         sensitivity_assemble (const MAST::FunctionBase& f,
                               libMesh::NumericVector<Real>& sensitivity_rhs);
         
+        /*!
+         *   assembles the sensitivity right-hand side for all parameters in
+         *   \p f in a single sweep over the elements. Each element is
+         *   initialized once and the element sensitivity is computed only
+         *   for the parameters that the element depends on.
+         */
+        virtual bool
+        sensitivity_assemble (const std::vector<const MAST::FunctionBase*>& f,
+                              std::vector<libMesh::NumericVector<Real>*>& sensitivity_rhs);
+        
+        
+        using MAST::AssemblyBase::calculate_output_adjoint_sensitivity;
+        
+        /*!
+         *   Evaluates the total sensitivity of \p output wrt all parameters
+         *   in \p p in a single sweep over the elements. The element
+         *   residual sensitivity is dotted with the local adjoint values
+         *   in \p dq_dX instead of being assembled into a global vector.
+         *   If an element parameter dependence object is attached, only the
+         *   parameters that an element depends on are evaluated on it.
+         *   The partial sensitivity of outputs that are a sum of element
+         *   contributions is computed in the same sweep. For other outputs
+         *   it is computed for each parameter separately.
+         */
+        virtual void
+        calculate_output_adjoint_sensitivity(const libMesh::NumericVector<Real>& X,
+                                             const libMesh::NumericVector<Real>& dq_dX,
+                                             const std::vector<const MAST::FunctionBase*>& p,
+                                             MAST::AssemblyElemOperations&       elem_ops,
+                                             MAST::OutputAssemblyElemOperations& output,
+                                             std::vector<Real>&                  dq_dp,
+                                             const bool include_partial_sens = true);
+        
     protected:
         
-
+        /*!
+         *    threaded version of the element loop in
+         *    \p residual_and_jacobian. Uses the element operation objects
+         *    in \p _thread_elem_ops.
+         */
+        void
+        _threaded_residual_and_jacobian(const libMesh::NumericVector<Real>& localized_solution,
+                                        libMesh::NumericVector<Real>* R,
+                                        libMesh::SparseMatrix<Real>*  J);
+        
+        /*!
+         *    adds the point loads, calls the post assembly operation and
+         *    closes \p R and \p J after the element loop in
+         *    \p residual_and_jacobian.
+         */
+        void
+        _finalize_residual_and_jacobian(const libMesh::NumericVector<Real>& X,
+                                        libMesh::NumericVector<Real>* R,
+                                        libMesh::SparseMatrix<Real>*  J,
+                                        libMesh::NonlinearImplicitSystem& S);
+        
+        /*!
+         *    element operation objects used by the threads in
+         *    \p _threaded_residual_and_jacobian.
+         */
+        std::vector<MAST::NonlinearImplicitAssemblyElemOperations*> _thread_elem_ops;
         
         /*!
          *    this object, if non-NULL is user-provided to perform actions
@@ -32,6 +32,8 @@
 #include "base/parameter.h"
 #include "base/output_assembly_elem_operations.h"
 #include "solver/slepc_eigen_solver.h"
+#include "mesh/fe_cache.h"
+#include "utility/perf_log.h"
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
@@ -40,6 +42,9 @@
 #include "libmesh/dof_map.h"
 #include "libmesh/nonlinear_solver.h"
 #include "libmesh/petsc_linear_solver.h"
+#include "libmesh/petsc_matrix.h"
+#include "libmesh/petsc_vector.h"
+#include "libmesh/petsc_macro.h"
 #include "libmesh/xdr_cxx.h"
 #include "libmesh/mesh_tools.h"
 #include "libmesh/utility.h"
@@ -96,10 +101,32 @@ MAST::NonlinearSystem::clear() {
       eigen_solver->clear();
     }
     
+    this->clear_fe_cache();
+    
     libMesh::NonlinearImplicitSystem::clear();
 }
 
 
+
+void
+MAST::NonlinearSystem::set_use_fe_cache(bool f) {
+    
+    if (f && !_fe_cache)
+        _fe_cache.reset(new MAST::FECache);
+    else if (!f)
+        _fe_cache.reset();
+}
+
+
+
+void
+MAST::NonlinearSystem::clear_fe_cache() {
+    
+    if (_fe_cache)
+        _fe_cache->clear();
+}
+
+
 void
 MAST::NonlinearSystem::set_eigenproblem_type (libMesh::EigenProblemType ept) {
     
@@ -164,6 +191,9 @@ void MAST::NonlinearSystem::reinit () {
     // initialize parent data
     libMesh::NonlinearImplicitSystem::reinit();
     
+    // the mesh may have changed, so the cached data is no longer valid
+    this->clear_fe_cache();
+    
     // Clear the matrices
     matrix_A->clear();
     
@@ -209,6 +239,8 @@ void
 MAST::NonlinearSystem::solve(MAST::AssemblyElemOperations& elem_ops,
                              MAST::AssemblyBase&  assembly) {
     
+    MAST_PERF_SCOPE("NonlinearSystem::solve");
+    
     libmesh_assert(_operation == MAST::NonlinearSystem::NONE);
     
     _operation = MAST::NonlinearSystem::NONLINEAR_SOLVE;
@@ -235,6 +267,8 @@ void
 MAST::NonlinearSystem::eigenproblem_solve(MAST::AssemblyElemOperations& elem_ops,
                                           MAST::EigenproblemAssembly& assembly) {
     
+    MAST_PERF_SCOPE("NonlinearSystem::eigenproblem_solve");
+    
     libmesh_assert(_operation == MAST::NonlinearSystem::NONE);
     
     _operation = MAST::NonlinearSystem::EIGENPROBLEM_SOLVE;
@@ -745,6 +779,7 @@ MAST::NonlinearSystem::sensitivity_solve(MAST::AssemblyElemOperations& elem_ops,
     
     // Log how long the linear solve takes.
     LOG_SCOPE("sensitivity_solve()", "NonlinearSystem");
+    MAST_PERF_SCOPE("NonlinearSystem::sensitivity_solve");
 
     assembly.set_elem_operation_object(elem_ops);
     
@@ -788,6 +823,164 @@ MAST::NonlinearSystem::sensitivity_solve(MAST::AssemblyElemOperations& elem_ops,
 
 
 
+std::vector<libMesh::NumericVector<Real>*>
+MAST::NonlinearSystem::sensitivity_solve(MAST::AssemblyElemOperations&                 elem_ops,
+                                         MAST::AssemblyBase&                           assembly,
+                                         const std::vector<const MAST::FunctionBase*>& p,
+                                         bool if_assemble_jacobian) {
+    
+    libmesh_assert(_operation == MAST::NonlinearSystem::NONE);
+    
+    _operation = MAST::NonlinearSystem::FORWARD_SENSITIVITY_SOLVE;
+    
+    // Log how long the linear solve takes.
+    LOG_SCOPE("sensitivity_solve(multiple)", "NonlinearSystem");
+    MAST_PERF_SCOPE("NonlinearSystem::sensitivity_solve(multiple)");
+    
+    const unsigned int
+    n_params = (unsigned int)p.size();
+    
+    std::vector<libMesh::NumericVector<Real>*>
+    dsol (n_params, nullptr),
+    rhs  (n_params, nullptr);
+    
+    for (unsigned int i=0; i<n_params; i++) {
+        dsol[i] = &this->add_sensitivity_solution(i);
+        rhs[i]  = &this->add_sensitivity_rhs(i);
+    }
+    
+    if (!n_params) {
+        _operation = MAST::NonlinearSystem::NONE;
+        return dsol;
+    }
+    
+    assembly.set_elem_operation_object(elem_ops);
+    
+    if (if_assemble_jacobian)
+        assembly.residual_and_jacobian(*solution, nullptr, matrix, *this);
+    assembly.sensitivity_assemble(p, rhs);
+    
+    assembly.clear_elem_operation_object();
+    
+    for (unsigned int i=0; i<n_params; i++)
+        rhs[i]->scale(-1.);
+    
+    std::pair<unsigned int, Real>
+    solver_params = this->get_linear_solve_parameters();
+    
+    // the KSP of the linear solver of this system is used for all
+    // right-hand sides, so that the preconditioner is set up only once and
+    // the solve uses the same options prefix, solver and preconditioner
+    // settings as the single parameter sensitivity solve.
+    PetscErrorCode ierr;
+    
+    matrix->close();
+    libMesh::PetscMatrix<Real>
+    &jac = dynamic_cast<libMesh::PetscMatrix<Real>&>(*matrix);
+    
+    libMesh::SparseMatrix<Real> * pc_mat = this->request_matrix("Preconditioner");
+    Mat
+    pmat = jac.mat();
+    if (pc_mat) {
+        pc_mat->close();
+        pmat = dynamic_cast<libMesh::PetscMatrix<Real>*>(pc_mat)->mat();
+    }
+    
+    libMesh::PetscLinearSolver<Real>
+    &petsc_solver = dynamic_cast<libMesh::PetscLinearSolver<Real>&>(*linear_solver);
+    
+    // does nothing if the solver was initialized with the system name prefix
+    petsc_solver.init(&jac);
+    
+    KSP
+    ksp = petsc_solver.ksp();
+    
+    ierr = KSPSetOperators(ksp, jac.mat(), pmat); CHKERRABORT(this->comm().get(), ierr);
+    ierr = KSPSetTolerances(ksp,
+                            solver_params.second,
+                            PETSC_DEFAULT,
+                            PETSC_DEFAULT,
+                            solver_params.first); CHKERRABORT(this->comm().get(), ierr);
+    ierr = KSPSetUp(ksp);                         CHKERRABORT(this->comm().get(), ierr);
+    
+#if !PETSC_VERSION_LESS_THAN(3,14,0)
+    
+    // solve all right-hand sides as a block. Direct solvers use this
+    // to perform a multiple right-hand side back-substitution.
+    Mat
+    B,
+    X;
+    Vec
+    col;
+    
+    const PetscInt
+    m_local  = (PetscInt)rhs[0]->local_size(),
+    m_global = (PetscInt)rhs[0]->size();
+    
+    ierr = MatCreateDense(this->comm().get(), m_local, PETSC_DECIDE,
+                          m_global, n_params, nullptr, &B);
+    CHKERRABORT(this->comm().get(), ierr);
+    ierr = MatCreateDense(this->comm().get(), m_local, PETSC_DECIDE,
+                          m_global, n_params, nullptr, &X);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    for (unsigned int i=0; i<n_params; i++) {
+        
+        ierr = MatDenseGetColumnVecWrite(B, i, &col);   CHKERRABORT(this->comm().get(), ierr);
+        ierr = VecCopy(dynamic_cast<libMesh::PetscVector<Real>*>(rhs[i])->vec(), col);
+        CHKERRABORT(this->comm().get(), ierr);
+        ierr = MatDenseRestoreColumnVecWrite(B, i, &col);
+        CHKERRABORT(this->comm().get(), ierr);
+    }
+    
+    {
+        MAST_PERF_SCOPE("NonlinearSystem::sensitivity_solve(multiple)/linear_solve");
+        MAST_PERF_COUNT("NonlinearSystem::n_sensitivity_rhs", n_params);
+        ierr = KSPMatSolve(ksp, B, X);             CHKERRABORT(this->comm().get(), ierr);
+    }
+    
+    for (unsigned int i=0; i<n_params; i++) {
+        
+        libMesh::PetscVector<Real>
+        &x = dynamic_cast<libMesh::PetscVector<Real>&>(*dsol[i]);
+        
+        ierr = MatDenseGetColumnVecRead(X, i, &col);    CHKERRABORT(this->comm().get(), ierr);
+        ierr = VecCopy(col, x.vec());                   CHKERRABORT(this->comm().get(), ierr);
+        ierr = MatDenseRestoreColumnVecRead(X, i, &col);
+        CHKERRABORT(this->comm().get(), ierr);
+        x.close();
+    }
+    
+    ierr = MatDestroy(&B);                         CHKERRABORT(this->comm().get(), ierr);
+    ierr = MatDestroy(&X);                         CHKERRABORT(this->comm().get(), ierr);
+#else
+    
+    for (unsigned int i=0; i<n_params; i++) {
+        
+        libMesh::PetscVector<Real>
+        &b = dynamic_cast<libMesh::PetscVector<Real>&>(*rhs[i]),
+        &x = dynamic_cast<libMesh::PetscVector<Real>&>(*dsol[i]);
+        
+        MAST_PERF_SCOPE("NonlinearSystem::sensitivity_solve(multiple)/linear_solve");
+        MAST_PERF_COUNT("NonlinearSystem::n_sensitivity_rhs", 1);
+        ierr = KSPSolve(ksp, b.vec(), x.vec());    CHKERRABORT(this->comm().get(), ierr);
+        x.close();
+    }
+#endif
+    
+    // The linear solver may not have fit our constraints exactly
+#ifdef LIBMESH_ENABLE_CONSTRAINTS
+    for (unsigned int i=0; i<n_params; i++)
+        this->get_dof_map().enforce_constraints_exactly (*this, dsol[i], /* homogeneous = */ true);
+#endif
+    
+    _operation = MAST::NonlinearSystem::NONE;
+    
+    return dsol;
+}
+
+
+
 void
 MAST::NonlinearSystem::adjoint_solve(MAST::AssemblyElemOperations&       elem_ops,
                                      MAST::OutputAssemblyElemOperations& output,
@@ -801,6 +994,7 @@ MAST::NonlinearSystem::adjoint_solve(MAST::AssemblyElemOperations&       elem_op
     
     // Log how long the linear solve takes.
     LOG_SCOPE("adjoint_solve()", "NonlinearSystem");
+    MAST_PERF_SCOPE("NonlinearSystem::adjoint_solve");
     
     libMesh::NumericVector<Real>
     &dsol  = this->add_adjoint_solution(),
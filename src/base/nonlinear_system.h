@@ -44,6 +44,7 @@ namespace MAST {
     class OutputAssemblyElemOperations;
     class FunctionBase;
     class EigenproblemAssembly;
+    class FECache;
     
     
     /*!
@@ -118,6 +119,28 @@ namespace MAST {
         virtual void reinit () libmesh_override;
 
 
+        /*!
+         *   if \p true, the finite element shape functions and quadrature
+         *   data initialized by \p MAST::GeomElem for this system are
+         *   stored and reused in subsequent assembly operations. The stored
+         *   data is cleared in \p reinit() and \p clear(). If the mesh nodes
+         *   are moved, the user must call \p clear_fe_cache(). This is
+         *   \p false by default.
+         */
+        void set_use_fe_cache(bool f);
+        
+        /*!
+         *   @returns a pointer to the finite element cache, or \p nullptr
+         *   if the cache is not used.
+         */
+        MAST::FECache* fe_cache() const { return _fe_cache.get(); }
+        
+        /*!
+         *   clears the cached finite element data, if any.
+         */
+        void clear_fe_cache();
+        
+        
         /*!
          *   calls NonlinearImplicitSystem::set_solver_parameters() before
          *   accessing the values.
@@ -145,6 +168,25 @@ namespace MAST {
                                        bool if_assemble_jacobian = true);
 
         
+        /*!
+         *   Solves the sensitivity problem for all parameters in \p p. The
+         *   Jacobian is assembled at most once and the right-hand sides of
+         *   all parameters are assembled in a single sweep over the elements.
+         *   The linear systems are solved with the Krylov solver of
+         *   \p linear_solver, with the same options as the single parameter
+         *   solve, and the preconditioner (or factorization) is set up
+         *   only once. The
+         *   solution sensitivity of the i-th parameter is stored in
+         *   \p get_sensitivity_solution(i) and the vector of these is
+         *   returned.
+         */
+        virtual std::vector<libMesh::NumericVector<Real>*>
+        sensitivity_solve(MAST::AssemblyElemOperations&                 elem_ops,
+                          MAST::AssemblyBase&                           assembly,
+                          const std::vector<const MAST::FunctionBase*>& p,
+                          bool if_assemble_jacobian = true);
+
+        
         /*!
          *   solves the adjoint problem for the provided output function.
          *   The Jacobian will be assembled before adjoint solve if
@@ -394,6 +436,11 @@ namespace MAST {
          */
         std::vector<libMesh::dof_id_type>  _local_non_condensed_dofs_vector;
         
+        /*!
+         *   cache of finite element data, if enabled.
+         */
+        std::unique_ptr<MAST::FECache>     _fe_cache;
+        
     };
 }
 
@@ -172,3 +172,24 @@ if_evaluate_for_boundary(const MAST::GeomElem& elem,
 }
 
 
+
+
+
+Real
+MAST::OutputAssemblyElemOperations::
+topology_sensitivity_for_elem(const MAST::FunctionBase& f,
+                              const MAST::FieldFunction<RealVectorX>& vel) {
+    
+    libmesh_error(); // must be implemented in derived class
+    return 0.;
+}
+
+
+
+void
+MAST::OutputAssemblyElemOperations::
+partial_sensitivity_for_elem(const std::vector<const MAST::FunctionBase*>& p,
+                             RealVectorX& dq_dp) {
+    
+    libmesh_error(); // must be implemented in derived class
+}
@@ -23,6 +23,7 @@
 // C++ includes
 #include <set>
 #include <memory>
+#include <vector>
 
 // MAST includes
 #include "base/mast_data_types.h"
@@ -164,6 +165,39 @@ namespace MAST {
         evaluate_topology_sensitivity(const MAST::FunctionBase& f,
                                       const MAST::FieldFunction<RealVectorX>& vel) = 0;
 
+        /*!
+         *    @returns the contribution of the present element to the
+         *    topology sensitivity for boundary velocity \p vel, without
+         *    accumulating it in this object. This is only defined for
+         *    outputs that are a sum of element contributions, and is used
+         *    to compute the sensitivity with respect to all level-set dofs
+         *    in one sweep. The default implementation throws an error.
+         */
+        virtual Real
+        topology_sensitivity_for_elem(const MAST::FunctionBase& f,
+                                      const MAST::FieldFunction<RealVectorX>& vel);
+
+        /*!
+         *    @returns \p true if the output is a sum of element
+         *    contributions, in which case \p partial_sensitivity_for_elem()
+         *    is implemented. The default implementation returns \p false.
+         */
+        virtual bool if_additive_over_elems() const { return false; }
+        
+        /*!
+         *    computes the partial derivative of the contribution of the
+         *    present element to the output with respect to each parameter
+         *    in \p p, with zero solution sensitivity, and returns them in
+         *    \p dq_dp without accumulating them in this object. This is
+         *    used to compute the partial sensitivity with respect to all
+         *    parameters in one sweep over the elements, and is only
+         *    defined if \p if_additive_over_elems() is \p true. The default
+         *    implementation throws an error.
+         */
+        virtual void
+        partial_sensitivity_for_elem(const std::vector<const MAST::FunctionBase*>& p,
+                                     RealVectorX& dq_dp);
+
         /*!
          *   The output function can be a boundary integrated quantity, volume
          *   integrated quantity or a combination of these two. The user
@@ -92,6 +92,15 @@ namespace MAST {
         
         
         
+        /*!
+         *  adds this parameter to \p p
+         */
+        virtual void get_parameters(std::set<const MAST::Parameter*>& p) const {
+            p.insert(this);
+        }
+        
+        
+        
         /*!
          *  sets the value of this function
          */
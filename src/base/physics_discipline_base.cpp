@@ -23,6 +23,8 @@
 #include "base/parameter.h"
 #include "base/nonlinear_system.h"
 #include "boundary_condition/dirichlet_boundary_condition.h"
+#include "boundary_condition/point_load_condition.h"
+#include "property_cards/element_property_card_base.h"
 #include "mesh/geom_elem.h"
 
 // libMesh includes
@@ -180,6 +182,36 @@ MAST::PhysicsDisciplineBase::get_property_card(const MAST::GeomElem& elem) const
 
 
 
+void
+MAST::PhysicsDisciplineBase::get_parameters(std::set<const MAST::Parameter*>& p) const {
+    
+    MAST::PropertyCardMapType::const_iterator
+    prop_it  = _element_property.begin(),
+    prop_end = _element_property.end();
+    for ( ; prop_it != prop_end; prop_it++)
+        prop_it->second->get_parameters(p);
+    
+    MAST::SideBCMapType::const_iterator
+    side_it  = _side_bc_map.begin(),
+    side_end = _side_bc_map.end();
+    for ( ; side_it != side_end; side_it++)
+        side_it->second->get_parameters(p);
+    
+    MAST::VolumeBCMapType::const_iterator
+    vol_it   = _vol_bc_map.begin(),
+    vol_end  = _vol_bc_map.end();
+    for ( ; vol_it != vol_end; vol_it++)
+        vol_it->second->get_parameters(p);
+    
+    MAST::PointLoadSetType::const_iterator
+    pt_it    = _point_loads.begin(),
+    pt_end   = _point_loads.end();
+    for ( ; pt_it != pt_end; pt_it++)
+        (*pt_it)->get_parameters(p);
+}
+
+
+
 void
 MAST::PhysicsDisciplineBase::
 init_system_dirichlet_bc(MAST::NonlinearSystem& sys) const {
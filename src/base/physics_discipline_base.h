@@ -22,6 +22,7 @@
 
 // C++ includes
 #include <map>
+#include <set>
 
 // MAST includes
 #include "base/mast_data_types.h"
@@ -208,6 +209,12 @@ namespace MAST {
          */
         const MAST::ElementPropertyCardBase& get_property_card(const unsigned int sid) const;
         
+        /*!
+         *    adds to \p p the parameters that the property cards and the
+         *    side, volume and point loads of this discipline depend on
+         */
+        void get_parameters(std::set<const MAST::Parameter*>& p) const;
+        
         
         
     protected:
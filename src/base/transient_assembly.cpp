@@ -284,6 +284,235 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
 
 
 
+bool
+MAST::TransientAssembly::
+coupling_sparsity(unsigned int j,
+                  const libMesh::DofMap& col_dof_map,
+                  std::vector<std::set<libMesh::dof_id_type> >& cols) {
+    
+    libmesh_assert(_system);
+    libmesh_assert(_discipline);
+    libmesh_assert(_elem_ops);
+    
+    MAST::TransientSolverBase
+    &solver = dynamic_cast<MAST::TransientSolverBase&>(*_elem_ops);
+    MAST::TransientAssemblyElemOperations
+    &ops = solver.get_elem_operation_object();
+    MAST::NonlinearSystem
+    &transient_sys = _system->system();
+    
+    const libMesh::DofMap& dof_map = transient_sys.get_dof_map();
+    
+    const libMesh::dof_id_type
+    first = dof_map.first_dof(),
+    end   = dof_map.end_dof();
+    
+    cols.clear();
+    cols.resize(end - first);
+    
+    std::vector<libMesh::dof_id_type>
+    row_dofs,
+    col_dofs;
+    
+    RealMatrixX
+    mat;
+    
+    bool
+    provided = true;
+    
+    // the ghosted elements also contribute to the rows owned by this
+    // processor
+    libMesh::MeshBase::const_element_iterator       el     =
+    transient_sys.get_mesh().active_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    transient_sys.get_mesh().active_elements_end();
+    
+    for ( ; el != end_el && provided; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        
+        provided = ops.elem_coupling_dofs(j, *elem, col_dofs);
+        
+        if (!provided || col_dofs.empty())
+            continue;
+        
+        dof_map.dof_indices (elem, row_dofs);
+        
+        mat.setZero(row_dofs.size(), col_dofs.size());
+        this->_constrain_coupling_matrix(col_dof_map, row_dofs, col_dofs, mat);
+        
+        for (unsigned int i=0; i<row_dofs.size(); i++)
+            if (row_dofs[i] >= first && row_dofs[i] < end)
+                cols[row_dofs[i]-first].insert(col_dofs.begin(), col_dofs.end());
+    }
+    
+    return provided;
+}
+
+
+
+void
+MAST::TransientAssembly::
+coupling_jacobian(const libMesh::NumericVector<Real>& X,
+                  unsigned int j,
+                  const libMesh::DofMap& col_dof_map,
+                  libMesh::SparseMatrix<Real>& J,
+                  libMesh::NonlinearImplicitSystem& S) {
+    
+    libmesh_assert(_system);
+    libmesh_assert(_discipline);
+    libmesh_assert(_elem_ops);
+    
+    MAST::TransientSolverBase
+    &solver = dynamic_cast<MAST::TransientSolverBase&>(*_elem_ops);
+    MAST::TransientAssemblyElemOperations
+    &ops = solver.get_elem_operation_object();
+    MAST::NonlinearSystem
+    &transient_sys = _system->system();
+    
+    // make sure that the system for which this object was created,
+    // and the system passed through the function call are the same
+    libmesh_assert_equal_to(&S, &transient_sys);
+    
+    RealMatrixX mat;
+    
+    std::vector<libMesh::dof_id_type>
+    dof_indices,
+    col_dofs;
+    const libMesh::DofMap& dof_map = transient_sys.get_dof_map();
+    
+    // stores the localized solution, velocity, acceleration, etc. vectors.
+    // These pointers will have to be deleted
+    std::vector<libMesh::NumericVector<Real>*>
+    local_qtys;
+    
+    // if a solution function is attached, initialize it
+    if (_sol_function)
+        _sol_function->init( X);
+    
+    // ask the solver to localize the relevant solutions
+    solver.build_local_quantities(X, local_qtys);
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    transient_sys.get_mesh().active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    transient_sys.get_mesh().active_local_elements_end();
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        
+        // elements without coupling are skipped
+        const bool
+        provided = ops.elem_coupling_dofs(j, *elem, col_dofs);
+        libmesh_assert(provided);
+        
+        if (!provided || col_dofs.empty())
+            continue;
+        
+        dof_map.dof_indices (elem, dof_indices);
+        
+        MAST::GeomElem geom_elem;
+        solver.set_elem_data(elem->dim(), *elem, geom_elem);
+        geom_elem.init(*elem, *_system);
+        
+        solver.init(geom_elem);
+        
+        mat.setZero(dof_indices.size(), col_dofs.size());
+        
+        solver.set_element_data(dof_indices, local_qtys);
+        
+        // perform the element level calculations
+        ops.elem_coupling_jacobian(j, mat);
+        solver.clear_elem();
+        
+        // constrain the quantities to account for hanging dofs,
+        // Dirichlet constraints, etc.
+        this->_constrain_coupling_matrix(col_dof_map, dof_indices, col_dofs, mat);
+        
+        if (col_dofs.empty())
+            continue;
+        
+        // add to the global matrix
+        DenseRealMatrix m;
+        MAST::copy(m, mat);
+        J.add_matrix(m, dof_indices, col_dofs);
+    }
+    
+    // delete pointers to the local solutions
+    for (unsigned int i=0; i<local_qtys.size(); i++)
+        delete local_qtys[i];
+    
+    // if a solution function is attached, clear it
+    if (_sol_function)
+        _sol_function->clear();
+    
+    J.close();
+}
+
+
+
+void
+MAST::TransientAssembly::
+_constrain_coupling_matrix(const libMesh::DofMap& col_dof_map,
+                           std::vector<libMesh::dof_id_type>& rows,
+                           std::vector<libMesh::dof_id_type>& cols,
+                           RealMatrixX& m) const {
+    
+    libmesh_assert(_system);
+    libmesh_assert_equal_to(m.rows(), rows.size());
+    libmesh_assert_equal_to(m.cols(), cols.size());
+    
+    const libMesh::DofMap& dof_map = _system->system().get_dof_map();
+    
+    // the matrix-free product uses a perturbation of the other system
+    // with its constrained dofs set to zero, so these columns are removed
+    std::vector<libMesh::dof_id_type>
+    c_dofs,
+    r_dofs;
+    std::vector<unsigned int>
+    c_idx;
+    
+    for (unsigned int i=0; i<cols.size(); i++)
+        if (!col_dof_map.is_constrained_dof(cols[i])) {
+            c_dofs.push_back(cols[i]);
+            c_idx.push_back(i);
+        }
+    
+    // the constraints of this system are applied to each column in the
+    // same way as to the element vector of the matrix-free product
+    RealMatrixX
+    cm;
+    RealVectorX
+    vec;
+    DenseRealVector
+    v;
+    
+    for (unsigned int i=0; i<c_idx.size(); i++) {
+        
+        r_dofs = rows;
+        vec    = m.col(c_idx[i]);
+        MAST::copy(v, vec);
+        dof_map.constrain_element_vector(v, r_dofs);
+        MAST::copy(vec, v);
+        
+        if (i == 0)
+            cm.setZero(r_dofs.size(), c_idx.size());
+        
+        cm.col(i) = vec;
+    }
+    
+    if (!c_idx.empty())
+        rows = r_dofs;
+    else
+        cm.setZero(rows.size(), 0);
+    
+    cols = c_dofs;
+    m    = cm;
+}
+
+
+
 bool
 MAST::TransientAssembly::
 sensitivity_assemble (const MAST::FunctionBase& f,
@@ -20,11 +20,16 @@
 #ifndef __mast__transient_assembly__
 #define __mast__transient_assembly__
 
+// C++ includes
+#include <vector>
+#include <set>
+
 // MAST includes
 #include "base/assembly_base.h"
 
 // libMesh includes
 #include "libmesh/nonlinear_implicit_system.h"
+#include "libmesh/dof_map.h"
 
 
 
@@ -102,6 +107,40 @@ namespace MAST {
                                              libMesh::NumericVector<Real>& JdX,
                                              libMesh::NonlinearImplicitSystem& S);
         
+        /*!
+         *    computes the sparsity of the derivative of the residual of this
+         *    system wrt the solution of discipline \p j of a multiphysics
+         *    system, whose dofs are numbered by \p col_dof_map. Upon return,
+         *    \p cols contains the columns of each row owned by this
+         *    processor, in the order of the local rows. The columns are
+         *    obtained from \p elem_coupling_dofs of the element operations,
+         *    with the constraints of both systems applied. Constrained dofs
+         *    of \p j are treated as fixed, which is exact for Dirichlet
+         *    constraints. Returns \p false if the element operations do not
+         *    provide the coupling Jacobian.
+         */
+        virtual bool
+        coupling_sparsity(unsigned int j,
+                          const libMesh::DofMap& col_dof_map,
+                          std::vector<std::set<libMesh::dof_id_type> >& cols);
+        
+        /*!
+         *    adds the derivative of the residual of this system at \p X wrt
+         *    the solution of discipline \p j of a multiphysics system to
+         *    \p J. The entries are computed with \p elem_coupling_jacobian
+         *    of the element operations, and are limited to the sparsity
+         *    from \p coupling_sparsity. As in
+         *    \p linearized_jacobian_solution_product, the user must ensure
+         *    that all multidisciplinary data-structures are initialized
+         *    before calling this method.
+         */
+        virtual void
+        coupling_jacobian(const libMesh::NumericVector<Real>& X,
+                          unsigned int j,
+                          const libMesh::DofMap& col_dof_map,
+                          libMesh::SparseMatrix<Real>& J,
+                          libMesh::NonlinearImplicitSystem& S);
+        
         /**
          * Assembly function.  This function will be called
          * to assemble the sensitivity of system residual prior to a solve and must
@@ -120,6 +159,18 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *    applies the constraints of this system to the rows, and of the
+         *    system with \p col_dof_map to the columns of the element
+         *    coupling matrix \p m. The rows may be expanded for hanging
+         *    dofs, while the columns of constrained dofs are removed.
+         */
+        void
+        _constrain_coupling_matrix(const libMesh::DofMap& col_dof_map,
+                                   std::vector<libMesh::dof_id_type>& rows,
+                                   std::vector<libMesh::dof_id_type>& cols,
+                                   RealMatrixX& m) const;
+        
         /*!
          *    this object, if non-NULL is user-provided to perform actions
          *    after assembly and before returning to the solver
@@ -36,4 +36,24 @@ MAST::TransientAssemblyElemOperations::~TransientAssemblyElemOperations() {
 
 
 
+bool
+MAST::TransientAssemblyElemOperations::
+elem_coupling_dofs(unsigned int j,
+                   const libMesh::Elem& elem,
+                   std::vector<libMesh::dof_id_type>& dofs) const {
+    
+    dofs.clear();
+    return false;
+}
+
+
+
+void
+MAST::TransientAssemblyElemOperations::
+elem_coupling_jacobian(unsigned int j,
+                       RealMatrixX& m) {
+    
+    // should not get here, since the coupling dofs were not provided
+    libmesh_error();
+}
 
@@ -21,6 +21,9 @@
 #ifndef __mast_transient_assembly_elem_operations_h__
 #define __mast_transient_assembly_elem_operations_h__
 
+// C++ includes
+#include <vector>
+
 // MAST includes
 #include "base/assembly_elem_operation.h"
 #include "base/mast_data_types.h"
@@ -100,6 +103,35 @@ namespace MAST {
                                                    RealVectorX& f_m,
                                                    RealVectorX& f_x) = 0;
 
+        
+        /*!
+         *   provides the dofs of discipline \p j of a multiphysics system
+         *   that the residual of \p elem depends on, in \p dofs. This
+         *   defines the sparsity of the coupling block of this discipline
+         *   with \p j, and should be empty for elements that are not
+         *   coupled to \p j. This can be called for ghosted elements that
+         *   are not local to the processor. Returns \p false if the
+         *   object does not provide the coupling Jacobian for \p j,
+         *   which is the default. The coupling is then only applied
+         *   through \p linearized_jacobian_solution_product.
+         */
+        virtual bool
+        elem_coupling_dofs(unsigned int j,
+                           const libMesh::Elem& elem,
+                           std::vector<libMesh::dof_id_type>& dofs) const;
+        
+        
+        /*!
+         *   calculates the derivative of the residual
+         *   \f$ f_m(x,\dot{x}) + f_x(x) \f$ of the current element wrt the
+         *   dofs of discipline \p j provided by \p elem_coupling_dofs, in
+         *   the same order, and returns it in \p m. \p m is sized by the
+         *   caller and set to zero.
+         */
+        virtual void
+        elem_coupling_jacobian(unsigned int j,
+                               RealMatrixX& m);
+
 
     protected:
         
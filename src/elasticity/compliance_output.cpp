@@ -151,11 +151,65 @@ MAST::ComplianceOutput::evaluate_sensitivity(const MAST::FunctionBase &f) {
 
 
 
+void
+MAST::ComplianceOutput::
+partial_sensitivity_for_elem(const std::vector<const MAST::FunctionBase*>& p,
+                             RealVectorX& dq_dp) {
+    
+    // make sure that this has not been initialized ana calculated for all elems
+    libmesh_assert(_physics_elem);
+    
+    dq_dp.setZero(p.size());
+    
+    if (this->if_evaluate_for_element(_physics_elem->elem())) {
+        
+        MAST::StructuralElementBase& e =
+        dynamic_cast<MAST::StructuralElementBase&>(*_physics_elem);
+        
+        RealVectorX
+        vec   = RealVectorX::Zero(e.sol().size());
+        
+        RealMatrixX
+        dummy = RealMatrixX::Zero(vec.size(), vec.size());
+        
+        // with zero solution sensitivity only the load sensitivity
+        // contributes
+        for (unsigned int i=0; i<p.size(); i++) {
+            
+            vec.setZero();
+            e.side_external_residual_sensitivity(*p[i], false,
+                                                 vec,
+                                                 dummy,
+                                                 dummy,
+                                                 _discipline->side_loads());
+            e.volume_external_residual_sensitivity(*p[i], false,
+                                                   vec,
+                                                   dummy,
+                                                   dummy,
+                                                   _discipline->volume_loads());
+            
+            dq_dp(i) = -vec.dot(e.sol());
+        }
+    }
+}
+
+
+
 void
 MAST::ComplianceOutput::
 evaluate_topology_sensitivity(const MAST::FunctionBase &f,
                               const MAST::FieldFunction<RealVectorX> &vel) {
     
+    _dcompliance_dp += this->topology_sensitivity_for_elem(f, vel);
+}
+
+
+
+Real
+MAST::ComplianceOutput::
+topology_sensitivity_for_elem(const MAST::FunctionBase &f,
+                              const MAST::FieldFunction<RealVectorX> &vel) {
+    
     // the primal data should have been calculated
     libmesh_assert(_physics_elem);
     libmesh_assert(f.is_topology_parameter());
@@ -188,8 +242,10 @@ evaluate_topology_sensitivity(const MAST::FunctionBase &f,
                                                      dummy);
         
         // compute the contribution of this element to compliance
-        _dcompliance_dp -= vec.dot(e.sol());
+        return -vec.dot(e.sol());
     }
+    else
+        return 0.;
 }
 
 
@@ -129,6 +129,28 @@ namespace MAST {
         evaluate_topology_sensitivity(const MAST::FunctionBase& f,
                                       const MAST::FieldFunction<RealVectorX>& vel);
         
+        /*!
+         *    @returns the contribution of this element to the topology
+         *    sensitivity, without accumulating it in this object.
+         */
+        virtual Real
+        topology_sensitivity_for_elem(const MAST::FunctionBase& f,
+                                      const MAST::FieldFunction<RealVectorX>& vel);
+        
+        /*!
+         *    the compliance is a sum of element contributions.
+         */
+        virtual bool if_additive_over_elems() const { return true; }
+        
+        /*!
+         *    computes the partial derivative of the compliance of this
+         *    element with respect to all parameters in \p p, from the
+         *    sensitivity of the external load.
+         */
+        virtual void
+        partial_sensitivity_for_elem(const std::vector<const MAST::FunctionBase*>& p,
+                                     RealVectorX& dq_dp);
+        
         /*!
          *   should not get called for this output. Use output_total() instead.
          */
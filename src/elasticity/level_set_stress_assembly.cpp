@@ -80,6 +80,15 @@ MAST::LevelSetStressAssembly::clear() {
 
 
 
+MAST::LevelSetIntersection&
+MAST::LevelSetStressAssembly::get_intersection() {
+    
+    libmesh_assert(_intersection);
+    return *_intersection;
+}
+
+
+
 extern void
 get_max_stress_strain_values(const std::vector<MAST::StressStrainOutputBase::Data*>& data,
                              RealVectorX&           max_strain,
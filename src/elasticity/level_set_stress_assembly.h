@@ -66,6 +66,12 @@ namespace MAST {
         clear();
 
         
+        /*!
+         *  @returns a reference to the level set intersection object
+         */
+        MAST::LevelSetIntersection& get_intersection();
+
+        
         /*!
          *   updates the stresses and strains for the specified solution
          *   vector \p X. Only the maximum values out of each element are
@@ -27,6 +27,7 @@
 #include "mesh/fe_base.h"
 #include "mesh/geom_elem.h"
 #include "base/assembly_base.h"
+#include "base/elem_workspace.h"
 #include "base/field_function_base.h"
 
 
@@ -66,7 +67,10 @@ initialize_bending_strain_operator_for_z(const MAST::FEBase& fe,
     
     const unsigned int n_phi = (unsigned int)phi.size();
     
-    RealVectorX phi_vec = RealVectorX::Zero(n_phi);
+    MAST::ElemWorkspace::Frame
+    ws(_structural_elem.workspace());
+    
+    RealVectorX& phi_vec = ws.vector(n_phi);
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
         phi_vec(i_nd) = dphi[i_nd][qp](0);  // dphi/dx
     
@@ -97,36 +101,39 @@ calculate_transverse_shear_residual(bool request_jacobian,
     
     const MAST::ElementPropertyCardBase& property = _structural_elem.elem_property();
     
-    // make an fe and quadrature object for the requested order for integrating
-    // transverse shear
+    // borrow an fe and quadrature object for the requested order for
+    // integrating transverse shear from the workspace of the element
+    MAST::ElemWorkspace::Frame
+    ws(_structural_elem.workspace());
     
-    std::unique_ptr<MAST::FEBase>
-    fe(_elem.init_fe(true, false, -_shear_quadrature_reduction));
+    const MAST::FEBase&
+    fe = _elem.init_fe(ws, true, false, -_shear_quadrature_reduction);
 
-    const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe->get_dphi();
-    const std::vector<std::vector<Real> >& phi = fe->get_phi();
-    const std::vector<Real>& JxW = fe->get_JxW();
-    const std::vector<libMesh::Point>& xyz = fe->get_xyz();
+    const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
+    const std::vector<std::vector<Real> >& phi = fe.get_phi();
+    const std::vector<Real>& JxW = fe.get_JxW();
+    const std::vector<libMesh::Point>& xyz = fe.get_xyz();
     
     const unsigned int
     n_phi = (unsigned int)phi.size(),
     n2    = 6*n_phi;
     
     RealVectorX
-    phi_vec   = RealVectorX::Zero(n_phi),
-    vec_n2    = RealVectorX::Zero(n2),
-    vec_2     = RealVectorX::Zero(2);
+    &phi_vec   = ws.vector(n_phi),
+    &vec_n2    = ws.vector(n2),
+    &vec_2     = ws.vector(2);
     RealMatrixX
-    material_trans_shear_mat,
-    mat_n2n2    = RealMatrixX::Zero(n2,n2),
-    mat_2n2     = RealMatrixX::Zero(2,n2);
+    &material_trans_shear_mat = ws.matrix(2,2),
+    &mat_n2n2    = ws.matrix(n2,n2),
+    &mat_2n2     = ws.matrix(2,n2);
     
     
-    FEMOperatorMatrix Bmat_trans;
-    Bmat_trans.reinit(2, 6, n_phi); // only two shear stresses
+    FEMOperatorMatrix
+    &Bmat_trans = ws.operator_matrix(2, 6, n_phi); // only two shear stresses
     
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff = property.transverse_shear_stiffness_matrix(_structural_elem);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff = &_structural_elem.workspace().property_matrix
+    (property, MAST::TRANSVERSE_SHEAR_STIFFNESS_MATRIX, _structural_elem);
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
@@ -166,36 +173,39 @@ calculate_transverse_shear_residual_sensitivity(const MAST::FunctionBase& p,
     
     const MAST::ElementPropertyCardBase& property = _structural_elem.elem_property();
     
-    // make an fe and quadrature object for the requested order for integrating
-    // transverse shear
+    // borrow an fe and quadrature object for the requested order for
+    // integrating transverse shear from the workspace of the element
+    MAST::ElemWorkspace::Frame
+    ws(_structural_elem.workspace());
     
-    std::unique_ptr<MAST::FEBase>
-    fe(_elem.init_fe(true, false, -_shear_quadrature_reduction));
+    const MAST::FEBase&
+    fe = _elem.init_fe(ws, true, false, -_shear_quadrature_reduction);
     
-    const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe->get_dphi();
-    const std::vector<std::vector<Real> >& phi = fe->get_phi();
-    const std::vector<Real>& JxW = fe->get_JxW();
-    const std::vector<libMesh::Point>& xyz = fe->get_xyz();
+    const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
+    const std::vector<std::vector<Real> >& phi = fe.get_phi();
+    const std::vector<Real>& JxW = fe.get_JxW();
+    const std::vector<libMesh::Point>& xyz = fe.get_xyz();
     
     const unsigned int
     n_phi = (unsigned int)phi.size(),
     n2    = 6*n_phi;
     
     RealVectorX
-    phi_vec   = RealVectorX::Zero(n_phi),
-    vec_n2    = RealVectorX::Zero(n2),
-    vec_2     = RealVectorX::Zero(2);
+    &phi_vec   = ws.vector(n_phi),
+    &vec_n2    = ws.vector(n2),
+    &vec_2     = ws.vector(2);
     RealMatrixX
-    material_trans_shear_mat,
-    mat_n2n2    = RealMatrixX::Zero(n2,n2),
-    mat_2n2     = RealMatrixX::Zero(2,n2);
+    &material_trans_shear_mat = ws.matrix(2,2),
+    &mat_n2n2    = ws.matrix(n2,n2),
+    &mat_2n2     = ws.matrix(2,n2);
 
     
-    FEMOperatorMatrix Bmat_trans;
-    Bmat_trans.reinit(2, 6, n_phi); // only two shear stresses
+    FEMOperatorMatrix
+    &Bmat_trans = ws.operator_matrix(2, 6, n_phi); // only two shear stresses
     
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff = property.transverse_shear_stiffness_matrix(_structural_elem);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff = &_structural_elem.workspace().property_matrix
+    (property, MAST::TRANSVERSE_SHEAR_STIFFNESS_MATRIX, _structural_elem);
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
@@ -267,8 +277,9 @@ calculate_transverse_shear_residual_boundary_velocity
     FEMOperatorMatrix Bmat_trans;
     Bmat_trans.reinit(2, 6, n_phi); // only two shear stresses
     
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff = property.transverse_shear_stiffness_matrix(_structural_elem);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff = &_structural_elem.workspace().property_matrix
+    (property, MAST::TRANSVERSE_SHEAR_STIFFNESS_MATRIX, _structural_elem);
     
     
     Real
@@ -277,7 +288,7 @@ calculate_transverse_shear_residual_boundary_velocity
     // modify the JxW_Vn by multiplying the normal velocity to it
     for (unsigned int qp=0; qp<JxW_Vn.size(); qp++) {
         
-        vel_f(xyz[qp], _structural_elem.system().time, vel);
+        _structural_elem.boundary_velocity(vel_f, *fe, qp, vel);
         vn = 0.;
         for (unsigned int i=0; i<dim; i++)
             vn += vel(i)*face_normals[qp](i);
@@ -326,6 +337,9 @@ _transverse_shear_operations(const std::vector<std::vector<Real> >& phi,
                              RealVectorX&           local_f,
                              RealMatrixX&           local_jac) {
     
+    Eigen::Matrix<Real, 2, 1>
+    shear_stress;
+    
     // initialize the strain operator
     for ( unsigned int i_nd=0; i_nd<phi.size(); i_nd++ )
         phi_vec(i_nd) = dphi[i_nd][qp](0);  // dphi/dx
@@ -347,7 +361,8 @@ _transverse_shear_operations(const std::vector<std::vector<Real> >& phi,
     
     // now add the transverse shear component
     Bmat.vector_mult(vec_2, _structural_elem.local_solution());
-    vec_2 = material * vec_2;
+    shear_stress.noalias() = material * vec_2;
+    vec_2 = shear_stress;
     Bmat.vector_mult_transpose(vec_n2, vec_2);
     local_f += JxW[qp] * vec_n2;
     
@@ -30,8 +30,10 @@
 #include "base/parameter.h"
 #include "base/constant_field_function.h"
 #include "base/assembly_base.h"
+#include "base/elem_workspace.h"
 #include "mesh/fe_base.h"
 #include "mesh/geom_elem.h"
+#include "utility/perf_log.h"
 
 
 MAST::StructuralElement1D::StructuralElement1D(MAST::SystemInitialization& sys,
@@ -540,6 +542,8 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
                                               RealVectorX& f,
                                               RealMatrixX& jac)
 {
+    MAST_PERF_SCOPE("StructuralElement1D::internal_residual");
+    
     std::unique_ptr<MAST::FEBase>   fe(_elem.init_fe(true,
                                                      false,
                                                      _property.extra_quadrature_order(_elem)));
@@ -603,19 +607,35 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
                                                    fe->get_qpoints()).release());
 
     
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff_A  = _property.stiffness_A_matrix(*this),
-    mat_stiff_B  = _property.stiffness_B_matrix(*this),
-    mat_stiff_D  = _property.stiffness_D_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff_A  = &_workspace.property_matrix(_property, MAST::STIFFNESS_A_MATRIX, *this),
+    *mat_stiff_B  = &_workspace.property_matrix(_property, MAST::STIFFNESS_B_MATRIX, *this),
+    *mat_stiff_D  = &_workspace.property_matrix(_property, MAST::STIFFNESS_D_MATRIX, *this);
+    
+    // the section stiffness is evaluated at all quadrature points at once
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    std::vector<RealMatrixX>
+    &material_A_mats = ws.matrix_array((unsigned int)JxW.size()),
+    &material_B_mats = ws.matrix_array((unsigned int)JxW.size()),
+    &material_D_mats = ws.matrix_array((unsigned int)JxW.size());
+    
+    mat_stiff_A->evaluate(xyz, _time, material_A_mats);
+    
+    if (bend.get()) {
+        mat_stiff_B->evaluate(xyz, _time, material_B_mats);
+        mat_stiff_D->evaluate(xyz, _time, material_D_mats);
+    }
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
         // get the material matrix
-        (*mat_stiff_A)(xyz[qp], _time, material_A_mat);
+        material_A_mat = material_A_mats[qp];
         
         if (bend.get()) {
-            (*mat_stiff_B)(xyz[qp], _time, material_B_mat);
-            (*mat_stiff_D)(xyz[qp], _time, material_D_mat);
+            material_B_mat = material_B_mats[qp];
+            material_D_mat = material_D_mats[qp];
         }
         
         // now calculte the quantity for these matrices
@@ -665,6 +685,8 @@ MAST::StructuralElement1D::internal_residual_sensitivity (const MAST::FunctionBa
                                                           RealVectorX& f,
                                                           RealMatrixX& jac)
 {
+    MAST_PERF_SCOPE("StructuralElement1D::internal_residual_sensitivity");
+    
     // this should be true if the function is called
     libmesh_assert(!p.is_shape_parameter()); // this is not implemented for now
     
@@ -741,10 +763,10 @@ MAST::StructuralElement1D::internal_residual_sensitivity (const MAST::FunctionBa
                                                    *this,
                                                    fe->get_qpoints()).release());
 
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff_A = _property.stiffness_A_matrix(*this),
-    mat_stiff_B = _property.stiffness_B_matrix(*this),
-    mat_stiff_D = _property.stiffness_D_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff_A = &_workspace.property_matrix(_property, MAST::STIFFNESS_A_MATRIX, *this),
+    *mat_stiff_B = &_workspace.property_matrix(_property, MAST::STIFFNESS_B_MATRIX, *this),
+    *mat_stiff_D = &_workspace.property_matrix(_property, MAST::STIFFNESS_D_MATRIX, *this);
     
     // first calculate the sensitivity due to the parameter
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
@@ -864,10 +886,10 @@ internal_residual_jac_dot_state_sensitivity (RealMatrixX& jac) {
     if (!if_vk)
         return false;
     
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff_A  = _property.stiffness_A_matrix(*this),
-    mat_stiff_B  = _property.stiffness_B_matrix(*this),
-    mat_stiff_D  = _property.stiffness_D_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff_A  = &_workspace.property_matrix(_property, MAST::STIFFNESS_A_MATRIX, *this),
+    *mat_stiff_B  = &_workspace.property_matrix(_property, MAST::STIFFNESS_B_MATRIX, *this),
+    *mat_stiff_D  = &_workspace.property_matrix(_property, MAST::STIFFNESS_D_MATRIX, *this);
     
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
@@ -1920,9 +1942,9 @@ MAST::StructuralElement1D::thermal_residual (bool request_jacobian,
                                                    *this,
                                                    fe->get_qpoints()).release());
 
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    expansion_A = _property.thermal_expansion_A_matrix(*this),
-    expansion_B = _property.thermal_expansion_B_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *expansion_A = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_A_MATRIX, *this),
+    *expansion_B = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_B_MATRIX, *this);
     
     // temperature function
     const MAST::FieldFunction<Real>
@@ -2089,9 +2111,9 @@ MAST::StructuralElement1D::thermal_residual_sensitivity (const MAST::FunctionBas
                                                    *this,
                                                    fe->get_qpoints()).release());
 
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    expansion_A = _property.thermal_expansion_A_matrix(*this),
-    expansion_B = _property.thermal_expansion_B_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *expansion_A = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_A_MATRIX, *this),
+    *expansion_B = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_B_MATRIX, *this);
     
     // temperature function
     const MAST::FieldFunction<Real>
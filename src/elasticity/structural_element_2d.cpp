@@ -32,6 +32,8 @@
 #include "base/parameter.h"
 #include "base/constant_field_function.h"
 #include "base/assembly_base.h"
+#include "base/elem_workspace.h"
+#include "utility/perf_log.h"
 
 
 MAST::StructuralElement2D::
@@ -39,8 +41,18 @@ StructuralElement2D(MAST::SystemInitialization& sys,
                     MAST::AssemblyBase& assembly,
                     const MAST::GeomElem& elem,
                     const MAST::ElementPropertyCardBase& p):
-MAST::BendingStructuralElem(sys, assembly, elem, p) {
+MAST::BendingStructuralElem(sys, assembly, elem, p),
+use_fixed_size_kernels (true) {
 
+    // the Mindlin operator is independent of the quadrature points, so it
+    // is created here once for all element routines
+    MAST::BendingOperatorType
+    bending_model = _property.bending_model(_elem);
+    
+    if (bending_model == MAST::MINDLIN)
+        _bending_op.reset(MAST::build_bending_operator_2D(bending_model,
+                                                          *this,
+                                                          _bending_op_pts).release());
 }
 
 
@@ -51,6 +63,31 @@ MAST::StructuralElement2D::~StructuralElement2D() {
 
 
 
+MAST::BendingOperator2D*
+MAST::StructuralElement2D::_bending_operator(const std::vector<libMesh::Point>& pts) {
+    
+    MAST::BendingOperatorType
+    bending_model = _property.bending_model(_elem);
+    
+    if (bending_model == MAST::NO_BENDING)
+        return nullptr;
+    
+    if (bending_model != MAST::MINDLIN &&
+        (!_bending_op.get() || _bending_op_pts != pts)) {
+        
+        _bending_op_pts = pts;
+        _bending_op.reset(MAST::build_bending_operator_2D(bending_model,
+                                                          *this,
+                                                          _bending_op_pts).release());
+    }
+    
+    libmesh_assert(_bending_op.get());
+    
+    return _bending_op.get();
+}
+
+
+
 
 void
 MAST::StructuralElement2D::
@@ -74,7 +111,10 @@ initialize_von_karman_strain_operator(const unsigned int qp,
     vk_strain.setZero();
     vk_dwdxi_mat.setZero();
     
-    RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    RealVectorX& phi_vec  = ws.vector(n_phi);
     
     dw = 0.;
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ ) {
@@ -118,7 +158,10 @@ initialize_von_karman_strain_operator_sensitivity(const unsigned int qp,
     Real dw=0.;
     vk_dwdxi_mat_sens.setZero();
     
-    RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    RealVectorX& phi_vec  = ws.vector(n_phi);
     
     dw = 0.;
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ ) {
@@ -161,7 +204,11 @@ initialize_green_lagrange_strain_operator(const unsigned int qp,
     dphi = fe.get_dphi();
     
     unsigned int n_phi = (unsigned int)dphi.size();
-    RealVectorX phi  = RealVectorX::Zero(n_phi);
+    
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    RealVectorX& phi  = ws.vector(n_phi);
     
     // make sure all matrices are the right size
     libmesh_assert_equal_to(epsilon.size(), 3);
@@ -215,21 +262,21 @@ initialize_green_lagrange_strain_operator(const unsigned int qp,
         
         // calculate the displacement gradient to create the
         RealVectorX
-        ddisp_dx = RealVectorX::Zero(2),
-        ddisp_dy = RealVectorX::Zero(2);
+        &ddisp_dx = ws.vector(2),
+        &ddisp_dy = ws.vector(2);
         
         Bmat_nl_x.vector_mult(ddisp_dx, local_disp);  // {du/dx, dv/dx, dw/dx}
         Bmat_nl_y.vector_mult(ddisp_dy, local_disp);  // {du/dy, dv/dy, dw/dy}
         
         // prepare the deformation gradient matrix
-        RealMatrixX
-        F = RealMatrixX::Zero(2,2),
-        E = RealMatrixX::Zero(2,2);
+        Eigen::Matrix<Real, 2, 2>
+        F,
+        E;
         F.col(0) = ddisp_dx;
         F.col(1) = ddisp_dy;
         
         // this calculates the Green-Lagrange strain in the reference config
-        E = 0.5*(F + F.transpose() + F.transpose() * F);
+        E.noalias() = 0.5*(F + F.transpose() + F.transpose() * F);
         
         // now, add this to the strain vector
         epsilon(0) = E(0,0);
@@ -254,52 +301,35 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                                             const MAST::FunctionBase* p,
                                             MAST::StressStrainOutputBase& output) {
     
-    std::unique_ptr<MAST::FEBase>   fe(_elem.init_fe(true, false));
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    const MAST::FEBase& fe = _elem.init_fe(ws, true, false);
     
-    const unsigned int
-    qp_loc_fe_size = (unsigned int)fe->get_qpoints().size(),
-    n_added_qp     = 2;
-
-    std::vector<libMesh::Point>
-    qp_loc_fe = fe->get_qpoints(),
-    qp_loc(qp_loc_fe.size()*n_added_qp);
-    std::vector<Real> JxW                     = fe->get_JxW();
-    const std::vector<libMesh::Point>& xyz    = fe->get_xyz();
-
     // we will evaluate the stress at upper and lower layers of element,
-    // so we will add two new points for each qp_loc.
+    // so we will add two new points for each qp_loc. The JxW of each
+    // point is scaled by (1/n_added_qp) since we are adding extra points
+    // and the total volume should add up to be the same.
     // TODO: this will need to be moved to element property section card
     // to handle composite elements at a later date
-    for (unsigned int i=0; i<qp_loc_fe.size(); i++) {
-        
-        qp_loc[i*2]      = qp_loc_fe[i];
-        qp_loc[i*2](2)   = +1.; // upper skin
-        
-        qp_loc[i*2+1]    = qp_loc_fe[i];
-        qp_loc[i*2+1](2) = -1.; // lower skin
-
-        ///////////////////////////////////////////////////////////////////////
-        //   scale the JxW of each QP by (1/n_added_qp) since we are
-        //   adding extra points and the total volume should add up to be
-        //   the same.
-        ///////////////////////////////////////////////////////////////////////
-        JxW[i] /= (1.*n_added_qp);
-    }
+    const unsigned int
+    qp_loc_fe_size = (unsigned int)fe.get_qpoints().size(),
+    n_added_qp     = 2;
 
+    const std::vector<libMesh::Point>& qp_loc_fe = fe.get_qpoints();
+    const std::vector<Real>& JxW                 = fe.get_JxW();
+    const std::vector<libMesh::Point>& xyz       = fe.get_xyz();
     
+    libMesh::Point
+    qp_loc;
 
-    MAST::BendingOperatorType bending_model =
-    _property.bending_model(_elem);
-    
-    std::unique_ptr<MAST::BendingOperator2D>
-    bend(MAST::build_bending_operator_2D(bending_model,
-                                         *this,
-                                         qp_loc_fe).release());
+    MAST::BendingOperator2D*
+    bend = _bending_operator(qp_loc_fe);
     
     // now that the FE object has been initialized, evaluate the stress values
     
     const unsigned int
-    n_phi    = (unsigned int)fe->n_shape_functions(),
+    n_phi    = (unsigned int)fe.n_shape_functions(),
     n1       = this->n_direct_strain_components(),
     n2       = 6*n_phi,
     n3       = this->n_von_karman_strain_components();
@@ -315,44 +345,37 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
     dalpha=  0.;
     
     RealMatrixX
-    material_mat,
-    vk_dwdxi_mat = RealMatrixX::Zero(n1,n3),
-    dstrain_dX   = RealMatrixX::Zero(n1,n2),
-    dstress_dX   = RealMatrixX::Zero(n1,n2),
-    mat_n1n2     = RealMatrixX::Zero(n1,n2),
-    eye          = RealMatrixX::Identity(n1, n1),
-    mat_x        = RealMatrixX::Zero(3,2),
-    mat_y        = RealMatrixX::Zero(3,2),
-    dstrain_dX_3D= RealMatrixX::Zero(6,n2),
-    dstress_dX_3D= RealMatrixX::Zero(6,n2);
+    &material_mat = ws.matrix(n1,n1),
+    &vk_dwdxi_mat = ws.matrix(n1,n3),
+    &dstrain_dX   = ws.matrix(n1,n2),
+    &dstress_dX   = ws.matrix(n1,n2),
+    &mat_n1n2     = ws.matrix(n1,n2),
+    &eye          = ws.matrix(n1,n1),
+    &mat_x        = ws.matrix(3,2),
+    &mat_y        = ws.matrix(3,2),
+    &dstrain_dX_3D= ws.matrix(6,n2),
+    &dstress_dX_3D= ws.matrix(6,n2);
     
     RealVectorX
-    strain      = RealVectorX::Zero(n1),
-    stress      = RealVectorX::Zero(n1),
-    strain_vk   = RealVectorX::Zero(n1),
-    strain_bend = RealVectorX::Zero(n1),
-    strain_3D   = RealVectorX::Zero(6),
-    stress_3D   = RealVectorX::Zero(6),
-    dstrain_dp  = RealVectorX::Zero(n1),
-    dstress_dp  = RealVectorX::Zero(n1);
+    &strain      = ws.vector(n1),
+    &stress      = ws.vector(n1),
+    &strain_vk   = ws.vector(n1),
+    &strain_bend = ws.vector(n1),
+    &strain_3D   = ws.vector(6),
+    &stress_3D   = ws.vector(6),
+    &dstrain_dp  = ws.vector(n1),
+    &dstress_dp  = ws.vector(n1);
     
+    eye.setIdentity();
     
     FEMOperatorMatrix
-    Bmat_lin,
-    Bmat_nl_x,
-    Bmat_nl_y,
-    Bmat_nl_u,
-    Bmat_nl_v,
-    Bmat_bend,
-    Bmat_vk;
-    
-    Bmat_lin.reinit (n1, _system.n_vars(), n_phi); // three stress-strain components
-    Bmat_nl_x.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_y.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_u.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_v.reinit(2, _system.n_vars(), n_phi);
-    Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
-    Bmat_vk.reinit  (n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
+    &Bmat_lin   = ws.operator_matrix(n1, _system.n_vars(), n_phi), // three stress-strain components
+    &Bmat_nl_x  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_y  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_u  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_v  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_bend  = ws.operator_matrix(n1, _system.n_vars(), n_phi),
+    &Bmat_vk    = ws.operator_matrix(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
 
     // TODO: remove this const-cast, which may need change in API of
     // material card
@@ -404,11 +427,15 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
         {
             qp = qp_loc_index*n_added_qp + section_qp_index;
             
+            // location of the point in the section: upper and lower skin
+            qp_loc    = qp_loc_fe[qp_loc_index];
+            qp_loc(2) = (section_qp_index == 0)? +1.: -1.;
+            
             // get the material matrix
             mat_stiff(xyz[qp_loc_index], _time, material_mat);
             
             this->initialize_green_lagrange_strain_operator(qp_loc_index,
-                                                            *fe,
+                                                            fe,
                                                             _local_sol,
                                                             strain,
                                                             mat_x,
@@ -435,7 +462,7 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                 if (if_vk) {  // get the vonKarman strain operator if needed
                     
                     this->initialize_von_karman_strain_operator(qp_loc_index,
-                                                                *fe,
+                                                                fe,
                                                                 strain_vk,
                                                                 vk_dwdxi_mat,
                                                                 Bmat_vk);
@@ -448,9 +475,9 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                 h_off(xyz[qp_loc_index], _time, z_off);
                 // TODO: this assumes isotropic section. Multilayered sections need
                 // special considerations
-                bend->initialize_bending_strain_operator_for_z(*fe,
+                bend->initialize_bending_strain_operator_for_z(fe,
                                                                qp_loc_index,
-                                                               qp_loc[qp](2) * z/2.+z_off,
+                                                               qp_loc(2) * z/2.+z_off,
                                                                Bmat_bend);
                 Bmat_bend.vector_mult(strain_bend, _local_sol);
                 
@@ -460,7 +487,7 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
             }
             
             // note that this assumes linear material laws
-            stress = material_mat * strain;
+            stress.noalias() = material_mat * strain;
             
             
             // now set the data for the 3D stress-strain vector
@@ -486,11 +513,11 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
             if (!request_derivative && !p)
                 data = &(stress_output.add_stress_strain_at_qp_location(_elem,
                                                                         qp,
-                                                                        qp_loc[qp],
+                                                                        qp_loc,
                                                                         xyz[qp_loc_index],
                                                                         stress_3D,
                                                                         strain_3D,
-                                                                        JxW[qp_loc_index]));
+                                                                        JxW[qp_loc_index]/(1.*n_added_qp)));
             else
                 data = &(stress_output.get_stress_strain_data_for_elem_at_qp(_elem, qp));
             
@@ -523,7 +550,7 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                 }
                 
                 // note: this assumes linear material laws
-                dstress_dX  = material_mat * dstrain_dX;
+                dstress_dX.noalias()  = material_mat * dstrain_dX;
                 
                 // copy to the 3D structure
                 dstress_dX_3D.row(0) = dstress_dX.row(0);  // sigma-xx
@@ -551,7 +578,7 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                     // presently, only material parameter is included
                     
                     
-                    dstrain_dp  =  RealVectorX::Zero(n1);
+                    dstrain_dp.setZero();
                     
                     // if thermal load was specified, then set the thermal strain
                     // component of the total strain
@@ -574,9 +601,9 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                                          xyz[qp_loc_index], _time, z_off);
                         // TODO: this assumes isotropic section. Multilayered sections need
                         // special considerations
-                        bend->initialize_bending_strain_operator_for_z(*fe,
+                        bend->initialize_bending_strain_operator_for_z(fe,
                                                                        qp_loc_index,
-                                                                       qp_loc[qp](2) * z/2.+z_off,
+                                                                       qp_loc(2) * z/2.+z_off,
                                                                        Bmat_bend);
                         Bmat_bend.vector_mult(strain_bend, _local_sol);
                         
@@ -587,7 +614,7 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                     
                     
                     // now use this to calculate the stress sensitivity.
-                    dstress_dp  =  material_mat * dstrain_dp;
+                    dstress_dp.noalias()  =  material_mat * dstrain_dp;
                     
                     // get the material matrix sensitivity
                     mat_stiff.derivative(*p,
@@ -600,14 +627,14 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                     // TODO: shape sensitivity of strain operator
                     
                     // now use this to calculate the stress sensitivity.
-                    dstress_dp +=  material_mat * strain;
+                    dstress_dp.noalias() +=  material_mat * strain;
                     
                     //
                     // use the derivative data to evaluate the second term in the
                     // sensitivity
                     //
-                    dstress_dp  += dstress_dX * _local_sol_sens;
-                    dstrain_dp  += dstrain_dX * _local_sol_sens;
+                    dstress_dp.noalias()  += dstress_dX * _local_sol_sens;
+                    dstrain_dp.noalias()  += dstrain_dX * _local_sol_sens;
                     
                     // copy the 3D object
                     stress_3D(0) = dstress_dp(0);  // sigma-xx
@@ -627,7 +654,7 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
     
     // make sure that the number of data points for this element is
     // the same as the number of requested points
-    libmesh_assert(qp_loc.size() ==
+    libmesh_assert(qp_loc_fe_size*n_added_qp ==
                    stress_output.n_stress_strain_data_for_elem(_elem));
     
     // if either derivative or sensitivity was requested, it was provided
@@ -713,7 +740,7 @@ calculate_stress_boundary_velocity(const MAST::FunctionBase& p,
     // modify the JxW_Vn by multiplying the normal velocity to it
     for (unsigned int qp=0; qp<JxW_Vn.size(); qp++) {
         
-        vel_f(xyz[qp], _time, vel);
+        this->boundary_velocity(vel_f, *fe, qp, vel);
         vn = 0.;
         for (unsigned int i=0; i<dim; i++)
             vn += vel(i)*face_normals[qp](i);
@@ -1003,131 +1030,157 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
                                               RealVectorX& f,
                                               RealMatrixX& jac)
 {
-    std::unique_ptr<MAST::FEBase>   fe(_elem.init_fe(true,
-                                                     false,
-                                                     _property.extra_quadrature_order(_elem)));
+    MAST_PERF_SCOPE("StructuralElement2D::internal_residual");
+    MAST_PERF_STOPWATCH(sw);
+    
+    // the finite element and scratch storage are borrowed from the
+    // workspace of this thread and returned when the frame goes out of scope
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    MAST_PERF_PHASE(sw, "StructuralElement2D::internal_residual/init_fe");
+    const MAST::FEBase& fe = _elem.init_fe(ws,
+                                           true,
+                                           false,
+                                           _property.extra_quadrature_order(_elem));
 
-    const std::vector<Real>& JxW           = fe->get_JxW();
-    const std::vector<libMesh::Point>& xyz = fe->get_xyz();
+    const std::vector<Real>& JxW           = fe.get_JxW();
+    const std::vector<libMesh::Point>& xyz = fe.get_xyz();
     
     const unsigned int
-    n_phi    = (unsigned int)fe->get_phi().size(),
+    n_phi    = (unsigned int)fe.get_phi().size(),
     n1       = this->n_direct_strain_components(),
     n2       =6*n_phi,
     n3       = this->n_von_karman_strain_components();
     
     RealMatrixX
-    material_A_mat,
-    material_B_mat,
-    material_D_mat,
-    mat1_n1n2     = RealMatrixX::Zero(n1,n2),
-    mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
-    mat4_n3n2     = RealMatrixX::Zero(n3,n2),
-    mat5_3n2      = RealMatrixX::Zero(3,n2),
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    stress        = RealMatrixX::Zero(2,2),
-    mat_x         = RealMatrixX::Zero(3,2),
-    mat_y         = RealMatrixX::Zero(3,2),
-    local_jac     = RealMatrixX::Zero(n2,n2);
-
+    &mat1_n1n2      = ws.matrix(n1,n2),
+    &mat2_n2n2      = ws.matrix(n2,n2),
+    &mat3           = ws.matrix(n1,n2),
+    &mat4_n3n2      = ws.matrix(n3,n2),
+    &mat5_2n2       = ws.matrix(2,n2),
+    &vk_dwdxi_mat   = ws.matrix(n1,n3),
+    &stress         = ws.matrix(2,2),
+    &mat_x          = ws.matrix(3,2),
+    &mat_y          = ws.matrix(3,2),
+    &local_jac      = ws.matrix(n2,n2);
+    
     RealVectorX
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n1    = RealVectorX::Zero(n1),
-    vec3_n2    = RealVectorX::Zero(n2),
-    vec4_n3    = RealVectorX::Zero(n3),
-    vec5_n3    = RealVectorX::Zero(n3),
-    vec6_n2    = RealVectorX::Zero(n2),
-    strain     = RealVectorX::Zero(3),
-    local_f    = RealVectorX::Zero(n2);
+    &vec1_n1    = ws.vector(n1),
+    &vec2_n1    = ws.vector(n1),
+    &vec3_n2    = ws.vector(n2),
+    &vec4_n3    = ws.vector(n3),
+    &vec5_n3    = ws.vector(n3),
+    &vec6_n2    = ws.vector(n2),
+    &strain     = ws.vector(3),
+    &local_f    = ws.vector(n2);
     
     FEMOperatorMatrix
-    Bmat_lin,
-    Bmat_nl_x,
-    Bmat_nl_y,
-    Bmat_nl_u,
-    Bmat_nl_v,
-    Bmat_bend,
-    Bmat_vk;
-    
-    Bmat_lin.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
-    Bmat_nl_x.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_y.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_u.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_v.reinit(2, _system.n_vars(), n_phi);
-    Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
-    Bmat_vk.reinit(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
+    &Bmat_lin   = ws.operator_matrix(n1, _system.n_vars(), n_phi), // three stress-strain components
+    &Bmat_nl_x  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_y  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_u  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_v  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_bend  = ws.operator_matrix(n1, _system.n_vars(), n_phi),
+    &Bmat_vk    = ws.operator_matrix(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
     
     bool if_vk = (_property.strain_type() == MAST::NONLINEAR_STRAIN);
 
-    MAST::BendingOperatorType
-    bending_model = _property.bending_model(_elem);
+    MAST::BendingOperator2D*
+    bend = _bending_operator(fe.get_qpoints());
+
+    MAST_PERF_PHASE(sw, "StructuralElement2D::internal_residual/property_evaluation");
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff_A  = &_workspace.property_matrix(_property, MAST::STIFFNESS_A_MATRIX, *this),
+    *mat_stiff_B  = &_workspace.property_matrix(_property, MAST::STIFFNESS_B_MATRIX, *this),
+    *mat_stiff_D  = &_workspace.property_matrix(_property, MAST::STIFFNESS_D_MATRIX, *this);
     
-    std::unique_ptr<MAST::BendingOperator2D> bend;
+    // the section stiffness is evaluated at all quadrature points at once
+    std::vector<RealMatrixX>
+    &material_A_mats = ws.matrix_array((unsigned int)JxW.size()),
+    &material_B_mats = ws.matrix_array((unsigned int)JxW.size()),
+    &material_D_mats = ws.matrix_array((unsigned int)JxW.size());
     
-    if (bending_model != MAST::NO_BENDING)
-        bend.reset(MAST::build_bending_operator_2D(bending_model,
-                                                   *this,
-                                                   fe->get_qpoints()).release());
-
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff_A  = _property.stiffness_A_matrix(*this),
-    mat_stiff_B  = _property.stiffness_B_matrix(*this),
-    mat_stiff_D  = _property.stiffness_D_matrix(*this);
+    mat_stiff_A->evaluate(xyz, _time, material_A_mats);
     
-    for (unsigned int qp=0; qp<JxW.size(); qp++) {
-        
-        // get the material matrix
-        (*mat_stiff_A)(xyz[qp], _time, material_A_mat);
-        
-        if (bend.get()) {
-            (*mat_stiff_B)(xyz[qp], _time, material_B_mat);
-            (*mat_stiff_D)(xyz[qp], _time, material_D_mat);
-        }
-        
-        // now calculte the quantity for these matrices
-        _internal_residual_operation(if_vk,
-                                     n2,
-                                     qp,
-                                     *fe,
-                                     JxW,
-                                     request_jacobian,
-                                     local_f,
-                                     local_jac,
-                                     _local_sol,
-                                     strain,
-                                     bend.get(),
-                                     Bmat_lin,
-                                     Bmat_nl_x,
-                                     Bmat_nl_y,
-                                     Bmat_nl_u,
-                                     Bmat_nl_v,
-                                     Bmat_bend,
-                                     Bmat_vk,
-                                     mat_x,
-                                     mat_y,
-                                     stress,
-                                     vk_dwdxi_mat,
-                                     material_A_mat,
-                                     material_B_mat,
-                                     material_D_mat,
-                                     vec1_n1,
-                                     vec2_n1,
-                                     vec3_n2,
-                                     vec4_n3,
-                                     vec5_n3,
-                                     vec6_n2,
-                                     mat1_n1n2,
-                                     mat2_n2n2,
-                                     mat3,
-                                     mat4_n3n2,
-                                     mat5_3n2);
+    if (bend) {
+        mat_stiff_B->evaluate(xyz, _time, material_B_mats);
+        mat_stiff_D->evaluate(xyz, _time, material_D_mats);
+    }
+    
+    // the common element types are integrated with kernels specialized on
+    // the number of shape functions. Others use the generic operator.
+    MAST_PERF_PHASE_ELEM(sw, "StructuralElement2D::internal_residual/integration",
+                         _elem.get_reference_elem().type());
+    switch (use_fixed_size_kernels? n_phi: 0) {
+            
+        case 3: // TRI3
+            _internal_residual_fixed<3>(request_jacobian, fe, bend,
+                                        material_A_mats, material_B_mats, material_D_mats,
+                                        local_f, local_jac);
+            break;
+            
+        case 4: // QUAD4
+            _internal_residual_fixed<4>(request_jacobian, fe, bend,
+                                        material_A_mats, material_B_mats, material_D_mats,
+                                        local_f, local_jac);
+            break;
+            
+        case 9: // QUAD9
+            _internal_residual_fixed<9>(request_jacobian, fe, bend,
+                                        material_A_mats, material_B_mats, material_D_mats,
+                                        local_f, local_jac);
+            break;
+            
+        default:
+            for (unsigned int qp=0; qp<JxW.size(); qp++) {
+            
+                // now calculte the quantity for these matrices
+                _internal_residual_operation(if_vk,
+                                             n2,
+                                             qp,
+                                             fe,
+                                             JxW,
+                                             request_jacobian,
+                                             local_f,
+                                             local_jac,
+                                             _local_sol,
+                                             strain,
+                                             bend,
+                                             Bmat_lin,
+                                             Bmat_nl_x,
+                                             Bmat_nl_y,
+                                             Bmat_nl_u,
+                                             Bmat_nl_v,
+                                             Bmat_bend,
+                                             Bmat_vk,
+                                             mat_x,
+                                             mat_y,
+                                             stress,
+                                             vk_dwdxi_mat,
+                                             material_A_mats[qp],
+                                             material_B_mats[qp],
+                                             material_D_mats[qp],
+                                             vec1_n1,
+                                             vec2_n1,
+                                             vec3_n2,
+                                             vec4_n3,
+                                             vec5_n3,
+                                             vec6_n2,
+                                             mat1_n1n2,
+                                             mat2_n2n2,
+                                             mat3,
+                                             mat4_n3n2,
+                                             mat5_2n2);
+            }
+            break;
     }
     
     
     // now calculate the transverse shear contribution if appropriate for the
     // element
-    if (bend.get() &&
+    MAST_PERF_PHASE(sw, "StructuralElement2D::internal_residual/transverse_shear");
+    if (bend &&
         bend->include_transverse_shear_energy())
         bend->calculate_transverse_shear_residual(request_jacobian,
                                                   local_f,
@@ -1135,6 +1188,7 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
     
     
     // now transform to the global coorodinate system
+    MAST_PERF_PHASE(sw, "StructuralElement2D::internal_residual/transform");
     transform_vector_to_global_system(local_f, vec3_n2);
     f += vec3_n2;
     
@@ -1162,6 +1216,8 @@ MAST::StructuralElement2D::internal_residual_sensitivity (const MAST::FunctionBa
                                                           RealVectorX& f,
                                                           RealMatrixX& jac)
 {
+    MAST_PERF_SCOPE("StructuralElement2D::internal_residual_sensitivity");
+    
     // this should be true if the function is called
     libmesh_assert(!p.is_shape_parameter()); // this is not implemented for now
     
@@ -1176,103 +1232,95 @@ MAST::StructuralElement2D::internal_residual_sensitivity (const MAST::FunctionBa
     if (!calculate)
         return false;
 
-    std::unique_ptr<MAST::FEBase>   fe(_elem.init_fe(true,
-                                                     false,
-                                                     _property.extra_quadrature_order(_elem)));
+    // the finite element and scratch storage are borrowed from the
+    // workspace of this thread and returned when the frame goes out of scope
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    const MAST::FEBase& fe = _elem.init_fe(ws,
+                                           true,
+                                           false,
+                                           _property.extra_quadrature_order(_elem));
 
-    const std::vector<Real>& JxW           = fe->get_JxW();
-    const std::vector<libMesh::Point>& xyz = fe->get_xyz();
+    const std::vector<Real>& JxW           = fe.get_JxW();
+    const std::vector<libMesh::Point>& xyz = fe.get_xyz();
     
     const unsigned int
-    n_phi    = (unsigned int)fe->get_phi().size(),
+    n_phi    = (unsigned int)fe.get_phi().size(),
     n1       = this->n_direct_strain_components(),
     n2       =6*n_phi,
     n3       = this->n_von_karman_strain_components();
 
     RealMatrixX
-    material_A_mat,
-    material_B_mat,
-    material_D_mat,
-    material_trans_shear_mat,
-    mat1_n1n2     = RealMatrixX::Zero(n1,n2),
-    mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
-    mat4_n3n2     = RealMatrixX::Zero(n3,n2),
-    mat5_3n2      = RealMatrixX::Zero(3,n2),
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    stress        = RealMatrixX::Zero(2,2),
-    mat_x         = RealMatrixX::Zero(3,2),
-    mat_y         = RealMatrixX::Zero(3,2),
-    local_jac     = RealMatrixX::Zero(n2,n2);
+    &mat1_n1n2     = ws.matrix(n1,n2),
+    &mat2_n2n2     = ws.matrix(n2,n2),
+    &mat3          = ws.matrix(n1,n2),
+    &mat4_n3n2     = ws.matrix(n3,n2),
+    &mat5_2n2      = ws.matrix(2,n2),
+    &vk_dwdxi_mat  = ws.matrix(n1,n3),
+    &stress        = ws.matrix(2,2),
+    &mat_x         = ws.matrix(3,2),
+    &mat_y         = ws.matrix(3,2),
+    &local_jac     = ws.matrix(n2,n2);
     RealVectorX
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n1    = RealVectorX::Zero(n1),
-    vec3_n2    = RealVectorX::Zero(n2),
-    vec4_n3    = RealVectorX::Zero(n3),
-    vec5_n3    = RealVectorX::Zero(n3),
-    vec6_n2    = RealVectorX::Zero(n2),
-    strain     = RealVectorX::Zero(3),
-    local_f    = RealVectorX::Zero(n2);
+    &vec1_n1    = ws.vector(n1),
+    &vec2_n1    = ws.vector(n1),
+    &vec3_n2    = ws.vector(n2),
+    &vec4_n3    = ws.vector(n3),
+    &vec5_n3    = ws.vector(n3),
+    &vec6_n2    = ws.vector(n2),
+    &strain     = ws.vector(3),
+    &local_f    = ws.vector(n2);
     
     FEMOperatorMatrix
-    Bmat_lin,
-    Bmat_nl_x,
-    Bmat_nl_y,
-    Bmat_nl_u,
-    Bmat_nl_v,
-    Bmat_bend,
-    Bmat_vk;
-    
-    Bmat_lin.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
-    Bmat_nl_x.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_y.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_u.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_v.reinit(2, _system.n_vars(), n_phi);
-    Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
-    Bmat_vk.reinit(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
+    &Bmat_lin   = ws.operator_matrix(n1, _system.n_vars(), n_phi), // three stress-strain components
+    &Bmat_nl_x  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_y  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_u  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_v  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_bend  = ws.operator_matrix(n1, _system.n_vars(), n_phi),
+    &Bmat_vk    = ws.operator_matrix(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
 
     bool if_vk = (_property.strain_type() == MAST::NONLINEAR_STRAIN);
     
-    MAST::BendingOperatorType
-    bending_model = _property.bending_model(_elem);
+    MAST::BendingOperator2D*
+    bend = _bending_operator(fe.get_qpoints());
+
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff_A = &_workspace.property_matrix(_property, MAST::STIFFNESS_A_MATRIX, *this),
+    *mat_stiff_B = &_workspace.property_matrix(_property, MAST::STIFFNESS_B_MATRIX, *this),
+    *mat_stiff_D = &_workspace.property_matrix(_property, MAST::STIFFNESS_D_MATRIX, *this);
     
-    std::unique_ptr<MAST::BendingOperator2D> bend;
+    // sensitivity of the section stiffness at all quadrature points
+    std::vector<RealMatrixX>
+    &material_A_mats = ws.matrix_array((unsigned int)JxW.size()),
+    &material_B_mats = ws.matrix_array((unsigned int)JxW.size()),
+    &material_D_mats = ws.matrix_array((unsigned int)JxW.size());
     
-    if (bending_model != MAST::NO_BENDING)
-        bend.reset(MAST::build_bending_operator_2D(bending_model,
-                                                   *this,
-                                                   fe->get_qpoints()).release());
-
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff_A = _property.stiffness_A_matrix(*this),
-    mat_stiff_B = _property.stiffness_B_matrix(*this),
-    mat_stiff_D = _property.stiffness_D_matrix(*this);
+    mat_stiff_A->evaluate_derivative(p, xyz, _time, material_A_mats);
+    
+    if (bend) {
+        
+        mat_stiff_B->evaluate_derivative(p, xyz, _time, material_B_mats);
+        mat_stiff_D->evaluate_derivative(p, xyz, _time, material_D_mats);
+    }
     
     // first calculate the sensitivity due to the parameter
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
-        // get the material matrix
-        mat_stiff_A->derivative(p, xyz[qp], _time, material_A_mat);
-        
-        if (bend.get()) {
-            
-            mat_stiff_B->derivative(p, xyz[qp], _time, material_B_mat);
-            mat_stiff_D->derivative(p, xyz[qp], _time, material_D_mat);
-        }
-        
         // now calculte the quantity for these matrices
         // this accounts for the sensitivity of the material property matrices
         _internal_residual_operation(if_vk,
                                      n2,
                                      qp,
-                                     *fe,
+                                     fe,
                                      JxW,
                                      request_jacobian,
                                      local_f,
                                      local_jac,
                                      _local_sol,
                                      strain,
-                                     bend.get(),
+                                     bend,
                                      Bmat_lin,
                                      Bmat_nl_x,
                                      Bmat_nl_y,
@@ -1284,9 +1332,9 @@ MAST::StructuralElement2D::internal_residual_sensitivity (const MAST::FunctionBa
                                      mat_y,
                                      stress,
                                      vk_dwdxi_mat,
-                                     material_A_mat,
-                                     material_B_mat,
-                                     material_D_mat,
+                                     material_A_mats[qp],
+                                     material_B_mats[qp],
+                                     material_D_mats[qp],
                                      vec1_n1,
                                      vec2_n1,
                                      vec3_n2,
@@ -1297,12 +1345,12 @@ MAST::StructuralElement2D::internal_residual_sensitivity (const MAST::FunctionBa
                                      mat2_n2n2,
                                      mat3,
                                      mat4_n3n2,
-                                     mat5_3n2);
+                                     mat5_2n2);
     }
     
     // now calculate the transverse shear contribution if appropriate for the
     // element
-    if (bend.get() &&
+    if (bend &&
         bend->include_transverse_shear_energy())
         bend->calculate_transverse_shear_residual_sensitivity(p,
                                                               request_jacobian,
@@ -1356,9 +1404,9 @@ internal_residual_boundary_velocity(const MAST::FunctionBase& p,
     material_trans_shear_mat,
     mat1_n1n2     = RealMatrixX::Zero(n1,n2),
     mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
+    mat3          = RealMatrixX::Zero(n1,n2),
     mat4_n3n2     = RealMatrixX::Zero(n3,n2),
-    mat5_3n2      = RealMatrixX::Zero(3,n2),
+    mat5_2n2      = RealMatrixX::Zero(2,n2),
     vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
     stress        = RealMatrixX::Zero(2,2),
     mat_x         = RealMatrixX::Zero(3,2),
@@ -1404,10 +1452,10 @@ internal_residual_boundary_velocity(const MAST::FunctionBase& p,
                                                    *this,
                                                    fe->get_qpoints()).release());
 
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff_A = _property.stiffness_A_matrix(*this),
-    mat_stiff_B = _property.stiffness_B_matrix(*this),
-    mat_stiff_D = _property.stiffness_D_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff_A = &_workspace.property_matrix(_property, MAST::STIFFNESS_A_MATRIX, *this),
+    *mat_stiff_B = &_workspace.property_matrix(_property, MAST::STIFFNESS_B_MATRIX, *this),
+    *mat_stiff_D = &_workspace.property_matrix(_property, MAST::STIFFNESS_D_MATRIX, *this);
     
     Real
     vn  = 0.;
@@ -1415,7 +1463,7 @@ internal_residual_boundary_velocity(const MAST::FunctionBase& p,
     // modify the JxW_Vn by multiplying the normal velocity to it
     for (unsigned int qp=0; qp<JxW_Vn.size(); qp++) {
         
-        vel_f(xyz[qp], _time, vel);
+        this->boundary_velocity(vel_f, *fe, qp, vel);
         vn = 0.;
         for (unsigned int i=0; i<dim; i++)
             vn += vel(i)*face_normals[qp](i);
@@ -1471,7 +1519,7 @@ internal_residual_boundary_velocity(const MAST::FunctionBase& p,
                                      mat2_n2n2,
                                      mat3,
                                      mat4_n3n2,
-                                     mat5_3n2);
+                                     mat5_2n2);
     }
     
     // now calculate the transverse shear contribution if appropriate for the
@@ -1562,10 +1610,10 @@ internal_residual_jac_dot_state_sensitivity (RealMatrixX& jac) {
     if (!if_vk)
         return false;
     
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff_A  = _property.stiffness_A_matrix(*this),
-    mat_stiff_B  = _property.stiffness_B_matrix(*this),
-    mat_stiff_D  = _property.stiffness_D_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff_A  = &_workspace.property_matrix(_property, MAST::STIFFNESS_A_MATRIX, *this),
+    *mat_stiff_B  = &_workspace.property_matrix(_property, MAST::STIFFNESS_B_MATRIX, *this),
+    *mat_stiff_D  = &_workspace.property_matrix(_property, MAST::STIFFNESS_D_MATRIX, *this);
     
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
@@ -1725,7 +1773,7 @@ MAST::StructuralElement2D::_internal_residual_operation
  RealMatrixX&               mat2_n2n2,
  RealMatrixX&               mat3,
  RealMatrixX&               mat4_2n2,
- RealMatrixX&               mat5_3n2) {
+ RealMatrixX&               mat5_2n2) {
     
     this->initialize_green_lagrange_strain_operator(qp,
                                                     fe,
@@ -1739,14 +1787,14 @@ MAST::StructuralElement2D::_internal_residual_operation
                                                     Bmat_nl_u,
                                                     Bmat_nl_v);
 
-    vec2_n1 = material_A_mat * strain_mem; // membrane stress
+    vec2_n1.noalias() = material_A_mat * strain_mem; // membrane stress
     
     if (bend) {
 
         // get the bending strain operator
         bend->initialize_bending_strain_operator(fe, qp, Bmat_bend);
         Bmat_bend.vector_mult(vec1_n1, local_disp);
-        vec2_n1 += material_B_mat * vec1_n1;
+        vec2_n1.noalias() += material_B_mat * vec1_n1;
         
         if (if_vk)  { // get the vonKarman strain operator if needed
             this->initialize_von_karman_strain_operator(qp,
@@ -1756,7 +1804,7 @@ MAST::StructuralElement2D::_internal_residual_operation
                                                         Bmat_vk);
             
             strain_mem  += vec1_n1;              // epsilon_mem + epsilon_vk
-            vec2_n1     += material_A_mat * vec1_n1; // stress
+            vec2_n1.noalias() += material_A_mat * vec1_n1; // stress
         }
     }
     
@@ -1776,12 +1824,12 @@ MAST::StructuralElement2D::_internal_residual_operation
         
         // nonlinear strain operator
         // x
-        vec4_2   = mat_x.transpose() * vec2_n1;
+        vec4_2.noalias() = mat_x.transpose() * vec2_n1;
         Bmat_nl_x.vector_mult_transpose(vec6_n2, vec4_2);
         local_f.topRows(n2) += JxW[qp] * vec6_n2;
         
         // y
-        vec4_2   = mat_y.transpose() * vec2_n1;
+        vec4_2.noalias() = mat_y.transpose() * vec2_n1;
         Bmat_nl_y.vector_mult_transpose(vec6_n2, vec4_2);
         local_f.topRows(n2) += JxW[qp] * vec6_n2;
     }
@@ -1790,20 +1838,20 @@ MAST::StructuralElement2D::_internal_residual_operation
     if (bend) {
         if (if_vk) {
             // von Karman strain
-            vec4_2 = vk_dwdxi_mat.transpose() * vec2_n1;
+            vec4_2.noalias() = vk_dwdxi_mat.transpose() * vec2_n1;
             Bmat_vk.vector_mult_transpose(vec3_n2, vec4_2);
             local_f += JxW[qp] * vec3_n2;
         }
         
         // now coupling with the bending strain
         // B_bend^T [B] B_mem
-        vec1_n1 = material_B_mat.transpose() * strain_mem;
+        vec1_n1.noalias() = material_B_mat.transpose() * strain_mem;
         Bmat_bend.vector_mult_transpose(vec3_n2, vec1_n1);
         local_f += JxW[qp] * vec3_n2;
         
         // now bending stress
         Bmat_bend.vector_mult(vec2_n1, local_disp);
-        vec1_n1 = material_D_mat * vec2_n1;
+        vec1_n1.noalias() = material_D_mat * vec2_n1;
         Bmat_bend.vector_mult_transpose(vec3_n2, vec1_n1);
         local_f += JxW[qp] * vec3_n2;
     }
@@ -1818,123 +1866,115 @@ MAST::StructuralElement2D::_internal_residual_operation
 
 
             // B_lin^T C mat_x B_x
-            Bmat_nl_x.left_multiply(mat1_n1n2, mat_x);
-            mat1_n1n2 =  material_A_mat * mat1_n1n2;
+            Bmat_nl_x.left_multiply(mat3, mat_x);
+            mat1_n1n2.noalias() =  material_A_mat * mat3;
             Bmat_lin.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_lin^T C mat_y B_y
-            Bmat_nl_y.left_multiply(mat1_n1n2, mat_y);
-            mat1_n1n2 =  material_A_mat * mat1_n1n2;
+            Bmat_nl_y.left_multiply(mat3, mat_y);
+            mat1_n1n2.noalias() =  material_A_mat * mat3;
             Bmat_lin.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_x^T mat_x^T C B_lin
             Bmat_lin.left_multiply(mat1_n1n2, material_A_mat);
-            mat5_3n2 = mat_x.transpose() * mat1_n1n2;
-            Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat5_3n2);
+            mat5_2n2.noalias() = mat_x.transpose() * mat1_n1n2;
+            Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat5_2n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_x^T mat_x^T C mat_x B_x
-            Bmat_nl_x.left_multiply(mat1_n1n2, mat_x);
-            mat1_n1n2 = material_A_mat * mat1_n1n2;
-            mat5_3n2 = mat_x.transpose() * mat1_n1n2;
-            Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat5_3n2);
+            Bmat_nl_x.left_multiply(mat3, mat_x);
+            mat1_n1n2.noalias() = material_A_mat * mat3;
+            mat5_2n2.noalias() = mat_x.transpose() * mat1_n1n2;
+            Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat5_2n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_x^T mat_x^T C mat_y B_y
-            Bmat_nl_y.left_multiply(mat1_n1n2, mat_y);
-            mat1_n1n2 = material_A_mat * mat1_n1n2;
-            mat5_3n2 = mat_x.transpose() * mat1_n1n2;
-            Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat5_3n2);
+            Bmat_nl_y.left_multiply(mat3, mat_y);
+            mat1_n1n2.noalias() = material_A_mat * mat3;
+            mat5_2n2.noalias() = mat_x.transpose() * mat1_n1n2;
+            Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat5_2n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_y^T mat_y^T C B_lin
             Bmat_lin.left_multiply(mat1_n1n2, material_A_mat);
-            mat5_3n2 = mat_y.transpose() * mat1_n1n2;
-            Bmat_nl_y.right_multiply_transpose(mat2_n2n2, mat5_3n2);
+            mat5_2n2.noalias() = mat_y.transpose() * mat1_n1n2;
+            Bmat_nl_y.right_multiply_transpose(mat2_n2n2, mat5_2n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_y^T mat_y^T C mat_x B_x
-            Bmat_nl_x.left_multiply(mat1_n1n2, mat_x);
-            mat1_n1n2 = material_A_mat * mat1_n1n2;
-            mat5_3n2 = mat_y.transpose() * mat1_n1n2;
-            Bmat_nl_y.right_multiply_transpose(mat2_n2n2, mat5_3n2);
+            Bmat_nl_x.left_multiply(mat3, mat_x);
+            mat1_n1n2.noalias() = material_A_mat * mat3;
+            mat5_2n2.noalias() = mat_y.transpose() * mat1_n1n2;
+            Bmat_nl_y.right_multiply_transpose(mat2_n2n2, mat5_2n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_y^T mat_y^T C mat_y B_y
-            Bmat_nl_y.left_multiply(mat1_n1n2, mat_y);
-            mat1_n1n2 = material_A_mat * mat1_n1n2;
-            mat5_3n2 = mat_y.transpose() * mat1_n1n2;
-            Bmat_nl_y.right_multiply_transpose(mat2_n2n2, mat5_3n2);
+            Bmat_nl_y.left_multiply(mat3, mat_y);
+            mat1_n1n2.noalias() = material_A_mat * mat3;
+            mat5_2n2.noalias() = mat_y.transpose() * mat1_n1n2;
+            Bmat_nl_y.right_multiply_transpose(mat2_n2n2, mat5_2n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // nonlinear membrane u - nonlinear membrane u
             // (geometric / initial stress stiffness)
             // u-disp
-            Bmat_nl_u.left_multiply(mat5_3n2, stress);
-            Bmat_nl_u.right_multiply_transpose(mat2_n2n2, mat5_3n2);
+            Bmat_nl_u.left_multiply(mat5_2n2, stress);
+            Bmat_nl_u.right_multiply_transpose(mat2_n2n2, mat5_2n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // nonlinear membrane v - nonlinear membrane v
             // (geometric / initial stress stiffness)
             // v-disp
-            Bmat_nl_v.left_multiply(mat5_3n2, stress);
-            Bmat_nl_v.right_multiply_transpose(mat2_n2n2, mat5_3n2);
+            Bmat_nl_v.left_multiply(mat5_2n2, stress);
+            Bmat_nl_v.right_multiply_transpose(mat2_n2n2, mat5_2n2);
             local_jac += JxW[qp] * mat2_n2n2;
         }
         
         if (bend) {
             if (if_vk) {
                 // membrane - vk
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
                 Bmat_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = material_A_mat * mat3;
-                Bmat_lin.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2.noalias() = material_A_mat * mat3;
+                Bmat_lin.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - membrane
                 Bmat_lin.left_multiply(mat1_n1n2, material_A_mat);
-                mat3 = vk_dwdxi_mat.transpose() * mat1_n1n2;
-                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat5_2n2.noalias() = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat5_2n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - vk
-                mat3 = RealMatrixX::Zero(2, n2);
-                Bmat_vk.left_multiply(mat3, stress);
-                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_vk.left_multiply(mat5_2n2, stress);
+                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat5_2n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
                 Bmat_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = vk_dwdxi_mat.transpose() * material_A_mat * mat3;
-                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2.noalias() = material_A_mat * mat3;
+                mat5_2n2.noalias() = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat5_2n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // bending - vk
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
                 Bmat_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = material_B_mat.transpose() * mat3;
-                Bmat_bend.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2.noalias() = material_B_mat.transpose() * mat3;
+                Bmat_bend.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - bending
                 Bmat_bend.left_multiply(mat1_n1n2, material_B_mat);
-                mat3 = vk_dwdxi_mat.transpose() * mat1_n1n2;
-                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat5_2n2.noalias() = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat5_2n2);
                 local_jac += JxW[qp] * mat2_n2n2;
             }
             
-            // bending - membrane
-            mat3 = material_B_mat.transpose();
-            Bmat_lin.left_multiply(mat1_n1n2, mat3);
-            Bmat_bend.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
-            local_jac += JxW[qp] * mat2_n2n2;
-            
-            // membrane - bending
+            // membrane - bending, and its transpose, bending - membrane
             Bmat_bend.left_multiply(mat1_n1n2, material_B_mat);
             Bmat_lin.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
             local_jac += JxW[qp] * mat2_n2n2;
+            local_jac += JxW[qp] * mat2_n2n2.transpose();
             
             // bending - bending
             Bmat_bend.left_multiply(mat1_n1n2, material_D_mat);
@@ -1946,6 +1986,229 @@ MAST::StructuralElement2D::_internal_residual_operation
 
 
 
+template <unsigned int NPhi>
+void
+MAST::StructuralElement2D::
+_internal_residual_fixed(bool                       request_jacobian,
+                         const MAST::FEBase&        fe,
+                         MAST::BendingOperator2D*   bend,
+                         const std::vector<RealMatrixX>& material_A_mats,
+                         const std::vector<RealMatrixX>& material_B_mats,
+                         const std::vector<RealMatrixX>& material_D_mats,
+                         RealVectorX&               local_f,
+                         RealMatrixX&               local_jac) {
+    
+    const unsigned int
+    N2 = 6*NPhi;
+    
+    typedef Eigen::Matrix<Real,  3,  1> Vec3;
+    typedef Eigen::Matrix<Real,  3,  3> Mat33;
+    typedef Eigen::Matrix<Real,  3,  2> Mat32;
+    typedef Eigen::Matrix<Real,  2,  2> Mat22;
+    typedef Eigen::Matrix<Real, N2,  1> VecN;
+    typedef Eigen::Matrix<Real,  3, N2> Mat3N;
+    typedef Eigen::Matrix<Real,  2, N2> Mat2N;
+    typedef Eigen::Matrix<Real, N2, N2> MatNN;
+    
+    libmesh_assert_equal_to(_system.n_vars(), 6);
+    libmesh_assert_equal_to(fe.get_phi().size(), NPhi);
+    libmesh_assert_equal_to(_local_sol.size(), N2);
+    libmesh_assert_equal_to(local_f.size(), N2);
+    
+    const std::vector<Real>& JxW           = fe.get_JxW();
+    
+    libmesh_assert_equal_to(material_A_mats.size(), JxW.size());
+    
+    const bool
+    if_vk = (_property.strain_type() == MAST::NONLINEAR_STRAIN);
+    
+    // the strain operators are initialized through the same routines as the
+    // generic path and then copied to fixed-size matrices, on which all
+    // products below are evaluated.
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    RealMatrixX
+    &mat_x          = ws.matrix(3,2),
+    &mat_y          = ws.matrix(3,2),
+    &vk_dwdxi_mat   = ws.matrix(3,2);
+    
+    RealVectorX
+    &strain         = ws.vector(3),
+    &vk_strain      = ws.vector(3);
+    
+    FEMOperatorMatrix
+    &Bmat_lin       = ws.operator_matrix(3, 6, NPhi),
+    &Bmat_nl_x      = ws.operator_matrix(2, 6, NPhi),
+    &Bmat_nl_y      = ws.operator_matrix(2, 6, NPhi),
+    &Bmat_nl_u      = ws.operator_matrix(2, 6, NPhi),
+    &Bmat_nl_v      = ws.operator_matrix(2, 6, NPhi),
+    &Bmat_bend      = ws.operator_matrix(3, 6, NPhi),
+    &Bmat_vk        = ws.operator_matrix(2, 6, NPhi);
+    
+    const VecN
+    u          = _local_sol;
+    
+    VecN
+    f          = VecN::Zero();
+    
+    MatNN
+    jac        = MatNN::Zero();
+    
+    Mat33
+    A          = Mat33::Zero(),
+    B          = Mat33::Zero(),
+    D          = Mat33::Zero();
+    
+    Mat32
+    mx, my, vk = Mat32::Zero();
+    
+    Mat22
+    S;
+    
+    Vec3
+    eps, eps_b = Vec3::Zero(), sig;
+    
+    Mat3N
+    Bl, Bm, Bb = Mat3N::Zero(), Mvk, tmp;
+    
+    Mat2N
+    Bx, By, Bu, Bv, Bvk = Mat2N::Zero();
+    
+    for (unsigned int qp=0; qp<JxW.size(); qp++) {
+        
+        // material matrices at this quadrature point
+        A = material_A_mats[qp];
+        
+        if (bend) {
+            B = material_B_mats[qp];
+            D = material_D_mats[qp];
+        }
+        
+        this->initialize_green_lagrange_strain_operator(qp,
+                                                        fe,
+                                                        _local_sol,
+                                                        strain,
+                                                        mat_x,
+                                                        mat_y,
+                                                        Bmat_lin,
+                                                        Bmat_nl_x,
+                                                        Bmat_nl_y,
+                                                        Bmat_nl_u,
+                                                        Bmat_nl_v);
+        Bmat_lin.get_dense(Bl);
+        eps  = strain;
+        sig  = A * eps;   // membrane stress
+        
+        if (bend) {
+            
+            bend->initialize_bending_strain_operator(fe, qp, Bmat_bend);
+            Bmat_bend.get_dense(Bb);
+            eps_b = Bb * u;
+            sig  += B * eps_b;
+            
+            if (if_vk) {
+                this->initialize_von_karman_strain_operator(qp,
+                                                            fe,
+                                                            vk_strain,
+                                                            vk_dwdxi_mat,
+                                                            Bmat_vk);
+                Bmat_vk.get_dense(Bvk);
+                vk    = vk_dwdxi_mat;
+                eps  += vk_strain;             // epsilon_mem + epsilon_vk
+                sig  += A * vk_strain;
+            }
+        }
+        
+        S <<
+        sig(0), sig(2),
+        sig(2), sig(1);
+        
+        // membrane strain operator with all A and B material operators
+        f.noalias() += JxW[qp] * (Bl.transpose() * sig);
+        
+        if (if_vk) {
+            
+            Bmat_nl_x.get_dense(Bx);
+            Bmat_nl_y.get_dense(By);
+            mx = mat_x;
+            my = mat_y;
+            
+            f.noalias() += JxW[qp] * (Bx.transpose() * (mx.transpose() * sig) +
+                                      By.transpose() * (my.transpose() * sig));
+        }
+        
+        if (bend) {
+            
+            // von Karman strain
+            if (if_vk)
+                f.noalias() += JxW[qp] * (Bvk.transpose() * (vk.transpose() * sig));
+            
+            // B_bend^T [B] eps_mem  +  B_bend^T [D] eps_bend
+            f.noalias() += JxW[qp] * (Bb.transpose() * (B.transpose() * eps + D * eps_b));
+        }
+        
+        if (request_jacobian) {
+            
+            // membrane - membrane, including the Green-Lagrange terms
+            Bm = Bl;
+            if (if_vk) {
+                Bm.noalias() += mx * Bx;
+                Bm.noalias() += my * By;
+            }
+            tmp.noalias() = A * Bm;
+            jac.noalias() += JxW[qp] * (Bm.transpose() * tmp);
+            
+            if (if_vk) {
+                
+                // geometric / initial stress stiffness
+                Bmat_nl_u.get_dense(Bu);
+                Bmat_nl_v.get_dense(Bv);
+                jac.noalias() += JxW[qp] * (Bu.transpose() * (S * Bu) +
+                                            Bv.transpose() * (S * Bv));
+            }
+            
+            if (bend) {
+                
+                if (if_vk) {
+                    
+                    Mvk.noalias() = vk * Bvk;
+                    
+                    // membrane - vk and vk - vk
+                    tmp.noalias()  = A * Mvk;
+                    jac.noalias() += JxW[qp] * (Bl.transpose() * tmp);
+                    jac.noalias() += JxW[qp] * (Mvk.transpose() * tmp);
+                    jac.noalias() += JxW[qp] * (Bvk.transpose() * (S * Bvk));
+                    
+                    // vk - membrane
+                    tmp.noalias()  = A * Bl;
+                    jac.noalias() += JxW[qp] * (Mvk.transpose() * tmp);
+                    
+                    // bending - vk and vk - bending
+                    tmp.noalias()  = B.transpose() * Mvk;
+                    jac.noalias() += JxW[qp] * (Bb.transpose() * tmp);
+                    jac.noalias() += JxW[qp] * (tmp.transpose() * Bb);
+                }
+                
+                // bending - membrane and membrane - bending
+                tmp.noalias()  = B.transpose() * Bl;
+                jac.noalias() += JxW[qp] * (Bb.transpose() * tmp);
+                jac.noalias() += JxW[qp] * (tmp.transpose() * Bb);
+                
+                // bending - bending
+                tmp.noalias()  = D * Bb;
+                jac.noalias() += JxW[qp] * (Bb.transpose() * tmp);
+            }
+        }
+    }
+    
+    local_f   += f;
+    if (request_jacobian)
+        local_jac += jac;
+}
+
+
+
 
 void
 MAST::StructuralElement2D::_convert_prestress_A_mat_to_vector(const RealMatrixX& mat,
@@ -1984,66 +2247,56 @@ MAST::StructuralElement2D::prestress_residual (bool request_jacobian,
     if (!_property.if_prestressed())
         return false;
     
-    std::unique_ptr<MAST::FEBase>   fe(_elem.init_fe(true,
-                                                     false,
-                                                     _property.extra_quadrature_order(_elem)));
+    // the finite element and scratch storage are borrowed from the
+    // workspace of this thread and returned when the frame goes out of scope
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    const MAST::FEBase& fe = _elem.init_fe(ws,
+                                           true,
+                                           false,
+                                           _property.extra_quadrature_order(_elem));
 
-    const std::vector<Real>& JxW               = fe->get_JxW();
-    const std::vector<libMesh::Point>& xyz     = fe->get_xyz();
+    const std::vector<Real>& JxW               = fe.get_JxW();
+    const std::vector<libMesh::Point>& xyz     = fe.get_xyz();
     const unsigned int
-    n_phi  = (unsigned int)fe->get_phi().size(),
+    n_phi  = (unsigned int)fe.get_phi().size(),
     n1     = this->n_direct_strain_components(),
     n2     = 6*n_phi,
     n3     = this->n_von_karman_strain_components();
     
     RealMatrixX
-    mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    local_jac     = RealMatrixX::Zero(n2,n2),
-    mat_x         = RealMatrixX::Zero(3,2),
-    mat_y         = RealMatrixX::Zero(3,2),
-    prestress_mat_A,
-    prestress_mat_B;
+    &mat2_n2n2       = ws.matrix(n2,n2),
+    &mat3            = ws.matrix(2,n2),
+    &vk_dwdxi_mat    = ws.matrix(n1,n3),
+    &local_jac       = ws.matrix(n2,n2),
+    &mat_x           = ws.matrix(3,2),
+    &mat_y           = ws.matrix(3,2),
+    &prestress_mat_A = ws.matrix(2,2),
+    &prestress_mat_B = ws.matrix(2,2);
     
     RealVectorX
-    vec2_n1         = RealVectorX::Zero(n1),
-    vec3_n2         = RealVectorX::Zero(n2),
-    vec4_n3         = RealVectorX::Zero(n3),
-    vec5_n3         = RealVectorX::Zero(n3),
-    local_f         = RealVectorX::Zero(n2),
-    strain          = RealVectorX::Zero(3),
-    prestress_vec_A,
-    prestress_vec_B;
+    &vec2_n1         = ws.vector(n1),
+    &vec3_n2         = ws.vector(n2),
+    &vec4_n3         = ws.vector(n3),
+    &local_f         = ws.vector(n2),
+    &strain          = ws.vector(3),
+    &prestress_vec_A = ws.vector(3),
+    &prestress_vec_B = ws.vector(3);
     
     FEMOperatorMatrix
-    Bmat_lin,
-    Bmat_nl_x,
-    Bmat_nl_y,
-    Bmat_nl_u,
-    Bmat_nl_v,
-    Bmat_bend,
-    Bmat_vk;
-    
-    Bmat_lin.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
-    Bmat_nl_x.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_y.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_u.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_v.reinit(2, _system.n_vars(), n_phi);
-    Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
-    Bmat_vk.reinit(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
+    &Bmat_lin   = ws.operator_matrix(n1, _system.n_vars(), n_phi), // three stress-strain components
+    &Bmat_nl_x  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_y  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_u  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_v  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_bend  = ws.operator_matrix(n1, _system.n_vars(), n_phi),
+    &Bmat_vk    = ws.operator_matrix(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
 
     bool if_vk = (_property.strain_type() == MAST::NONLINEAR_STRAIN);
     
-    MAST::BendingOperatorType
-    bending_model = _property.bending_model(_elem);
-    
-    std::unique_ptr<MAST::BendingOperator2D> bend;
-    
-    if (bending_model != MAST::NO_BENDING)
-        bend.reset(MAST::build_bending_operator_2D(bending_model,
-                                                   *this,
-                                                   fe->get_qpoints()).release());
+    MAST::BendingOperator2D*
+    bend = _bending_operator(fe.get_qpoints());
 
     std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
     prestress_A = _property.prestress_A_matrix(*this),
@@ -2058,7 +2311,7 @@ MAST::StructuralElement2D::prestress_residual (bool request_jacobian,
         _convert_prestress_B_mat_to_vector(prestress_mat_B, prestress_vec_B);
         
         this->initialize_green_lagrange_strain_operator(qp,
-                                                        *fe,
+                                                        fe,
                                                         _local_sol,
                                                         strain,
                                                         mat_x,
@@ -2071,12 +2324,12 @@ MAST::StructuralElement2D::prestress_residual (bool request_jacobian,
 
         // get the bending strain operator if needed
         vec2_n1.setZero(); // used to store vk strain, if applicable
-        if (bend.get()) {
-            bend->initialize_bending_strain_operator(*fe, qp, Bmat_bend);
+        if (bend) {
+            bend->initialize_bending_strain_operator(fe, qp, Bmat_bend);
             
             if (if_vk)  // get the vonKarman strain operator if needed
                 this->initialize_von_karman_strain_operator(qp,
-                                                            *fe,
+                                                            fe,
                                                             vec2_n1,
                                                             vk_dwdxi_mat,
                                                             Bmat_vk);
@@ -2088,10 +2341,10 @@ MAST::StructuralElement2D::prestress_residual (bool request_jacobian,
         Bmat_lin.vector_mult_transpose(vec3_n2, prestress_vec_A);
         local_f += JxW[qp] * vec3_n2; // epsilon_mem * sigma_0
         
-        if (bend.get()) {
+        if (bend) {
             if (if_vk) {
                 // von Karman strain
-                vec4_n3 = vk_dwdxi_mat.transpose() * prestress_vec_A;
+                vec4_n3.noalias() = vk_dwdxi_mat.transpose() * prestress_vec_A;
                 Bmat_vk.vector_mult_transpose(vec3_n2, vec4_n3);
                 local_f += JxW[qp] * vec3_n2; // epsilon_vk * sigma_0
             }
@@ -2102,8 +2355,7 @@ MAST::StructuralElement2D::prestress_residual (bool request_jacobian,
         }
         
         if (request_jacobian) {
-            if (bend.get() && if_vk) {
-                mat3 = RealMatrixX::Zero(2, n2);
+            if (bend && if_vk) {
                 Bmat_vk.left_multiply(mat3, prestress_mat_A);
                 Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
                 local_jac += JxW[qp] * mat2_n2n2;
@@ -2136,66 +2388,56 @@ MAST::StructuralElement2D::prestress_residual_sensitivity (const MAST::FunctionB
     if (!_property.if_prestressed())
         return false;
     
-    std::unique_ptr<MAST::FEBase>   fe(_elem.init_fe(true,
-                                                     false,
-                                                     _property.extra_quadrature_order(_elem)));
+    // the finite element and scratch storage are borrowed from the
+    // workspace of this thread and returned when the frame goes out of scope
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    const MAST::FEBase& fe = _elem.init_fe(ws,
+                                           true,
+                                           false,
+                                           _property.extra_quadrature_order(_elem));
 
-    const std::vector<Real>& JxW            = fe->get_JxW();
-    const std::vector<libMesh::Point>& xyz  = fe->get_xyz();
+    const std::vector<Real>& JxW            = fe.get_JxW();
+    const std::vector<libMesh::Point>& xyz  = fe.get_xyz();
     const unsigned int
-    n_phi = (unsigned int)fe->get_phi().size(),
+    n_phi = (unsigned int)fe.get_phi().size(),
     n1    = this->n_direct_strain_components(),
     n2    = 6*n_phi,
     n3    = this->n_von_karman_strain_components();
     
     RealMatrixX
-    mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    local_jac     = RealMatrixX::Zero(n2,n2),
-    mat_x         = RealMatrixX::Zero(3,2),
-    mat_y         = RealMatrixX::Zero(3,2),
-    prestress_mat_A,
-    prestress_mat_B;
+    &mat2_n2n2       = ws.matrix(n2,n2),
+    &mat3            = ws.matrix(2,n2),
+    &vk_dwdxi_mat    = ws.matrix(n1,n3),
+    &local_jac       = ws.matrix(n2,n2),
+    &mat_x           = ws.matrix(3,2),
+    &mat_y           = ws.matrix(3,2),
+    &prestress_mat_A = ws.matrix(2,2),
+    &prestress_mat_B = ws.matrix(2,2);
     
     RealVectorX
-    vec2_n1     = RealVectorX::Zero(n1),
-    vec3_n2     = RealVectorX::Zero(n2),
-    vec4_n3     = RealVectorX::Zero(n3),
-    vec5_n3     = RealVectorX::Zero(n3),
-    local_f     = RealVectorX::Zero(n2),
-    strain      = RealVectorX::Zero(3),
-    prestress_vec_A,
-    prestress_vec_B;
+    &vec2_n1         = ws.vector(n1),
+    &vec3_n2         = ws.vector(n2),
+    &vec4_n3         = ws.vector(n3),
+    &local_f         = ws.vector(n2),
+    &strain          = ws.vector(3),
+    &prestress_vec_A = ws.vector(3),
+    &prestress_vec_B = ws.vector(3);
     
     FEMOperatorMatrix
-    Bmat_lin,
-    Bmat_nl_x,
-    Bmat_nl_y,
-    Bmat_nl_u,
-    Bmat_nl_v,
-    Bmat_bend,
-    Bmat_vk;
-    
-    Bmat_lin.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
-    Bmat_nl_x.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_y.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_u.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_v.reinit(2, _system.n_vars(), n_phi);
-    Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
-    Bmat_vk.reinit(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
+    &Bmat_lin   = ws.operator_matrix(n1, _system.n_vars(), n_phi), // three stress-strain components
+    &Bmat_nl_x  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_y  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_u  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_v  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_bend  = ws.operator_matrix(n1, _system.n_vars(), n_phi),
+    &Bmat_vk    = ws.operator_matrix(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
 
     bool if_vk = (_property.strain_type() == MAST::NONLINEAR_STRAIN);
     
-    MAST::BendingOperatorType
-    bending_model = _property.bending_model(_elem);
-    
-    std::unique_ptr<MAST::BendingOperator2D> bend;
-    
-    if (bending_model != MAST::NO_BENDING)
-        bend.reset(MAST::build_bending_operator_2D(bending_model,
-                                                   *this,
-                                                   fe->get_qpoints()).release());
+    MAST::BendingOperator2D*
+    bend = _bending_operator(fe.get_qpoints());
 
     std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
     prestress_A = _property.prestress_A_matrix(*this),
@@ -2210,7 +2452,7 @@ MAST::StructuralElement2D::prestress_residual_sensitivity (const MAST::FunctionB
         _convert_prestress_B_mat_to_vector(prestress_mat_B, prestress_vec_B);
         
         this->initialize_green_lagrange_strain_operator(qp,
-                                                        *fe,
+                                                        fe,
                                                         _local_sol,
                                                         strain,
                                                         mat_x,
@@ -2223,12 +2465,12 @@ MAST::StructuralElement2D::prestress_residual_sensitivity (const MAST::FunctionB
 
         // get the bending strain operator if needed
         vec2_n1.setZero(); // used to store vk strain, if applicable
-        if (bend.get()) {
-            bend->initialize_bending_strain_operator(*fe, qp, Bmat_bend);
+        if (bend) {
+            bend->initialize_bending_strain_operator(fe, qp, Bmat_bend);
             
             if (if_vk)  // get the vonKarman strain operator if needed
                 this->initialize_von_karman_strain_operator(qp,
-                                                            *fe,
+                                                            fe,
                                                             vec2_n1,
                                                             vk_dwdxi_mat,
                                                             Bmat_vk);
@@ -2240,10 +2482,10 @@ MAST::StructuralElement2D::prestress_residual_sensitivity (const MAST::FunctionB
         Bmat_lin.vector_mult_transpose(vec3_n2, prestress_vec_A);
         local_f += JxW[qp] * vec3_n2; // epsilon_mem * sigma_0
         
-        if (bend.get()) {
+        if (bend) {
             if (if_vk) {
                 // von Karman strain
-                vec4_n3 = vk_dwdxi_mat.transpose() * prestress_vec_A;
+                vec4_n3.noalias() = vk_dwdxi_mat.transpose() * prestress_vec_A;
                 Bmat_vk.vector_mult_transpose(vec3_n2, vec4_n3);
                 local_f += JxW[qp] * vec3_n2; // epsilon_vk * sigma_0
             }
@@ -2254,8 +2496,7 @@ MAST::StructuralElement2D::prestress_residual_sensitivity (const MAST::FunctionB
         }
         
         if (request_jacobian) {
-            if (bend.get() && if_vk) {
-                mat3 = RealMatrixX::Zero(2, n2);
+            if (bend && if_vk) {
                 Bmat_vk.left_multiply(mat3, prestress_mat_A);
                 Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
                 local_jac += JxW[qp] * mat2_n2n2;
@@ -2442,74 +2683,62 @@ MAST::StructuralElement2D::thermal_residual (bool request_jacobian,
                                              MAST::BoundaryConditionBase& bc)
 {
     
-    std::unique_ptr<MAST::FEBase>   fe(_elem.init_fe(true,
-                                                     false,
-                                                     _property.extra_quadrature_order(_elem)));
+    // the finite element and scratch storage are borrowed from the
+    // workspace of this thread and returned when the frame goes out of scope
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    const MAST::FEBase& fe = _elem.init_fe(ws,
+                                           true,
+                                           false,
+                                           _property.extra_quadrature_order(_elem));
 
-    const std::vector<Real>& JxW            = fe->get_JxW();
-    const std::vector<libMesh::Point>& xyz  = fe->get_xyz();
+    const std::vector<Real>& JxW            = fe.get_JxW();
+    const std::vector<libMesh::Point>& xyz  = fe.get_xyz();
     
     const unsigned int
-    n_phi   = (unsigned int)fe->get_phi().size(),
+    n_phi   = (unsigned int)fe.get_phi().size(),
     n1      = this->n_direct_strain_components(),
     n2      = 6*n_phi,
     n3      = this->n_von_karman_strain_components();
 
     RealMatrixX
-    material_exp_A_mat,
-    material_exp_B_mat,
-    mat1_n1n2     = RealMatrixX::Zero(n1,n2),
-    mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3          = RealMatrixX::Zero(2, n2),
-    mat4_n3n2     = RealMatrixX::Zero(n3,n2),
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    stress        = RealMatrixX::Zero(2,2),
-    mat_x         = RealMatrixX::Zero(3,2),
-    mat_y         = RealMatrixX::Zero(3,2),
-    local_jac     = RealMatrixX::Zero(n2,n2);
+    &material_exp_A_mat = ws.matrix(n1,1),
+    &material_exp_B_mat = ws.matrix(n1,1),
+    &mat2_n2n2          = ws.matrix(n2,n2),
+    &mat3               = ws.matrix(2, n2),
+    &vk_dwdxi_mat       = ws.matrix(n1,n3),
+    &stress             = ws.matrix(2,2),
+    &mat_x              = ws.matrix(3,2),
+    &mat_y              = ws.matrix(3,2),
+    &local_jac          = ws.matrix(n2,n2);
     
     RealVectorX
-    vec1_n1     = RealVectorX::Zero(n1),
-    vec2_n1     = RealVectorX::Zero(n1),
-    vec3_n2     = RealVectorX::Zero(n2),
-    vec4_2      = RealVectorX::Zero(2),
-    vec5_n3     = RealVectorX::Zero(n3),
-    local_f     = RealVectorX::Zero(n2),
-    strain      = RealVectorX::Zero(3),
-    delta_t     = RealVectorX::Zero(1);
+    &vec1_n1     = ws.vector(n1),
+    &vec2_n1     = ws.vector(n1),
+    &vec3_n2     = ws.vector(n2),
+    &vec4_2      = ws.vector(2),
+    &local_f     = ws.vector(n2),
+    &strain      = ws.vector(3),
+    &delta_t     = ws.vector(1);
     
     FEMOperatorMatrix
-    Bmat_lin,
-    Bmat_nl_x,
-    Bmat_nl_y,
-    Bmat_nl_u,
-    Bmat_nl_v,
-    Bmat_bend,
-    Bmat_vk;
-    
-    Bmat_lin.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
-    Bmat_nl_x.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_y.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_u.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_v.reinit(2, _system.n_vars(), n_phi);
-    Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
-    Bmat_vk.reinit(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
+    &Bmat_lin   = ws.operator_matrix(n1, _system.n_vars(), n_phi), // three stress-strain components
+    &Bmat_nl_x  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_y  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_u  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_v  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_bend  = ws.operator_matrix(n1, _system.n_vars(), n_phi),
+    &Bmat_vk    = ws.operator_matrix(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
 
     bool if_vk = (_property.strain_type() == MAST::NONLINEAR_STRAIN);
     
-    MAST::BendingOperatorType
-    bending_model = _property.bending_model(_elem);
-    
-    std::unique_ptr<MAST::BendingOperator2D> bend;
-    
-    if (bending_model != MAST::NO_BENDING)
-        bend.reset(MAST::build_bending_operator_2D(bending_model,
-                                                   *this,
-                                                   fe->get_qpoints()).release());
+    MAST::BendingOperator2D*
+    bend = _bending_operator(fe.get_qpoints());
 
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    expansion_A = _property.thermal_expansion_A_matrix(*this),
-    expansion_B = _property.thermal_expansion_B_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *expansion_A = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_A_MATRIX, *this),
+    *expansion_B = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_B_MATRIX, *this);
     
     const MAST::FieldFunction<Real>
     &temp_func     = bc.get<MAST::FieldFunction<Real> >("temperature"),
@@ -2534,15 +2763,15 @@ MAST::StructuralElement2D::thermal_residual (bool request_jacobian,
         ref_temp_func(xyz[qp], _time, t0);
         delta_t(0) = t-t0;
         
-        vec1_n1 = material_exp_A_mat * delta_t; // [C]{alpha (T - T0)} (with membrane strain)
-        vec2_n1 = material_exp_B_mat * delta_t; // [C]{alpha (T - T0)} (with bending strain)
+        vec1_n1.noalias() = material_exp_A_mat * delta_t; // [C]{alpha (T - T0)} (with membrane strain)
+        vec2_n1.noalias() = material_exp_B_mat * delta_t; // [C]{alpha (T - T0)} (with bending strain)
         stress(0,0) = vec1_n1(0); // sigma_xx
         stress(0,1) = vec1_n1(2); // sigma_xy
         stress(1,0) = vec1_n1(2); // sigma_yx
         stress(1,1) = vec1_n1(1); // sigma_yy
         
         this->initialize_green_lagrange_strain_operator(qp,
-                                                        *fe,
+                                                        fe,
                                                         _local_sol,
                                                         strain,
                                                         mat_x,
@@ -2561,19 +2790,19 @@ MAST::StructuralElement2D::thermal_residual (bool request_jacobian,
 
             // nonlinear strain operotor
             // x
-            vec4_2 = mat_x.transpose() * vec1_n1;
+            vec4_2.noalias() = mat_x.transpose() * vec1_n1;
             Bmat_nl_x.vector_mult_transpose(vec3_n2, vec4_2);
             local_f.topRows(n2) += JxW[qp] * vec3_n2;
             
             // y
-            vec4_2 = mat_y.transpose() * vec1_n1;
+            vec4_2.noalias() = mat_y.transpose() * vec1_n1;
             Bmat_nl_y.vector_mult_transpose(vec3_n2, vec4_2);
             local_f.topRows(n2) += JxW[qp] * vec3_n2;
         }
         
-        if (bend.get()) {
+        if (bend) {
             // bending strain
-            bend->initialize_bending_strain_operator(*fe, qp, Bmat_bend);
+            bend->initialize_bending_strain_operator(fe, qp, Bmat_bend);
             Bmat_bend.vector_mult_transpose(vec3_n2, vec2_n1);
             local_f += JxW[qp] * vec3_n2;
             
@@ -2581,12 +2810,12 @@ MAST::StructuralElement2D::thermal_residual (bool request_jacobian,
             if (if_vk) {
                 // get the vonKarman strain operator if needed
                 this->initialize_von_karman_strain_operator(qp,
-                                                            *fe,
+                                                            fe,
                                                             vec2_n1, // epsilon_vk
                                                             vk_dwdxi_mat,
                                                             Bmat_vk);
                 // von Karman strain
-                vec4_2 = vk_dwdxi_mat.transpose() * vec1_n1;
+                vec4_2.noalias() = vk_dwdxi_mat.transpose() * vec1_n1;
                 Bmat_vk.vector_mult_transpose(vec3_n2, vec4_2);
                 local_f += JxW[qp] * vec3_n2;
             }
@@ -2608,7 +2837,6 @@ MAST::StructuralElement2D::thermal_residual (bool request_jacobian,
             
         if (request_jacobian && if_vk) {
             // vk - vk
-            mat3 = RealMatrixX::Zero(2, n2);
             Bmat_vk.left_multiply(mat3, stress);
             Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
             local_jac += JxW[qp] * mat2_n2n2;
@@ -2638,77 +2866,66 @@ thermal_residual_sensitivity (const MAST::FunctionBase& p,
                               RealMatrixX& jac,
                               MAST::BoundaryConditionBase& bc)
 {
-    std::unique_ptr<MAST::FEBase>   fe(_elem.init_fe(true,
-                                                     false,
-                                                     _property.extra_quadrature_order(_elem)));
+    // the finite element and scratch storage are borrowed from the
+    // workspace of this thread and returned when the frame goes out of scope
+    MAST::ElemWorkspace::Frame
+    ws(_workspace);
+    
+    const MAST::FEBase& fe = _elem.init_fe(ws,
+                                           true,
+                                           false,
+                                           _property.extra_quadrature_order(_elem));
 
-    const std::vector<Real>& JxW           = fe->get_JxW();
-    const std::vector<libMesh::Point>& xyz = fe->get_xyz();
+    const std::vector<Real>& JxW           = fe.get_JxW();
+    const std::vector<libMesh::Point>& xyz = fe.get_xyz();
 
     const unsigned int
-    n_phi = (unsigned int)fe->get_phi().size(),
+    n_phi = (unsigned int)fe.get_phi().size(),
     n1    = this->n_direct_strain_components(),
     n2    = 6*n_phi,
     n3    = this->n_von_karman_strain_components();
     
     RealMatrixX
-    material_exp_A_mat,
-    material_exp_B_mat,
-    material_exp_A_mat_sens,
-    material_exp_B_mat_sens,
-    mat1_n1n2       = RealMatrixX::Zero(n1,n2),
-    mat2_n2n2       = RealMatrixX::Zero(n2,n2),
-    mat3            = RealMatrixX::Zero(2, n2),
-    mat4_n3n2       = RealMatrixX::Zero(n3,n2),
-    vk_dwdxi_mat    = RealMatrixX::Zero(n1,n3),
-    stress          = RealMatrixX::Zero(2,2),
-    mat_x           = RealMatrixX::Zero(3,2),
-    mat_y           = RealMatrixX::Zero(3,2),
-    local_jac       = RealMatrixX::Zero(n2,n2);
+    &material_exp_A_mat      = ws.matrix(n1,1),
+    &material_exp_B_mat      = ws.matrix(n1,1),
+    &material_exp_A_mat_sens = ws.matrix(n1,1),
+    &material_exp_B_mat_sens = ws.matrix(n1,1),
+    &mat2_n2n2               = ws.matrix(n2,n2),
+    &mat3                    = ws.matrix(2, n2),
+    &vk_dwdxi_mat            = ws.matrix(n1,n3),
+    &stress                  = ws.matrix(2,2),
+    &mat_x                   = ws.matrix(3,2),
+    &mat_y                   = ws.matrix(3,2),
+    &local_jac               = ws.matrix(n2,n2);
     
     RealVectorX
-    vec1_n1      = RealVectorX::Zero(n1),
-    vec2_n1      = RealVectorX::Zero(n1),
-    vec3_n2      = RealVectorX::Zero(n2),
-    vec4_2       = RealVectorX::Zero(2),
-    vec5_n1      = RealVectorX::Zero(n1),
-    local_f      = RealVectorX::Zero(n2),
-    strain       = RealVectorX::Zero(3),
-    delta_t      = RealVectorX::Zero(1),
-    delta_t_sens = RealVectorX::Zero(1);
+    &vec1_n1      = ws.vector(n1),
+    &vec2_n1      = ws.vector(n1),
+    &vec3_n2      = ws.vector(n2),
+    &vec4_2       = ws.vector(2),
+    &vec5_n1      = ws.vector(n1),
+    &local_f      = ws.vector(n2),
+    &strain       = ws.vector(3),
+    &delta_t      = ws.vector(1),
+    &delta_t_sens = ws.vector(1);
     
     FEMOperatorMatrix
-    Bmat_lin,
-    Bmat_nl_x,
-    Bmat_nl_y,
-    Bmat_nl_u,
-    Bmat_nl_v,
-    Bmat_bend,
-    Bmat_vk;
-    
-    Bmat_lin.reinit(n1, _system.n_vars(), n_phi); // three stress-strain components
-    Bmat_nl_x.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_y.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_u.reinit(2, _system.n_vars(), n_phi);
-    Bmat_nl_v.reinit(2, _system.n_vars(), n_phi);
-    Bmat_bend.reinit(n1, _system.n_vars(), n_phi);
-    Bmat_vk.reinit(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
+    &Bmat_lin   = ws.operator_matrix(n1, _system.n_vars(), n_phi), // three stress-strain components
+    &Bmat_nl_x  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_y  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_u  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_nl_v  = ws.operator_matrix(2, _system.n_vars(), n_phi),
+    &Bmat_bend  = ws.operator_matrix(n1, _system.n_vars(), n_phi),
+    &Bmat_vk    = ws.operator_matrix(n3, _system.n_vars(), n_phi); // only dw/dx and dw/dy
 
     bool if_vk = (_property.strain_type() == MAST::NONLINEAR_STRAIN);
     
-    MAST::BendingOperatorType
-    bending_model = _property.bending_model(_elem);
-    
-    std::unique_ptr<MAST::BendingOperator2D> bend;
-    
-    if (bending_model != MAST::NO_BENDING)
-        bend.reset(MAST::build_bending_operator_2D(bending_model,
-                                                   *this,
-                                                   fe->get_qpoints()).release());
+    MAST::BendingOperator2D*
+    bend = _bending_operator(fe.get_qpoints());
 
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    expansion_A = _property.thermal_expansion_A_matrix(*this),
-    expansion_B = _property.thermal_expansion_B_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *expansion_A = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_A_MATRIX, *this),
+    *expansion_B = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_B_MATRIX, *this);
     
     // temperature function
     const MAST::FieldFunction<Real>
@@ -2738,21 +2955,21 @@ thermal_residual_sensitivity (const MAST::FunctionBase& p,
         delta_t_sens(0) = t_sens;
         
         // now prepare the membrane force sensitivity
-        vec1_n1 = material_exp_A_mat * delta_t_sens; // [C]{alpha dT/dp} (with membrane strain)
-        vec2_n1 = material_exp_A_mat_sens * delta_t; // d([C]alpha)/dp (T - T0)} (with membrane strain)
+        vec1_n1.noalias() = material_exp_A_mat * delta_t_sens; // [C]{alpha dT/dp} (with membrane strain)
+        vec2_n1.noalias() = material_exp_A_mat_sens * delta_t; // d([C]alpha)/dp (T - T0)} (with membrane strain)
         vec1_n1 += vec2_n1;
         stress(0,0) = vec1_n1(0); // sigma_xx
         stress(0,1) = vec1_n1(2); // sigma_xy
         stress(1,0) = vec1_n1(2); // sigma_yx
         stress(1,1) = vec1_n1(1); // sigma_yy
         
-        vec2_n1 = material_exp_B_mat * delta_t_sens; // [C]{alpha dT/dp} (with bending strain)
-        vec5_n1 = material_exp_B_mat_sens * delta_t; // d([C] alpha)/dp (T - T0) (with bending strain)
+        vec2_n1.noalias() = material_exp_B_mat * delta_t_sens; // [C]{alpha dT/dp} (with bending strain)
+        vec5_n1.noalias() = material_exp_B_mat_sens * delta_t; // d([C] alpha)/dp (T - T0) (with bending strain)
         vec2_n1 += vec5_n1;
         
         
         this->initialize_green_lagrange_strain_operator(qp,
-                                                        *fe,
+                                                        fe,
                                                         _local_sol,
                                                         strain,
                                                         mat_x,
@@ -2771,19 +2988,19 @@ thermal_residual_sensitivity (const MAST::FunctionBase& p,
             
             // nonlinear strain operotor
             // x
-            vec4_2 = mat_x.transpose() * vec1_n1;
+            vec4_2.noalias() = mat_x.transpose() * vec1_n1;
             Bmat_nl_x.vector_mult_transpose(vec3_n2, vec4_2);
             local_f.topRows(n2) += JxW[qp] * vec3_n2;
             
             // y
-            vec4_2 = mat_y.transpose() * vec1_n1;
+            vec4_2.noalias() = mat_y.transpose() * vec1_n1;
             Bmat_nl_y.vector_mult_transpose(vec3_n2, vec4_2);
             local_f.topRows(n2) += JxW[qp] * vec3_n2;
         }
 
-        if (bend.get()) {
+        if (bend) {
             // bending strain
-            bend->initialize_bending_strain_operator(*fe, qp, Bmat_bend);
+            bend->initialize_bending_strain_operator(fe, qp, Bmat_bend);
             Bmat_bend.vector_mult_transpose(vec3_n2, vec2_n1);
             local_f += JxW[qp] * vec3_n2;
             
@@ -2791,12 +3008,12 @@ thermal_residual_sensitivity (const MAST::FunctionBase& p,
             if (if_vk) {
                 // get the vonKarman strain operator if needed
                 this->initialize_von_karman_strain_operator(qp,
-                                                            *fe,
+                                                            fe,
                                                             vec2_n1, // epsilon_vk
                                                             vk_dwdxi_mat,
                                                             Bmat_vk);
                 // von Karman strain
-                vec4_2 = vk_dwdxi_mat.transpose() * vec1_n1;
+                vec4_2.noalias() = vk_dwdxi_mat.transpose() * vec1_n1;
                 Bmat_vk.vector_mult_transpose(vec3_n2, vec4_2);
                 local_f += JxW[qp] * vec3_n2;
             }
@@ -2819,7 +3036,6 @@ thermal_residual_sensitivity (const MAST::FunctionBase& p,
         if (request_jacobian && if_vk) { // Jacobian only for vk strain
             
             // vk - vk
-            mat3 = RealMatrixX::Zero(2, n2);
             Bmat_vk.left_multiply(mat3, stress);
             Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
             local_jac += JxW[qp] * mat2_n2n2;
@@ -2920,9 +3136,9 @@ thermal_residual_boundary_velocity(const MAST::FunctionBase& p,
                                                    *this,
                                                    fe->get_qpoints()).release());
 
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    expansion_A = _property.thermal_expansion_A_matrix(*this),
-    expansion_B = _property.thermal_expansion_B_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *expansion_A = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_A_MATRIX, *this),
+    *expansion_B = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_B_MATRIX, *this);
     
     const MAST::FieldFunction<Real>
     &temp_func     = bc.get<MAST::FieldFunction<Real> >("temperature"),
@@ -2936,7 +3152,7 @@ thermal_residual_boundary_velocity(const MAST::FunctionBase& p,
     // modify the JxW_Vn by multiplying the normal velocity to it
     for (unsigned int qp=0; qp<JxW_Vn.size(); qp++) {
         
-        vel_f(xyz[qp], _time, vel);
+        this->boundary_velocity(vel_f, *fe, qp, vel);
         vn = 0.;
         for (unsigned int i=0; i<dim; i++)
             vn += vel(i)*face_normals[qp](i);
@@ -3121,9 +3337,9 @@ thermal_residual_temperature_derivative(const MAST::FEBase& fe_thermal,
                                                    *this,
                                                    fe_str->get_qpoints()).release());
 
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    expansion_A = _property.thermal_expansion_A_matrix(*this),
-    expansion_B = _property.thermal_expansion_B_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *expansion_A = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_A_MATRIX, *this),
+    *expansion_B = &_workspace.property_matrix(_property, MAST::THERMAL_EXPANSION_B_MATRIX, *this);
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
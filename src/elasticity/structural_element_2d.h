@@ -22,6 +22,7 @@
 
 // C++ includes
 #include <memory>
+#include <vector>
 
 
 // MAST includes
@@ -50,6 +51,15 @@ namespace MAST {
         
         virtual ~StructuralElement2D();
         
+        /*!
+         *    if \p true (default), \p internal_residual uses the kernels
+         *    specialized on the number of shape functions for TRI3, QUAD4
+         *    and QUAD9 elements. If \p false, the generic kernel is used
+         *    for all element types, which is used to verify the specialized
+         *    kernels.
+         */
+        bool use_fixed_size_kernels;
+        
         /*!
          *    row dimension of the direct strain matrix, also used for the
          *    bending operator row dimension
@@ -339,7 +349,9 @@ namespace MAST {
         /*!
          *   performs integration at the quadrature point for the provided
          *   matrices. The temperature vector and matrix entities are provided for
-         *   integration
+         *   integration. The scratch vectors and matrices must be sized as
+         *   indicated by their names, with \p mat3 sized the same as
+         *   \p mat1_n1n2, so that no storage is allocated here.
          */
         virtual void
         _internal_residual_operation(bool                       if_vk,
@@ -377,7 +389,28 @@ namespace MAST {
                                      RealMatrixX&               mat2_n2n2,
                                      RealMatrixX&               mat3,
                                      RealMatrixX&               mat4_2n2,
-                                     RealMatrixX&               mat5_3n2);
+                                     RealMatrixX&               mat5_2n2);
+        
+        
+        /*!
+         *   computes the internal residual and Jacobian contributions over
+         *   all quadrature points using compile-time sized matrices for
+         *   elements with \p NPhi shape functions. This is used by
+         *   internal_residual() for TRI3, QUAD4 and QUAD9 elements and gives
+         *   results identical to _internal_residual_operation(). The
+         *   section stiffness matrices are provided at each quadrature point.
+         *   Contributions are added to \p local_f and \p local_jac.
+         */
+        template <unsigned int NPhi>
+        void
+        _internal_residual_fixed(bool                       request_jacobian,
+                                 const MAST::FEBase&        fe,
+                                 MAST::BendingOperator2D*   bend,
+                                 const std::vector<RealMatrixX>& material_A_mats,
+                                 const std::vector<RealMatrixX>& material_B_mats,
+                                 const std::vector<RealMatrixX>& material_D_mats,
+                                 RealVectorX&               local_f,
+                                 RealMatrixX&               local_jac);
         
         
         /*!
@@ -392,6 +425,26 @@ namespace MAST {
         void _convert_prestress_B_mat_to_vector(const RealMatrixX& mat,
                                                 RealVectorX& vec) const;
 
+        /*!
+         *   @returns the bending operator of this element for integration
+         *   at the quadrature points \p pts, or \p nullptr if the section
+         *   does not include bending. The operator is owned by the element.
+         *   The Mindlin operator does not depend on \p pts and is created
+         *   with the element. The DKT operator is created on first use and
+         *   recreated only if it is requested for different points.
+         */
+        MAST::BendingOperator2D*
+        _bending_operator(const std::vector<libMesh::Point>& pts);
+        
+        /*!
+         *   bending operator returned by \p _bending_operator()
+         */
+        std::unique_ptr<MAST::BendingOperator2D>  _bending_op;
+        
+        /*!
+         *   quadrature points for which \p _bending_op was created
+         */
+        std::vector<libMesh::Point>               _bending_op_pts;
     };
 }
 
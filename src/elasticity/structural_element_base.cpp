@@ -27,12 +27,14 @@
 #include "base/boundary_condition_base.h"
 #include "base/nonlinear_system.h"
 #include "base/assembly_base.h"
+#include "base/elem_workspace.h"
 #include "base/field_function_base.h"
 #include "property_cards/element_property_card_base.h"
 #include "mesh/geom_elem.h"
 #include "mesh/fe_base.h"
 #include "numerics/fem_operator_matrix.h"
 #include "numerics/utility.h"
+#include "utility/perf_log.h"
 
 
 MAST::StructuralElementBase::StructuralElementBase(MAST::SystemInitialization& sys,
@@ -260,6 +262,8 @@ MAST::StructuralElementBase::inertial_residual (bool request_jacobian,
                                                 RealMatrixX& jac_xddot,
                                                 RealMatrixX& jac_xdot,
                                                 RealMatrixX& jac) {
+    MAST_PERF_SCOPE("StructuralElementBase::inertial_residual");
+    
     
     std::unique_ptr<MAST::FEBase> fe(_elem.init_fe(false, false));
 
@@ -284,8 +288,8 @@ MAST::StructuralElementBase::inertial_residual (bool request_jacobian,
     vec2_n2    = RealVectorX::Zero(n2),
     local_f    = RealVectorX::Zero(n2);
     
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
-    mat_inertia  = _property.inertia_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_inertia  = &_workspace.property_matrix(_property, MAST::INERTIA_MATRIX, *this);
     
     MAST::FEMOperatorMatrix Bmat;
     
@@ -407,6 +411,8 @@ MAST::StructuralElementBase::inertial_residual_sensitivity (const MAST::Function
                                                             RealMatrixX& jac_xddot,
                                                             RealMatrixX& jac_xdot,
                                                             RealMatrixX& jac) {
+    MAST_PERF_SCOPE("StructuralElementBase::inertial_residual_sensitivity");
+    
     
     std::unique_ptr<MAST::FEBase> fe(_elem.init_fe(false, false));
 
@@ -431,8 +437,8 @@ MAST::StructuralElementBase::inertial_residual_sensitivity (const MAST::Function
     vec2_n2    = RealVectorX::Zero(n2),
     local_f    = RealVectorX::Zero(n2);
     
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
-    mat_inertia  = _property.inertia_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_inertia  = &_workspace.property_matrix(_property, MAST::INERTIA_MATRIX, *this);
     
     MAST::FEMOperatorMatrix Bmat;
     
@@ -548,7 +554,7 @@ inertial_residual_boundary_velocity (const MAST::FunctionBase& p,
     // modify the JxW_Vn by multiplying the normal velocity to it
     for (unsigned int qp=0; qp<JxW_Vn.size(); qp++) {
         
-        vel_f(xyz[qp], _time, vel);
+        this->boundary_velocity(vel_f, *fe, qp, vel);
         vn = 0.;
         for (unsigned int i=0; i<dim; i++)
             vn += vel(i)*face_normals[qp](i);
@@ -556,8 +562,8 @@ inertial_residual_boundary_velocity (const MAST::FunctionBase& p,
     }
     
 
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
-    mat_inertia  = _property.inertia_matrix(*this);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_inertia  = &_workspace.property_matrix(_property, MAST::INERTIA_MATRIX, *this);
     
     MAST::FEMOperatorMatrix Bmat;
     
@@ -633,6 +639,8 @@ side_external_residual(bool request_jacobian,
                        RealMatrixX& jac_xdot,
                        RealMatrixX& jac,
                        std::multimap<libMesh::boundary_id_type, MAST::BoundaryConditionBase*>& bc) {
+    MAST_PERF_SCOPE("StructuralElementBase::side_external_residual");
+    
     
     std::map<unsigned int, std::vector<MAST::BoundaryConditionBase*>> loads;
     _elem.external_side_loads_for_quadrature_elem(bc, loads);
@@ -789,6 +797,8 @@ volume_external_residual (bool request_jacobian,
                           RealMatrixX& jac_xdot,
                           RealMatrixX& jac,
                           std::multimap<libMesh::subdomain_id_type, MAST::BoundaryConditionBase*>& bc) {
+    MAST_PERF_SCOPE("StructuralElementBase::volume_external_residual");
+    
     
     // iterate over the boundary ids given in the provided force map
     std::pair<std::multimap<libMesh::subdomain_id_type, MAST::BoundaryConditionBase*>::const_iterator,
@@ -957,6 +967,8 @@ side_external_residual_sensitivity(const MAST::FunctionBase& p,
                                    RealMatrixX& jac_xdot,
                                    RealMatrixX& jac,
                                    std::multimap<libMesh::boundary_id_type, MAST::BoundaryConditionBase*>& bc) {
+    MAST_PERF_SCOPE("StructuralElementBase::side_external_residual_sensitivity");
+    
     
     std::map<unsigned int, std::vector<MAST::BoundaryConditionBase*>> loads;
     _elem.external_side_loads_for_quadrature_elem(bc, loads);
@@ -1020,6 +1032,8 @@ volume_external_residual_sensitivity (const MAST::FunctionBase& p,
                                       RealMatrixX& jac_xdot,
                                       RealMatrixX& jac,
                                       std::multimap<libMesh::subdomain_id_type, MAST::BoundaryConditionBase*>& bc) {
+    MAST_PERF_SCOPE("StructuralElementBase::volume_external_residual_sensitivity");
+    
     
     // iterate over the boundary ids given in the provided force map
     std::pair<std::multimap<libMesh::subdomain_id_type, MAST::BoundaryConditionBase*>::const_iterator,
@@ -1332,7 +1346,7 @@ surface_pressure_boundary_velocity(const MAST::FunctionBase& p,
     // modify the JxW_Vn by multiplying the normal velocity to it
     for (unsigned int qp=0; qp<JxW_Vn.size(); qp++) {
         
-        vel_f(xyz[qp], _time, vel);
+        this->boundary_velocity(vel_f, *fe, qp, vel);
         vn = 0.;
         for (unsigned int i=0; i<dim; i++)
             vn += vel(i)*face_normals[qp](i);
@@ -27,6 +27,7 @@
 #include "mesh/geom_elem.h"
 #include "base/nonlinear_system.h"
 #include "base/assembly_base.h"
+#include "base/elem_workspace.h"
 #include "base/field_function_base.h"
 
 
@@ -122,8 +123,9 @@ calculate_transverse_shear_residual(bool request_jacobian,
     Bmat_trans_v.reinit(2, 6, n_phi); // one shear stress for v-bending
     Bmat_trans_w.reinit(2, 6, n_phi); // one shear stress for w-bending
     
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX>>
-    mat_stiff = property.transverse_shear_stiffness_matrix(_structural_elem);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff = &_structural_elem.workspace().property_matrix
+    (property, MAST::TRANSVERSE_SHEAR_STIFFNESS_MATRIX, _structural_elem);
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
@@ -190,8 +192,9 @@ calculate_transverse_shear_residual_sensitivity(const MAST::FunctionBase &p,
     Bmat_trans_v.reinit(2, 6, n_phi); // one shear stress for v-bending
     Bmat_trans_w.reinit(2, 6, n_phi); // one shear stress for w-bending
     
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
-    mat_stiff = property.transverse_shear_stiffness_matrix(_structural_elem);
+    const MAST::FieldFunction<RealMatrixX>
+    *mat_stiff = &_structural_elem.workspace().property_matrix
+    (property, MAST::TRANSVERSE_SHEAR_STIFFNESS_MATRIX, _structural_elem);
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
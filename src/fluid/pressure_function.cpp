@@ -26,6 +26,7 @@
 #include "fluid/small_disturbance_primitive_fluid_solution.h"
 #include "fluid/flight_condition.h"
 #include "base/nonlinear_system.h"
+#include "base/mesh_field_function.h"
 
 
 // libMesh includes
@@ -38,6 +39,7 @@ MAST::PressureFunction::
 PressureFunction(MAST::SystemInitialization& sys,
                  MAST::FlightCondition&      flt):
 MAST::FieldFunction<Real>("pressure"),
+_ghosted          (false),
 _if_cp            (false),
 _ref_pressure     (0.),
 _system           (sys),
@@ -64,11 +66,7 @@ init(const libMesh::NumericVector<Real>& steady_sol,
     
     // first initialize the solution to the given vector
     // steady state solution
-    _sol.reset(libMesh::NumericVector<Real>::build(sys.comm()).release());
-    _sol->init(steady_sol.size(), true, libMesh::SERIAL);
-    
-    // now localize the give solution to this objects's vector
-    steady_sol.localize(*_sol);
+    _sol = this->_localize(steady_sol);
     
     
     // if the mesh function has not been created so far, initialize it
@@ -82,10 +80,7 @@ init(const libMesh::NumericVector<Real>& steady_sol,
     if (small_dist_sol) {
         
         // solution real part
-        _dsol.reset(libMesh::NumericVector<Real>::build(sys.comm()).release());
-        _dsol->init(steady_sol.size(), true, libMesh::SERIAL);
-        
-        small_dist_sol->localize(*_dsol);
+        _dsol = this->_localize(*small_dist_sol);
         
         _dsol_function.reset(new libMesh::MeshFunction(sys.get_equation_systems(),
                                                        *_dsol,
@@ -114,9 +109,6 @@ operator() (const libMesh::Point& p,
     
     libmesh_assert(_sol_function.get()); // should be initialized before this call
     
-    press  = 0.;
-    
-    
     // get the nonlinear and linearized solution
     DenseRealVector
     v;
@@ -129,21 +121,7 @@ operator() (const libMesh::Point& p,
     (*_sol_function)(p, 0., v);
     MAST::copy(sol, v);
     
-    
-    MAST::PrimitiveSolution                     p_sol;
-    
-    // now initialize the primitive variable contexts
-    p_sol.init(dynamic_cast<MAST::ConservativeFluidSystemInitialization&>(_system).dim(),
-               sol,
-               _flt_cond.gas_property.cp,
-               _flt_cond.gas_property.cv,
-               _flt_cond.gas_property.if_viscous);
-    
-    if (_if_cp)
-        press     = p_sol.c_pressure(_flt_cond.p0(), _flt_cond.q0());
-    else {
-        press     =  p_sol.p - _ref_pressure;
-    }
+    press  = this->_pressure(sol);
 }
 
 
@@ -159,9 +137,6 @@ perturbation(const libMesh::Point& p,
     libmesh_assert(_sol_function.get()); // should be initialized before this call
     libmesh_assert(_dsol_function.get()); // should be initialized before this call
     
-    dpress = 0.;
-    
-    
     // get the nonlinear and linearized solution
     DenseRealVector
     v;
@@ -173,13 +148,85 @@ perturbation(const libMesh::Point& p,
     
     // first copy the real and imaginary solutions
     (*_dsol_function)(p, 0., v);
-    MAST::copy(sol, v);
-    dsol = sol;
+    MAST::copy(dsol, v);
     
     // now the steady state function itself
     (*_sol_function)(p, 0., v);
     MAST::copy(sol, v);
     
+    dpress = this->_pressure_perturbation(sol, dsol);
+}
+
+
+
+
+void
+MAST::PressureFunction::
+operator() (const libMesh::Elem&  e,
+            const libMesh::Point& xi,
+            const Real            t,
+            Real                  &press) const {
+    
+    libmesh_assert(_sol.get()); // should be initialized before this call
+    
+    RealVectorX
+    sol;
+    
+    MAST::MeshFieldFunction::interpolate(_system.system(), *_sol, e, xi, sol, nullptr);
+    
+    press  = this->_pressure(sol);
+}
+
+
+
+
+void
+MAST::PressureFunction::
+perturbation(const libMesh::Elem&  e,
+             const libMesh::Point& xi,
+             const Real            t,
+             Real                  &dpress) const {
+    
+    libmesh_assert(_sol.get());  // should be initialized before this call
+    libmesh_assert(_dsol.get()); // should be initialized before this call
+    
+    RealVectorX
+    sol,
+    dsol;
+    
+    MAST::MeshFieldFunction::interpolate(_system.system(), *_sol,  e, xi, sol,  nullptr);
+    MAST::MeshFieldFunction::interpolate(_system.system(), *_dsol, e, xi, dsol, nullptr);
+    
+    dpress = this->_pressure_perturbation(sol, dsol);
+}
+
+
+
+
+Real
+MAST::PressureFunction::_pressure(const RealVectorX& sol) const {
+    
+    MAST::PrimitiveSolution                     p_sol;
+    
+    // now initialize the primitive variable contexts
+    p_sol.init(dynamic_cast<MAST::ConservativeFluidSystemInitialization&>(_system).dim(),
+               sol,
+               _flt_cond.gas_property.cp,
+               _flt_cond.gas_property.cv,
+               _flt_cond.gas_property.if_viscous);
+    
+    if (_if_cp)
+        return p_sol.c_pressure(_flt_cond.p0(), _flt_cond.q0());
+    else
+        return p_sol.p - _ref_pressure;
+}
+
+
+
+
+Real
+MAST::PressureFunction::_pressure_perturbation(const RealVectorX& sol,
+                                               const RealVectorX& dsol) const {
     
     MAST::PrimitiveSolution                     p_sol;
     SmallPerturbationPrimitiveSolution<Real> delta_p_sol;
@@ -195,8 +242,39 @@ perturbation(const libMesh::Point& p,
                      _flt_cond.gas_property.if_viscous);
     
     if (_if_cp)
-        dpress    = delta_p_sol.c_pressure(_flt_cond.q0());
+        return delta_p_sol.c_pressure(_flt_cond.q0());
     else
-        dpress    =  delta_p_sol.dp;
+        return delta_p_sol.dp;
 }
 
+
+
+
+std::unique_ptr<libMesh::NumericVector<Real>>
+MAST::PressureFunction::_localize(const libMesh::NumericVector<Real>& v) const {
+    
+    MAST::NonlinearSystem& sys = _system.system();
+    
+    std::unique_ptr<libMesh::NumericVector<Real>>
+    local(libMesh::NumericVector<Real>::build(sys.comm()).release());
+    
+    if (_ghosted) {
+        
+        const std::vector<libMesh::dof_id_type>&
+        send_list = sys.get_dof_map().get_send_list();
+        
+        local->init(sys.n_dofs(),
+                    sys.n_local_dofs(),
+                    send_list,
+                    false,
+                    libMesh::GHOSTED);
+        v.localize(*local, send_list);
+    }
+    else {
+        
+        local->init(v.size(), true, libMesh::SERIAL);
+        v.localize(*local);
+    }
+    
+    return local;
+}
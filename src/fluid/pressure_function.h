@@ -72,6 +72,19 @@ namespace MAST {
         }
 
         
+        /*!
+         *   if \p f is true, init() localizes the solutions only to the
+         *   send-list of the system instead of a serial copy on each
+         *   processor. The pressure can then be evaluated only on elements
+         *   that are local or ghosted on this processor. This must be
+         *   called before init().
+         */
+        void set_ghosted_localization(bool f) {
+            
+            _ghosted = f;
+        }
+        
+        
         /*!
          *   initiate the mesh function for this solution
          */
@@ -98,8 +111,56 @@ namespace MAST {
                      Real& dpress) const;
 
         
+        /*!
+         *   provides the value of the pressure at the reference coordinate
+         *   \p xi of element \p e of the fluid mesh. This does not search
+         *   for the element, and should be used when the element is known.
+         */
+        void
+        operator() (const libMesh::Elem& e,
+                    const libMesh::Point& xi,
+                    const Real t,
+                    Real& press) const;
+        
+        
+        /*!
+         *   provides the pressure perturbation at the reference coordinate
+         *   \p xi of element \p e of the fluid mesh.
+         */
+        void
+        perturbation(const libMesh::Elem& e,
+                     const libMesh::Point& xi,
+                     const Real t,
+                     Real& dpress) const;
+
+        
     protected:
 
+        /*!
+         *   computes the pressure from the conservative solution \p sol
+         */
+        Real _pressure(const RealVectorX& sol) const;
+        
+        /*!
+         *   computes the pressure perturbation from the conservative
+         *   solution \p sol and its perturbation \p dsol
+         */
+        Real _pressure_perturbation(const RealVectorX& sol,
+                                    const RealVectorX& dsol) const;
+        
+        /*!
+         *   @returns a copy of \p v localized to this processor according
+         *   to the localization mode.
+         */
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        _localize(const libMesh::NumericVector<Real>& v) const;
+        
+        /*!
+         *    the solution is localized to the send-list of the system if
+         *    this is true, otherwise it is serialized.
+         */
+        bool _ghosted;
+        
         /*!
          *    the function will return cp instead of pressure if this option is
          *    true.
@@ -19,6 +19,9 @@
 
 // C++ includes
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 // MAST includes
 #include "level_set/filter_base.h"
@@ -27,6 +30,186 @@
 #include "libmesh/mesh_base.h"
 #include "libmesh/node.h"
 #include "libmesh/numeric_vector.h"
+#include "libmesh/threads.h"
+#include "libmesh/parallel_sync.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/petsc_matrix.h"
+#include "libmesh/petsc_vector.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   node location and level set dof used in the neighbor search
+     */
+    struct FilterNode {
+        libMesh::Point       p;
+        libMesh::dof_id_type id;
+        unsigned int         dof;
+        bool                 target;
+    };
+    
+    
+    inline bool
+    filter_node_id_less(const MAST::FilterNode& a, const MAST::FilterNode& b) {
+        return a.id < b.id;
+    }
+    
+    
+    /*!
+     *   uniform grid of bins of the size of the filter radius. The nodes
+     *   are sorted by their bin key, so that the nodes in a bin are found
+     *   with a binary search. Nodes within the filter radius of a point
+     *   are located in the 27 bins surrounding the bin of the point.
+     */
+    class FilterBins {
+    public:
+        
+        FilterBins(const std::vector<MAST::FilterNode>& nodes,
+                   const Real radius):
+        _radius (radius) {
+            
+            libmesh_assert(nodes.size());
+            
+            for (unsigned int i=0; i<3; i++) {
+                _x0[i] = nodes[0].p(i);
+                _n[i]  = 1;
+            }
+            
+            for (unsigned int j=1; j<nodes.size(); j++)
+                for (unsigned int i=0; i<3; i++)
+                    _x0[i] = std::min(_x0[i], nodes[j].p(i));
+            
+            for (unsigned int j=0; j<nodes.size(); j++)
+                for (unsigned int i=0; i<3; i++)
+                    _n[i] = std::max(_n[i], this->_bin(nodes[j].p, i)+1);
+            
+            _keys.resize(nodes.size());
+            for (unsigned int j=0; j<nodes.size(); j++)
+                _keys[j] = std::make_pair(this->_key(this->_bin(nodes[j].p, 0),
+                                                     this->_bin(nodes[j].p, 1),
+                                                     this->_bin(nodes[j].p, 2)),
+                                          j);
+            std::sort(_keys.begin(), _keys.end());
+        }
+        
+        
+        /*!
+         *   adds the indices of nodes in the bins neighboring \p p to
+         *   \p nbrs, sorted in increasing order.
+         */
+        void neighbor_candidates(const libMesh::Point& p,
+                                 std::vector<unsigned int>& nbrs) const {
+            
+            nbrs.clear();
+            
+            const unsigned long
+            b0 = this->_bin(p, 0),
+            b1 = this->_bin(p, 1),
+            b2 = this->_bin(p, 2);
+            
+            for (unsigned long k=(b2?b2-1:0); k<=std::min(b2+1, _n[2]-1); k++)
+                for (unsigned long j=(b1?b1-1:0); j<=std::min(b1+1, _n[1]-1); j++)
+                    for (unsigned long i=(b0?b0-1:0); i<=std::min(b0+1, _n[0]-1); i++) {
+                        
+                        std::vector<std::pair<unsigned long, unsigned int>>::const_iterator
+                        it  = std::lower_bound(_keys.begin(),
+                                               _keys.end(),
+                                               std::make_pair(this->_key(i, j, k), 0u));
+                        
+                        for ( ; it != _keys.end() && it->first == this->_key(i, j, k); it++)
+                            nbrs.push_back(it->second);
+                    }
+            
+            std::sort(nbrs.begin(), nbrs.end());
+        }
+        
+    protected:
+        
+        unsigned long _bin(const libMesh::Point& p, unsigned int i) const {
+            return (unsigned long)std::floor((p(i) - _x0[i])/_radius);
+        }
+        
+        unsigned long _key(unsigned long i, unsigned long j, unsigned long k) const {
+            return i + _n[0] * (j + _n[1] * k);
+        }
+        
+        Real                                               _radius;
+        Real                                               _x0[3];
+        unsigned long                                      _n[3];
+        std::vector<std::pair<unsigned long, unsigned int>> _keys;
+    };
+    
+    
+    /*!
+     *   computes the filter coefficients for a range of target nodes.
+     */
+    class FilterWeightsBody {
+    public:
+        
+        FilterWeightsBody(const std::vector<MAST::FilterNode>&  nodes,
+                          const std::vector<unsigned int>&      targets,
+                          const MAST::FilterBins&               bins,
+                          const Real                            radius,
+                          std::vector<std::vector<std::pair<unsigned int, Real>>>& weights):
+        _nodes   (nodes),
+        _targets (targets),
+        _bins    (bins),
+        _radius  (radius),
+        _weights (weights) { }
+        
+        void operator() (const libMesh::Threads::BlockedRange<std::size_t>& range) const {
+            
+            std::vector<unsigned int> nbrs;
+            libMesh::Point d;
+            Real
+            d_12 = 0.,
+            sum  = 0.;
+            
+            for (std::size_t i=range.begin(); i<range.end(); i++) {
+                
+                const MAST::FilterNode& n1 = _nodes[_targets[i]];
+                std::vector<std::pair<unsigned int, Real>>& vec = _weights[i];
+                
+                _bins.neighbor_candidates(n1.p, nbrs);
+                sum = 0.;
+                
+                // the candidates are visited in the order of node ids, so
+                // that the coefficients and their sum are accumulated in the
+                // same order as a loop over all mesh nodes
+                for (unsigned int j=0; j<nbrs.size(); j++) {
+                    
+                    const MAST::FilterNode& n2 = _nodes[nbrs[j]];
+                    
+                    d    = n1.p - n2.p;
+                    d_12 = d.norm();
+                    
+                    if (d_12 <= _radius) {
+                        
+                        sum  += _radius - d_12;
+                        vec.push_back(std::pair<unsigned int, Real>(n2.dof, _radius - d_12));
+                    }
+                }
+                
+                libmesh_assert_greater(sum, 0.);
+                
+                for (unsigned int j=0; j<vec.size(); j++) {
+                    
+                    vec[j].second /= sum;
+                    libmesh_assert_less_equal(vec[j].second, 1.);
+                }
+            }
+        }
+        
+    protected:
+        
+        const std::vector<MAST::FilterNode>&                      _nodes;
+        const std::vector<unsigned int>&                          _targets;
+        const MAST::FilterBins&                                   _bins;
+        const Real                                                _radius;
+        std::vector<std::vector<std::pair<unsigned int, Real>>>&  _weights;
+    };
+}
 
 
 
@@ -53,37 +236,37 @@ void
 MAST::FilterBase::compute_filtered_values(const libMesh::NumericVector<Real>& input,
                                           libMesh::NumericVector<Real>& output) const {
     
-    libmesh_assert_equal_to(input.size(), _filter_map.size());
-    libmesh_assert_equal_to(output.size(), _filter_map.size());
+    libmesh_assert(_filter);
+    libmesh_assert_equal_to(input.size(), _filter->m());
+    libmesh_assert_equal_to(output.size(), _filter->m());
     
-    output.zero();
+    _filter->vector_mult(output, input);
+}
+
+
+
+void
+MAST::FilterBase::
+compute_filtered_sensitivity_transpose(const libMesh::NumericVector<Real>& dJ_dphi_filtered,
+                                       libMesh::NumericVector<Real>& dJ_dphi) const {
     
-    std::vector<Real> input_vals(input.size(), 0.);
-    input.localize(input_vals);
+    libmesh_assert(_filter);
+    libmesh_assert_equal_to(dJ_dphi_filtered.size(), _filter->m());
+    libmesh_assert_equal_to(dJ_dphi.size(), _filter->m());
     
-    std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>>::const_iterator
-    map_it   = _filter_map.begin(),
-    map_end  = _filter_map.end();
+    libMesh::PetscMatrix<Real>
+    &mat = dynamic_cast<libMesh::PetscMatrix<Real>&>(*_filter);
     
-    for ( ; map_it != map_end; map_it++) {
-        
-        std::vector<std::pair<unsigned int, Real>>::const_iterator
-        vec_it  = map_it->second.begin(),
-        vec_end = map_it->second.end();
-        
-        for ( ; vec_it != vec_end; vec_it++) {
-            if (map_it->first >= input.first_local_index() &&
-                map_it->first <  input.last_local_index()) {
-                
-                if (_dv_dof_ids.count(map_it->first))
-                    output.add(map_it->first, input_vals[vec_it->first] * vec_it->second);
-                else
-                    output.set(map_it->first, input_vals[map_it->first]);
-            }
-        }
-    }
+    libMesh::PetscVector<Real>
+    &x   = dynamic_cast<libMesh::PetscVector<Real>&>
+    (const_cast<libMesh::NumericVector<Real>&>(dJ_dphi_filtered)),
+    &y   = dynamic_cast<libMesh::PetscVector<Real>&>(dJ_dphi);
+    
+    PetscErrorCode
+    ierr = MatMultTranspose(mat.mat(), x.vec(), y.vec());
+    CHKERRABORT(_level_set_system.comm().get(), ierr);
     
-    output.close();
+    y.close();
 }
 
 
@@ -93,8 +276,11 @@ void
 MAST::FilterBase::compute_filtered_values(const std::vector<Real>& input,
                                           std::vector<Real>& output) const {
     
-    libmesh_assert_equal_to(input.size(), _filter_map.size());
-    libmesh_assert_equal_to(output.size(), _filter_map.size());
+    // the vectors store the values of all dofs on all processors. On a
+    // distributed mesh the filter map only has the rows of the local nodes,
+    // so each processor computes its rows and the rows are summed.
+    libmesh_assert_equal_to(input.size(), _level_set_system.n_dofs());
+    libmesh_assert_equal_to(output.size(), _level_set_system.n_dofs());
 
     std::fill(output.begin(), output.end(), 0.);
     
@@ -108,13 +294,18 @@ MAST::FilterBase::compute_filtered_values(const std::vector<Real>& input,
         vec_it  = map_it->second.begin(),
         vec_end = map_it->second.end();
         
-        for ( ; vec_it != vec_end; vec_it++) {
-            if (_dv_dof_ids.count(map_it->first))
+        // rows that are not design variables are identity, as in the
+        // filter matrix
+        if (_dv_dof_ids.count(map_it->first)) {
+            for ( ; vec_it != vec_end; vec_it++)
                 output[map_it->first] += input[vec_it->first] * vec_it->second;
-            else
-                output[map_it->first] += input[map_it->first];
         }
+        else
+            output[map_it->first] = input[map_it->first];
     }
+    
+    if (!_level_set_system.get_mesh().is_replicated())
+        _level_set_system.comm().sum(output);
 }
 
 
@@ -155,62 +346,77 @@ MAST::FilterBase::_init() {
     
     libMesh::MeshBase& mesh = _level_set_system.get_mesh();
     
-    // currently implemented for replicated mesh
-    libmesh_assert(mesh.is_replicated());
+    const unsigned int
+    sys_num  = _level_set_system.number();
     
-    // iterate over all nodes to compute the
-    libMesh::MeshBase::const_node_iterator
-    node_it_1    =  mesh.nodes_begin(),
-    node_it_2    =  mesh.nodes_begin(),
-    node_end     =  mesh.nodes_end();
+    const libMesh::processor_id_type
+    rank     = mesh.comm().rank();
     
-    libMesh::Point
-    d;
+    // on a replicated mesh the filter is computed for all nodes. On a
+    // distributed mesh it is computed for the local nodes, and the nodes
+    // within one filter radius from other processors are added to the search
+    const bool
+    replicated = mesh.is_replicated();
     
-    Real
-    d_12 = 0.,
-    sum  = 0.;
+    std::vector<MAST::FilterNode> nodes;
+    nodes.reserve(mesh.n_nodes());
     
-    unsigned int
-    dof_1,
-    dof_2;
+    libMesh::MeshBase::const_node_iterator
+    node_it    =  mesh.nodes_begin(),
+    node_end   =  mesh.nodes_end();
     
-    for ( ; node_it_1 != node_end; node_it_1++) {
+    for ( ; node_it != node_end; node_it++) {
         
-        dof_1 = (*node_it_1)->dof_number(_level_set_system.number(), 0, 0);
+        const libMesh::Node* n = *node_it;
         
-        node_it_2 = mesh.nodes_begin();
-        sum       = 0.;
+        MAST::FilterNode fn;
+        fn.p      = *n;
+        fn.id     = n->id();
+        fn.dof    = n->dof_number(sys_num, 0, 0);
+        fn.target = replicated || n->processor_id() == rank;
+        nodes.push_back(fn);
+    }
+    
+    if (!replicated)
+        _add_remote_nodes_in_filter_radius(nodes);
+    
+    // sort the nodes by id, which is the order in which the nodes are
+    // iterated. Remote copies of nodes already available on this processor
+    // are removed.
+    std::stable_sort(nodes.begin(), nodes.end(), MAST::filter_node_id_less);
+    {
+        std::vector<MAST::FilterNode> unique_nodes;
+        unique_nodes.reserve(nodes.size());
+        for (unsigned int i=0; i<nodes.size(); i++)
+            if (!unique_nodes.size() || unique_nodes.back().id != nodes[i].id)
+                unique_nodes.push_back(nodes[i]);
+        nodes.swap(unique_nodes);
+    }
+    
+    std::vector<unsigned int> targets;
+    for (unsigned int i=0; i<nodes.size(); i++)
+        if (nodes[i].target)
+            targets.push_back(i);
+    
+    if (nodes.size()) {
         
-        for ( ; node_it_2 != node_end; node_it_2++) {
-            
-            // compute the distance between the two nodes
-            d    = (**node_it_1) - (**node_it_2);
-            d_12 = d.norm();
-            
-            // if the nodes is within the filter radius, add it to the map
-            if (d_12 <= _radius) {
-                
-                sum  += _radius - d_12;
-                dof_2 = (*node_it_2)->dof_number(_level_set_system.number(), 0, 0);
-
-                _filter_map[dof_1].push_back(std::pair<unsigned int, Real>(dof_2, _radius - d_12));
-            }
-        }
+        MAST::FilterBins bins(nodes, _radius);
         
-        libmesh_assert_greater(sum, 0.);
+        std::vector<std::vector<std::pair<unsigned int, Real>>>
+        weights(targets.size());
         
-        // with the coefficients computed for dof_1, divide each coefficient
-        // with the sum
-        std::vector<std::pair<unsigned int, Real>>& vec = _filter_map[dof_1];
-        for (unsigned int i=0; i<vec.size(); i++) {
-            
-            vec[i].second /= sum;
-            libmesh_assert_less_equal(vec[i].second, 1.);
-        }
+        libMesh::Threads::parallel_for
+        (libMesh::Threads::BlockedRange<std::size_t>(0, targets.size()),
+         MAST::FilterWeightsBody(nodes, targets, bins, _radius, weights));
+        
+        for (unsigned int i=0; i<targets.size(); i++)
+            _filter_map[nodes[targets[i]].dof].swap(weights[i]);
     }
     
     // compute the largest element size
+    Real
+    d_12 = 0.;
+    
     libMesh::MeshBase::const_element_iterator
     e_it          = mesh.elements_begin(),
     e_end         = mesh.elements_end();
@@ -222,13 +428,172 @@ MAST::FilterBase::_init() {
         if (_level_set_fe_size < d_12)
             _level_set_fe_size = d_12;
     }
+    
+    if (!replicated)
+        mesh.comm().max(_level_set_fe_size);
+    
+    _init_filter_matrix();
+}
+
+
+
+void
+MAST::FilterBase::_init_filter_matrix() {
+    
+    const libMesh::DofMap&
+    dof_map = _level_set_system.get_dof_map();
+    
+    const libMesh::dof_id_type
+    first   = dof_map.first_dof(),
+    end     = dof_map.end_dof(),
+    n       = dof_map.n_dofs(),
+    n_l     = dof_map.n_local_dofs();
+    
+    // number of nonzeros in the diagonal and off-diagonal blocks of the
+    // local rows
+    std::vector<libMesh::numeric_index_type>
+    n_nz (n_l, 0),
+    n_oz (n_l, 0);
+    
+    std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>>::const_iterator
+    map_it   = _filter_map.lower_bound(first),
+    map_end  = _filter_map.lower_bound(end);
+    
+    for ( ; map_it != map_end; map_it++) {
+        
+        const unsigned int
+        row = map_it->first - first;
+        
+        if (_dv_dof_ids.count(map_it->first)) {
+            
+            for (unsigned int i=0; i<map_it->second.size(); i++) {
+                
+                if (map_it->second[i].first >= first &&
+                    map_it->second[i].first <  end)
+                    n_nz[row]++;
+                else
+                    n_oz[row]++;
+            }
+        }
+        else
+            n_nz[row] = 1;
+    }
+    
+    libMesh::PetscMatrix<Real>*
+    mat = new libMesh::PetscMatrix<Real>(_level_set_system.comm());
+    mat->init(n, n, n_l, n_l, n_nz, n_oz);
+    _filter.reset(mat);
+    
+    map_it   = _filter_map.lower_bound(first);
+    
+    for ( ; map_it != map_end; map_it++) {
+        
+        if (_dv_dof_ids.count(map_it->first)) {
+            
+            for (unsigned int i=0; i<map_it->second.size(); i++)
+                _filter->set(map_it->first,
+                             map_it->second[i].first,
+                             map_it->second[i].second);
+        }
+        else
+            _filter->set(map_it->first, map_it->first, 1.);
+    }
+    
+    _filter->close();
 }
 
 
+
+void
+MAST::FilterBase::
+_add_remote_nodes_in_filter_radius(std::vector<MAST::FilterNode>& nodes) const {
+    
+    const libMesh::Parallel::Communicator&
+    comm = _level_set_system.comm();
+    
+    const libMesh::processor_id_type
+    rank = comm.rank();
+    
+    // bounding box of the local nodes expanded by the filter radius
+    std::vector<Real>
+    box(6, 0.);
+    for (unsigned int i=0; i<3; i++) {
+        box[i]   =  std::numeric_limits<Real>::max();
+        box[i+3] = -std::numeric_limits<Real>::max();
+    }
+    
+    for (unsigned int j=0; j<nodes.size(); j++)
+        if (nodes[j].target)
+            for (unsigned int i=0; i<3; i++) {
+                box[i]   = std::min(box[i],   nodes[j].p(i) - _radius);
+                box[i+3] = std::max(box[i+3], nodes[j].p(i) + _radius);
+            }
+    
+    comm.allgather(box, true);
+    
+    // send the local nodes that lie within the expanded box of each
+    // processor. Each node is packed as x, y, z, id, dof.
+    std::map<libMesh::processor_id_type, std::vector<Real>> send_data;
+    
+    for (libMesh::processor_id_type q=0; q<comm.size(); q++) {
+        
+        if (q == rank)
+            continue;
+        
+        const Real* b = &box[6*q];
+        
+        for (unsigned int j=0; j<nodes.size(); j++) {
+            
+            const MAST::FilterNode& n = nodes[j];
+            
+            if (n.target &&
+                n.p(0) >= b[0] && n.p(0) <= b[3] &&
+                n.p(1) >= b[1] && n.p(1) <= b[4] &&
+                n.p(2) >= b[2] && n.p(2) <= b[5]) {
+                
+                std::vector<Real>& v = send_data[q];
+                v.push_back(n.p(0));
+                v.push_back(n.p(1));
+                v.push_back(n.p(2));
+                v.push_back(n.id);
+                v.push_back(n.dof);
+            }
+        }
+    }
+    
+    std::vector<MAST::FilterNode> received;
+    
+    auto receive_nodes =
+    [&received] (libMesh::processor_id_type, const std::vector<Real>& v) {
+        
+        libmesh_assert_equal_to(v.size()%5, 0);
+        
+        for (unsigned int j=0; j<v.size()/5; j++) {
+            
+            MAST::FilterNode fn;
+            fn.p      = libMesh::Point(v[5*j], v[5*j+1], v[5*j+2]);
+            fn.id     = (libMesh::dof_id_type)v[5*j+3];
+            fn.dof    = (unsigned int)v[5*j+4];
+            fn.target = false;
+            received.push_back(fn);
+        }
+    };
+    
+    libMesh::Parallel::push_parallel_vector_data(comm, send_data, receive_nodes);
+    
+    nodes.insert(nodes.end(), received.begin(), received.end());
+}
+
+
+
 void
 MAST::FilterBase::print(std::ostream& o) const {
     
     o << "Filter radius: " << _radius << std::endl;
+    
+    // on a distributed mesh only the rows of the local nodes are available
+    if (!_level_set_system.get_mesh().is_replicated())
+        o << "Rows on processor: " << _level_set_system.comm().rank() << std::endl;
 
     o
     << std::setw(20) << "Filtered ID"
@@ -254,9 +619,9 @@ MAST::FilterBase::print(std::ostream& o) const {
                 << " : " << std::setw(8) << vec_it->first
                 << " (" << std::setw(8) << vec_it->second << " )";
             else
-                libMesh::out << " : " << map_it->first;
+                o << " : " << map_it->first;
         }
-        libMesh::out << std::endl;
+        o << std::endl;
     }
 }
 
@@ -25,14 +25,21 @@
 // MAST includes
 #include "base/mast_data_types.h"
 
+// C++ includes
+#include <memory>
+
 // libMesh includes
 #include "libmesh/system.h"
 #include "libmesh/node.h"
 #include "libmesh/elem.h"
+#include "libmesh/sparse_matrix.h"
 
 
 namespace MAST {
     
+    // Forward declerations
+    struct FilterNode;
+    
     /*!
      *   Creates a geometric filter for the level-set design variables.
      */
@@ -48,12 +55,29 @@ namespace MAST {
         virtual ~FilterBase();
         
         /*!
-         *   computes the filtered output from the provided input.
+         *   computes the filtered output from the provided input as a
+         *   parallel product with the assembled filter matrix,
+         *   \f$ \tilde{\phi} = B \phi \f$.
          */
         void compute_filtered_values(const libMesh::NumericVector<Real>& input,
                                      libMesh::NumericVector<Real>& output) const;
 
-        
+        /*!
+         *   applies the chain rule through the filter. Given the derivative
+         *   of a function wrt the filtered values in \p dJ_dphi_filtered,
+         *   this computes the derivative wrt the unfiltered values,
+         *   \f$ dJ/d\phi = B^T dJ/d\tilde{\phi} \f$, in \p dJ_dphi.
+         */
+        void compute_filtered_sensitivity_transpose(const libMesh::NumericVector<Real>& dJ_dphi_filtered,
+                                                    libMesh::NumericVector<Real>& dJ_dphi) const;
+
+        /*!
+         *   computes the filtered output from the provided input, where
+         *   both vectors store the values of all dofs of the level set
+         *   system and are identical on all processors. On a distributed
+         *   mesh this requires communication, so it must be called on all
+         *   processors.
+         */
         void compute_filtered_values(const std::vector<Real>& input,
                                      std::vector<Real>& output) const;
 
@@ -70,7 +94,8 @@ namespace MAST {
 
         
         /*!
-         *  prints the filter data.
+         *  prints the filter data. On a distributed mesh each processor
+         *  prints the rows of its local nodes.
          */
         virtual void print(std::ostream& o) const;
         
@@ -78,10 +103,25 @@ namespace MAST {
     protected:
         
         /*!
-         *   initializes the algebraic data structures
+         *   initializes the algebraic data structures. The neighbors of
+         *   each node are found with a search over a uniform grid of bins
+         *   with the size of the filter radius.
          */
         void _init();
         
+        /*!
+         *   on a distributed mesh, adds to \p nodes the nodes from other
+         *   processors that are within one filter radius of the local nodes.
+         */
+        void _add_remote_nodes_in_filter_radius(std::vector<MAST::FilterNode>& nodes) const;
+        
+        /*!
+         *   assembles \p _filter_map into the distributed matrix \p _filter.
+         *   Rows of design variable dofs contain the filter coefficients and
+         *   the other rows are identity.
+         */
+        void _init_filter_matrix();
+        
         /*!
          *   system on which the level set discrete function is defined
          */
@@ -109,6 +149,12 @@ namespace MAST {
          *   design variables \f$ \tilde{\phi}_i = B_{ij} \phi_j \f$
          */
         std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>> _filter_map;
+
+        /*!
+         *   the filter coefficients \f$ B_{ij} \f$ stored as a distributed
+         *   matrix with the row partitioning of the level set system.
+         */
+        std::unique_ptr<libMesh::SparseMatrix<Real>> _filter;
     };
     
     
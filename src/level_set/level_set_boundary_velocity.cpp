@@ -17,71 +17,145 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <algorithm>
+
 // MAST includes
 #include "level_set/level_set_boundary_velocity.h"
+#include "base/system_initialization.h"
+#include "base/nonlinear_system.h"
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+#include "libmesh/elem.h"
+#include "libmesh/fe_interface.h"
+#include "libmesh/mesh_base.h"
+#include "libmesh/mesh_tools.h"
+#include "libmesh/bounding_box.h"
+#include "libmesh/remote_elem.h"
 
 
 MAST::LevelSetBoundaryVelocity::LevelSetBoundaryVelocity(const unsigned int dim):
 MAST::FieldFunction<RealVectorX>("phi"),
 _dim(dim),
-_phi(nullptr) {
+_sys(nullptr),
+_elem(nullptr) {
     
 }
 
 MAST::LevelSetBoundaryVelocity::~LevelSetBoundaryVelocity() {
     
-    if (_phi)
-        delete _phi;
 }
 
+
+void
+MAST::LevelSetBoundaryVelocity::
+add_evaluation_mesh(MAST::SystemInitialization& sys,
+                    const libMesh::MeshBase& mesh) {
+    
+    const libMesh::System&
+    ls_sys   = sys.system();
+    const libMesh::MeshBase&
+    ls_mesh  = ls_sys.get_mesh();
+    const libMesh::DofMap&
+    dof_map  = ls_sys.get_dof_map();
+    
+    // the level-set elements that overlap the region of the local
+    // elements of the mesh can be needed for the evaluation. Only the
+    // local and ghosted level-set elements are available on a
+    // distributed mesh, and these are the ones searched here.
+    const libMesh::BoundingBox
+    box = libMesh::MeshTools::create_local_bounding_box(mesh);
+    
+    const libMesh::dof_id_type
+    first = dof_map.first_dof(),
+    last  = dof_map.end_dof();
+    
+    std::vector<libMesh::dof_id_type> dof_indices;
+    
+    libMesh::MeshBase::const_element_iterator
+    it   = ls_mesh.active_elements_begin(),
+    end  = ls_mesh.active_elements_end();
+    
+    for ( ; it != end; it++) {
+        
+        const libMesh::Elem& e = **it;
+        
+        libMesh::BoundingBox e_box(e.point(0), e.point(0));
+        for (unsigned int i=1; i<e.n_nodes(); i++)
+            e_box.union_with(e.point(i));
+        
+        if (!box.intersects(e_box))
+            continue;
+        
+        dof_map.dof_indices(&e, dof_indices, 0);
+        
+        for (unsigned int i=0; i<dof_indices.size(); i++)
+            if (dof_indices[i] < first || dof_indices[i] >= last)
+                _ghost_dofs.insert(dof_indices[i]);
+    }
+}
+
+
 void
 MAST::LevelSetBoundaryVelocity::init(MAST::SystemInitialization& sys,
                                      const libMesh::NumericVector<Real>& sol,
                                      const libMesh::NumericVector<Real>& dsol) {
     
-    if (!_phi)
-        _phi = new MAST::MeshFieldFunction(sys, "phi");
-    else
-        _phi->clear();
-    _phi->init(sol, &dsol);
+    this->_init(sys, sol, &dsol);
 }
 
 
 void
-MAST::LevelSetBoundaryVelocity::operator() (const libMesh::Point& p,
-                                            const Real t,
-                                            RealVectorX& v) const {
+MAST::LevelSetBoundaryVelocity::clear() {
     
-    libmesh_assert(_phi);
+    _sol.reset();
+    _dsol.reset();
+    _locator.reset();
+    _fe.reset();
+    _ghost_dofs.clear();
+    _sys  = nullptr;
+    _elem = nullptr;
+}
+
+
+const libMesh::System&
+MAST::LevelSetBoundaryVelocity::system() const {
     
-    Real
-    tol    = 1.e-6;
+    libmesh_assert(_sys);
+    return *_sys;
+}
+
+
+void
+MAST::LevelSetBoundaryVelocity::velocity(const libMesh::Elem& e,
+                                         const libMesh::Point& xi,
+                                         const Real t,
+                                         RealVectorX& v) const {
     
-    RealVectorX
-    val      = RealVectorX::Zero(1),
-    grad     = RealVectorX::Zero(_dim),
-    dval     = RealVectorX::Zero(1);
+    libmesh_assert(_sol);
+    
+    this->_reinit(e, xi);
+    
+    const std::vector<std::vector<libMesh::RealGradient>>&
+    dphi = _fe->get_dphi();
     
-    RealMatrixX
-    gradmat  = RealMatrixX::Zero(1, _dim);
+    RealVectorX
+    grad     = RealVectorX::Zero(_dim);
     
-    // the velocity is identified using the level set function gradient
-    // and its sensitivity
-    (*_phi)(p, t, val);
+    for (unsigned int i=0; i<_dof_indices.size(); i++) {
+        
+        const Real
+        val = (*_sol)(_dof_indices[i]);
+        
+        for (unsigned int j=0; j<_dim; j++)
+            grad(j) += dphi[i][0](j) * val;
+    }
     
     // since the function provides the velocity at the boundary, the
-    // level set value should be close to zero. This is commented out since
+    // level set value should be close to zero. This is not checked since
     // for a coarse level set mesh used to define geometry on a fine analysis
     // mesh, the boundary can exist on locations that are not necessarily phi=0.
-    //libmesh_assert_less_equal(std::fabs(val(0)), tol);
-    //if (std::fabs(val(0)) > tol)
-    //    libMesh::out << "**** !!!  level-set not zero at boundary: " << val(0) << std::endl;
-    
-    _phi->gradient(p, t, gradmat);
-    _phi->perturbation(p, t, dval);
-    
-    // copy the matrix to the vector for further calculations
-    grad = gradmat.row(0);
     
     // at boundary, phi(x) = 0
     // so,  dphi/dp + grad(phi) . V = 0
@@ -93,6 +167,340 @@ MAST::LevelSetBoundaryVelocity::operator() (const libMesh::Point& p,
     //          =  -grad(phi)/ |grad(phi)| * (dphi/dp) / |grad(phi)|
     //          =  -grad(phi) * (dphi/dp)/|grad(phi)|^2
     //
-    v = -dval(0)/grad.squaredNorm()*grad;
+    v = -this->_perturbation()/grad.squaredNorm()*grad;
+}
+
+
+void
+MAST::LevelSetBoundaryVelocity::velocity_at_point(const libMesh::Elem& e,
+                                                  const libMesh::Point& p,
+                                                  const Real t,
+                                                  RealVectorX& v) const {
+    
+    libmesh_assert(_sol);
+    
+    // an element of the level-set mesh is used directly, which avoids the
+    // search for the element that contains the point
+    if (_sys->get_mesh().query_elem_ptr(e.id()) != &e) {
+        
+        (*this)(p, t, v);
+        return;
+    }
+    
+    const libMesh::Point
+    xi = libMesh::FEInterface::inverse_map(e.dim(),
+                                           _sys->get_dof_map().variable_type(0),
+                                           &e,
+                                           p);
+    
+    this->velocity(e, xi, t, v);
+}
+
+
+void
+MAST::LevelSetBoundaryVelocity::operator() (const libMesh::Point& p,
+                                            const Real t,
+                                            RealVectorX& v) const {
+    
+    libmesh_assert(_sol);
+    
+    const libMesh::Elem* e = this->_find_elem(p);
+    
+    if (!e) {
+        
+        v = RealVectorX::Zero(_dim);
+        return;
+    }
+    
+    const libMesh::Point
+    xi = libMesh::FEInterface::inverse_map(e->dim(),
+                                           _sys->get_dof_map().variable_type(0),
+                                           e,
+                                           p);
+    
+    this->velocity(*e, xi, t, v);
+}
+
+
+void
+MAST::LevelSetBoundaryVelocity::operator() (const libMesh::Point& p,
+                                            const libMesh::Elem& e,
+                                            const Real t,
+                                            RealVectorX& v) const {
+    
+    this->velocity_at_point(e, p, t, v);
+}
+
+
+void
+MAST::LevelSetBoundaryVelocity::_init(MAST::SystemInitialization& sys,
+                                      const libMesh::NumericVector<Real>& sol,
+                                      const libMesh::NumericVector<Real>* dsol) {
+    
+    // the locator and finite element are reused if the system is unchanged
+    if (_sys != &sys.system()) {
+        
+        _sys     = &sys.system();
+        _locator = _sys->get_mesh().sub_point_locator();
+        
+        // points of an overlapping mesh can lie marginally outside the
+        // level-set mesh, and the velocity is zero for such points.
+        _locator->enable_out_of_mesh_mode();
+        
+        _fe.reset(libMesh::FEBase::build(_sys->get_mesh().mesh_dimension(),
+                                         _sys->get_dof_map().variable_type(0)).release());
+        _fe->get_phi();
+        _fe->get_dphi();
+    }
+    
+    _elem = nullptr;
+    
+    _sol = this->_localize(sol);
+    
+    if (dsol)
+        _dsol = this->_localize(*dsol);
+    else
+        _dsol.reset();
+}
+
+
+std::unique_ptr<libMesh::NumericVector<Real>>
+MAST::LevelSetBoundaryVelocity::_localize(const libMesh::NumericVector<Real>& v) const {
+    
+    libmesh_assert(_sys);
+    
+    const std::vector<libMesh::dof_id_type>&
+    send_list = _sys->get_dof_map().get_send_list();
+    
+    std::vector<libMesh::dof_id_type>
+    ghost_list(send_list);
+    ghost_list.insert(ghost_list.end(), _ghost_dofs.begin(), _ghost_dofs.end());
+    std::sort(ghost_list.begin(), ghost_list.end());
+    ghost_list.erase(std::unique(ghost_list.begin(), ghost_list.end()),
+                     ghost_list.end());
+    
+    std::unique_ptr<libMesh::NumericVector<Real>>
+    local(libMesh::NumericVector<Real>::build(_sys->comm()).release());
+    
+    local->init(_sys->n_dofs(),
+                _sys->n_local_dofs(),
+                ghost_list,
+                false,
+                libMesh::GHOSTED);
+    v.localize(*local, ghost_list);
+    
+    return local;
+}
+
+
+const libMesh::Elem*
+MAST::LevelSetBoundaryVelocity::_find_elem(const libMesh::Point& p) const {
+    
+    libmesh_assert(_locator);
+    
+    // check the last element and its neighbors before the tree search
+    if (_elem) {
+        
+        if (_elem->contains_point(p))
+            return _elem;
+        
+        for (unsigned int i=0; i<_elem->n_neighbors(); i++) {
+            
+            const libMesh::Elem* nb = _elem->neighbor_ptr(i);
+            
+            if (nb && nb->active() && nb->contains_point(p)) {
+                
+                _elem = nb;
+                return _elem;
+            }
+        }
+    }
+    
+    const libMesh::Elem* e = (*_locator)(p);
+    
+    if (e)
+        _elem = e;
+    
+    return e;
+}
+
+
+void
+MAST::LevelSetBoundaryVelocity::_reinit(const libMesh::Elem& e,
+                                        const libMesh::Point& xi) const {
+    
+    libmesh_assert(_fe);
+    
+    _xi.resize(1);
+    _xi[0] = xi;
+    _fe->reinit(&e, &_xi);
+    
+    _sys->get_dof_map().dof_indices(&e, _dof_indices, 0);
+}
+
+
+Real
+MAST::LevelSetBoundaryVelocity::_perturbation() const {
+    
+    libmesh_assert(_dsol);
+    
+    const std::vector<std::vector<Real>>&
+    phi = _fe->get_phi();
+    
+    Real
+    dval = 0.;
+    
+    for (unsigned int i=0; i<_dof_indices.size(); i++)
+        dval += phi[i][0] * (*_dsol)(_dof_indices[i]);
+    
+    return dval;
+}
+
+
+
+MAST::LevelSetNodalBoundaryVelocity::
+LevelSetNodalBoundaryVelocity(const unsigned int dim):
+MAST::LevelSetBoundaryVelocity(dim),
+_dof(0) {
+    
+}
+
+
+MAST::LevelSetNodalBoundaryVelocity::~LevelSetNodalBoundaryVelocity() {
+    
+}
+
+
+void
+MAST::LevelSetNodalBoundaryVelocity::init(MAST::SystemInitialization& sys,
+                                          const libMesh::NumericVector<Real>& sol) {
+    
+    this->_init(sys, sol, nullptr);
+}
+
+
+void
+MAST::LevelSetNodalBoundaryVelocity::clear() {
+    
+    MAST::LevelSetBoundaryVelocity::clear();
+    _dof = 0;
 }
 
+
+void
+MAST::LevelSetNodalBoundaryVelocity::
+dofs_on_elem(const libMesh::Elem& e,
+             std::set<libMesh::dof_id_type>& dofs) const {
+    
+    libmesh_assert(_sys);
+    
+    dofs.clear();
+    
+    std::vector<libMesh::dof_id_type> dof_indices;
+    const libMesh::DofMap& dof_map = _sys->get_dof_map();
+    
+    // the vertices are pulled slightly towards the centroid so that on
+    // the level-set mesh the bounding box does not touch the neighbors of
+    // the element itself.
+    const libMesh::Point
+    c = e.centroid();
+    
+    libMesh::BoundingBox box(c, c);
+    for (unsigned int i=0; i<e.n_vertices(); i++)
+        box.union_with(c + 0.99 * (e.point(i) - c));
+    
+    // a level-set element that contains a point of the element is used to
+    // start the search.
+    const libMesh::Elem* start = this->_find_elem(c);
+    
+    for (unsigned int i=0; !start && i<e.n_vertices(); i++)
+        start = this->_find_elem(c + 0.99 * (e.point(i) - c));
+    
+    if (!start)
+        return;
+    
+    // the level-set elements that overlap the bounding box are connected
+    // to the start element through neighbors that also overlap the box.
+    // Hence, these are collected by a search over neighbors that stops at
+    // the elements outside the box.
+    std::set<const libMesh::Elem*> visited;
+    std::vector<const libMesh::Elem*>
+    stack(1, start),
+    family;
+    visited.insert(start);
+    
+    while (!stack.empty()) {
+        
+        const libMesh::Elem* ls_elem = stack.back();
+        stack.pop_back();
+        
+        libMesh::BoundingBox e_box(ls_elem->point(0), ls_elem->point(0));
+        for (unsigned int i=1; i<ls_elem->n_nodes(); i++)
+            e_box.union_with(ls_elem->point(i));
+        
+        if (!box.intersects(e_box))
+            continue;
+        
+        dof_map.dof_indices(ls_elem, dof_indices, 0);
+        dofs.insert(dof_indices.begin(), dof_indices.end());
+        
+        for (unsigned int i=0; i<ls_elem->n_neighbors(); i++) {
+            
+            const libMesh::Elem* nb = ls_elem->neighbor_ptr(i);
+            
+            // neighbors outside the mesh, or not available on this
+            // processor, are skipped
+            if (!nb || nb == libMesh::remote_elem)
+                continue;
+            
+            // a coarser neighbor is active itself, while for a refined
+            // neighbor the active children on this side are searched
+            family.clear();
+            if (nb->active())
+                family.push_back(nb);
+            else
+                nb->active_family_tree_by_neighbor(family, ls_elem);
+            
+            for (unsigned int j=0; j<family.size(); j++)
+                if (visited.insert(family[j]).second)
+                    stack.push_back(family[j]);
+        }
+    }
+}
+
+
+Real
+MAST::LevelSetNodalBoundaryVelocity::shape_function(const libMesh::Point& p) const {
+    
+    libmesh_assert(_sys);
+    
+    const libMesh::Elem* e = this->_find_elem(p);
+    
+    if (!e)
+        return 0.;
+    
+    const libMesh::Point
+    xi = libMesh::FEInterface::inverse_map(e->dim(),
+                                           _sys->get_dof_map().variable_type(0),
+                                           e,
+                                           p);
+    
+    this->_reinit(*e, xi);
+    
+    return this->_perturbation();
+}
+
+
+Real
+MAST::LevelSetNodalBoundaryVelocity::_perturbation() const {
+    
+    const std::vector<std::vector<Real>>&
+    phi = _fe->get_phi();
+    
+    for (unsigned int i=0; i<_dof_indices.size(); i++)
+        if (_dof_indices[i] == _dof)
+            return phi[i][0];
+    
+    // the dof does not support this element
+    return 0.;
+}
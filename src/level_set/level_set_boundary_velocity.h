@@ -20,12 +20,40 @@
 #ifndef __mast__level_set_boundary_velocity_h__
 #define __mast__level_set_boundary_velocity_h__
 
+// C++ includes
+#include <set>
+#include <vector>
+#include <memory>
+
 // MAST includes
-#include "base/mesh_field_function.h"
+#include "base/field_function_base.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+#include "libmesh/mesh_base.h"
+#include "libmesh/point_locator_base.h"
+#include "libmesh/fe_base.h"
 
 
 namespace MAST {
     
+    // Forward declerations
+    class SystemInitialization;
+    
+    
+    /*!
+     *   Velocity of the level-set boundary due to a perturbation of the
+     *   level-set function, \f$ V = -\dot{\phi} \nabla \phi / |\nabla \phi|^2 \f$.
+     *   The level set and its perturbation are stored in vectors ghosted
+     *   to the dofs needed on this processor, and are interpolated
+     *   using the shape functions of the level-set element. The velocity
+     *   can be evaluated directly on a level-set element at a reference
+     *   coordinate using velocity(), or at a point using operator(), which
+     *   locates the element first. The located element is remembered and
+     *   checked first for the next point, since consecutive points
+     *   usually lie in the same element. Hence, this object is not
+     *   thread-safe.
+     */
     class LevelSetBoundaryVelocity:
     public MAST::FieldFunction<RealVectorX> {
     public:
@@ -34,18 +62,195 @@ namespace MAST {
         
         virtual ~LevelSetBoundaryVelocity();
         
+        /*!
+         *   identifies the level-set dofs that are needed, in addition to
+         *   the send-list of the level-set system \p sys, to evaluate the
+         *   velocity on the local elements of \p mesh. This is required
+         *   only if \p mesh is different from the level-set mesh, and
+         *   should be called before init(). The dofs are kept until clear()
+         *   is called, so this should be called again if either mesh
+         *   changes. Only the level-set elements available on this
+         *   processor are searched. Hence, if the level-set mesh is
+         *   distributed, its local and ghosted elements should cover the
+         *   region of the local elements of \p mesh.
+         */
+        void add_evaluation_mesh(MAST::SystemInitialization& sys,
+                                 const libMesh::MeshBase& mesh);
+        
         void init(MAST::SystemInitialization& sys,
                   const libMesh::NumericVector<Real>& sol,
                   const libMesh::NumericVector<Real>& dsol);
         
+        void clear();
+        
+        /*!
+         *   @returns the level-set system
+         */
+        const libMesh::System& system() const;
+        
+        /*!
+         *   computes the velocity \p v at reference coordinate \p xi of
+         *   level-set element \p e.
+         */
+        void velocity(const libMesh::Elem& e,
+                      const libMesh::Point& xi,
+                      const Real t,
+                      RealVectorX& v) const;
+        
+        /*!
+         *   computes the velocity \p v at point \p p in element \p e. If
+         *   \p e belongs to the level-set mesh, then the velocity is
+         *   computed on \p e with velocity(). Otherwise, \p e belongs to an
+         *   overlapping mesh and the level-set element containing \p p is
+         *   located first.
+         */
+        void velocity_at_point(const libMesh::Elem& e,
+                               const libMesh::Point& p,
+                               const Real t,
+                               RealVectorX& v) const;
+        
+        /*!
+         *   computes the velocity at \p p. The velocity is zero if \p p is
+         *   outside the level-set mesh.
+         */
         virtual void operator() (const libMesh::Point& p,
                                  const Real t,
                                  RealVectorX& v) const;
         
+        /*!
+         *   computes the velocity at \p p using velocity_at_point(), which
+         *   uses \p e directly if it belongs to the level-set mesh.
+         */
+        virtual void operator() (const libMesh::Point& p,
+                                 const libMesh::Elem& e,
+                                 const Real t,
+                                 RealVectorX& v) const;
+        
+    protected:
+        
+        /*!
+         *   initializes the level-set system and the ghosted level-set
+         *   vector. The perturbation is localized only if \p dsol is
+         *   provided.
+         */
+        void _init(MAST::SystemInitialization& sys,
+                   const libMesh::NumericVector<Real>& sol,
+                   const libMesh::NumericVector<Real>* dsol);
+        
+        /*!
+         *   @returns a ghosted copy of \p v that has all values needed on
+         *   this processor.
+         */
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        _localize(const libMesh::NumericVector<Real>& v) const;
+        
+        /*!
+         *   @returns the level-set element that contains \p p, or
+         *   \p nullptr if \p p is outside the level-set mesh.
+         */
+        const libMesh::Elem* _find_elem(const libMesh::Point& p) const;
+        
+        /*!
+         *   initializes the shape functions and their gradients for \p e at
+         *   reference coordinate \p xi, and the dof indices of \p e.
+         */
+        void _reinit(const libMesh::Elem& e,
+                     const libMesh::Point& xi) const;
+        
+        /*!
+         *   @returns the perturbation of the level set using the shape
+         *   functions and dofs from the last call to _reinit()
+         */
+        virtual Real _perturbation() const;
+        
+        unsigned int                                   _dim;
+        
+        libMesh::System                               *_sys;
+        
+        /*!
+         *   level-set dofs needed in addition to the send-list
+         */
+        std::set<libMesh::dof_id_type>                 _ghost_dofs;
+        
+        /*!
+         *   level set and perturbation ghosted to the needed dofs
+         */
+        std::unique_ptr<libMesh::NumericVector<Real>>  _sol, _dsol;
+        
+        std::unique_ptr<libMesh::PointLocatorBase>     _locator;
+        
+        /*!
+         *   element found for the last point
+         */
+        mutable const libMesh::Elem                   *_elem;
+        
+        /*!
+         *   finite element to compute the shape functions at a point
+         */
+        std::unique_ptr<libMesh::FEBase>               _fe;
+        
+        mutable std::vector<libMesh::Point>            _xi;
+        
+        mutable std::vector<libMesh::dof_id_type>      _dof_indices;
+    };
+    
+    
+    /*!
+     *   Boundary velocity from a unit perturbation of a single dof of the
+     *   level-set system. The perturbed level set is the finite element
+     *   basis function of that dof, so that
+     *   \f$ V_j = -N_j \nabla \phi / |\nabla \phi|^2 \f$.
+     *   Since the velocity is linear in the level-set perturbation, the
+     *   velocity for any perturbation is the dof-weighted sum of \f$ V_j \f$.
+     *   This allows the sensitivity with respect to all level-set dofs to
+     *   be computed in one sweep over the mesh.
+     */
+    class LevelSetNodalBoundaryVelocity:
+    public MAST::LevelSetBoundaryVelocity {
+    public:
+        
+        LevelSetNodalBoundaryVelocity(const unsigned int dim);
+        
+        virtual ~LevelSetNodalBoundaryVelocity();
+        
+        /*!
+         *   initializes the level-set function to \p sol of \p sys.
+         */
+        void init(MAST::SystemInitialization& sys,
+                  const libMesh::NumericVector<Real>& sol);
+        
+        void clear();
+        
+        /*!
+         *   identifies the level-set dofs with basis functions that are
+         *   nonzero on element \p e. The element can belong to the level-set
+         *   mesh or to a different mesh that overlaps it. The dofs of all
+         *   level-set elements that overlap the bounding box of \p e are
+         *   included, so the set can be larger than needed for elements
+         *   that are not aligned with the level-set mesh.
+         */
+        void dofs_on_elem(const libMesh::Elem& e,
+                          std::set<libMesh::dof_id_type>& dofs) const;
+        
+        /*!
+         *   sets the level-set dof for which the velocity is computed.
+         */
+        void set_dof(libMesh::dof_id_type dof) { _dof = dof; }
+        
+        /*!
+         *   @returns the value of the basis function of the present dof at
+         *   \p p
+         */
+        Real shape_function(const libMesh::Point& p) const;
+        
     protected:
         
-        unsigned int             _dim;
-        MAST::MeshFieldFunction *_phi;
+        /*!
+         *   @returns the basis function of the present dof
+         */
+        virtual Real _perturbation() const;
+        
+        libMesh::dof_id_type                           _dof;
     };
 }
 
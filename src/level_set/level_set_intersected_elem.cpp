@@ -125,6 +125,18 @@ MAST::LevelSetIntersectedElem::init_fe(bool init_grads,
 }
 
 
+const MAST::FEBase&
+MAST::LevelSetIntersectedElem::init_fe(MAST::ElemWorkspace::Frame& ws,
+                                       bool init_grads,
+                                       bool init_second_order_derivative,
+                                       int extra_quadrature_order) const {
+    
+    return ws.adopt_fe(this->init_fe(init_grads,
+                                     init_second_order_derivative,
+                                     extra_quadrature_order));
+}
+
+
 std::unique_ptr<MAST::FEBase>
 MAST::LevelSetIntersectedElem::init_side_fe(unsigned int s,
                                             bool init_grads,
@@ -101,6 +101,17 @@ namespace MAST {
                 bool init_second_order_derivative,
                 int extra_quadrature_order = 0) const;
         
+        /*!
+         *   the sub-cell finite element depends on the intersection of
+         *   this element, so a new object is created and owned by \p ws
+         *   instead of reusing one from the workspace.
+         */
+        virtual const MAST::FEBase&
+        init_fe(MAST::ElemWorkspace::Frame& ws,
+                bool init_grads,
+                bool init_second_order_derivative,
+                int extra_quadrature_order = 0) const;
+        
         
         /*!
          *   initializes the finite element shape function and quadrature
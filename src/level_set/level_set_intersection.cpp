@@ -24,6 +24,7 @@
 
 // MAST includes
 #include "level_set/level_set_intersection.h"
+#include "level_set/level_set_intersection_cache.h"
 #include "base/field_function_base.h"
 
 
@@ -36,6 +37,8 @@ _max_mesh_node_id                (0),
 _max_elem_divs                   (4),
 _elem                            (nullptr),
 _initialized                     (false),
+_cache                           (nullptr),
+_cached                          (nullptr),
 _if_elem_on_positive_phi         (false),
 _if_elem_on_negative_phi         (false),
 _mode                            (MAST::NO_INTERSECTION),
@@ -65,6 +68,8 @@ MAST::LevelSetIntersection::get_intersection_mode() const {
     
     libmesh_assert(_initialized);
     
+    if (_cached) return _cached->get_intersection_mode();
+    
     return _mode;
 }
 
@@ -74,6 +79,9 @@ unsigned int
 MAST::LevelSetIntersection::node_on_boundary() const {
     
     libmesh_assert(_initialized);
+    
+    if (_cached) return _cached->node_on_boundary();
+    
     libmesh_assert(_mode == MAST::THROUGH_NODE);
     
     return _node_num_on_boundary;
@@ -85,6 +93,9 @@ unsigned int
 MAST::LevelSetIntersection::edge_on_boundary() const {
     
     libmesh_assert(_initialized);
+    
+    if (_cached) return _cached->edge_on_boundary();
+    
     libmesh_assert(_mode == MAST::COLINEAR_EDGE);
     
     return _edge_num_on_boundary;
@@ -97,6 +108,8 @@ bool
 MAST::LevelSetIntersection::if_elem_on_positive_phi() const {
     
     libmesh_assert(_initialized);
+    
+    if (_cached) return _cached->if_elem_on_positive_phi();
 
     return _if_elem_on_positive_phi;
 }
@@ -107,6 +120,8 @@ MAST::LevelSetIntersection::if_elem_on_negative_phi() const {
     
     libmesh_assert(_initialized);
     
+    if (_cached) return _cached->if_elem_on_negative_phi();
+    
     return _if_elem_on_negative_phi;
 }
 
@@ -117,6 +132,8 @@ MAST::LevelSetIntersection::if_elem_has_positive_phi_region() const {
 
     libmesh_assert(_initialized);
     
+    if (_cached) return _cached->if_elem_has_positive_phi_region();
+    
     return (_if_elem_on_positive_phi || !_if_elem_on_negative_phi);
 }
 
@@ -125,6 +142,8 @@ MAST::LevelSetIntersection::if_elem_has_positive_phi_region() const {
 bool
 MAST::LevelSetIntersection::if_elem_has_boundary() const {
     
+    if (_cached) return _cached->if_elem_has_boundary();
+    
     return (this->if_intersection_through_elem() ||
             (_mode == MAST::COLINEAR_EDGE));
 }
@@ -135,6 +154,8 @@ MAST::LevelSetIntersection::if_elem_has_boundary() const {
 bool
 MAST::LevelSetIntersection::if_intersection_through_elem() const {
     
+    if (_cached) return _cached->if_intersection_through_elem();
+    
     return ((_mode == MAST::OPPOSITE_EDGES)      ||
             (_mode == MAST::ADJACENT_EDGES)      ||
             (_mode == MAST::OPPOSITE_NODES)      ||
@@ -149,6 +170,8 @@ Real
 MAST::LevelSetIntersection::get_positive_phi_volume_fraction() const {
     
     libmesh_assert(_initialized);
+    
+    if (_cached) return _cached->get_positive_phi_volume_fraction();
 
     std::vector<const libMesh::Elem*>::const_iterator
     it      =  _positive_phi_elems.begin(),
@@ -170,6 +193,9 @@ Real
 MAST::LevelSetIntersection::get_node_phi_value(const libMesh::Node* n) const {
     
     libmesh_assert(_initialized);
+    
+    if (_cached) return _cached->get_node_phi_value(n);
+    
     std::map<const libMesh::Node*, std::pair<Real, bool> >::const_iterator
     it   = _node_phi_vals.find(n),
     end  = _node_phi_vals.end();
@@ -187,6 +213,7 @@ MAST::LevelSetIntersection::clear() {
     _max_iters                  = 10;
     _elem                       = nullptr;
     _initialized                = false;
+    _cached                     = nullptr;
     _if_elem_on_positive_phi    = false;
     _if_elem_on_negative_phi    = false;
     _mode                       = MAST::NO_INTERSECTION;
@@ -235,6 +262,15 @@ MAST::LevelSetIntersection::init(const MAST::FieldFunction<Real>& phi,
     
     _elem      =  &e;
     
+    if (_cache) {
+        
+        // the data is owned by the cache, and this object only provides
+        // access to it until clear() is called.
+        _cached      = &_cache->get(phi, e, t, max_elem_id, max_node_id);
+        _initialized = true;
+        return;
+    }
+    
     switch (e.type()) {
         case libMesh::QUAD4:
             _init_on_first_order_ref_elem(phi, e, t);
@@ -256,6 +292,26 @@ MAST::LevelSetIntersection::init(const MAST::FieldFunction<Real>& phi,
 
 
 
+void
+MAST::LevelSetIntersection::attach_cache(MAST::LevelSetIntersectionCache& cache) {
+    
+    libmesh_assert(!_initialized);
+    
+    _cache = &cache;
+}
+
+
+
+void
+MAST::LevelSetIntersection::detach_cache() {
+    
+    libmesh_assert(!_initialized);
+    
+    _cache = nullptr;
+}
+
+
+
 std::unique_ptr<libMesh::Elem>
 MAST::LevelSetIntersection::_first_order_elem(const libMesh::Elem &e) {
     
@@ -508,6 +564,8 @@ _init_on_first_order_ref_elem(const MAST::FieldFunction<Real>& phi,
 const std::vector<const libMesh::Elem*>&
 MAST::LevelSetIntersection::get_sub_elems_positive_phi() const {
     
+    if (_cached) return _cached->get_sub_elems_positive_phi();
+    
     return _positive_phi_elems;
 }
     
@@ -515,6 +573,8 @@ MAST::LevelSetIntersection::get_sub_elems_positive_phi() const {
 
 const std::vector<const libMesh::Elem*>&
 MAST::LevelSetIntersection::get_sub_elems_negative_phi() const {
+    
+    if (_cached) return _cached->get_sub_elems_negative_phi();
 
     return _negative_phi_elems;
 }
@@ -524,6 +584,8 @@ void
 MAST::LevelSetIntersection::
 get_corner_nodes_on_negative_phi(std::set<const libMesh::Node*>& nodes) const {
     
+    if (_cached) return _cached->get_corner_nodes_on_negative_phi(nodes);
+    
     nodes.clear();
     
     // iterate over the corner nodes and return the ones that had a negative phi
@@ -565,6 +627,8 @@ bool
 MAST::LevelSetIntersection::
 has_side_on_interface(const libMesh::Elem& e) const {
     
+    if (_cached) return _cached->has_side_on_interface(e);
+    
     std::map<const libMesh::Elem*, int>::const_iterator it;
     it  = _elem_sides_on_interface.find(&e);
     
@@ -579,6 +643,8 @@ unsigned int
 MAST::LevelSetIntersection::
 get_side_on_interface(const libMesh::Elem& e) const {
     
+    if (_cached) return _cached->get_side_on_interface(e);
+    
     std::map<const libMesh::Elem*, int>::const_iterator it;
     it  = _elem_sides_on_interface.find(&e);
     
@@ -1620,6 +1686,8 @@ MAST::LevelSetIntersection::get_nondimensional_coordinate_for_node
     
     libmesh_assert(_initialized);
     
+    if (_cached) return _cached->get_nondimensional_coordinate_for_node(n);
+    
     std::map<const libMesh::Node*, libMesh::Point>::const_iterator
     it = _node_local_coords.find(&n);
     
@@ -48,6 +48,7 @@ namespace MAST {
 
     // Forward declerations
     template <typename ValType> class FieldFunction;
+    class LevelSetIntersectionCache;
     
     
     
@@ -70,6 +71,18 @@ namespace MAST {
          */
         void clear();
         
+        /*!
+         *   after this call, init() obtains the intersection from \p cache
+         *   instead of computing it, and all accessors return the cached
+         *   data. The cache must outlive this object, or be detached first.
+         */
+        void attach_cache(MAST::LevelSetIntersectionCache& cache);
+        
+        /*!
+         *   reverts to computing the intersection in init()
+         */
+        void detach_cache();
+        
         /*!
          *   @return a reference to the element on which the intersection is
          *   defined
@@ -216,6 +229,17 @@ namespace MAST {
         const unsigned int                           _max_elem_divs;
         const libMesh::Elem*                         _elem;
         bool                                         _initialized;
+        
+        /*!
+         *   cache used to obtain the intersection in init(), if attached
+         */
+        MAST::LevelSetIntersectionCache*             _cache;
+        
+        /*!
+         *   intersection provided by \p _cache for the current element. If
+         *   set, all accessors forward to this object.
+         */
+        const MAST::LevelSetIntersection*            _cached;
 
         /*!
          *   \p true if element is completely on the positive side of level set
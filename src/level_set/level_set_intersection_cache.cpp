@@ -0,0 +1,122 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// MAST includes
+#include "level_set/level_set_intersection_cache.h"
+#include "level_set/level_set_intersection.h"
+
+// libMesh includes
+#include "libmesh/elem.h"
+
+
+MAST::LevelSetIntersectionCache::Entry::Entry():
+version        (0),
+phi            (nullptr),
+elem           (nullptr),
+t              (0.),
+intersection   (new MAST::LevelSetIntersection) {
+    
+}
+
+
+
+MAST::LevelSetIntersectionCache::Entry::~Entry() {
+    
+    delete intersection;
+}
+
+
+
+MAST::LevelSetIntersectionCache::LevelSetIntersectionCache():
+_version     (1),
+_n_computed  (0),
+_n_reused    (0) {
+    
+}
+
+
+
+MAST::LevelSetIntersectionCache::~LevelSetIntersectionCache() {
+    
+    this->clear();
+}
+
+
+
+void
+MAST::LevelSetIntersectionCache::clear() {
+    
+    std::map<libMesh::dof_id_type, Entry*>::iterator
+    it  = _entries.begin(),
+    end = _entries.end();
+    
+    for ( ; it != end; it++)
+        delete it->second;
+    
+    _entries.clear();
+    _n_computed = 0;
+    _n_reused   = 0;
+}
+
+
+
+void
+MAST::LevelSetIntersectionCache::increment_version() {
+    
+    _version++;
+}
+
+
+
+const MAST::LevelSetIntersection&
+MAST::LevelSetIntersectionCache::get(const MAST::FieldFunction<Real>& phi,
+                                     const libMesh::Elem& e,
+                                     const Real t,
+                                     unsigned int max_elem_id,
+                                     unsigned int max_node_id) {
+    
+    Entry*& entry = _entries[e.id()];
+    
+    if (!entry)
+        entry = new Entry;
+    
+    if (entry->version == _version &&
+        entry->phi     == &phi     &&
+        entry->elem    == &e       &&
+        entry->t       == t) {
+        
+        _n_reused++;
+        return *entry->intersection;
+    }
+    
+    // the entry is out-of-date. The intersection object is reused for the
+    // new version
+    entry->intersection->clear();
+    entry->intersection->init(phi, e, t, max_elem_id, max_node_id);
+    
+    entry->version = _version;
+    entry->phi     = &phi;
+    entry->elem    = &e;
+    entry->t       = t;
+    
+    _n_computed++;
+    
+    return *entry->intersection;
+}
@@ -0,0 +1,132 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_level_set_intersection_cache_h__
+#define __mast_level_set_intersection_cache_h__
+
+// C++ includes
+#include <map>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/id_types.h"
+
+
+namespace libMesh {
+    class Elem;
+}
+
+
+namespace MAST {
+
+    // Forward declerations
+    class LevelSetIntersection;
+    template <typename ValType> class FieldFunction;
+    
+    
+    /*!
+     *   Stores the intersection of the level-set function with each element
+     *   of the mesh, so that the mode, the sub-elements and the interface
+     *   nodes are computed once per design update and shared by all
+     *   assemblies, outputs and the interface dof handler that attach to it
+     *   through LevelSetIntersection::attach_cache().
+     *
+     *   An intersection is recomputed only when the element is visited for
+     *   the first time after increment_version(), or if the level-set
+     *   function, time or element differ from those used to compute it.
+     *   Entries are pooled per element id and reused across versions.
+     *   The user must call increment_version() each time the level-set
+     *   solution or the mesh is modified.
+     */
+    class LevelSetIntersectionCache {
+        
+    public:
+        
+        LevelSetIntersectionCache();
+        
+        virtual ~LevelSetIntersectionCache();
+        
+        /*!
+         *   deletes all cached intersections
+         */
+        void clear();
+        
+        /*!
+         *   marks all cached intersections as out-of-date. This should be
+         *   called after each update of the level-set function.
+         */
+        void increment_version();
+        
+        /*!
+         *   @returns the current version stamp
+         */
+        unsigned long long version() const { return _version; }
+        
+        /*!
+         *   @returns the intersection of \p phi with element \p e at time
+         *   \p t. This is computed if the cached value is out-of-date.
+         */
+        const MAST::LevelSetIntersection&
+        get(const MAST::FieldFunction<Real>& phi,
+            const libMesh::Elem& e,
+            const Real t,
+            unsigned int max_elem_id,
+            unsigned int max_node_id);
+        
+        /*!
+         *   @returns the number of intersections computed since construction
+         *   or the last call to clear()
+         */
+        unsigned int n_computed() const { return _n_computed; }
+
+        /*!
+         *   @returns the number of lookups that were served from the cache
+         *   since construction or the last call to clear()
+         */
+        unsigned int n_reused() const { return _n_reused; }
+
+    protected:
+        
+        struct Entry {
+            
+            Entry();
+            ~Entry();
+            
+            unsigned long long                  version;
+            const MAST::FieldFunction<Real>*    phi;
+            const libMesh::Elem*                elem;
+            Real                                t;
+            MAST::LevelSetIntersection*         intersection;
+        };
+        
+        unsigned long long                       _version;
+        
+        unsigned int                             _n_computed;
+        
+        unsigned int                             _n_reused;
+        
+        std::map<libMesh::dof_id_type, Entry*>   _entries;
+    };
+}
+
+
+#endif // __mast_level_set_intersection_cache_h__
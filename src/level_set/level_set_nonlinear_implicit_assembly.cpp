@@ -26,6 +26,8 @@
 #include "level_set/sub_cell_fe.h"
 #include "level_set/filter_base.h"
 #include "level_set/level_set_parameter.h"
+#include "level_set/level_set_boundary_velocity.h"
+#include "base/parameter.h"
 #include "base/system_initialization.h"
 #include "base/nonlinear_system.h"
 #include "base/mesh_field_function.h"
@@ -1334,3 +1336,274 @@ calculate_output_direct_sensitivity(const libMesh::NumericVector<Real>& X,
     output.clear_assembly();
 }
 
+
+
+void
+MAST::LevelSetNonlinearImplicitAssembly::
+calculate_output_topology_gradient(const libMesh::NumericVector<Real>& X,
+                                   const libMesh::NumericVector<Real>* dq_dX,
+                                   MAST::AssemblyElemOperations*       elem_ops,
+                                   MAST::LevelSetNodalBoundaryVelocity& vel,
+                                   MAST::OutputAssemblyElemOperations& output,
+                                   libMesh::NumericVector<Real>&       dq_dphi) {
+    
+    libmesh_assert(_system);
+    libmesh_assert(_discipline);
+    libmesh_assert(_level_set);
+    libmesh_assert(!dq_dX || elem_ops);
+    
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
+    
+    // if this assembly is for the level-set system itself, then the
+    // element level-set sensitivity is the unit perturbation of the dof.
+    // Otherwise, the partial sensitivity is computed with a zero
+    // solution sensitivity.
+    const bool
+    if_level_set_sys = (&vel.system() == &nonlin_sys);
+    
+    // parameter that identifies the unit perturbation of each level-set dof
+    MAST::Parameter dphi("dphi", 0.);
+    dphi.set_as_topology_parameter(true);
+    
+    output.zero_for_sensitivity();
+    output.set_assembly(*this);
+    
+    const Real
+    tol   = 1.e-10;
+    
+    RealVectorX
+    sol,
+    dsol,
+    vec,
+    res_factored_u,
+    nd_indicator = RealVectorX::Ones(1),
+    indicator    = RealVectorX::Zero(1);
+    RealMatrixX
+    mat,
+    jac_factored_uu;
+    
+    std::vector<libMesh::dof_id_type>
+    dof_indices,
+    constrained_dof_indices,
+    material_rows;
+    const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
+    
+    // level-set dofs that influence the present element, and their
+    // contributions
+    std::set<libMesh::dof_id_type>                  ls_dofs;
+    std::map<libMesh::dof_id_type, Real>            dq;
+    std::map<libMesh::dof_id_type, RealVectorX>     dres;
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    localized_solution,
+    localized_adjoint;
+    localized_solution.reset(build_localized_vector(nonlin_sys,
+                                                    X).release());
+    if (dq_dX)
+        localized_adjoint.reset(build_localized_vector(nonlin_sys,
+                                                       *dq_dX).release());
+    
+    MAST::NonlinearImplicitAssemblyElemOperations*
+    ops = nullptr;
+    if (dq_dX)
+        ops = &dynamic_cast<MAST::NonlinearImplicitAssemblyElemOperations&>(*elem_ops);
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    nonlin_sys.get_mesh().active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    nonlin_sys.get_mesh().active_local_elements_end();
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        
+        _intersection->init(*_level_set, *elem, nonlin_sys.time,
+                            nonlin_sys.get_mesh().max_elem_id(),
+                            nonlin_sys.get_mesh().max_node_id());
+        
+        // the topology sensitivity is a boundary integral, so elements
+        // without the level-set boundary do not contribute
+        if (!_intersection->if_elem_has_boundary()) {
+            
+            _intersection->clear();
+            continue;
+        }
+        
+        // use the indicator if it was provided
+        if (_indicator) {
+            
+            nd_indicator.setZero(elem->n_nodes());
+            for (unsigned int i=0; i<elem->n_nodes(); i++) {
+                (*_indicator)(elem->node_ref(i), nonlin_sys.time, indicator);
+                nd_indicator(i) = indicator(0);
+            }
+        }
+        
+        const bool
+        if_low = (_evaluate_output_on_negative_phi &&
+                  _intersection->get_sub_elems_negative_phi().size()),
+        if_hi  = (nd_indicator.maxCoeff() > tol &&
+                  _intersection->if_elem_has_positive_phi_region());
+        
+        if (!if_low && !if_hi) {
+            
+            _intersection->clear();
+            continue;
+        }
+        
+        dof_map.dof_indices (elem, dof_indices);
+        
+        // get the solution
+        unsigned int ndofs = (unsigned int)dof_indices.size();
+        sol.setZero(ndofs);
+        
+        for (unsigned int i=0; i<dof_indices.size(); i++)
+            sol(i) = (*localized_solution)(dof_indices[i]);
+        
+        // if the element has been marked for factorization then
+        // get the void solution from the storage
+        if (_dof_handler && _dof_handler->if_factor_element(*elem))
+            _dof_handler->solution_of_factored_element(*elem, sol);
+        
+        vel.dofs_on_elem(*elem, ls_dofs);
+        
+        dq.clear();
+        dres.clear();
+        std::set<libMesh::dof_id_type>::const_iterator
+        dof_it  = ls_dofs.begin(),
+        dof_end = ls_dofs.end();
+        
+        for ( ; dof_it != dof_end; dof_it++) {
+            dq[*dof_it]   = 0.;
+            dres[*dof_it] = RealVectorX::Zero(ndofs);
+        }
+        
+        // sub elements on which the output is evaluated
+        std::vector<const libMesh::Elem*> sub_elems;
+        if (if_low)
+            sub_elems.insert(sub_elems.end(),
+                             _intersection->get_sub_elems_negative_phi().begin(),
+                             _intersection->get_sub_elems_negative_phi().end());
+        
+        const unsigned int n_low = (unsigned int)sub_elems.size();
+        
+        if (if_hi)
+            sub_elems.insert(sub_elems.end(),
+                             _intersection->get_sub_elems_positive_phi().begin(),
+                             _intersection->get_sub_elems_positive_phi().end());
+        
+        for (unsigned int i_sub=0; i_sub<sub_elems.size(); i_sub++) {
+            
+            const libMesh::Elem* sub_elem = sub_elems[i_sub];
+            
+            // partial sensitivity of the output
+            {
+                MAST::LevelSetIntersectedElem geom_elem;
+                output.set_elem_data(elem->dim(), *elem, geom_elem);
+                geom_elem.init(*sub_elem, *_system, *_intersection);
+                
+                output.init(geom_elem);
+                output.set_elem_solution(sol);
+                
+                for (dof_it = ls_dofs.begin(); dof_it != dof_end; dof_it++) {
+                    
+                    dsol.setZero(ndofs);
+                    if (if_level_set_sys)
+                        for (unsigned int i=0; i<ndofs; i++)
+                            if (dof_indices[i] == *dof_it) dsol(i) = 1.;
+                    
+                    vel.set_dof(*dof_it);
+                    output.set_elem_solution_sensitivity(dsol);
+                    dq[*dof_it] += output.topology_sensitivity_for_elem(dphi, vel);
+                }
+                
+                output.clear_elem();
+            }
+            
+            // the residual is only assembled on the positive phi region
+            if (!dq_dX || i_sub < n_low)
+                continue;
+            
+            MAST::LevelSetIntersectedElem geom_elem;
+            ops->set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*sub_elem, *_system, *_intersection);
+            
+            ops->init(geom_elem);
+            ops->set_elem_solution(sol);
+            
+            std::map<libMesh::dof_id_type, RealVectorX> sub_dres;
+            
+            for (dof_it = ls_dofs.begin(); dof_it != dof_end; dof_it++) {
+                
+                vec.setZero(ndofs);
+                vel.set_dof(*dof_it);
+                ops->elem_topology_sensitivity_calculations(dphi, vel, vec);
+                sub_dres[*dof_it] = vec;
+            }
+            
+            ops->clear_elem();
+            
+            // if the element has been identified for factoring then
+            // we will factor the residual sensitivity. The Jacobian is
+            // the same for all level-set dofs.
+            if (_dof_handler && _dof_handler->if_factor_element(*elem)) {
+                
+                vec.setZero(ndofs);
+                mat.setZero(ndofs, ndofs);
+                
+                MAST::GeomElem geom_elem;
+                ops->set_elem_data(elem->dim(), *elem, geom_elem);
+                geom_elem.init(*elem, *_system);
+                
+                ops->init(geom_elem);
+                ops->set_elem_solution(sol);
+                ops->elem_calculations(true, vec, mat);
+                ops->clear_elem();
+                mat *= _intersection->get_positive_phi_volume_fraction();
+                
+                for (dof_it = ls_dofs.begin(); dof_it != dof_end; dof_it++) {
+                    
+                    _dof_handler->element_factored_residual_and_jacobian(*elem,
+                                                                         mat,
+                                                                         sub_dres[*dof_it],
+                                                                         material_rows,
+                                                                         jac_factored_uu,
+                                                                         res_factored_u);
+                    
+                    sub_dres[*dof_it].setZero();
+                    
+                    for (unsigned int i=0; i<material_rows.size(); i++)
+                        sub_dres[*dof_it](material_rows[i]) = res_factored_u(i);
+                }
+            }
+            
+            for (dof_it = ls_dofs.begin(); dof_it != dof_end; dof_it++)
+                dres[*dof_it] += sub_dres[*dof_it];
+        }
+        
+        for (dof_it = ls_dofs.begin(); dof_it != dof_end; dof_it++) {
+            
+            if (dq_dX) {
+                
+                // constrain the residual sensitivity to account for hanging
+                // dofs, Dirichlet constraints, etc., and take its product
+                // with the adjoint solution
+                DenseRealVector v;
+                MAST::copy(v, dres[*dof_it]);
+                constrained_dof_indices = dof_indices;
+                dof_map.constrain_element_vector(v, constrained_dof_indices);
+                
+                for (unsigned int i=0; i<constrained_dof_indices.size(); i++)
+                    dq[*dof_it] += v(i) * (*localized_adjoint)(constrained_dof_indices[i]);
+            }
+            
+            dq_dphi.add(*dof_it, dq[*dof_it]);
+        }
+        
+        dof_indices.clear();
+        _intersection->clear();
+    }
+    
+    dq_dphi.close();
+    output.clear_assembly();
+}
@@ -31,6 +31,7 @@ namespace MAST {
     class LevelSetIntersection;
     class LevelSetInterfaceDofHandler;
     class LevelSetVoidSolution;
+    class LevelSetNodalBoundaryVelocity;
     class FilterBase;
     
     
@@ -125,6 +126,39 @@ namespace MAST {
         sensitivity_assemble (const MAST::FunctionBase& f,
                               libMesh::NumericVector<Real>& sensitivity_rhs);
         
+        /*!
+         *   calls the single parameter \p sensitivity_assemble for each
+         *   parameter, since the void-solution and topology contributions
+         *   are parameter specific.
+         */
+        virtual bool
+        sensitivity_assemble (const std::vector<const MAST::FunctionBase*>& f,
+                              std::vector<libMesh::NumericVector<Real>*>& sensitivity_rhs) {
+            return MAST::AssemblyBase::sensitivity_assemble(f, sensitivity_rhs);
+        }
+        
+        
+        using MAST::NonlinearImplicitAssembly::calculate_output_adjoint_sensitivity;
+        
+        /*!
+         *   calls the single parameter adjoint sensitivity for each
+         *   parameter, since the topology sensitivity depends on the
+         *   velocity attached for each parameter.
+         */
+        virtual void
+        calculate_output_adjoint_sensitivity(const libMesh::NumericVector<Real>& X,
+                                             const libMesh::NumericVector<Real>& dq_dX,
+                                             const std::vector<const MAST::FunctionBase*>& p,
+                                             MAST::AssemblyElemOperations&       elem_ops,
+                                             MAST::OutputAssemblyElemOperations& output,
+                                             std::vector<Real>&                  dq_dp,
+                                             const bool include_partial_sens = true) {
+            MAST::AssemblyBase::calculate_output_adjoint_sensitivity(X, dq_dX, p,
+                                                                     elem_ops, output,
+                                                                     dq_dp,
+                                                                     include_partial_sens);
+        }
+        
         
         virtual void
         calculate_output_derivative(const libMesh::NumericVector<Real>& X,
@@ -165,6 +199,27 @@ namespace MAST {
                                             MAST::OutputAssemblyElemOperations& output);
         
         
+        /*!
+         *   calculates the sensitivity of \p output with respect to every
+         *   dof of the level-set system of \p vel in a single sweep over the
+         *   mesh, and adds it to \p dq_dphi. If the adjoint solution
+         *   \p dq_dX is provided, then the term
+         *   \f$ \lambda^T \partial R/\partial \phi \f$ is included with
+         *   the residual from \p elem_ops. The level-set dofs affect the
+         *   element quantities only through the boundary velocity, so
+         *   only elements intersected by the level set are visited, and
+         *   \p output must implement
+         *   OutputAssemblyElemOperations::topology_sensitivity_for_elem().
+         */
+        virtual void
+        calculate_output_topology_gradient(const libMesh::NumericVector<Real>& X,
+                                           const libMesh::NumericVector<Real>* dq_dX,
+                                           MAST::AssemblyElemOperations*       elem_ops,
+                                           MAST::LevelSetNodalBoundaryVelocity& vel,
+                                           MAST::OutputAssemblyElemOperations& output,
+                                           libMesh::NumericVector<Real>&       dq_dphi);
+        
+        
         /*!
          *   Evaluates the total sensitivity of \p output wrt \p p using
          *   the adjoint solution provided in \p dq_dX for a linearization
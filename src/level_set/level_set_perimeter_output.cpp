@@ -174,6 +174,15 @@ void
 MAST::LevelSetPerimeter::evaluate_topology_sensitivity(const MAST::FunctionBase& f,
                                                        const MAST::FieldFunction<RealVectorX>& vel) {
     
+    _dper_dp += this->topology_sensitivity_for_elem(f, vel);
+}
+
+
+
+Real
+MAST::LevelSetPerimeter::topology_sensitivity_for_elem(const MAST::FunctionBase& f,
+                                                       const MAST::FieldFunction<RealVectorX>& vel) {
+    
     // here we ignore the velocity, since the element is able to compute that
     // and provide the sensitivity from level set sensitivity values.
     (void)vel;
@@ -191,7 +200,9 @@ MAST::LevelSetPerimeter::evaluate_topology_sensitivity(const MAST::FunctionBase&
         MAST::LevelSetElementBase&
         e = dynamic_cast<MAST::LevelSetElementBase&>(*_physics_elem);
 
-        _dper_dp += e.perimeter_sensitivity();
+        return e.perimeter_sensitivity();
     }
+    else
+        return 0.;
 }
 
@@ -0,0 +1,108 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// MAST includes
+#include "level_set/level_set_topology_gradient.h"
+#include "level_set/level_set_nonlinear_implicit_assembly.h"
+#include "level_set/filter_base.h"
+#include "base/system_initialization.h"
+#include "base/nonlinear_system.h"
+#include "base/output_assembly_elem_operations.h"
+
+
+MAST::LevelSetTopologyGradient::
+LevelSetTopologyGradient(MAST::SystemInitialization& level_set_sys_init,
+                         const MAST::FilterBase& filter):
+_level_set_sys_init   (level_set_sys_init),
+_filter               (filter),
+_vel                  (level_set_sys_init.system().get_mesh().mesh_dimension()) {
+    
+}
+
+
+MAST::LevelSetTopologyGradient::~LevelSetTopologyGradient() {
+    
+    this->clear();
+}
+
+
+void
+MAST::LevelSetTopologyGradient::add_evaluation_mesh(const libMesh::MeshBase& mesh) {
+    
+    _vel.add_evaluation_mesh(_level_set_sys_init, mesh);
+}
+
+
+void
+MAST::LevelSetTopologyGradient::init(const libMesh::NumericVector<Real>& phi) {
+    
+    _vel.init(_level_set_sys_init, phi);
+    
+    if (!_dq_dphi)
+        _dq_dphi.reset(phi.zero_clone().release());
+}
+
+
+void
+MAST::LevelSetTopologyGradient::clear() {
+    
+    _vel.clear();
+    _dq_dphi.reset();
+}
+
+
+const libMesh::NumericVector<Real>&
+MAST::LevelSetTopologyGradient::filtered_gradient() const {
+    
+    libmesh_assert(_dq_dphi);
+    return *_dq_dphi;
+}
+
+
+void
+MAST::LevelSetTopologyGradient::
+output_gradient(MAST::LevelSetNonlinearImplicitAssembly& assembly,
+                const libMesh::NumericVector<Real>& X,
+                MAST::OutputAssemblyElemOperations& output,
+                libMesh::NumericVector<Real>& dq_ddv) {
+    
+    libmesh_assert(_dq_dphi);
+    
+    _dq_dphi->zero();
+    assembly.calculate_output_topology_gradient(X, nullptr, nullptr, _vel, output, *_dq_dphi);
+    _filter.compute_filtered_sensitivity_transpose(*_dq_dphi, dq_ddv);
+}
+
+
+void
+MAST::LevelSetTopologyGradient::
+output_adjoint_gradient(MAST::LevelSetNonlinearImplicitAssembly& assembly,
+                        const libMesh::NumericVector<Real>& X,
+                        const libMesh::NumericVector<Real>& dq_dX,
+                        MAST::AssemblyElemOperations& elem_ops,
+                        MAST::OutputAssemblyElemOperations& output,
+                        libMesh::NumericVector<Real>& dq_ddv) {
+    
+    libmesh_assert(_dq_dphi);
+    
+    _dq_dphi->zero();
+    assembly.calculate_output_topology_gradient(X, &dq_dX, &elem_ops, _vel, output, *_dq_dphi);
+    _filter.compute_filtered_sensitivity_transpose(*_dq_dphi, dq_ddv);
+}
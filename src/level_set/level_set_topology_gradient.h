@@ -0,0 +1,122 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_level_set_topology_gradient_h__
+#define __mast_level_set_topology_gradient_h__
+
+// C++ includes
+#include <memory>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "level_set/level_set_boundary_velocity.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class SystemInitialization;
+    class FilterBase;
+    class LevelSetNonlinearImplicitAssembly;
+    class AssemblyElemOperations;
+    class OutputAssemblyElemOperations;
+    
+    
+    /*!
+     *   Computes the gradient of an output with respect to the level-set
+     *   design variables. The shape derivative for all dofs of the filtered
+     *   level set is computed in one sweep over the mesh (see
+     *   LevelSetNonlinearImplicitAssembly::calculate_output_topology_gradient),
+     *   and the filter transpose then maps it to the design variables. This
+     *   gives the same result as a unit perturbation of each design
+     *   variable followed by the filter and the velocity computation, at
+     *   the cost of one sweep per output.
+     */
+    class LevelSetTopologyGradient {
+        
+    public:
+        
+        LevelSetTopologyGradient(MAST::SystemInitialization& level_set_sys_init,
+                                 const MAST::FilterBase& filter);
+        
+        virtual ~LevelSetTopologyGradient();
+        
+        /*!
+         *   identifies the level-set dofs needed for outputs evaluated on
+         *   \p mesh, if it is different from the level-set mesh. This should
+         *   be called before init().
+         */
+        void add_evaluation_mesh(const libMesh::MeshBase& mesh);
+        
+        /*!
+         *   initializes the boundary velocity for the filtered level-set
+         *   solution \p phi. This must be called after each design update.
+         */
+        void init(const libMesh::NumericVector<Real>& phi);
+        
+        void clear();
+        
+        /*!
+         *   @returns the sensitivity of the last output with respect to the
+         *   filtered level-set dofs
+         */
+        const libMesh::NumericVector<Real>& filtered_gradient() const;
+        
+        /*!
+         *   calculates the gradient of \p output, which depends on the
+         *   level-set only through its boundary (e.g., volume or perimeter),
+         *   and returns it in \p dq_ddv. \p dq_ddv has the layout of the
+         *   level-set solution, and the gradient is in the rows of the
+         *   design variables.
+         */
+        void output_gradient(MAST::LevelSetNonlinearImplicitAssembly& assembly,
+                             const libMesh::NumericVector<Real>& X,
+                             MAST::OutputAssemblyElemOperations& output,
+                             libMesh::NumericVector<Real>& dq_ddv);
+        
+        /*!
+         *   calculates the gradient of \p output using the adjoint solution
+         *   \p dq_dX for a linearization about \p X, and returns it in
+         *   \p dq_ddv, which is defined as in output_gradient().
+         */
+        void output_adjoint_gradient(MAST::LevelSetNonlinearImplicitAssembly& assembly,
+                                     const libMesh::NumericVector<Real>& X,
+                                     const libMesh::NumericVector<Real>& dq_dX,
+                                     MAST::AssemblyElemOperations& elem_ops,
+                                     MAST::OutputAssemblyElemOperations& output,
+                                     libMesh::NumericVector<Real>& dq_ddv);
+        
+    protected:
+        
+        MAST::SystemInitialization&                     _level_set_sys_init;
+        
+        const MAST::FilterBase&                         _filter;
+        
+        MAST::LevelSetNodalBoundaryVelocity             _vel;
+        
+        std::unique_ptr<libMesh::NumericVector<Real>>   _dq_dphi;
+    };
+}
+
+
+#endif // __mast_level_set_topology_gradient_h__
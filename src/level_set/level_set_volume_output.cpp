@@ -174,6 +174,15 @@ void
 MAST::LevelSetVolume::evaluate_topology_sensitivity(const MAST::FunctionBase& f,
                                                     const MAST::FieldFunction<RealVectorX>& vel) {
     
+    _dvol_dp += this->topology_sensitivity_for_elem(f, vel);
+}
+
+
+
+Real
+MAST::LevelSetVolume::topology_sensitivity_for_elem(const MAST::FunctionBase& f,
+                                                    const MAST::FieldFunction<RealVectorX>& vel) {
+    
     // here we ignore the velocity, since the element is able to compute that
     // and provide the sensitivity from level set sensitivity values.
     (void)vel;
@@ -193,8 +202,10 @@ MAST::LevelSetVolume::evaluate_topology_sensitivity(const MAST::FunctionBase& f,
         MAST::LevelSetElementBase&
         e = dynamic_cast<MAST::LevelSetElementBase&>(*_physics_elem);
         
-        _dvol_dp += e.volume_boundary_velocity_on_side
+        return e.volume_boundary_velocity_on_side
         (elem.get_subelem_side_on_level_set_boundary());
     }
+    else
+        return 0.;
 }
 
@@ -156,6 +156,28 @@ namespace MAST {
         virtual void evaluate_topology_sensitivity(const MAST::FunctionBase& f,
                                                    const MAST::FieldFunction<RealVectorX>& vel);
 
+        /*!
+         *    @returns the contribution of this element to the topology
+         *    sensitivity, without accumulating it in this object.
+         */
+        virtual Real topology_sensitivity_for_elem(const MAST::FunctionBase& f,
+                                                   const MAST::FieldFunction<RealVectorX>& vel);
+
+        /*!
+         *    the volume is a sum of element contributions.
+         */
+        virtual bool if_additive_over_elems() const { return true; }
+        
+        /*!
+         *    the volume only depends on the topology parameters, so the
+         *    partial sensitivity is zero.
+         */
+        virtual void
+        partial_sensitivity_for_elem(const std::vector<const MAST::FunctionBase*>& p,
+                                     RealVectorX& dq_dp) {
+            dq_dp.setZero(p.size());
+        }
+
     protected:
 
         const MAST::LevelSetIntersection&   _intersection;
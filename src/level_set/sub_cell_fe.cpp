@@ -61,7 +61,8 @@ MAST::SubCellFE::init(const MAST::GeomElem& elem,
     // this method does not allow quadrature points to be spcified.
     libmesh_assert(!pts);
 
-    _elem    = &elem;
+    _elem           = &elem;
+    _use_local_elem = elem.use_local_elem();
     
     // the quadrature element is the subcell on which the quadrature is to be
     // performed and the reference element is the element inside which the
@@ -239,7 +240,8 @@ MAST::SubCellFE::init_for_side(const MAST::GeomElem& elem,
 
     libmesh_assert(!_initialized);
 
-    _elem     = &elem;
+    _elem           = &elem;
+    _use_local_elem = elem.use_local_elem();
     
     // the quadrature element is the subcell on which the quadrature is to be
     // performed and the reference element is the element inside which the
@@ -29,6 +29,10 @@ _sys                           (sys),
 _extra_quadrature_order        (0),
 _init_second_order_derivatives (false),
 _initialized                   (false),
+_fe_quadrature_order           (0),
+_fe_init_grads                 (false),
+_fe_init_second_order_derivatives (false),
+_use_local_elem                (false),
 _elem                          (nullptr),
 _fe                            (nullptr),
 _qrule                         (nullptr) {
@@ -68,7 +72,8 @@ MAST::FEBase::init(const MAST::GeomElem& elem,
     libmesh_assert(!_initialized);
     
     
-    _elem   = &elem;
+    _elem           = &elem;
+    _use_local_elem = elem.use_local_elem();
     const unsigned int
     nv      = _sys.n_vars();
     libMesh::FEType
@@ -99,10 +104,13 @@ MAST::FEBase::init(const MAST::GeomElem& elem,
     }
     if (_init_second_order_derivatives) _fe->get_d2phi();
     
+    _fe_quadrature_order              = _sys.system().extra_quadrature_order+(int)_extra_quadrature_order;
+    _fe_init_grads                    = init_grads;
+    _fe_init_second_order_derivatives = _init_second_order_derivatives;
+    
     if (pts == nullptr) {
         _qrule = fe_type.default_quadrature_rule
-        (q_elem->dim(),
-         _sys.system().extra_quadrature_order+_extra_quadrature_order).release();  // system extra quadrature
+        (q_elem->dim(), _fe_quadrature_order).release();  // system extra quadrature
         _fe->attach_quadrature_rule(_qrule);
         _fe->reinit(q_elem);
     }
@@ -113,20 +121,104 @@ MAST::FEBase::init(const MAST::GeomElem& elem,
 
     // now initialize the global xyz locations if the element uses a locally
     // defined element.
-    if (elem.use_local_elem()) {
+    this->_init_global_xyz(elem);
+    
+    _initialized = true;
+}
+
+
+
+bool
+MAST::FEBase::can_reinit(const MAST::GeomElem& elem,
+                         bool init_grads,
+                         bool init_second_order_derivatives,
+                         int extra_quadrature_order) const {
+    
+    // the finite element and quadrature rule can only be reused if they
+    // were created by init() for the same element dimension and options.
+    // Objects initialized with user specified points or for a side do not
+    // qualify.
+    if (!_initialized || !_qrule)
+        return false;
+    
+    const libMesh::Elem*
+    q_elem = nullptr;
+    
+    if (elem.use_local_elem())
+        q_elem = &elem.get_quadrature_local_elem();
+    else
+        q_elem = &elem.get_quadrature_elem();
+    
+    const int
+    q_order = _sys.system().extra_quadrature_order+extra_quadrature_order;
+    
+    return
+    _qrule->get_dim()                 == q_elem->dim()   &&
+    _fe->get_dim()                    == q_elem->dim()   &&
+    _fe->get_fe_type()                == _sys.fetype(0)  &&
+    _fe_quadrature_order              == q_order         &&
+    _fe_init_grads                    == init_grads      &&
+    _fe_init_second_order_derivatives == init_second_order_derivatives;
+}
+
+
+
+bool
+MAST::FEBase::reinit(const MAST::GeomElem& elem,
+                     bool init_grads) {
+    
+    if (!this->can_reinit(elem,
+                          init_grads,
+                          _init_second_order_derivatives,
+                          (int)_extra_quadrature_order)) {
         
-        const std::vector<libMesh::Point>
-        local_xyz    = _fe->get_xyz();
+        delete _fe;
+        delete _qrule;
+        _fe          = nullptr;
+        _qrule       = nullptr;
+        _initialized = false;
         
-        unsigned int
-        n = (unsigned int) local_xyz.size();
-        _global_xyz.resize(n);
+        this->init(elem, init_grads);
         
-        for (unsigned int i=0; i<n; i++)
-            elem.transform_point_to_global_coordinate(local_xyz[i], _global_xyz[i]);
+        return true;
     }
     
-    _initialized = true;
+    const libMesh::Elem*
+    q_elem = nullptr;
+    
+    if (elem.use_local_elem())
+        q_elem = &elem.get_quadrature_local_elem();
+    else
+        q_elem = &elem.get_quadrature_elem();
+    
+    _elem           = &elem;
+    _use_local_elem = elem.use_local_elem();
+    
+    // libMesh reuses the shape functions if the element type is unchanged
+    _fe->reinit(q_elem);
+    
+    this->_init_global_xyz(elem);
+    
+    return false;
+}
+
+
+
+void
+MAST::FEBase::_init_global_xyz(const MAST::GeomElem& elem) {
+    
+    if (!elem.use_local_elem())
+        return;
+    
+    const std::vector<libMesh::Point>
+    &local_xyz    = _fe->get_xyz();
+    
+    unsigned int
+    n = (unsigned int) local_xyz.size();
+    _global_xyz.resize(n);
+    
+    for (unsigned int i=0; i<n; i++)
+        elem.transform_point_to_global_coordinate(local_xyz[i], _global_xyz[i]);
 }
 
 
@@ -140,7 +232,8 @@ MAST::FEBase::init_for_side(const MAST::GeomElem& elem,
 
     libmesh_assert(!_initialized);
 
-    _elem = &elem;
+    _elem           = &elem;
+    _use_local_elem = elem.use_local_elem();
     
     const unsigned int
     nv    = _sys.n_vars();
@@ -228,7 +321,7 @@ const std::vector<libMesh::Point>&
 MAST::FEBase::get_xyz() const {
     
     libmesh_assert(_initialized);
-    if (_elem->use_local_elem())
+    if (_use_local_elem)
         return _global_xyz;
     else
         return _fe->get_xyz();
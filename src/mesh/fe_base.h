@@ -70,6 +70,37 @@ namespace MAST {
                           bool init_grads,
                           const std::vector<libMesh::Point>* pts = nullptr);
         
+        /*!
+         *   Reinitializes the finite element for volume integration over
+         *   \p elem. The libMesh finite element and quadrature rule of the
+         *   previous initialization are reused if the element dimension,
+         *   finite element type, quadrature order and requested derivatives
+         *   are unchanged, so that the same object can be used for a
+         *   sequence of elements without heap allocation. Otherwise, the
+         *   object is initialized using \p init(). @returns \p true if new
+         *   finite element and quadrature objects had to be created.
+         */
+        virtual bool reinit(const MAST::GeomElem& elem,
+                            bool init_grads);
+        
+        /*!
+         *   @returns \p true if \p reinit() for \p elem with the specified
+         *   options can reuse the finite element and quadrature rule of
+         *   this object.
+         */
+        bool can_reinit(const MAST::GeomElem& elem,
+                        bool init_grads,
+                        bool init_second_order_derivatives,
+                        int extra_quadrature_order) const;
+        
+        /*!
+         *   @returns the system initialization object for which this
+         *   finite element is created
+         */
+        const MAST::SystemInitialization& system_initialization() const {
+            return _sys;
+        }
+        
         
         /*!
          *   Initializes the quadrature and finite element for element side
@@ -83,7 +114,7 @@ namespace MAST {
                                    bool if_calculate_dphi);
         
         
-        libMesh::FEType
+        virtual libMesh::FEType
         get_fe_type() const;
         
         virtual const std::vector<Real>&
@@ -176,10 +207,25 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   computes the global coordinates of the quadrature points for
+         *   elements that use a local element
+         */
+        void _init_global_xyz(const MAST::GeomElem& elem);
+        
         const MAST::SystemInitialization& _sys;
         unsigned int                      _extra_quadrature_order;
         bool                              _init_second_order_derivatives;
         bool                              _initialized;
+        
+        /*!
+         *   quadrature order and derivative flags that \p _fe and
+         *   \p _qrule were created with in \p init()
+         */
+        int                               _fe_quadrature_order;
+        bool                              _fe_init_grads;
+        bool                              _fe_init_second_order_derivatives;
+        bool                              _use_local_elem;
         const MAST::GeomElem*             _elem;
         libMesh::FEBase*                  _fe;
         libMesh::QBase*                   _qrule;
@@ -0,0 +1,186 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// MAST includes
+#include "mesh/fe_cache.h"
+#include "mesh/geom_elem.h"
+#include "base/system_initialization.h"
+
+
+MAST::FECache::FECache() {
+    
+}
+
+
+MAST::FECache::~FECache() {
+    
+    this->clear();
+}
+
+
+
+const MAST::FEBase&
+MAST::FECache::get_fe(const MAST::SystemInitialization& sys,
+                      const MAST::GeomElem& elem,
+                      bool init_grads,
+                      bool init_second_order_derivative,
+                      int extra_quadrature_order) {
+    
+    const KeyType
+    key (elem.get_reference_elem().id(),
+         -1,
+         sys.fetype(0),
+         extra_quadrature_order,
+         init_grads,
+         init_second_order_derivative);
+    
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
+    std::map<KeyType, MAST::FEBase*>::iterator
+    it = _fe.find(key);
+    
+    if (it == _fe.end()) {
+        
+        MAST::FEBase* fe = new MAST::FEBase(sys);
+        fe->set_extra_quadrature_order(extra_quadrature_order);
+        fe->set_evaluate_second_order_derivatives(init_second_order_derivative);
+        fe->init(elem, init_grads);
+        
+        it = _fe.insert(std::make_pair(key, fe)).first;
+    }
+    
+    return *it->second;
+}
+
+
+
+std::unique_ptr<MAST::FEBase>
+MAST::FECache::init_fe(const MAST::SystemInitialization& sys,
+                       const MAST::GeomElem& elem,
+                       bool init_grads,
+                       bool init_second_order_derivative,
+                       int extra_quadrature_order) {
+    
+    const MAST::FEBase&
+    fe = this->get_fe(sys,
+                      elem,
+                      init_grads,
+                      init_second_order_derivative,
+                      extra_quadrature_order);
+    
+    return std::unique_ptr<MAST::FEBase>(new MAST::CachedFEBase(sys, fe));
+}
+
+
+
+std::unique_ptr<MAST::FEBase>
+MAST::FECache::init_side_fe(const MAST::SystemInitialization& sys,
+                            const MAST::GeomElem& elem,
+                            unsigned int s,
+                            bool init_grads,
+                            int extra_quadrature_order) {
+    
+    const KeyType
+    key (elem.get_reference_elem().id(),
+         (int)s,
+         sys.fetype(0),
+         extra_quadrature_order,
+         init_grads,
+         false);
+    
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
+    std::map<KeyType, MAST::FEBase*>::iterator
+    it = _fe.find(key);
+    
+    if (it == _fe.end()) {
+        
+        MAST::FEBase* fe = new MAST::FEBase(sys);
+        fe->set_extra_quadrature_order(extra_quadrature_order);
+        fe->init_for_side(elem, s, init_grads);
+        
+        it = _fe.insert(std::make_pair(key, fe)).first;
+    }
+    
+    return std::unique_ptr<MAST::FEBase>(new MAST::CachedFEBase(sys, *it->second));
+}
+
+
+
+void
+MAST::FECache::clear() {
+    
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
+    std::map<KeyType, MAST::FEBase*>::iterator
+    it  = _fe.begin(),
+    end = _fe.end();
+    
+    for ( ; it != end; it++)
+        delete it->second;
+    
+    _fe.clear();
+}
+
+
+
+
+MAST::CachedFEBase::CachedFEBase(const MAST::SystemInitialization& sys,
+                                 const MAST::FEBase& fe):
+MAST::FEBase(sys),
+_cached_fe (fe) {
+    
+    _initialized = true;
+}
+
+
+MAST::CachedFEBase::~CachedFEBase() {
+    
+}
+
+
+void
+MAST::CachedFEBase::init(const MAST::GeomElem& elem,
+                         bool init_grads,
+                         const std::vector<libMesh::Point>* pts) {
+    
+    // the cached data is read-only
+    libmesh_error();
+}
+
+
+void
+MAST::CachedFEBase::init_for_side(const MAST::GeomElem& elem,
+                                  unsigned int s,
+                                  bool if_calculate_dphi) {
+    
+    // the cached data is read-only
+    libmesh_error();
+}
+
+
+bool
+MAST::CachedFEBase::reinit(const MAST::GeomElem& elem,
+                           bool init_grads) {
+    
+    // the cached data is read-only
+    libmesh_error();
+    return false;
+}
+
@@ -0,0 +1,246 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast_fe_cache_h__
+#define __mast_fe_cache_h__
+
+// C++ includes
+#include <map>
+#include <memory>
+#include <tuple>
+
+// MAST includes
+#include "mesh/fe_base.h"
+
+// libMesh includes
+#include "libmesh/threads.h"
+
+
+namespace MAST {
+
+    // forward declerations
+    class SystemInitialization;
+    class GeomElem;
+    
+    /*!
+     *   Stores the finite element shape functions and quadrature data for
+     *   elements and element sides so that they can be reused across
+     *   successive assembly operations on an unchanged mesh. Entries are
+     *   keyed by the element id, side, finite element type, extra
+     *   quadrature order and the requested derivatives. The cached data
+     *   depends only on the element geometry, so the cache must be cleared
+     *   with \p clear() when the mesh moves or is refined. This is done
+     *   automatically by \p MAST::NonlinearSystem::reinit().
+     */
+    class FECache {
+        
+    public:
+        
+        FECache();
+        
+        virtual ~FECache();
+        
+        /*!
+         *   @returns a reference to the cached finite element data for
+         *   volume integration over \p elem. The data is computed and
+         *   stored if it does not already exist. The reference is valid
+         *   until the cache is cleared.
+         */
+        const MAST::FEBase&
+        get_fe(const MAST::SystemInitialization& sys,
+               const MAST::GeomElem& elem,
+               bool init_grads,
+               bool init_second_order_derivative,
+               int extra_quadrature_order);
+        
+        /*!
+         *   @returns a read-only wrapper around the cached finite element
+         *   data for volume integration over \p elem. The data is computed
+         *   and stored if it does not already exist.
+         */
+        std::unique_ptr<MAST::FEBase>
+        init_fe(const MAST::SystemInitialization& sys,
+                const MAST::GeomElem& elem,
+                bool init_grads,
+                bool init_second_order_derivative,
+                int extra_quadrature_order);
+        
+        /*!
+         *   @returns a read-only wrapper around the cached finite element
+         *   data for integration over side \p s of \p elem. The data is
+         *   computed and stored if it does not already exist.
+         */
+        std::unique_ptr<MAST::FEBase>
+        init_side_fe(const MAST::SystemInitialization& sys,
+                     const MAST::GeomElem& elem,
+                     unsigned int s,
+                     bool init_grads,
+                     int extra_quadrature_order);
+        
+        /*!
+         *   removes all cached data. Any wrapper returned by this object
+         *   before this call is invalid after the call, so this should not
+         *   be called while an assembly is using the cache.
+         */
+        void clear();
+        
+        /*!
+         *   @returns the number of cached finite element objects
+         */
+        unsigned int size() const {
+            
+            libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+            return (unsigned int)_fe.size();
+        }
+        
+    protected:
+        
+        /*!
+         *   element id, side (-1 for volume), FE type, extra quadrature
+         *   order, gradients flag, second order derivatives flag.
+         */
+        typedef std::tuple<libMesh::dof_id_type, int, libMesh::FEType, int, bool, bool>
+        KeyType;
+
+        /*!
+         *   mutex to allow the cache to be populated from multiple
+         *   assembly threads.
+         */
+        mutable libMesh::Threads::spin_mutex _mutex;
+        
+        /*!
+         *   map of cached finite element objects
+         */
+        std::map<KeyType, MAST::FEBase*>   _fe;
+    };
+    
+    
+    
+    /*!
+     *   Provides read-only access to a finite element object stored in
+     *   the \p MAST::FECache. The object does not own the data and should
+     *   not be used after the cache is cleared.
+     */
+    class CachedFEBase:
+    public MAST::FEBase {
+        
+    public:
+        
+        CachedFEBase(const MAST::SystemInitialization& sys,
+                     const MAST::FEBase& fe);
+        
+        virtual ~CachedFEBase();
+        
+        virtual void init(const MAST::GeomElem& elem,
+                          bool init_grads,
+                          const std::vector<libMesh::Point>* pts = nullptr);
+        
+        virtual void init_for_side(const MAST::GeomElem& elem,
+                                   unsigned int s,
+                                   bool if_calculate_dphi);
+        
+        virtual bool reinit(const MAST::GeomElem& elem,
+                            bool init_grads);
+        
+        virtual libMesh::FEType get_fe_type() const
+        { return _cached_fe.get_fe_type(); }
+        
+        virtual const std::vector<Real>& get_JxW() const
+        { return _cached_fe.get_JxW(); }
+        
+        virtual const std::vector<libMesh::Point>& get_xyz() const
+        { return _cached_fe.get_xyz(); }
+        
+        virtual unsigned int n_shape_functions() const
+        { return _cached_fe.n_shape_functions(); }
+        
+        virtual const std::vector<std::vector<Real> >& get_phi() const
+        { return _cached_fe.get_phi(); }
+        
+        virtual const std::vector<std::vector<libMesh::RealVectorValue> >& get_dphi() const
+        { return _cached_fe.get_dphi(); }
+        
+        virtual const std::vector<std::vector<libMesh::RealTensorValue>>& get_d2phi() const
+        { return _cached_fe.get_d2phi(); }
+        
+        virtual const std::vector<Real>& get_dxidx() const
+        { return _cached_fe.get_dxidx(); }
+        
+        virtual const std::vector<Real>& get_dxidy() const
+        { return _cached_fe.get_dxidy(); }
+        
+        virtual const std::vector<Real>& get_dxidz() const
+        { return _cached_fe.get_dxidz(); }
+        
+        virtual const std::vector<Real>& get_detadx() const
+        { return _cached_fe.get_detadx(); }
+        
+        virtual const std::vector<Real>& get_detady() const
+        { return _cached_fe.get_detady(); }
+        
+        virtual const std::vector<Real>& get_detadz() const
+        { return _cached_fe.get_detadz(); }
+        
+        virtual const std::vector<Real>& get_dzetadx() const
+        { return _cached_fe.get_dzetadx(); }
+        
+        virtual const std::vector<Real>& get_dzetady() const
+        { return _cached_fe.get_dzetady(); }
+        
+        virtual const std::vector<Real>& get_dzetadz() const
+        { return _cached_fe.get_dzetadz(); }
+        
+        virtual const std::vector<libMesh::RealVectorValue>& get_dxyzdxi() const
+        { return _cached_fe.get_dxyzdxi(); }
+        
+        virtual const std::vector<libMesh::RealVectorValue>& get_dxyzdeta() const
+        { return _cached_fe.get_dxyzdeta(); }
+        
+        virtual const std::vector<libMesh::RealVectorValue>& get_dxyzdzeta() const
+        { return _cached_fe.get_dxyzdzeta(); }
+        
+        virtual const std::vector<std::vector<Real> >& get_dphidxi() const
+        { return _cached_fe.get_dphidxi(); }
+        
+        virtual const std::vector<std::vector<Real> >& get_dphideta() const
+        { return _cached_fe.get_dphideta(); }
+        
+        virtual const std::vector<std::vector<Real> >& get_dphidzeta() const
+        { return _cached_fe.get_dphidzeta(); }
+        
+        virtual const std::vector<libMesh::Point>& get_normals_for_reference_coordinate() const
+        { return _cached_fe.get_normals_for_reference_coordinate(); }
+        
+        virtual const std::vector<libMesh::Point>& get_normals_for_local_coordinate() const
+        { return _cached_fe.get_normals_for_local_coordinate(); }
+        
+        virtual const std::vector<libMesh::Point>& get_qpoints() const
+        { return _cached_fe.get_qpoints(); }
+        
+        virtual const libMesh::QBase& get_qrule() const
+        { return _cached_fe.get_qrule(); }
+        
+    protected:
+        
+        const MAST::FEBase& _cached_fe;
+    };
+}
+
+
+#endif // __mast_fe_cache_h__
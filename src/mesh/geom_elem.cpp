@@ -21,6 +21,7 @@
 // MAST includes
 #include "mesh/geom_elem.h"
 #include "mesh/fe_base.h"
+#include "mesh/fe_cache.h"
 #include "base/nonlinear_system.h"
 #include "base/system_initialization.h"
 
@@ -145,6 +146,15 @@ MAST::GeomElem::init_fe(bool init_grads,
     
     libmesh_assert(_ref_elem);
     
+    // use the cached data if the system provides a cache
+    MAST::FECache* cache = _sys_init->system().fe_cache();
+    if (cache)
+        return cache->init_fe(*_sys_init,
+                              *this,
+                              init_grads,
+                              init_second_order_derivative,
+                              extra_quadrature_order);
+    
     std::unique_ptr<MAST::FEBase> fe(new MAST::FEBase(*_sys_init));
     fe->set_extra_quadrature_order(extra_quadrature_order);
     fe->set_evaluate_second_order_derivatives(init_second_order_derivative);
@@ -153,6 +163,32 @@ MAST::GeomElem::init_fe(bool init_grads,
     
     return fe;
 }
+
+
+
+const MAST::FEBase&
+MAST::GeomElem::init_fe(MAST::ElemWorkspace::Frame& ws,
+                        bool init_grads,
+                        bool init_second_order_derivative,
+                        int extra_quadrature_order) const {
+    
+    libmesh_assert(_ref_elem);
+    
+    // use the cached data if the system provides a cache
+    MAST::FECache* cache = _sys_init->system().fe_cache();
+    if (cache)
+        return cache->get_fe(*_sys_init,
+                             *this,
+                             init_grads,
+                             init_second_order_derivative,
+                             extra_quadrature_order);
+    
+    return ws.fe(*_sys_init,
+                 *this,
+                 init_grads,
+                 init_second_order_derivative,
+                 extra_quadrature_order);
+}
         
 
 std::unique_ptr<MAST::FEBase>
@@ -160,6 +196,15 @@ MAST::GeomElem::init_side_fe(unsigned int s,
                              bool init_grads,
                              int extra_quadrature_order) const {
  
+    // use the cached data if the system provides a cache
+    MAST::FECache* cache = _sys_init->system().fe_cache();
+    if (cache)
+        return cache->init_side_fe(*_sys_init,
+                                   *this,
+                                   s,
+                                   init_grads,
+                                   extra_quadrature_order);
+    
     std::unique_ptr<MAST::FEBase> fe(new MAST::FEBase(*_sys_init));
     fe->set_extra_quadrature_order(extra_quadrature_order);
     
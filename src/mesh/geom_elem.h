@@ -23,6 +23,7 @@
 
 // MAST includes
 #include "base/mast_data_types.h"
+#include "base/elem_workspace.h"
 
 // libMesh includes
 #include "libmesh/elem.h"
@@ -125,6 +126,19 @@ namespace MAST {
                 bool init_second_order_derivative,
                 int extra_quadrature_order = 0) const;
 
+        /*!
+         *   same as \p init_fe() above, except that the finite element is
+         *   borrowed from the element workspace through \p ws, which
+         *   avoids creating new finite element and quadrature objects for
+         *   each element. The returned object is valid until \p ws is
+         *   destroyed.
+         */
+        virtual const MAST::FEBase&
+        init_fe(MAST::ElemWorkspace::Frame& ws,
+                bool init_grads,
+                bool init_second_order_derivative,
+                int extra_quadrature_order = 0) const;
+
 
         /*!
          *   initializes the finite element shape function and quadrature
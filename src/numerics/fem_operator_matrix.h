@@ -132,6 +132,15 @@ namespace MAST {
         void left_multiply_transpose(T& r, const T& m) const;
         
         
+        /*!
+         *   copies the operator into the dense matrix \p m, which must be
+         *   sized m() x n(). This is used by the fixed-size element kernels
+         *   that operate on compile-time sized Eigen matrices.
+         */
+        template <typename T>
+        void get_dense(T& m) const;
+        
+        
     protected:
         
         /*!
@@ -150,12 +159,20 @@ namespace MAST {
         unsigned int _n_dofs_per_var;
         
         /*!
-         *    stores the shape function values that defines the coupling
-         *    of i_th interpolated var and j_th discrete var. Stored in
-         *    column major format. nullptr, if values are zero, otherwise the
-         *    value is set in the vector.
+         *    stores the shape function values that define the coupling
+         *    of i_th interpolated var and j_th discrete var. The block for
+         *    (i, j) is stored in column \p j*_n_interpolated_vars+i of this
+         *    column-major matrix, so that the shape functions of each block
+         *    are contiguous in memory. The storage is retained across
+         *    calls to \p reinit() with unchanged dimensions.
+         */
+        RealMatrixX  _shape_functions;
+        
+        /*!
+         *    \p true for blocks whose shape functions have been set, and
+         *    \p false for blocks that are zero.
          */
-        std::vector<RealVectorX*>  _var_shape_functions;
+        std::vector<bool>  _occupied;
     };
     
 }
@@ -170,9 +187,9 @@ MAST::FEMOperatorMatrix::print(std::ostream& o) {
     for (unsigned int i=0; i<_n_interpolated_vars; i++) {// row
         for (unsigned int j=0; j<_n_discrete_vars; j++) { // column
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) // check if this is non-nullptr
+            if (_occupied[index]) // check if this is non-zero
                 for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                    o << std::setw(15) << (*_var_shape_functions[index])(k);
+                    o << std::setw(15) << _shape_functions(k, index);
             else
                 for (unsigned int k=0; k<_n_dofs_per_var; k++)
                     o << std::setw(15) << 0.;
@@ -190,15 +207,8 @@ MAST::FEMOperatorMatrix::clear() {
     _n_discrete_vars     = 0;
     _n_dofs_per_var      = 0;
     
-    // iterate over the shape function entries and delete the non-nullptr values
-    std::vector<RealVectorX*>::iterator it = _var_shape_functions.begin(),
-    end = _var_shape_functions.end();
-    
-    for ( ; it!=end; it++)
-        if ( *it != nullptr)
-            delete *it;
-    
-    _var_shape_functions.clear();
+    _shape_functions.resize(0, 0);
+    _occupied.clear();
 }
 
 
@@ -211,13 +221,13 @@ reinit(unsigned int n_interpolated_vars,
        unsigned int n_discrete_vars,
        unsigned int n_discrete_dofs_per_var) {
     
-    this->clear();
     _n_interpolated_vars = n_interpolated_vars;
-    _n_discrete_vars = n_discrete_vars;
-    _n_dofs_per_var = n_discrete_dofs_per_var;
-    _var_shape_functions.resize(_n_interpolated_vars*_n_discrete_vars);
-    for (unsigned int i=0; i<_var_shape_functions.size(); i++)
-        _var_shape_functions[i] = nullptr;
+    _n_discrete_vars     = n_discrete_vars;
+    _n_dofs_per_var      = n_discrete_dofs_per_var;
+    
+    // Eigen does not reallocate if the size of the matrix is unchanged
+    _shape_functions.resize(_n_dofs_per_var, _n_interpolated_vars*_n_discrete_vars);
+    _occupied.assign(_n_interpolated_vars*_n_discrete_vars, false);
 }
 
 
@@ -230,22 +240,18 @@ set_shape_function(unsigned int interpolated_var,
                    const RealVectorX& shape_func) {
     
     // make sure that reinit has been called.
-    libmesh_assert(_var_shape_functions.size());
+    libmesh_assert(_occupied.size());
     
     // also make sure that the specified indices are within bounds
     libmesh_assert(interpolated_var < _n_interpolated_vars);
     libmesh_assert(discrete_var < _n_discrete_vars);
+    libmesh_assert_equal_to(shape_func.size(), _n_dofs_per_var);
     
-    RealVectorX* vec =
-    _var_shape_functions[discrete_var*_n_interpolated_vars+interpolated_var];
-    
-    if (!vec)
-    {
-        vec = new RealVectorX;
-        _var_shape_functions[discrete_var*_n_interpolated_vars+interpolated_var] = vec;
-    }
+    const unsigned int
+    index = discrete_var*_n_interpolated_vars+interpolated_var;
     
-    *vec = shape_func;
+    _shape_functions.col(index) = shape_func;
+    _occupied[index]            = true;
 }
 
 
@@ -256,18 +262,12 @@ MAST::FEMOperatorMatrix::
 reinit(unsigned int n_vars,
        const RealVectorX& shape_func) {
     
-    this->clear();
-    
-    _n_interpolated_vars = n_vars;
-    _n_discrete_vars = n_vars;
-    _n_dofs_per_var = (unsigned int)shape_func.size();
-    _var_shape_functions.resize(n_vars*n_vars);
+    this->reinit(n_vars, n_vars, (unsigned int)shape_func.size());
     
-    for (unsigned int i=0; i<n_vars; i++)
-    {
-        RealVectorX*  vec = new RealVectorX;
-        *vec = shape_func;
-        _var_shape_functions[i*n_vars+i] = vec;
+    for (unsigned int i=0; i<n_vars; i++) {
+        
+        _shape_functions.col(i*n_vars+i) = shape_func;
+        _occupied[i*n_vars+i]            = true;
     }
 }
 
@@ -282,16 +282,18 @@ vector_mult(T& res, const T& v) const {
     libmesh_assert_equal_to(res.size(), _n_interpolated_vars);
     libmesh_assert_equal_to(v.size(), n());
     
+    typedef typename T::Scalar ScalarType;
+    
     res.setZero();
     unsigned int index = 0;
     
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) // check if this is non-nullptr
-                for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                    res(i) +=
-                    (*_var_shape_functions[index])(k) * v(j*_n_dofs_per_var+k);
+            if (_occupied[index])
+                res(i) +=
+                _shape_functions.col(index).template cast<ScalarType>().dot
+                (v.segment(j*_n_dofs_per_var, _n_dofs_per_var));
         }
 }
 
@@ -305,16 +307,17 @@ vector_mult_transpose(T& res, const T& v) const {
     libmesh_assert_equal_to(res.size(), n());
     libmesh_assert_equal_to(v.size(), _n_interpolated_vars);
     
+    typedef typename T::Scalar ScalarType;
+    
     res.setZero(res.size());
     unsigned int index = 0;
     
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) // check if this is non-nullptr
-                for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                    res(j*_n_dofs_per_var+k) +=
-                    (*_var_shape_functions[index])(k) * v(i);
+            if (_occupied[index])
+                res.segment(j*_n_dofs_per_var, _n_dofs_per_var) +=
+                _shape_functions.col(index).template cast<ScalarType>() * v(i);
         }
 }
 
@@ -330,18 +333,18 @@ right_multiply(T& r, const T& m) const {
     libmesh_assert_equal_to(r.cols(), m.cols());
     libmesh_assert_equal_to(m.rows(), n());
     
+    typedef typename T::Scalar ScalarType;
+    
     r.setZero();
     unsigned int index = 0;
     
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column of operator
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
-                for (unsigned int l=0; l<m.cols(); l++) // column of matrix
-                    for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                        r(i,l) +=
-                        (*_var_shape_functions[index])(k) * m(j*_n_dofs_per_var+k,l);
-            }
+            if (_occupied[index])
+                r.row(i).noalias() +=
+                _shape_functions.col(index).transpose().template cast<ScalarType>() *
+                m.block(j*_n_dofs_per_var, 0, _n_dofs_per_var, m.cols());
         }
 }
 
@@ -358,18 +361,18 @@ right_multiply_transpose(T& r, const T& m) const {
     libmesh_assert_equal_to(r.cols(), m.cols());
     libmesh_assert_equal_to(m.rows(), _n_interpolated_vars);
     
+    typedef typename T::Scalar ScalarType;
+    
     r.setZero(r.rows(), r.cols());
     unsigned int index = 0;
     
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column of operator
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
-                for (unsigned int l=0; l<m.cols(); l++) // column of matrix
-                    for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                        r(j*_n_dofs_per_var+k,l) +=
-                        (*_var_shape_functions[index])(k) * m(i,l);
-            }
+            if (_occupied[index])
+                // rank-1 update of the rows of r for discrete var j
+                r.block(j*_n_dofs_per_var, 0, _n_dofs_per_var, r.cols()).noalias() +=
+                _shape_functions.col(index).template cast<ScalarType>() * m.row(i);
         }
 }
 
@@ -385,23 +388,24 @@ right_multiply_transpose(T& r, const MAST::FEMOperatorMatrix& m) const {
     libmesh_assert_equal_to(r.cols(), m.n());
     libmesh_assert_equal_to(_n_interpolated_vars, m._n_interpolated_vars);
     
+    typedef typename T::Scalar ScalarType;
+    
     r.setZero();
     unsigned int index_i, index_j = 0;
     
-    for (unsigned int i=0; i<_n_discrete_vars; i++) // row of result
-        for (unsigned int j=0; j<m._n_discrete_vars; j++) // column of result
+    for (unsigned int j=0; j<m._n_discrete_vars; j++) // column of result
+        for (unsigned int i=0; i<_n_discrete_vars; i++) // row of result
             for (unsigned int k=0; k<_n_interpolated_vars; k++) {
                 index_i = i*_n_interpolated_vars+k;
                 index_j = j*m._n_interpolated_vars+k;
-                if (_var_shape_functions[index_i] &&
-                    m._var_shape_functions[index_j]) { // if shape function exists for both
-                    const RealVectorX &n1 = *_var_shape_functions[index_i],
-                    &n2 = *m._var_shape_functions[index_j];
-                    for (unsigned int i_n1=0; i_n1<n1.size(); i_n1++)
-                        for (unsigned int i_n2=0; i_n2<n2.size(); i_n2++)
-                            r (i*_n_dofs_per_var+i_n1,
-                               j*m._n_dofs_per_var+i_n2) += n1(i_n1) * n2(i_n2);
-                }
+                if (_occupied[index_i] &&
+                    m._occupied[index_j]) // if shape function exists for both
+                    r.block(i*_n_dofs_per_var,
+                            j*m._n_dofs_per_var,
+                            _n_dofs_per_var,
+                            m._n_dofs_per_var).noalias() +=
+                    (_shape_functions.col(index_i) *
+                     m._shape_functions.col(index_j).transpose()).template cast<ScalarType>();
             }
 }
 
@@ -418,18 +422,19 @@ left_multiply(T& r, const T& m) const {
     libmesh_assert_equal_to(r.cols(), n());
     libmesh_assert_equal_to(m.cols(), _n_interpolated_vars);
     
+    typedef typename T::Scalar ScalarType;
+    
     r.setZero(r.rows(), r.cols());
     unsigned int index = 0;
     
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column of operator
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
-                for (unsigned int l=0; l<m.rows(); l++) // rows of matrix
-                    for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                        r(l,j*_n_dofs_per_var+k) +=
-                        (*_var_shape_functions[index])(k) * m(l,i);
-            }
+            if (_occupied[index])
+                // rank-1 update of the columns of r for discrete var j
+                r.block(0, j*_n_dofs_per_var, r.rows(), _n_dofs_per_var).noalias() +=
+                m.col(i) *
+                _shape_functions.col(index).transpose().template cast<ScalarType>();
         }
 }
 
@@ -445,23 +450,45 @@ left_multiply_transpose(T& r, const T& m) const {
     libmesh_assert_equal_to(r.cols(), _n_interpolated_vars);
     libmesh_assert_equal_to(m.cols(), n());
     
+    typedef typename T::Scalar ScalarType;
+    
     r.setZero();
     unsigned int index = 0;
     
-    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
-        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column of operator
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
-                for (unsigned int l=0; l<m.rows(); l++) // column of matrix
-                    for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                        r(l,i) +=
-                        (*_var_shape_functions[index])(k) * m(l,j*_n_dofs_per_var+k);
-            }
+            if (_occupied[index])
+                r.col(i).noalias() +=
+                m.block(0, j*_n_dofs_per_var, m.rows(), _n_dofs_per_var) *
+                _shape_functions.col(index).template cast<ScalarType>();
         }
 }
 
 
 
+template <typename T>
+inline
+void
+MAST::FEMOperatorMatrix::get_dense(T& m) const {
+    
+    libmesh_assert_equal_to(m.rows(), _n_interpolated_vars);
+    libmesh_assert_equal_to(m.cols(), n());
+    
+    typedef typename T::Scalar ScalarType;
+    
+    m.setZero();
+    unsigned int index = 0;
+    
+    for (unsigned int j=0; j<_n_discrete_vars; j++) // column
+        for (unsigned int i=0; i<_n_interpolated_vars; i++) { // row
+            index = j*_n_interpolated_vars+i;
+            if (_occupied[index])
+                m.block(i, j*_n_dofs_per_var, 1, _n_dofs_per_var) =
+                _shape_functions.col(index).transpose().template cast<ScalarType>();
+        }
+}
+
+
 
 #endif // __mast__fem_operator_matrix__
-
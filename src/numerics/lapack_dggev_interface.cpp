@@ -20,6 +20,7 @@
 
 // MAST includes
 #include "numerics/lapack_dggev_interface.h"
+#include "numerics/utility.h"
 
 
 void
@@ -148,3 +149,17 @@ MAST::LAPACK_DGGEV::compute(const RealMatrixX &A,
 }
 
 
+
+void
+MAST::LAPACK_DGGEV::broadcast(const libMesh::Parallel::Communicator& c,
+                              const unsigned int root_id) {
+    
+    c.broadcast(info_val, root_id);
+    
+    MAST::parallel_broadcast(c, _A,    root_id);
+    MAST::parallel_broadcast(c, _B,    root_id);
+    MAST::parallel_broadcast(c, VL,    root_id);
+    MAST::parallel_broadcast(c, VR,    root_id);
+    MAST::parallel_broadcast(c, alpha, root_id);
+    MAST::parallel_broadcast(c, beta,  root_id);
+}
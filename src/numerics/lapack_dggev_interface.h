@@ -24,6 +24,9 @@
 // MAST includes
 #include "base/mast_data_types.h"
 
+// libMesh includes
+#include "libmesh/parallel.h"
+
 
 extern "C" {
     
@@ -248,6 +251,13 @@ namespace MAST {
             }
         }
         
+        /*!
+         *    broadcasts the eigensolution computed on processor \p root_id
+         *    to all processors of \p c.
+         */
+        void broadcast(const libMesh::Parallel::Communicator& c,
+                       const unsigned int root_id);
+        
         void print_inner_product(std::ostream& out) const {
             libmesh_assert(info_val == 0);
             ComplexMatrixX r;
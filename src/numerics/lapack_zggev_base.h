@@ -23,6 +23,7 @@
 
 // MAST includes
 #include "base/mast_data_types.h"
+#include "numerics/utility.h"
 
 
 
@@ -110,6 +111,23 @@ namespace MAST {
             }
         }
         
+        /*!
+         *    broadcasts the eigensolution computed on processor \p root_id
+         *    to all processors of \p c.
+         */
+        void broadcast(const libMesh::Parallel::Communicator& c,
+                       const unsigned int root_id) {
+            
+            c.broadcast(info_val, root_id);
+            
+            MAST::parallel_broadcast(c, _A,    root_id);
+            MAST::parallel_broadcast(c, _B,    root_id);
+            MAST::parallel_broadcast(c, VL,    root_id);
+            MAST::parallel_broadcast(c, VR,    root_id);
+            MAST::parallel_broadcast(c, alpha, root_id);
+            MAST::parallel_broadcast(c, beta,  root_id);
+        }
+        
         void print_inner_product(std::ostream& out) const {
             libmesh_assert(info_val == 0);
             ComplexMatrixX r;
@@ -252,6 +252,38 @@ namespace MAST {
                 mat(i,j) = vals[m*j+i];
         
     }
+    
+    
+    
+    /*!
+     *   broadcasts the dense matrix or vector \p mat from processor
+     *   \p root_id to all processors of \p c. \p mat is resized on the
+     *   other processors.
+     */
+    template <typename MatType>
+    inline void
+    parallel_broadcast (const libMesh::Parallel::Communicator& c,
+                        MatType& mat,
+                        const unsigned int root_id) {
+        
+        unsigned int
+        m =  (unsigned int)mat.rows(),
+        n =  (unsigned int)mat.cols();
+        
+        c.broadcast(m, root_id);
+        c.broadcast(n, root_id);
+        
+        std::vector<typename MatType::Scalar> vals(m*n);
+        if (c.rank() == root_id)
+            for (unsigned int i=0; i<m*n; i++)
+                vals[i] = mat.data()[i];
+        
+        c.broadcast(vals, root_id);
+        
+        mat.resize(m, n);
+        for (unsigned int i=0; i<m*n; i++)
+            mat.data()[i] = vals[i];
+    }
 }
 
 
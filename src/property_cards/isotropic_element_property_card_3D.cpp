@@ -190,6 +190,15 @@ MAST::IsotropicElementPropertyCard3D::depends_on(const MAST::FunctionBase& f) co
 
 
 
+void
+MAST::IsotropicElementPropertyCard3D::get_parameters(std::set<const MAST::Parameter*>& p) const {
+    
+    _material->get_parameters(p);
+    MAST::ElementPropertyCardBase::get_parameters(p);
+}
+
+
+
 MAST::IsotropicElementProperty3D::StiffnessMatrix::
 StiffnessMatrix(const MAST::FieldFunction<RealMatrixX>& mat):
 MAST::FieldFunction<RealMatrixX> ("StiffnessMatrix3D"),
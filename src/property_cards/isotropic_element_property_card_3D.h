@@ -98,6 +98,11 @@ namespace MAST
          *  returns true if the property card depends on the function \p f
          */
         virtual bool depends_on(const MAST::FunctionBase& f) const;
+        
+        /*!
+         *  adds to \p p the parameters that this property card depends on
+         */
+        virtual void get_parameters(std::set<const MAST::Parameter*>& p) const;
 
         
         virtual std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
@@ -93,6 +93,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual void evaluate (const std::vector<libMesh::Point>& p,
+                                   const Real t,
+                                   std::vector<RealMatrixX>& m) const;
+            
             virtual void derivative(   const MAST::FunctionBase& f,
                                     const libMesh::Point& p,
                                     const Real t,
@@ -424,6 +428,41 @@ StiffnessMatrix2D::operator() (const libMesh::Point& p,
 
 
 
+void
+MAST::IsotropicMaterialProperty::
+StiffnessMatrix2D::evaluate (const std::vector<libMesh::Point>& p,
+                             const Real t,
+                             std::vector<RealMatrixX>& m) const {
+    libmesh_assert(_plane_stress); // currently only implemented for plane stress
+    
+    // this object is shared by all threads, so E and nu are evaluated
+    // pointwise instead of into temporary vectors
+    Real E, nu, E0 = 0., nu0 = 0.;
+    
+    m.resize(p.size());
+    
+    for (unsigned int i=0; i<p.size(); i++) {
+        
+        _E(p[i], t, E); _nu(p[i], t, nu);
+        
+        // the matrix is only recomputed if the properties change
+        if (i && E == E0 && nu == nu0) {
+            m[i] = m[i-1];
+            continue;
+        }
+        
+        E0 = E; nu0 = nu;
+        
+        m[i].setZero(3, 3);
+        m[i](0,0) = m[i](1,1) = E/(1.-nu*nu); // diagonal: direct stress
+        m[i](0,1) = m[i](1,0) = E*nu/(1.-nu*nu); // offdiagonal: direct stress
+        m[i](2,2) = E/2./(1.+nu); // diagonal: shear stress
+    }
+}
+
+
+
+
 void
 MAST::IsotropicMaterialProperty::
 StiffnessMatrix2D::derivative (  const MAST::FunctionBase& f,
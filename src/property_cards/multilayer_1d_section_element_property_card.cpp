@@ -241,6 +241,18 @@ MAST::Multilayer1DSectionElementPropertyCard::depends_on(const MAST::FunctionBas
 
 
 
+void
+MAST::Multilayer1DSectionElementPropertyCard::get_parameters(std::set<const MAST::Parameter*>& p) const {
+    
+    for (unsigned int i=0; i<_layers.size(); i++)
+        _layers[i]->get_parameters(p);
+    
+    for (unsigned int i=0; i<_layer_offsets.size(); i++)
+        _layer_offsets[i]->get_parameters(p);
+}
+
+
+
 std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
 MAST::Multilayer1DSectionElementPropertyCard::
 stiffness_A_matrix(const MAST::ElementBase& e) {
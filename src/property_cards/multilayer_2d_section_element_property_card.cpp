@@ -248,6 +248,18 @@ MAST::Multilayer2DSectionElementPropertyCard::depends_on(const MAST::FunctionBas
 
 
 
+void
+MAST::Multilayer2DSectionElementPropertyCard::get_parameters(std::set<const MAST::Parameter*>& p) const {
+    
+    for (unsigned int i=0; i<_layers.size(); i++)
+        _layers[i]->get_parameters(p);
+    
+    for (unsigned int i=0; i<_layer_offsets.size(); i++)
+        _layer_offsets[i]->get_parameters(p);
+}
+
+
+
 std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
 MAST::Multilayer2DSectionElementPropertyCard::
 stiffness_A_matrix(const MAST::ElementBase& e) {
@@ -202,6 +202,15 @@ MAST::OrthotropicElementPropertyCard3D::depends_on(const MAST::FunctionBase& f)
 
 
 
+void
+MAST::OrthotropicElementPropertyCard3D::get_parameters(std::set<const MAST::Parameter*>& p) const {
+    
+    _material->get_parameters(p);
+    MAST::ElementPropertyCardBase::get_parameters(p);
+}
+
+
+
 MAST::OrthotropicProperty3D::StiffnessMatrix::
 StiffnessMatrix(const MAST::FieldFunction<RealMatrixX>& mat,
                 const MAST::CoordinateBase& orient):
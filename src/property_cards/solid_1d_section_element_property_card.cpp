@@ -1385,6 +1385,15 @@ depends_on(const MAST::FunctionBase& f) const {
 
 
 
+void
+MAST::Solid1DSectionElementPropertyCard::get_parameters(std::set<const MAST::Parameter*>& p) const {
+    
+    _material->get_parameters(p);
+    MAST::ElementPropertyCardBase::get_parameters(p);
+}
+
+
+
 const MAST::FieldFunction<Real>&
 MAST::Solid1DSectionElementPropertyCard::A() const {
     
@@ -39,6 +39,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual void evaluate (const std::vector<libMesh::Point>& p,
+                                   const Real t,
+                                   std::vector<RealMatrixX>& m) const;
+            
             virtual void derivative (    const MAST::FunctionBase& f,
                                      const libMesh::Point& p,
                                      const Real t,
@@ -66,6 +70,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual void evaluate (const std::vector<libMesh::Point>& p,
+                                   const Real t,
+                                   std::vector<RealMatrixX>& m) const;
+            
             virtual void derivative (    const MAST::FunctionBase& f,
                                      const libMesh::Point& p,
                                      const Real t,
@@ -91,6 +99,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual void evaluate (const std::vector<libMesh::Point>& p,
+                                   const Real t,
+                                   std::vector<RealMatrixX>& m) const;
+            
             virtual void derivative (    const MAST::FunctionBase& f,
                                      const libMesh::Point& p,
                                      const Real t,
@@ -369,6 +381,15 @@ MAST::Solid2DSectionElementPropertyCard::depends_on(const MAST::FunctionBase& f)
 
 
 
+void
+MAST::Solid2DSectionElementPropertyCard::get_parameters(std::set<const MAST::Parameter*>& p) const {
+    
+    _material->get_parameters(p);
+    MAST::ElementPropertyCardBase::get_parameters(p);
+}
+
+
+
 
 MAST::Solid2DSectionProperty::ExtensionStiffnessMatrix::
 ExtensionStiffnessMatrix(const MAST::FieldFunction<RealMatrixX>& mat,
@@ -397,6 +418,24 @@ ExtensionStiffnessMatrix::operator() (const libMesh::Point& p,
 
 
 
+void
+MAST::Solid2DSectionProperty::
+ExtensionStiffnessMatrix::evaluate (const std::vector<libMesh::Point>& p,
+                                    const Real t,
+                                    std::vector<RealMatrixX>& m) const {
+    // [C]*h. The scalar section properties are evaluated pointwise,
+    // which needs no temporary storage.
+    Real h;
+    _material_stiffness.evaluate(p, t, m);
+    for (unsigned int i=0; i<p.size(); i++) {
+        _h(p[i], t, h);
+        m[i] *= h;
+    }
+}
+
+
+
+
 void
 MAST::Solid2DSectionProperty::
 ExtensionStiffnessMatrix::derivative (     const MAST::FunctionBase& f,
@@ -451,6 +490,24 @@ ExtensionBendingStiffnessMatrix::operator() (const libMesh::Point& p,
 
 
 
+void
+MAST::Solid2DSectionProperty::
+ExtensionBendingStiffnessMatrix::evaluate (const std::vector<libMesh::Point>& p,
+                                           const Real t,
+                                           std::vector<RealMatrixX>& m) const {
+    // [C]*h*off
+    Real h, off;
+    _material_stiffness.evaluate(p, t, m);
+    for (unsigned int i=0; i<p.size(); i++) {
+        _h(p[i], t, h);
+        _off(p[i], t, off);
+        m[i] *= h*off;
+    }
+}
+
+
+
+
 void
 MAST::Solid2DSectionProperty::
 ExtensionBendingStiffnessMatrix::derivative (            const MAST::FunctionBase& f,
@@ -502,6 +559,24 @@ BendingStiffnessMatrix::operator() (const libMesh::Point& p,
 
 
 
+void
+MAST::Solid2DSectionProperty::
+BendingStiffnessMatrix::evaluate (const std::vector<libMesh::Point>& p,
+                                  const Real t,
+                                  std::vector<RealMatrixX>& m) const {
+    // [C]*(h^3/12 + h*off^2)
+    Real h, off;
+    _material_stiffness.evaluate(p, t, m);
+    for (unsigned int i=0; i<p.size(); i++) {
+        _h(p[i], t, h);
+        _off(p[i], t, off);
+        m[i] *= (pow(h,3)/12. + h*pow(off,2));
+    }
+}
+
+
+
+
 void
 MAST::Solid2DSectionProperty::
 BendingStiffnessMatrix::derivative (   const MAST::FunctionBase& f,
@@ -85,6 +85,11 @@ namespace MAST {
          */
         virtual bool depends_on(const MAST::FunctionBase& f) const;
         
+        /*!
+         *  adds to \p p the parameters that this property card depends on
+         */
+        virtual void get_parameters(std::set<const MAST::Parameter*>& p) const;
+        
         
         virtual std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
         stiffness_A_matrix(const MAST::ElementBase& e) const;
@@ -22,6 +22,7 @@
 #include "solver/complex_solver_base.h"
 #include "base/complex_assembly_base.h"
 #include "base/nonlinear_system.h"
+#include "utility/perf_log.h"
 
 
 // libMesh includes
@@ -189,6 +190,7 @@ MAST::ComplexSolverBase::solve_pc_fieldsplit() {
     libmesh_assert(_assembly);
 
     START_LOG("complex_solve()", "PetscFieldSplitSolver");
+    MAST_PERF_SCOPE("ComplexSolverBase::solve_pc_fieldsplit");
     
     // get reference to the system
     MAST::NonlinearSystem& sys =
@@ -335,6 +337,7 @@ MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     libmesh_assert(_assembly);
     
     START_LOG("solve_block_matrix()", "ComplexSolve");
+    MAST_PERF_SCOPE("ComplexSolverBase::solve_block_matrix");
     
     // get reference to the system
     MAST::NonlinearSystem& sys =
@@ -474,7 +477,10 @@ MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     START_LOG("KSPSolve", "ComplexSolve");
     
     // now solve
-    ierr = KSPSolve(ksp, res_vec, sol_vec);
+    {
+        MAST_PERF_SCOPE("ComplexSolverBase::solve_block_matrix/KSPSolve");
+        ierr = KSPSolve(ksp, res_vec, sol_vec);
+    }
 
     STOP_LOG("KSPSolve", "ComplexSolve");
     
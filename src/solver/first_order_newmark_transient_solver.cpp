@@ -374,3 +374,25 @@ elem_topology_sensitivity_calculations(const MAST::FunctionBase& f,
 
 
 
+void
+MAST::FirstOrderNewmarkTransientSolver::
+_effective_jacobian_coefficients(std::vector<Real>& c) const {
+    
+    c.resize(2);
+    c[0] = dt;
+    c[1] = beta;
+}
+
+
+
+void
+MAST::FirstOrderNewmarkTransientSolver::
+_local_truncation_error(const libMesh::NumericVector<Real>& sol,
+                        libMesh::NumericVector<Real>& err) {
+    
+    // e = dt/2 (x_dot - x0_dot)
+    this->update_velocity(err, sol);
+    err.add(-1., this->velocity(1));
+    err.scale(0.5*dt);
+    err.close();
+}
@@ -212,6 +212,23 @@ namespace MAST {
 
     protected:
         
+        /*!
+         *   estimates the local truncation error from the difference
+         *   between the solution and the forward Euler predictor,
+         *   \f$ e = \Delta t (\dot{x} - \dot{x}_0)/2 \f$, which is
+         *   \f$ O(\Delta t^2) \f$ for all values of \f$ \beta \f$.
+         */
+        virtual void
+        _local_truncation_error(const libMesh::NumericVector<Real>& sol,
+                                libMesh::NumericVector<Real>& err);
+
+        virtual unsigned int _local_truncation_error_order() const { return 2; }
+
+        /*!
+         *   the effective Jacobian depends on \f$ \Delta t \f$ and \f$ \beta \f$
+         */
+        virtual void
+        _effective_jacobian_coefficients(std::vector<Real>& c) const;
     };
     
 }
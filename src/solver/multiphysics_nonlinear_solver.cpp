@@ -18,11 +18,16 @@
  */
 
 
+// C++ includes
+#include <algorithm>
+#include <set>
+
 // MAST includes
 #include "solver/multiphysics_nonlinear_solver.h"
 #include "base/transient_assembly.h"
 #include "base/system_initialization.h"
 #include "base/nonlinear_system.h"
+#include "utility/perf_log.h"
 
 // libMesh includes
 #include "libmesh/dof_map.h"
@@ -168,6 +173,7 @@ PetscErrorCode
 __mast_multiphysics_petsc_snes_residual (SNES snes, Vec x, Vec r, void * ctx) {
     
     LOG_SCOPE("residual()", "PetscMultiphysicsNonlinearSolver");
+    MAST_PERF_SCOPE("MultiphysicsNonlinearSolverBase::residual");
     
     PetscErrorCode ierr=0;
     
@@ -287,6 +293,7 @@ PetscErrorCode
 __mast_multiphysics_petsc_snes_jacobian(SNES snes, Vec x, Mat jac, Mat pc, void * ctx)
 {
     LOG_SCOPE("jacobian()", "PetscMultiphysicsNonlinearSolver");
+    MAST_PERF_SCOPE("MultiphysicsNonlinearSolverBase::jacobian");
     
     PetscErrorCode ierr=0;
     
@@ -360,6 +367,11 @@ __mast_multiphysics_petsc_snes_jacobian(SNES snes, Vec x, Mat jac, Mat pc, void
         sys.matrix->close();
     }
 
+    //////////////////////////////////////////////////////////////////
+    // the off-diagonal blocks, if any are to be assembled
+    //////////////////////////////////////////////////////////////////
+    solver->update_coupling_blocks(sys_sols);
+    
     //////////////////////////////////////////////////////////////////
     // resotre the subvectors
     //////////////////////////////////////////////////////////////////
@@ -374,7 +386,6 @@ __mast_multiphysics_petsc_snes_jacobian(SNES snes, Vec x, Mat jac, Mat pc, void
         // now restore the subvectors
         ierr = VecRestoreSubVector(x, sys_is, &sol[i]);  CHKERRABORT(solver->comm().get(), ierr);
     }
-
     
     // call assembly of the global matrix
     ierr = MatAssemblyBegin(jac, MAT_FINAL_ASSEMBLY);  CHKERRABORT(solver->comm().get(), ierr);
@@ -399,7 +410,21 @@ _update                       (nullptr),
 _discipline_assembly          (n, nullptr),
 _is                           (_n_disciplines, PETSC_NULL),
 _sub_mats                     (_n_disciplines*_n_disciplines, PETSC_NULL),
-_n_dofs                       (0) {
+_shell_ctx                    (_n_disciplines*_n_disciplines, nullptr),
+_sys_n_dofs                   (_n_disciplines, 0),
+_sys_n_local_dofs             (_n_disciplines, 0),
+_n_dofs                       (0),
+_petsc_initialized            (false),
+_snes                         (PETSC_NULL),
+_mat                          (PETSC_NULL),
+_sol                          (PETSC_NULL),
+_res                          (PETSC_NULL),
+_coupling_type                (MAST::MultiphysicsNonlinearSolverBase::MATRIX_FREE),
+_coupling_mats                (_n_disciplines*_n_disciplines, PETSC_NULL),
+_if_coupling_assembled        (_n_disciplines*_n_disciplines, false),
+_if_coupling_init             (_n_disciplines*_n_disciplines, false),
+_coupling_nnz                 (_n_disciplines*_n_disciplines, 0.),
+_max_coupling_nnz_fraction    (0.5) {
     
 }
 
@@ -409,6 +434,7 @@ _n_dofs                       (0) {
 
 MAST::MultiphysicsNonlinearSolverBase::~MultiphysicsNonlinearSolverBase() {
     
+    this->clear_petsc_objects();
 }
 
 
@@ -430,6 +456,19 @@ set_system_assembly(unsigned int i,
 
 
 
+bool
+MAST::MultiphysicsNonlinearSolverBase::
+if_coupling_block_assembled(unsigned int i,
+                            unsigned int j) const {
+    
+    libmesh_assert_less(i, _n_disciplines);
+    libmesh_assert_less(j, _n_disciplines);
+    
+    return _if_coupling_assembled[i*_n_disciplines+j];
+}
+
+
+
 MAST::TransientAssembly&
 MAST::MultiphysicsNonlinearSolverBase::
 get_system_assembly(unsigned int i) {
@@ -448,6 +487,7 @@ get_system_assembly(unsigned int i) {
 void
 MAST::MultiphysicsNonlinearSolverBase::solve() {
     
+    MAST_PERF_SCOPE("MultiphysicsNonlinearSolverBase::solve");
     
     // make sure that all systems have been specified
     bool p = true;
@@ -455,16 +495,131 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
         p = ((_discipline_assembly[i] != nullptr) && p);
     libmesh_assert(p);
     
+    // the PETSc objects from the previous solve are reused, unless the
+    // disciplines have changed since they were created
+    if (!this->_if_petsc_objects_valid()) {
+        
+        this->clear_petsc_objects();
+        this->_init_petsc_objects();
+    }
+    
+    PetscErrorCode   ierr;
+    
+    //////////////////////////////////////////////////////////////////////
+    // now initialize the vector from the system solutions, which will serve
+    // as the initial solution for the coupled system
+    //////////////////////////////////////////////////////////////////////
+    for (unsigned int i=0; i<_n_disciplines; i++) {
+
+        // solution from the provided system
+        libMesh::NumericVector<Real>
+        &sys_sol = *_discipline_assembly[i]->system().solution;
+        
+        // limiting indices for the system, and multiphysics assembly. Should
+        // be the same
+        int
+        multiphysics_first = 0,
+        multiphysics_last  = 0,
+        first              = sys_sol.first_local_index(),
+        last               = sys_sol.last_local_index();
+        
+        // get the subvector corresponding to the the discipline
+        Vec sub_vec;
+
+        ierr = VecGetSubVector(_sol, _is[i], &sub_vec);  CHKERRABORT(this->comm().get(), ierr);
+        ierr = VecGetOwnershipRange(sub_vec,
+                                    &multiphysics_first,
+                                    &multiphysics_last); CHKERRABORT(this->comm().get(), ierr);
+        
+        // the first and last indices must match between the two representations
+        libmesh_assert_equal_to(multiphysics_first, first);
+        libmesh_assert_equal_to( multiphysics_last,  last);
+        
+        std::unique_ptr<libMesh::NumericVector<Real> >
+        multiphysics_sol(new libMesh::PetscVector<Real>(sub_vec, this->comm()));
+        
+        for (unsigned int i=first; i<last; i++)
+            multiphysics_sol->set(i, sys_sol(i));
+
+        multiphysics_sol->close();
+        
+        ierr = VecRestoreSubVector(_sol, _is[i], &sub_vec);  CHKERRABORT(this->comm().get(), ierr);
+    }
+    
+    
+    //ierr = SNESSetSolution(_snes, _sol);
+    //this->verify_gateaux_derivatives(_snes);
+    
+    //////////////////////////////////////////////////////////////////////
+    // now, solve
+    //////////////////////////////////////////////////////////////////////
+    START_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
+    
+    // now solve
+    {
+        MAST_PERF_SCOPE("MultiphysicsNonlinearSolverBase::SNESSolve");
+        ierr = SNESSolve(_snes, PETSC_NULL, _sol);
+    }
+    
+    STOP_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
+    
+    
+    //////////////////////////////////////////////////////////////////////
+    // now copy the solution back to the system solution vector
+    //////////////////////////////////////////////////////////////////////
+    for (unsigned int i=0; i<_n_disciplines; i++) {
+        
+        // solution from the provided system
+        libMesh::NumericVector<Real>
+        &sys_sol = *_discipline_assembly[i]->system().solution;
+        
+        // limiting indices for the system, and multiphysics assembly. Should
+        // be the same
+        int
+        multiphysics_first = 0,
+        multiphysics_last  = 0,
+        first              = sys_sol.first_local_index(),
+        last               = sys_sol.last_local_index();
+        
+        // get the subvector corresponding to the the discipline
+        Vec sub_vec;
+        
+        ierr = VecGetSubVector(_sol, _is[i], &sub_vec);  CHKERRABORT(this->comm().get(), ierr);
+        ierr = VecGetOwnershipRange(sub_vec,
+                                    &multiphysics_first,
+                                    &multiphysics_last); CHKERRABORT(this->comm().get(), ierr);
+        
+        // the first and last indices must match between the two representations
+        libmesh_assert_equal_to(multiphysics_first, first);
+        libmesh_assert_equal_to( multiphysics_last,  last);
+        
+        std::unique_ptr<libMesh::NumericVector<Real> >
+        multiphysics_sol(new libMesh::PetscVector<Real>(sub_vec, this->comm()));
+        
+        for (unsigned int i=first; i<last; i++)
+            sys_sol.set(i, (*multiphysics_sol)(i));
+
+        ierr = VecRestoreSubVector(_sol, _is[i], &sub_vec);  CHKERRABORT(this->comm().get(), ierr);
+    }
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::_init_petsc_objects() {
+    
+    MAST_PERF_SCOPE("MultiphysicsNonlinearSolverBase::init_petsc_objects");
+    
+    libmesh_assert(!_petsc_initialized);
     
     //////////////////////////////////////////////////////////////////////
     // create the solver context. This will be partially initialized now
     // since it is needed in the shell matrix context
     //////////////////////////////////////////////////////////////////////
     PetscErrorCode   ierr;
-    SNES             snes;
 
     // setup the solver context
-    ierr = SNESCreate(this->comm().get(), &snes);      CHKERRABORT(this->comm().get(), ierr);
+    ierr = SNESCreate(this->comm().get(), &_snes);     CHKERRABORT(this->comm().get(), ierr);
 
     //////////////////////////////////////////////////////////////////////
     // create a petsc nested matrix of size NxN
@@ -472,8 +627,6 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
     const bool       sys_name = libMesh::on_command_line("--solver_system_names");
     std::string      nm;
     unsigned int     n_local_dofs = 0;
-    std::vector<__mast_multiphysics_petsc_shell_context>
-    mat_ctx(_n_disciplines*_n_disciplines);
     
     
     // all diagonal blocks use the system matrcices, while shell matrices
@@ -487,6 +640,10 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
         _n_dofs      +=  sys.n_dofs();
         n_local_dofs +=  sys.n_local_dofs();
         
+        // sizes used to check if the objects can be reused in later solves
+        _sys_n_dofs[i]       = sys.n_dofs();
+        _sys_n_local_dofs[i] = sys.n_local_dofs();
+        
         for (unsigned int j=0; j<_n_disciplines; j++) {
             
             if (i==j) {
@@ -515,14 +672,18 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
                                       &_sub_mats[i*_n_disciplines+j]);
                 CHKERRABORT(this->comm().get(), ierr);
                 
-                // initialize the context and tell the matrix about it
-                mat_ctx[i*_n_disciplines+j].i      = i;
-                mat_ctx[i*_n_disciplines+j].j      = j;
-                mat_ctx[i*_n_disciplines+j].snes   = snes;
-                mat_ctx[i*_n_disciplines+j].solver = this;
+                // initialize the context and tell the matrix about it. The
+                // context is kept along with the shell matrix.
+                __mast_multiphysics_petsc_shell_context
+                *mat_ctx = new __mast_multiphysics_petsc_shell_context;
+                mat_ctx->i      = i;
+                mat_ctx->j      = j;
+                mat_ctx->snes   = _snes;
+                mat_ctx->solver = this;
+                _shell_ctx[i*_n_disciplines+j] = mat_ctx;
                 
                 ierr = MatShellSetContext(_sub_mats[i*_n_disciplines+j],
-                                          &mat_ctx[i*_n_disciplines+j]);
+                                          mat_ctx);
                 CHKERRABORT(this->comm().get(), ierr);
                 
                 // set the mat-vec multiplication operation for this
@@ -542,6 +703,10 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
                          &_sub_mats[0],
                          &_mat);
     CHKERRABORT(this->comm().get(), ierr);
+    
+    // the nested matrix starts with the shell matrices for all coupling
+    // blocks
+    std::fill(_if_coupling_assembled.begin(), _if_coupling_assembled.end(), false);
 
     // we need to turn off MULT_TRANSPOSE operator for the global matrix
     // since that is not implemented for the shell matrices pushes PETSc 3.7.4
@@ -580,50 +745,6 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
                                 PETSC_NULL);
     CHKERRABORT(this->comm().get(), ierr);
     
-    //////////////////////////////////////////////////////////////////////
-    // now initialize the vector from the system solutions, which will serve
-    // as the initial solution for the coupled system
-    //////////////////////////////////////////////////////////////////////
-    for (unsigned int i=0; i<_n_disciplines; i++) {
-
-        // solution from the provided system
-        libMesh::NumericVector<Real>
-        &sys_sol = *_discipline_assembly[i]->system().solution;
-        
-        // limiting indices for the system, and multiphysics assembly. Should
-        // be the same
-        int
-        multiphysics_first = 0,
-        multiphysics_last  = 0,
-        first              = sys_sol.first_local_index(),
-        last               = sys_sol.last_local_index();
-        
-        // get the subvector corresponding to the the discipline
-        Vec sub_vec;
-
-        ierr = VecGetSubVector(_sol, _is[i], &sub_vec);  CHKERRABORT(this->comm().get(), ierr);
-        ierr = VecGetOwnershipRange(sub_vec,
-                                    &multiphysics_first,
-                                    &multiphysics_last); CHKERRABORT(this->comm().get(), ierr);
-        
-        // the first and last indices must match between the two representations
-        libmesh_assert_equal_to(multiphysics_first, first);
-        libmesh_assert_equal_to( multiphysics_last,  last);
-        
-        std::unique_ptr<libMesh::NumericVector<Real> >
-        multiphysics_sol(new libMesh::PetscVector<Real>(sub_vec, this->comm()));
-        
-        for (unsigned int i=first; i<last; i++)
-            multiphysics_sol->set(i, sys_sol(i));
-
-        multiphysics_sol->close();
-        
-        ierr = VecRestoreSubVector(_sol, _is[i], &sub_vec);  CHKERRABORT(this->comm().get(), ierr);
-    }
-    
-    
-    
-    
     //////////////////////////////////////////////////////////////////////
     // initialize the solver context
     //////////////////////////////////////////////////////////////////////
@@ -633,11 +754,11 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
     
     
     // tell the solver where to store the Jacobian and how to calculate it
-    ierr = SNESSetFunction (snes,
+    ierr = SNESSetFunction (_snes,
                             _res,
                             __mast_multiphysics_petsc_snes_residual,
                             this);
-    ierr = SNESSetJacobian(snes,
+    ierr = SNESSetJacobian(_snes,
                            _mat,
                            _mat,
                            __mast_multiphysics_petsc_snes_jacobian,
@@ -647,14 +768,14 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
     if (sys_name) {
         
         nm = this->name() + "_";
-        SNESSetOptionsPrefix(snes, nm.c_str());
+        SNESSetOptionsPrefix(_snes, nm.c_str());
     }
     
     
     
     // setup the ksp
-    ierr = SNESGetKSP (snes, &ksp);                   CHKERRABORT(this->comm().get(), ierr);
-    ierr = SNESSetFromOptions(snes);                  CHKERRABORT(this->comm().get(), ierr);
+    ierr = SNESGetKSP (_snes, &ksp);                   CHKERRABORT(this->comm().get(), ierr);
+    ierr = SNESSetFromOptions(_snes);                  CHKERRABORT(this->comm().get(), ierr);
     
     
     
@@ -672,74 +793,310 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
             ierr = PCFieldSplitSetIS(pc, nullptr, _is[i]);CHKERRABORT(this->comm().get(), ierr);
     }
     
+    _petsc_initialized = true;
+}
 
-    //ierr = SNESSetSolution(snes, _sol);
-    //this->verify_gateaux_derivatives(snes);
-    
-    //////////////////////////////////////////////////////////////////////
-    // now, solve
-    //////////////////////////////////////////////////////////////////////
-    START_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
-    
-    // now solve
-    ierr = SNESSolve(snes, PETSC_NULL, _sol);
-    
-    STOP_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
+
+
+bool
+MAST::MultiphysicsNonlinearSolverBase::_if_petsc_objects_valid() const {
     
+    if (!_petsc_initialized)
+        return false;
     
-    //////////////////////////////////////////////////////////////////////
-    // now copy the solution back to the system solution vector
-    //////////////////////////////////////////////////////////////////////
+    // the objects are reused if the sizes of the disciplines and their
+    // system matrices, which serve as the diagonal blocks, are unchanged.
     for (unsigned int i=0; i<_n_disciplines; i++) {
         
-        // solution from the provided system
-        libMesh::NumericVector<Real>
-        &sys_sol = *_discipline_assembly[i]->system().solution;
-        
-        // limiting indices for the system, and multiphysics assembly. Should
-        // be the same
-        int
-        multiphysics_first = 0,
-        multiphysics_last  = 0,
-        first              = sys_sol.first_local_index(),
-        last               = sys_sol.last_local_index();
-        
-        // get the subvector corresponding to the the discipline
-        Vec sub_vec;
-        
-        ierr = VecGetSubVector(_sol, _is[i], &sub_vec);  CHKERRABORT(this->comm().get(), ierr);
-        ierr = VecGetOwnershipRange(sub_vec,
-                                    &multiphysics_first,
-                                    &multiphysics_last); CHKERRABORT(this->comm().get(), ierr);
-        
-        // the first and last indices must match between the two representations
-        libmesh_assert_equal_to(multiphysics_first, first);
-        libmesh_assert_equal_to( multiphysics_last,  last);
+        MAST::NonlinearSystem& sys = _discipline_assembly[i]->system();
         
-        std::unique_ptr<libMesh::NumericVector<Real> >
-        multiphysics_sol(new libMesh::PetscVector<Real>(sub_vec, this->comm()));
+        libMesh::PetscMatrix<Real>
+        *mat = dynamic_cast<libMesh::PetscMatrix<Real>*>(sys.matrix);
         
-        for (unsigned int i=first; i<last; i++)
-            sys_sol.set(i, (*multiphysics_sol)(i));
-
-        ierr = VecRestoreSubVector(_sol, _is[i], &sub_vec);  CHKERRABORT(this->comm().get(), ierr);
+        if (sys.n_dofs()       != _sys_n_dofs[i]       ||
+            sys.n_local_dofs() != _sys_n_local_dofs[i] ||
+            !mat                                       ||
+            mat->mat()         != _sub_mats[i*_n_disciplines+i])
+            return false;
     }
+    
+    return true;
+}
+
 
+
+void
+MAST::MultiphysicsNonlinearSolverBase::clear_petsc_objects() {
     
+    if (!_petsc_initialized)
+        return;
+    
+    PetscErrorCode   ierr;
     
     // destroy the Petsc contexts
-    ierr = SNESDestroy(&snes);                        CHKERRABORT(this->comm().get(), ierr);
+    ierr = SNESDestroy(&_snes);                        CHKERRABORT(this->comm().get(), ierr);
     for (unsigned int i=0; i<_n_disciplines; i++)
         for (unsigned int j=0; j<_n_disciplines; j++)
             if (i != j) {
                 ierr = MatDestroy(&_sub_mats[i*_n_disciplines+j]);
                 CHKERRABORT(this->comm().get(), ierr);
+                delete _shell_ctx[i*_n_disciplines+j];
+                _shell_ctx[i*_n_disciplines+j] = nullptr;
+                
+                if (_coupling_mats[i*_n_disciplines+j]) {
+                    
+                    ierr = MatDestroy(&_coupling_mats[i*_n_disciplines+j]);
+                    CHKERRABORT(this->comm().get(), ierr);
+                }
             }
     
     ierr = MatDestroy(&_mat);                          CHKERRABORT(this->comm().get(), ierr);
     ierr = VecDestroy(&_sol);                          CHKERRABORT(this->comm().get(), ierr);
     ierr = VecDestroy(&_res);                          CHKERRABORT(this->comm().get(), ierr);
     
+    // the index sets are owned by the nested matrix
+    std::fill(_is.begin(), _is.end(), PETSC_NULL);
+    std::fill(_sub_mats.begin(), _sub_mats.end(), PETSC_NULL);
+    std::fill(_coupling_mats.begin(), _coupling_mats.end(), PETSC_NULL);
+    std::fill(_if_coupling_assembled.begin(), _if_coupling_assembled.end(), false);
+    std::fill(_if_coupling_init.begin(), _if_coupling_init.end(), false);
+    std::fill(_coupling_nnz.begin(), _coupling_nnz.end(), 0.);
+    
+    _petsc_initialized = false;
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::
+update_coupling_blocks(const std::vector<libMesh::NumericVector<Real>*>& sols) {
+    
+    libmesh_assert(_petsc_initialized);
+    libmesh_assert_equal_to(sols.size(), _n_disciplines);
+    
+    PetscErrorCode   ierr;
+    
+    for (unsigned int i=0; i<_n_disciplines; i++)
+        for (unsigned int j=0; j<_n_disciplines; j++) {
+            
+            if (i == j)
+                continue;
+            
+            const unsigned int
+            k = i*_n_disciplines+j;
+            
+            // the sparsity is obtained only if the block may be assembled
+            if (_coupling_type != MAST::MultiphysicsNonlinearSolverBase::MATRIX_FREE &&
+                !_if_coupling_init[k])
+                this->_init_coupling_block(i, j);
+            
+            bool
+            assemble = false;
+            
+            switch (_coupling_type) {
+                    
+                case MAST::MultiphysicsNonlinearSolverBase::MATRIX_FREE:
+                    assemble = false;
+                    break;
+                    
+                case MAST::MultiphysicsNonlinearSolverBase::ASSEMBLED: {
+                    
+                    if (!_coupling_mats[k])
+                        libmesh_error_msg("Coupling Jacobian not provided by element "
+                                          "operations of discipline "
+                                          << i << " for discipline " << j);
+                    assemble = true;
+                }
+                    break;
+                    
+                case MAST::MultiphysicsNonlinearSolverBase::AUTOMATIC:
+                    assemble = this->_if_assemble_coupling_block(i, j);
+                    break;
+                    
+                default:
+                    libmesh_error(); // should not get here
+            }
+            
+            if (assemble)
+                this->_assemble_coupling_block(i, j, *sols[i]);
+            
+            // replace the block in the nested matrix if its type has changed
+            if (assemble != _if_coupling_assembled[k]) {
+                
+                ierr = MatNestSetSubMat(_mat, i, j,
+                                        assemble?_coupling_mats[k]:_sub_mats[k]);
+                CHKERRABORT(this->comm().get(), ierr);
+                _if_coupling_assembled[k] = assemble;
+            }
+        }
+}
+
+
+
+bool
+MAST::MultiphysicsNonlinearSolverBase::
+_if_assemble_coupling_block(unsigned int i, unsigned int j) {
+    
+    const unsigned int
+    k = i*_n_disciplines+j;
+    
+    // the element operations do not provide the coupling Jacobian
+    if (!_coupling_mats[k])
+        return false;
+    
+    // the nonzeros of the diagonal block in this row
+    PetscErrorCode   ierr;
+    MatInfo          info;
+    ierr = MatGetInfo(_sub_mats[i*_n_disciplines+i], MAT_GLOBAL_SUM, &info);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    // the assembled block replaces the discipline mesh sweep of each
+    // matrix-free product by a sparse product with the block, which is
+    // preferred unless the block is dense compared to the diagonal block.
+    return _coupling_nnz[k] <= _max_coupling_nnz_fraction * info.nz_used;
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::
+_init_coupling_block(unsigned int i, unsigned int j) {
+    
+    MAST_PERF_SCOPE("MultiphysicsNonlinearSolverBase::init_coupling_block");
+    
+    const unsigned int
+    k = i*_n_disciplines+j;
+    
+    libmesh_assert(!_if_coupling_init[k]);
+    libmesh_assert(!_coupling_mats[k]);
+    
+    const libMesh::DofMap
+    &dof_map_i = _discipline_assembly[i]->system().get_dof_map(),
+    &dof_map_j = _discipline_assembly[j]->system().get_dof_map();
+    
+    std::vector<std::set<libMesh::dof_id_type> >
+    cols;
+    
+    unsigned int
+    provided = _discipline_assembly[i]->coupling_sparsity(j, dof_map_j, cols);
+    this->comm().min(provided);
+    
+    _if_coupling_init[k] = true;
+    _coupling_nnz[k]     = 0.;
+    
+    if (!provided)
+        return;
+    
+    PetscErrorCode   ierr;
+    
+    const libMesh::dof_id_type
+    first_i = dof_map_i.first_dof(),
+    first_j = dof_map_j.first_dof(),
+    end_j   = dof_map_j.end_dof();
+    
+    // number of nonzeros in the diagonal and off-diagonal parts of each
+    // local row
+    std::vector<PetscInt>
+    d_nnz(cols.size(), 0),
+    o_nnz(cols.size(), 0);
+    
+    unsigned long
+    nnz = 0;
+    
+    for (unsigned int r=0; r<cols.size(); r++) {
+        
+        std::set<libMesh::dof_id_type>::const_iterator
+        it  = cols[r].begin(),
+        end = cols[r].end();
+        
+        for ( ; it != end; it++) {
+            if (*it >= first_j && *it < end_j)
+                d_nnz[r]++;
+            else
+                o_nnz[r]++;
+        }
+        
+        nnz += cols[r].size();
+    }
+    
+    this->comm().sum(nnz);
+    _coupling_nnz[k] = 1. * nnz;
+    
+    Mat
+    &mat = _coupling_mats[k];
+    
+    ierr = MatCreateAIJ(this->comm().get(),
+                        _sys_n_local_dofs[i],
+                        _sys_n_local_dofs[j],
+                        _sys_n_dofs[i],
+                        _sys_n_dofs[j],
+                        0, d_nnz.empty()?PETSC_NULL:&d_nnz[0],
+                        0, o_nnz.empty()?PETSC_NULL:&o_nnz[0],
+                        &mat);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    // the nonzero pattern is set with explicit zeros, so that it does not
+    // depend on the values of the first assembly. Entries outside of this
+    // pattern are an error in the element operations.
+    std::vector<PetscInt>
+    col_ids;
+    std::vector<PetscScalar>
+    vals;
+    
+    for (unsigned int r=0; r<cols.size(); r++) {
+        
+        if (cols[r].empty())
+            continue;
+        
+        const PetscInt
+        row = first_i + r;
+        
+        col_ids.assign(cols[r].begin(), cols[r].end());
+        vals.assign(cols[r].size(), 0.);
+        
+        ierr = MatSetValues(mat, 1, &row,
+                            (PetscInt)col_ids.size(), &col_ids[0],
+                            &vals[0], INSERT_VALUES);
+        CHKERRABORT(this->comm().get(), ierr);
+    }
+    
+    ierr = MatAssemblyBegin(mat, MAT_FINAL_ASSEMBLY);            CHKERRABORT(this->comm().get(), ierr);
+    ierr = MatAssemblyEnd(mat, MAT_FINAL_ASSEMBLY);              CHKERRABORT(this->comm().get(), ierr);
+    ierr = MatSetOption(mat, MAT_NEW_NONZERO_LOCATION_ERR, PETSC_TRUE);
+    CHKERRABORT(this->comm().get(), ierr);
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::
+_assemble_coupling_block(unsigned int i,
+                         unsigned int j,
+                         const libMesh::NumericVector<Real>& X) {
+    
+    MAST_PERF_SCOPE("MultiphysicsNonlinearSolverBase::assemble_coupling_block");
+    
+    const unsigned int
+    k = i*_n_disciplines+j;
+    
+    libmesh_assert(_coupling_mats[k]);
+    
+    PetscErrorCode   ierr;
+    ierr = MatZeroEntries(_coupling_mats[k]);                    CHKERRABORT(this->comm().get(), ierr);
+    
+    // the wrapper does not destroy the matrix
+    libMesh::PetscMatrix<Real>
+    mat(_coupling_mats[k], this->comm());
+    
+    MAST::NonlinearSystem
+    &sys_i = _discipline_assembly[i]->system(),
+    &sys_j = _discipline_assembly[j]->system();
+    
+    _discipline_assembly[i]->coupling_jacobian(X,
+                                               j,
+                                               sys_j.get_dof_map(),
+                                               mat,
+                                               sys_i);
 }
 
 
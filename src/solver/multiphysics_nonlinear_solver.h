@@ -36,6 +36,10 @@
 #include <petscsnes.h>
 
 
+// Forward declerations
+struct __mast_multiphysics_petsc_shell_context;
+
+
 namespace MAST {
 
     // Forward declerations
@@ -47,6 +51,32 @@ namespace MAST {
         
     public:
         
+        /*!
+         *   defines how the off-diagonal coupling blocks of the Jacobian
+         *   are applied
+         */
+        enum CouplingBlockType {
+            /*!
+             *   matrix-free application of the coupling Jacobian through
+             *   the linearized Jacobian-solution product of the disciplines
+             */
+            MATRIX_FREE,
+            /*!
+             *   the coupling blocks are assembled as sparse matrices from
+             *   the coupling Jacobian of the element operations once for
+             *   each Jacobian evaluation. The element operations of all
+             *   disciplines must provide the coupling Jacobian.
+             */
+            ASSEMBLED,
+            /*!
+             *   a block is assembled if the element operations provide its
+             *   coupling Jacobian, and if its number of nonzeros from the
+             *   coupling sparsity is small compared to the diagonal block
+             *   of the same row. Other blocks are applied matrix-free.
+             */
+            AUTOMATIC
+        };
+
         /*!
          *   default constructor
          */
@@ -116,9 +146,66 @@ namespace MAST {
         
         /*!
          *   solves the system using the nested matrices that uses the
-         *   discipline specific solver options
+         *   discipline specific solver options. The SNES, nested matrix,
+         *   off-diagonal shell matrices, index sets and field-split
+         *   preconditioner are created in the first call and reused in
+         *   subsequent calls, as long as the number of dofs and the system
+         *   matrix of each discipline are unchanged. Since the diagonal
+         *   blocks retain their nonzero pattern, PETSc reuses the symbolic
+         *   factorizations and sub-solvers across calls and only updates
+         *   the numerical values. A change in the sparsity pattern of a
+         *   discipline matrix that leaves its number of dofs and its Mat
+         *   unchanged is not detected, and \p clear_petsc_objects() must be
+         *   called before the next solve in that case.
          */
         void solve();
+
+        /*!
+         *   destroys the PETSc objects kept between calls to solve(). This
+         *   must be called if the discipline matrices are modified in a
+         *   way that is not identified by solve(), e.g., a change in the
+         *   sparsity pattern without a change in the number of dofs. The
+         *   objects are created again in the next call to solve().
+         */
+        void clear_petsc_objects();
+
+        /*!
+         *   sets the treatment of the off-diagonal coupling blocks. The
+         *   default is \p MATRIX_FREE.
+         */
+        void set_coupling_block_type(CouplingBlockType t) {
+            _coupling_type = t;
+        }
+
+        /*!
+         *   sets the largest ratio of the nonzeros of a coupling block to
+         *   the nonzeros of the diagonal block in the same row for which
+         *   the \p AUTOMATIC option assembles the block. The default is
+         *   0.5.
+         */
+        void set_max_coupling_nnz_fraction(Real f) {
+            libmesh_assert_greater(f, 0.);
+            _max_coupling_nnz_fraction = f;
+        }
+
+        /*!
+         *   @returns true if the coupling block of row \p i and column \p j
+         *   is currently an assembled matrix
+         */
+        bool if_coupling_block_assembled(unsigned int i,
+                                         unsigned int j) const;
+
+        /*!
+         *   updates the off-diagonal blocks of the nested matrix based on
+         *   the coupling block type, at the discipline solutions \p sols.
+         *   This is called after the diagonal blocks have been assembled in
+         *   the Jacobian evaluation. The matrices of the assembled blocks
+         *   are preallocated from the coupling sparsity of the disciplines
+         *   when they are first needed. A change in this sparsity requires
+         *   a call to \p clear_petsc_objects().
+         */
+        void
+        update_coupling_blocks(const std::vector<libMesh::NumericVector<Real>*>& sols);
         
 
         /*!
@@ -179,6 +266,40 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   creates the PETSc solver, matrices and vectors for the current
+         *   disciplines
+         */
+        void _init_petsc_objects();
+
+        /*!
+         *   @returns true if the PETSc objects have been created and are
+         *   consistent with the current disciplines
+         */
+        bool _if_petsc_objects_valid() const;
+
+        /*!
+         *   @returns true if the coupling block of row \p i and column \p j
+         *   should be assembled with the \p AUTOMATIC option.
+         */
+        bool _if_assemble_coupling_block(unsigned int i, unsigned int j);
+
+        /*!
+         *   obtains the coupling sparsity of row \p i and column \p j from
+         *   the discipline assembly and, if the element operations provide
+         *   the coupling Jacobian, creates the matrix for the block with
+         *   this nonzero pattern.
+         */
+        void _init_coupling_block(unsigned int i, unsigned int j);
+
+        /*!
+         *   assembles the coupling block of row \p i and column \p j at the
+         *   solution \p X of discipline \p i from the element coupling
+         *   Jacobians.
+         */
+        void _assemble_coupling_block(unsigned int i,
+                                      unsigned int j,
+                                      const libMesh::NumericVector<Real>& X);
 
         /*!
          *  name of this multiphysics solution
@@ -204,11 +325,35 @@ namespace MAST {
 
         std::vector<IS>  _is;
         std::vector<Mat> _sub_mats; // row-major ordering
+        std::vector<__mast_multiphysics_petsc_shell_context*> _shell_ctx;
+        std::vector<libMesh::dof_id_type> _sys_n_dofs, _sys_n_local_dofs;
         unsigned int     _n_dofs;
+        bool             _petsc_initialized;
 
+        SNES             _snes;
         Mat              _mat;
         Vec              _sol, _res;
 
+        /*!
+         *   treatment of the coupling blocks
+         */
+        CouplingBlockType _coupling_type;
+
+        /*!
+         *   matrices for the assembled coupling blocks in row-major
+         *   ordering, along with flags for the blocks currently used in the
+         *   nested matrix and for the blocks whose sparsity has been
+         *   obtained, and the number of nonzeros from this sparsity. The
+         *   matrix is \p PETSC_NULL if the element operations do not
+         *   provide the coupling Jacobian.
+         */
+        std::vector<Mat>  _coupling_mats;
+        std::vector<bool> _if_coupling_assembled;
+        std::vector<bool> _if_coupling_init;
+        std::vector<Real> _coupling_nnz;
+
+        Real              _max_coupling_nnz_fraction;
+
     };
 }
 
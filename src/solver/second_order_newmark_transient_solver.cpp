@@ -472,3 +472,26 @@ elem_topology_sensitivity_calculations(const MAST::FunctionBase& f,
 
 
 
+void
+MAST::SecondOrderNewmarkTransientSolver::
+_effective_jacobian_coefficients(std::vector<Real>& c) const {
+    
+    c.resize(3);
+    c[0] = dt;
+    c[1] = beta;
+    c[2] = gamma;
+}
+
+
+
+void
+MAST::SecondOrderNewmarkTransientSolver::
+_local_truncation_error(const libMesh::NumericVector<Real>& sol,
+                        libMesh::NumericVector<Real>& err) {
+    
+    // e = (beta - 1/6) dt^2 (x_ddot - x0_ddot)
+    this->update_acceleration(err, sol);
+    err.add(-1., this->acceleration(1));
+    err.scale((beta-1./6.)*dt*dt);
+    err.close();
+}
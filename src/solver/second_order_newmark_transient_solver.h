@@ -184,6 +184,24 @@ namespace MAST {
 
     protected:
         
+        /*!
+         *   estimates the local truncation error of the displacement from
+         *   the difference with a Taylor series predictor that assumes a
+         *   linear variation of acceleration over the step (Zienkiewicz and
+         *   Xie), \f$ e = (\beta - 1/6) \Delta t^2 (\ddot{x} - \ddot{x}_0)
+         *   \f$. The estimate vanishes for \f$ \beta = 1/6 \f$.
+         */
+        virtual void
+        _local_truncation_error(const libMesh::NumericVector<Real>& sol,
+                                libMesh::NumericVector<Real>& err);
+
+        virtual unsigned int _local_truncation_error_order() const { return 3; }
+
+        /*!
+         *   the effective Jacobian depends on \f$ \Delta t \f$, \f$ \beta \f$ and \f$ \gamma \f$
+         */
+        virtual void
+        _effective_jacobian_coefficients(std::vector<Real>& c) const;
     };
     
 }
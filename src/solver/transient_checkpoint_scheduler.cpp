@@ -0,0 +1,415 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+#include <sstream>
+
+// MAST includes
+#include "solver/transient_checkpoint_scheduler.h"
+#include "solver/transient_solver_base.h"
+#include "base/assembly_base.h"
+#include "base/system_initialization.h"
+#include "base/nonlinear_system.h"
+#include "utility/perf_log.h"
+
+
+MAST::TransientCheckpointScheduler::
+TransientCheckpointScheduler(unsigned int n_steps,
+                             unsigned int n_memory_checkpoints,
+                             unsigned int n_disk_checkpoints):
+_n_steps                (n_steps),
+_n_memory_checkpoints   (n_memory_checkpoints),
+_n_disk_checkpoints     (n_disk_checkpoints),
+_solver                 (nullptr),
+_assembly               (nullptr),
+_dir                    ("checkpoints"),
+_n_step_solves          (0),
+_n_disk_writes          (0),
+_n_disk_reads           (0),
+_if_forward_done        (false) {
+    
+    libmesh_assert_greater(_n_steps, 0);
+    libmesh_assert_greater(_n_memory_checkpoints + _n_disk_checkpoints, 0);
+    
+    _checkpoints.resize(_n_memory_checkpoints + _n_disk_checkpoints);
+}
+
+
+
+MAST::TransientCheckpointScheduler::~TransientCheckpointScheduler() {
+    
+    for (unsigned int i=0; i<_checkpoints.size(); i++)
+        for (unsigned int j=0; j<_checkpoints[i].vecs.size(); j++)
+            delete _checkpoints[i].vecs[j];
+}
+
+
+
+void
+MAST::TransientCheckpointScheduler::
+attach_solver(MAST::TransientSolverBase& solver,
+              MAST::AssemblyBase&        assembly) {
+    
+    _solver   = &solver;
+    _assembly = &assembly;
+}
+
+
+
+void
+MAST::TransientCheckpointScheduler::set_checkpoint_directory(const std::string& dir) {
+    
+    _dir = dir;
+}
+
+
+
+unsigned long
+MAST::TransientCheckpointScheduler::max_steps(unsigned int s, unsigned int t) {
+    
+    // binomial coefficient (s+t)!/s!/t!, computed so that each
+    // intermediate value is itself a binomial coefficient
+    unsigned long v = 1;
+    for (unsigned int k=1; k<=s; k++)
+        v = (v * (t+k)) / k;
+    
+    return v;
+}
+
+
+
+unsigned int
+MAST::TransientCheckpointScheduler::split(unsigned int n, unsigned int s) {
+    
+    libmesh_assert_greater(n, 1);
+    libmesh_assert_greater(s, 0);
+    
+    // smallest repetition number for which the n steps can be reversed
+    unsigned int t = 0;
+    while (max_steps(s, t) < n)
+        t++;
+    
+    // the steps to the left of the new checkpoint are reversed with the
+    // same number of checkpoints but one fewer repetition, and the steps
+    // to the right with one fewer checkpoint. Placing the checkpoint at
+    // beta(s, t-1) satisfies both since beta(s,t) = beta(s,t-1) + beta(s-1,t)
+    unsigned long
+    m = max_steps(s, t-1);
+    
+    return (unsigned int) std::max(1UL, std::min(m, (unsigned long)(n-1)));
+}
+
+
+
+void
+MAST::TransientCheckpointScheduler::forward_sweep(MAST::TransientSweepOperations& ops) {
+    
+    MAST_PERF_SCOPE("TransientCheckpointScheduler::forward_sweep");
+    
+    for (unsigned int i=0; i<_checkpoints.size(); i++)
+        _checkpoints[i].valid = false;
+    
+    _dt.clear();
+    _dt.reserve(_n_steps);
+    
+    // the levels at which the states are stored in the forward sweep are
+    // the ones at which the first descent of the reverse sweep expects
+    // them.
+    std::vector<int>
+    level(_n_steps+1, -1);
+    
+    {
+        unsigned int
+        l     = 0,
+        s     = (unsigned int)_checkpoints.size() - 1,
+        depth = 0;
+        
+        while (_n_steps - l > 1 && s > 0) {
+            
+            l       += split(_n_steps - l, s);
+            depth++;
+            s--;
+            level[l] = depth;
+        }
+    }
+    
+    this->_store_checkpoint(0, 0);
+    
+    for (unsigned int i=0; i<_n_steps; i++) {
+        
+        this->_solve_step(i);
+        ops.forward_step(i);
+        this->_advance_step();
+        
+        if (level[i+1] >= 0)
+            this->_store_checkpoint(level[i+1], i+1);
+    }
+    
+    _if_forward_done = true;
+}
+
+
+
+void
+MAST::TransientCheckpointScheduler::reverse_sweep(MAST::TransientSweepOperations& ops) {
+    
+    libmesh_assert_msg(_if_forward_done, "Forward sweep must precede reverse sweep.");
+    
+    MAST_PERF_SCOPE("TransientCheckpointScheduler::reverse_sweep");
+    
+    this->_reverse(0, _n_steps, (unsigned int)_checkpoints.size()-1, 0, ops);
+    
+    _if_forward_done = false;
+}
+
+
+
+unsigned int
+MAST::TransientCheckpointScheduler::n_recomputed_steps() const {
+    
+    return _n_step_solves > _n_steps ? _n_step_solves - _n_steps : 0;
+}
+
+
+
+Real
+MAST::TransientCheckpointScheduler::recomputation_ratio() const {
+    
+    return (1. * this->n_recomputed_steps()) / _n_steps;
+}
+
+
+
+void
+MAST::TransientCheckpointScheduler::print_statistics(std::ostream& o) const {
+    
+    o
+    << "Transient checkpointing:" << std::endl
+    << "  time steps          : " << _n_steps << std::endl
+    << "  checkpoints         : " << _n_memory_checkpoints << " memory, "
+    << _n_disk_checkpoints << " disk" << std::endl
+    << "  step solves         : " << _n_step_solves << std::endl
+    << "  recomputed steps    : " << this->n_recomputed_steps()
+    << "  (ratio = " << this->recomputation_ratio() << ")" << std::endl
+    << "  disk writes / reads : " << _n_disk_writes << " / " << _n_disk_reads << std::endl;
+}
+
+
+
+void
+MAST::TransientCheckpointScheduler::_reverse(unsigned int l,
+                                             unsigned int r,
+                                             unsigned int s,
+                                             unsigned int depth,
+                                             MAST::TransientSweepOperations& ops) {
+    
+    // place a checkpoint between l and r, reverse the steps to its right
+    // with one fewer free checkpoint, and then continue with the steps
+    // to its left after the checkpoint has been released.
+    while (r - l > 1 && s > 0) {
+        
+        const unsigned int
+        m = l + split(r - l, s);
+        
+        const Checkpoint
+        &c = _checkpoints[depth+1];
+        
+        // the checkpoint may have been stored in the forward sweep
+        if (!c.valid || c.step != m) {
+            
+            this->_restore_checkpoint(depth);
+            for (unsigned int i=l; i<m; i++) {
+                this->_solve_step(i);
+                this->_advance_step();
+            }
+            this->_store_checkpoint(depth+1, m);
+        }
+        
+        this->_reverse(m, r, s-1, depth+1, ops);
+        _checkpoints[depth+1].valid = false;
+        r = m;
+    }
+    
+    // without any free checkpoints the remaining steps are recomputed from
+    // the checkpoint at l for each step
+    for (unsigned int i=r; i>l; i--) {
+        
+        this->_restore_checkpoint(depth);
+        for (unsigned int j=l; j<i-1; j++) {
+            this->_solve_step(j);
+            this->_advance_step();
+        }
+        this->_solve_step(i-1);
+        ops.adjoint_step(i-1);
+    }
+}
+
+
+
+void
+MAST::TransientCheckpointScheduler::
+_state_vectors(std::vector<libMesh::NumericVector<Real>*>& vecs) {
+    
+    libmesh_assert(_solver);
+    
+    const unsigned int
+    n_levels = std::max(1U, _solver->n_iters_to_store()-1);
+    
+    vecs.clear();
+    
+    for (unsigned int i=0; i<n_levels; i++) {
+        
+        vecs.push_back(&_solver->solution(i));
+        vecs.push_back(&_solver->velocity(i));
+        if (_solver->ode_order() > 1)
+            vecs.push_back(&_solver->acceleration(i));
+    }
+}
+
+
+
+void
+MAST::TransientCheckpointScheduler::_store_checkpoint(unsigned int depth,
+                                                      unsigned int i) {
+    
+    libmesh_assert_less(depth, _checkpoints.size());
+    
+    MAST::NonlinearSystem
+    &sys = _solver->get_system_initialization().system();
+    
+    Checkpoint
+    &c = _checkpoints[depth];
+    
+    std::vector<libMesh::NumericVector<Real>*> vecs;
+    this->_state_vectors(vecs);
+    
+    c.on_disk = depth < _n_disk_checkpoints;
+    
+    if (c.on_disk) {
+        
+        for (unsigned int j=0; j<vecs.size(); j++) {
+            
+            std::ostringstream nm;
+            nm << "checkpoint_" << depth << "_" << j;
+            sys.write_out_vector(*vecs[j], _dir, nm.str(), true);
+        }
+        _n_disk_writes++;
+    }
+    else {
+        
+        if (c.vecs.empty())
+            for (unsigned int j=0; j<vecs.size(); j++)
+                c.vecs.push_back(vecs[j]->clone().release());
+        else
+            for (unsigned int j=0; j<vecs.size(); j++)
+                *c.vecs[j] = *vecs[j];
+    }
+    
+    c.valid = true;
+    c.step  = i;
+    c.time  = sys.time;
+}
+
+
+
+void
+MAST::TransientCheckpointScheduler::_restore_checkpoint(unsigned int depth) {
+    
+    libmesh_assert_less(depth, _checkpoints.size());
+    libmesh_assert(_checkpoints[depth].valid);
+    
+    MAST::NonlinearSystem
+    &sys = _solver->get_system_initialization().system();
+    
+    const Checkpoint
+    &c = _checkpoints[depth];
+    
+    std::vector<libMesh::NumericVector<Real>*> vecs;
+    this->_state_vectors(vecs);
+    
+    if (c.on_disk) {
+        
+        for (unsigned int j=0; j<vecs.size(); j++) {
+            
+            std::ostringstream nm;
+            nm << "checkpoint_" << depth << "_" << j;
+            sys.read_in_vector(*vecs[j], _dir, nm.str(), true);
+        }
+        _n_disk_reads++;
+    }
+    else
+        for (unsigned int j=0; j<vecs.size(); j++)
+            *vecs[j] = *c.vecs[j];
+    
+    // after a time step is advanced, the oldest stored iteration is a copy
+    // of the one before it
+    const unsigned int
+    n = _solver->n_iters_to_store();
+    
+    if (n > 1) {
+        
+        _solver->solution(n-1) = _solver->solution(n-2);
+        _solver->velocity(n-1) = _solver->velocity(n-2);
+        if (_solver->ode_order() > 1)
+            _solver->acceleration(n-1) = _solver->acceleration(n-2);
+    }
+    
+    sys.time = c.time;
+    sys.update();
+}
+
+
+
+void
+MAST::TransientCheckpointScheduler::_solve_step(unsigned int i) {
+    
+    libmesh_assert_msg(_solver, "Solver not attached.");
+    libmesh_assert_less_equal(i, _dt.size());
+    
+    if (i == _dt.size()) {
+        
+        // step of the primary forward sweep
+        if (_solver->if_adaptive_time_stepping())
+            _solver->adaptive_solve(*_assembly);
+        else
+            _solver->solve(*_assembly);
+        
+        _dt.push_back(_solver->dt);
+    }
+    else {
+        
+        // recomputation with the step size accepted in the forward sweep
+        _solver->dt = _dt[i];
+        _solver->solve(*_assembly);
+    }
+    
+    _n_step_solves++;
+}
+
+
+
+void
+MAST::TransientCheckpointScheduler::_advance_step() {
+    
+    libmesh_assert_msg(_solver, "Solver not attached.");
+    
+    _solver->advance_time_step();
+}
@@ -0,0 +1,273 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__transient_checkpoint_scheduler_h__
+#define __mast__transient_checkpoint_scheduler_h__
+
+// C++ includes
+#include <vector>
+#include <string>
+#include <ostream>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class TransientSolverBase;
+    class AssemblyBase;
+    
+    
+    /*!
+     *   Interface for the operations performed during the forward and
+     *   reverse sweeps of a checkpointed transient analysis. Time step
+     *   \p i advances the solution from state \p i to state \p i+1.
+     */
+    class TransientSweepOperations {
+        
+    public:
+        
+        TransientSweepOperations() { }
+        
+        virtual ~TransientSweepOperations() { }
+        
+        /*!
+         *   called once for each step \p i of the primary forward sweep,
+         *   after the step has been solved and before the solver is advanced.
+         *   This can be used to accumulate the output functional.
+         */
+        virtual void forward_step(unsigned int i) { }
+        
+        /*!
+         *   called for \p i = n_steps-1, ..., 0 with the solver in the same
+         *   state as after the solution of step \p i in the forward sweep,
+         *   i.e., the current solution is from state \p i+1 and the
+         *   previous iterate is from state \p i.
+         */
+        virtual void adjoint_step(unsigned int i) = 0;
+    };
+    
+    
+    /*!
+     *   Schedules the forward and reverse sweeps of a transient adjoint
+     *   analysis with binomial checkpointing (Griewank and Walther, the
+     *   revolve algorithm). Only a fixed number of solver states are stored
+     *   at any time, and the states between checkpoints are recomputed from
+     *   the nearest preceding checkpoint when the reverse sweep needs them.
+     *   With \f$ s+1 \f$ checkpoints and \f$ n \f$ time steps, no step is
+     *   solved more than \f$ t \f$ times in the reverse sweep, where
+     *   \f$ t \f$ is the smallest positive integer with \f$ \binom{s+t}{s} \geq n
+     *   \f$. This includes the solution of each step that precedes its
+     *   adjoint step.
+     *
+     *   The checkpoints are split into in-memory and on-disk storage. Since
+     *   the checkpoints are used in a last-in first-out order, and those
+     *   created last are restored most often, the first \p n_disk levels
+     *   of the checkpoint stack are written to disk and the remaining are
+     *   kept in memory. The state of step 0 always occupies the first
+     *   checkpoint.
+     *
+     *   Steps are recomputed with the step sizes accepted in the forward
+     *   sweep, so that adaptive time stepping is supported.
+     */
+    class TransientCheckpointScheduler {
+        
+    public:
+        
+        TransientCheckpointScheduler(unsigned int n_steps,
+                                     unsigned int n_memory_checkpoints,
+                                     unsigned int n_disk_checkpoints = 0);
+        
+        virtual ~TransientCheckpointScheduler();
+        
+        /*!
+         *   attaches the solver and assembly used to solve and recompute the
+         *   time steps. The solver must have been initialized, so that its
+         *   current state is the state of step 0.
+         */
+        void attach_solver(MAST::TransientSolverBase& solver,
+                           MAST::AssemblyBase&        assembly);
+        
+        /*!
+         *   directory where the on-disk checkpoints are written
+         */
+        void set_checkpoint_directory(const std::string& dir);
+        
+        /*!
+         *   solves the \p n_steps time steps starting from the current state
+         *   of the solver and stores the checkpoints for the reverse sweep.
+         *   The steps are solved with adaptive_solve() if adaptive time
+         *   stepping is enabled in the solver. Upon return the solver is in
+         *   state \p n_steps.
+         */
+        void forward_sweep(MAST::TransientSweepOperations& ops);
+        
+        /*!
+         *   calls \p ops.adjoint_step() for all time steps in reverse
+         *   order, recomputing the states from the checkpoints as needed.
+         *   Must be called after forward_sweep().
+         */
+        void reverse_sweep(MAST::TransientSweepOperations& ops);
+        
+        /*!
+         *   @returns the number of steps for which the forward sweep was
+         *   solved
+         */
+        unsigned int n_steps() const { return _n_steps; }
+        
+        /*!
+         *   @returns the total number of checkpoints
+         */
+        unsigned int n_checkpoints() const {
+            return _n_memory_checkpoints + _n_disk_checkpoints;
+        }
+        
+        /*!
+         *   @returns the total number of time step solutions, including the
+         *   forward sweep
+         */
+        unsigned int n_step_solves() const { return _n_step_solves; }
+        
+        /*!
+         *   @returns the number of time step solutions repeated in the
+         *   reverse sweep
+         */
+        unsigned int n_recomputed_steps() const;
+        
+        /*!
+         *   @returns the ratio of recomputed steps to the number of steps,
+         *   which is the overhead of checkpointing relative to storing the
+         *   complete trajectory.
+         */
+        Real recomputation_ratio() const;
+        
+        /*!
+         *   @returns the number of checkpoints written to and read from disk
+         */
+        unsigned int n_disk_writes() const { return _n_disk_writes; }
+        unsigned int n_disk_reads()  const { return _n_disk_reads; }
+        
+        /*!
+         *   writes the checkpoint and recomputation statistics to \p o
+         */
+        void print_statistics(std::ostream& o) const;
+        
+        /*!
+         *   @returns \f$ \binom{s+t}{s} \f$, the maximum number of steps that
+         *   can be reversed with \p s checkpoints if each step is solved
+         *   at most \p t times after the forward sweep.
+         */
+        static unsigned long max_steps(unsigned int s, unsigned int t);
+        
+        /*!
+         *   @returns the number of steps from a checkpoint at which the next
+         *   checkpoint is placed when \p n steps are to be reversed with
+         *   \p s free checkpoints.
+         */
+        static unsigned int split(unsigned int n, unsigned int s);
+        
+    protected:
+        
+        /*!
+         *   checkpoint stored at one level of the checkpoint stack
+         */
+        struct Checkpoint {
+            
+            Checkpoint(): valid(false), step(0), time(0.), on_disk(false) { }
+            
+            bool valid;
+            unsigned int step;
+            Real time;
+            bool on_disk;
+            std::vector<libMesh::NumericVector<Real>*> vecs;
+        };
+        
+        /*!
+         *   reverses steps \p l to \p r-1 with the state of step \p l stored
+         *   at level \p depth of the checkpoint stack and \p s free levels
+         *   above it.
+         */
+        void _reverse(unsigned int l,
+                      unsigned int r,
+                      unsigned int s,
+                      unsigned int depth,
+                      MAST::TransientSweepOperations& ops);
+        
+        /*!
+         *   stores the current solver state for step \p i at level \p depth
+         */
+        virtual void _store_checkpoint(unsigned int depth, unsigned int i);
+        
+        /*!
+         *   restores the solver state from level \p depth
+         */
+        virtual void _restore_checkpoint(unsigned int depth);
+        
+        /*!
+         *   solves step \p i from the current state. Steps of the forward
+         *   sweep are solved with adaptive_solve() if adaptive time stepping
+         *   is enabled and their step size is recorded, while recomputed
+         *   steps use the recorded step size.
+         */
+        virtual void _solve_step(unsigned int i);
+        
+        /*!
+         *   advances the solver to the next time step
+         */
+        virtual void _advance_step();
+        
+        /*!
+         *   @returns the vectors of the solver that define its state, which
+         *   are the solution and time derivatives of all but the oldest
+         *   stored iteration. The oldest iteration is a copy of the one
+         *   before it after a time step is advanced.
+         */
+        void _state_vectors(std::vector<libMesh::NumericVector<Real>*>& vecs);
+        
+        const unsigned int _n_steps;
+        const unsigned int _n_memory_checkpoints;
+        const unsigned int _n_disk_checkpoints;
+        
+        MAST::TransientSolverBase* _solver;
+        MAST::AssemblyBase*        _assembly;
+        
+        std::string                _dir;
+        
+        /*!
+         *   time step sizes accepted in the forward sweep
+         */
+        std::vector<Real>          _dt;
+        
+        /*!
+         *   checkpoint stack
+         */
+        std::vector<Checkpoint>    _checkpoints;
+        
+        unsigned int _n_step_solves, _n_disk_writes, _n_disk_reads;
+        bool         _if_forward_done;
+    };
+}
+
+#endif // __mast__transient_checkpoint_scheduler_h__
@@ -24,12 +24,20 @@
 #include "base/transient_assembly.h"
 #include "base/nonlinear_system.h"
 #include "base/system_initialization.h"
+#include "base/physics_discipline_base.h"
+#include "base/parameter.h"
+#include "utility/perf_log.h"
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
 #include "libmesh/dof_map.h"
 #include "libmesh/sparse_matrix.h"
 #include "libmesh/linear_solver.h"
+#include "libmesh/nonlinear_solver.h"
+
+// C++ includes
+#include <limits>
+#include <cmath>
 
 
 
@@ -42,7 +50,18 @@ _first_sensitivity_step         (true),
 _ode_order                      (o),
 _n_iters_to_store               (n),
 _assembly_ops                   (nullptr),
-_if_highest_derivative_solution (false) {
+_if_highest_derivative_solution (false),
+_if_linear                      (false),
+_linear_jacobian_valid          (false),
+_n_linear_jacobian_assemblies   (0),
+_if_adaptive                    (false),
+_adaptive_rel_tol               (1.e-4),
+_adaptive_abs_tol               (1.e-8),
+_dt_min                         (0.),
+_dt_max                         (std::numeric_limits<Real>::max()),
+_dt_next                        (0.),
+_prev_error_norm                (1.),
+_n_rejected_steps               (0) {
 
 }
 
@@ -136,7 +155,8 @@ set_elem_operation_object(MAST::TransientAssemblyElemOperations &assembly_ops) {
         }
     }
     
-    _first_step = true;
+    _first_step            = true;
+    _linear_jacobian_valid = false;
 }
 
 
@@ -186,8 +206,9 @@ MAST::TransientSolverBase::clear_elem_operation_object() {
         }
     }
     
-    _assembly_ops   = nullptr;
-    _first_step     = true;
+    _assembly_ops          = nullptr;
+    _first_step            = true;
+    _linear_jacobian_valid = false;
 }
 
 
@@ -316,15 +337,169 @@ MAST::TransientSolverBase::acceleration_sensitivity(unsigned int prev_iter) cons
 
 
 
+void
+MAST::TransientSolverBase::set_linear_problem(bool f) {
+    
+    _if_linear             = f;
+    _linear_jacobian_valid = false;
+    _linear_jacobian_coeffs.clear();
+    _linear_jacobian_params.clear();
+}
+
+
+
+void
+MAST::TransientSolverBase::reset_linear_jacobian() {
+    
+    _linear_jacobian_valid = false;
+}
+
+
+
 void
 MAST::TransientSolverBase::solve(MAST::AssemblyBase& assembly) {
     
     // make sure that the system has been specified
     libmesh_assert_msg(_system, "System pointer is nullptr.");
     
-    // ask the Newton solver to solve for the system solution
-    _system->system().solve(*this, assembly);
+    if (_if_linear)
+        this->_linear_solve(assembly);
+    else
+        // ask the Newton solver to solve for the system solution
+        _system->system().solve(*this, assembly);
+}
+
+
+
+void
+MAST::TransientSolverBase::set_adaptive_time_stepping(bool f,
+                                                      Real rel_tol,
+                                                      Real abs_tol) {
+    
+    libmesh_assert_greater(rel_tol, 0.);
+    libmesh_assert_greater_equal(abs_tol, 0.);
+    
+    _if_adaptive      = f;
+    _adaptive_rel_tol = rel_tol;
+    _adaptive_abs_tol = abs_tol;
+    _dt_next          = 0.;
+    _prev_error_norm  = 1.;
+    _n_rejected_steps = 0;
+    _accepted_dt.clear();
+}
+
+
+
+void
+MAST::TransientSolverBase::set_time_step_limits(Real dt_min, Real dt_max) {
+    
+    libmesh_assert_greater_equal(dt_min, 0.);
+    libmesh_assert_greater(dt_max, dt_min);
     
+    _dt_min = dt_min;
+    _dt_max = dt_max;
+}
+
+
+
+void
+MAST::TransientSolverBase::adaptive_solve(MAST::AssemblyBase& assembly) {
+    
+    libmesh_assert_msg(_system, "System pointer is nullptr.");
+    libmesh_assert_msg(_if_adaptive, "Adaptive time stepping is not enabled.");
+    
+    MAST_PERF_SCOPE("TransientSolverBase::adaptive_solve");
+    
+    MAST::NonlinearSystem
+    &sys = _system->system();
+    
+    // safety factor and bounds on the step size ratio, along with the
+    // integral and proportional gains of the PI controller
+    const Real
+    k         = this->_local_truncation_error_order(),
+    safety    = 0.9,
+    fac_min   = 0.2,
+    fac_max   = 5.,
+    k_I       = 0.7/k,
+    k_P       = 0.4/k,
+    n_dofs    = sys.n_dofs();
+    
+    // use the step size proposed after the previous step
+    if (_dt_next > 0.)
+        dt = _dt_next;
+    dt = std::min(std::max(dt, _dt_min), _dt_max);
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    err(sys.solution->zero_clone().release());
+    
+    while (true) {
+        
+        this->solve(assembly);
+        
+        Real
+        fac = 0.5;
+        
+        if (_if_linear || sys.nonlinear_solver->converged) {
+            
+            this->_local_truncation_error(*sys.solution, *err);
+            
+            // RMS norm of the error relative to the tolerance
+            const Real
+            err_norm = std::max(err->l2_norm()/std::sqrt(n_dofs) /
+                                (_adaptive_abs_tol +
+                                 _adaptive_rel_tol * sys.solution->l2_norm()/std::sqrt(n_dofs)),
+                                1.e-4);
+            
+            if (err_norm <= 1.) {
+                
+                fac = safety *
+                std::pow(err_norm, -k_I) *
+                std::pow(_prev_error_norm, k_P);
+                fac = std::min(std::max(fac, fac_min), fac_max);
+                
+                _dt_next         = std::min(std::max(dt*fac, _dt_min), _dt_max);
+                _prev_error_norm = err_norm;
+                _accepted_dt.push_back(dt);
+                return;
+            }
+            
+            fac = std::max(safety * std::pow(err_norm, -1./k), fac_min);
+        }
+        
+        // reject the step and restore the solution from the previous step
+        // before retrying with a smaller step
+        _n_rejected_steps++;
+        
+        if (dt <= _dt_min)
+            libmesh_error_msg("Time step rejected at minimum step size: dt = "
+                              << dt << "  at t = " << sys.time);
+        
+        sys.solution->zero();
+        sys.solution->add(1., this->solution(1));
+        sys.solution->close();
+        sys.update();
+        
+        dt = std::max(dt*fac, _dt_min);
+    }
+}
+
+
+
+void
+MAST::TransientSolverBase::
+_local_truncation_error(const libMesh::NumericVector<Real>& sol,
+                        libMesh::NumericVector<Real>& err) {
+    
+    libmesh_error_msg("Truncation error estimate not implemented for this solver.");
+}
+
+
+
+unsigned int
+MAST::TransientSolverBase::_local_truncation_error_order() const {
+    
+    libmesh_error_msg("Truncation error estimate not implemented for this solver.");
+    return 0;
 }
 
 
@@ -336,8 +511,138 @@ MAST::TransientSolverBase::sensitivity_solve(MAST::AssemblyBase& assembly,
     // make sure that the system has been specified
     libmesh_assert_msg(_system, "System pointer is nullptr.");
     
-    // ask the Newton solver to solve for the system solution
-    _system->system().sensitivity_solve(*this, assembly, f);
+    MAST::NonlinearSystem
+    &sys = _system->system();
+
+    if (_if_linear) {
+        
+        std::vector<Real> coeffs;
+        std::map<const MAST::Parameter*, Real> params;
+        this->_check_linear_jacobian(coeffs, params);
+    }
+    
+    if (_if_linear && _linear_jacobian_valid) {
+        
+        // the Jacobian of a linear problem is independent of the solution,
+        // so the matrix and preconditioner from the last time step are
+        // used for the sensitivity solve.
+        sys.linear_solver->reuse_preconditioner(true);
+        sys.sensitivity_solve(*this, assembly, f, false);
+        sys.linear_solver->reuse_preconditioner(false);
+    }
+    else
+        // ask the Newton solver to solve for the system solution
+        sys.sensitivity_solve(*this, assembly, f);
+}
+
+
+
+void
+MAST::TransientSolverBase::_linear_solve(MAST::AssemblyBase& assembly) {
+    
+    libmesh_assert(_system);
+    libmesh_assert(_discipline);
+    libmesh_assert(!_assembly);
+    
+    MAST_PERF_SCOPE("TransientSolverBase::linear_solve");
+    
+    MAST::NonlinearSystem
+    &sys = _system->system();
+    
+    // the stored Jacobian is invalidated by a change in the time step,
+    // integration coefficients or parameter values
+    std::vector<Real> coeffs;
+    std::map<const MAST::Parameter*, Real> params;
+    this->_check_linear_jacobian(coeffs, params);
+    
+    const bool
+    if_jac = !_linear_jacobian_valid;
+    
+    // the residual is evaluated at the current solution estimate, which
+    // is the solution from the previous time step. Since the residual is
+    // linear in the solution, a single Newton update provides the
+    // converged solution.
+    assembly.set_elem_operation_object(*this);
+    assembly.residual_and_jacobian(*sys.solution,
+                                   sys.rhs,
+                                   if_jac?sys.matrix:nullptr,
+                                   sys);
+    assembly.clear_elem_operation_object();
+    
+    if (if_jac) {
+        _linear_jacobian_coeffs = coeffs;
+        _linear_jacobian_params = params;
+        _linear_jacobian_valid  = true;
+        _n_linear_jacobian_assemblies++;
+    }
+    
+    std::pair<unsigned int, Real>
+    solver_params = sys.get_linear_solve_parameters();
+    
+    libMesh::SparseMatrix<Real> *
+    pc = sys.request_matrix("Preconditioner");
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    dvec(sys.solution->zero_clone().release());
+    
+    // the factorization is rebuilt only if the Jacobian was reassembled.
+    // The reuse flag is reset after the solve since the linear solver is
+    // shared with the other solves of this system.
+    sys.linear_solver->reuse_preconditioner(!if_jac);
+    sys.linear_solver->solve(*sys.matrix, pc,
+                             *dvec,
+                             *sys.rhs,
+                             solver_params.second,
+                             solver_params.first);
+    sys.linear_solver->reuse_preconditioner(false);
+    
+    sys.solution->add(-1., *dvec);
+    
+    // The linear solver may not have fit our constraints exactly
+#ifdef LIBMESH_ENABLE_CONSTRAINTS
+    sys.get_dof_map().enforce_constraints_exactly(sys, sys.solution.get());
+#endif
+    
+    sys.solution->close();
+    sys.update();
+}
+
+
+
+void
+MAST::TransientSolverBase::
+_effective_jacobian_coefficients(std::vector<Real>& c) const {
+    
+    c.resize(1);
+    c[0] = dt;
+}
+
+
+
+void
+MAST::TransientSolverBase::
+_check_linear_jacobian(std::vector<Real>& coeffs,
+                       std::map<const MAST::Parameter*, Real>& params) {
+    
+    libmesh_assert(_discipline);
+    
+    this->_effective_jacobian_coefficients(coeffs);
+    
+    // the parameters are collected in each call, since property cards and
+    // loads may have been added to the discipline since the last call
+    std::set<const MAST::Parameter*> p;
+    _discipline->get_parameters(p);
+    
+    params.clear();
+    std::set<const MAST::Parameter*>::const_iterator
+    it  = p.begin(),
+    end = p.end();
+    for ( ; it != end; it++)
+        params[*it] = (**it)();
+    
+    if (coeffs != _linear_jacobian_coeffs ||
+        params != _linear_jacobian_params)
+        _linear_jacobian_valid = false;
 }
 
 
@@ -366,6 +671,9 @@ solve_highest_derivative_and_advance_time_step(MAST::AssemblyBase& assembly) {
     // reset the solution flag
     _if_highest_derivative_solution = false;
     
+    // the system matrix now stores the Jacobian wrt the highest derivative
+    _linear_jacobian_valid          = false;
+    
     std::pair<unsigned int, Real>
     solver_params = sys.get_linear_solve_parameters();
     
@@ -460,6 +768,9 @@ solve_highest_derivative_and_advance_time_step_with_sensitivity(MAST::AssemblyBa
     // reset the solution flag
     _if_highest_derivative_solution = false;
     
+    // the system matrix now stores the Jacobian wrt the highest derivative
+    _linear_jacobian_valid          = false;
+    
     std::pair<unsigned int, Real>
     solver_params = sys.get_linear_solve_parameters();
     
@@ -21,6 +21,9 @@
 #ifndef __mast__transient_solver_base__
 #define __mast__transient_solver_base__
 
+// C++ includes
+#include <map>
+
 // MAST includes
 #include "base/mast_data_types.h"
 #include "base/nonlinear_implicit_assembly_elem_operations.h"
@@ -35,6 +38,7 @@ namespace MAST {
     class TransientAssemblyElemOperations;
     class ElementBase;
     class NonlinearSystem;
+    class Parameter;
     
     
     class TransientSolverBase:
@@ -76,6 +80,17 @@ namespace MAST {
          */
         Real dt;
 
+        /*!
+         *   @returns the highest order time derivative handled by the solver
+         */
+        unsigned int ode_order() const { return _ode_order; }
+
+        /*!
+         *   @returns the number of iterations for which the solution and its
+         *   time derivatives are stored.
+         */
+        unsigned int n_iters_to_store() const { return _n_iters_to_store; }
+
         
         /*!
          *    @returns a reference to the localized solution from
@@ -174,10 +189,97 @@ namespace MAST {
         update_delta_acceleration(libMesh::NumericVector<Real>& acc,
                                   const libMesh::NumericVector<Real>& sol) = 0;
 
+        /*!
+         *   Tells the solver that the residual is linear in the solution and
+         *   its time derivatives, with coefficient matrices that do not
+         *   change from one time step to the next. The effective Jacobian is
+         *   then assembled and factored only once, and each subsequent time
+         *   step requires only the assembly of the residual followed by a
+         *   single linear solve with the stored factorization. The Jacobian
+         *   is rebuilt if the time step, the integration coefficients or the
+         *   value of any parameter that the property cards or loads of the
+         *   discipline depend on change, or after reset_linear_jacobian() is
+         *   called.
+         */
+        void set_linear_problem(bool f);
+
+        /*!
+         *   @returns true if the solver is treating the problem as linear.
+         */
+        bool if_linear_problem() const { return _if_linear; }
+
+        /*!
+         *   marks the Jacobian stored for a linear problem as outdated, so
+         *   that it is reassembled and refactored in the next solve. A change
+         *   in the parameters of the discipline is detected automatically,
+         *   so this is needed only if the operators change otherwise, for
+         *   example through a field function that is not a parameter.
+         */
+        void reset_linear_jacobian();
+
+        /*!
+         *   @returns the number of times the effective Jacobian has been
+         *   assembled by the linear solution mode.
+         */
+        unsigned int n_linear_jacobian_assemblies() const {
+            return _n_linear_jacobian_assemblies;
+        }
+
         /*!
          *   solves the current time step for solution and velocity
          */
         virtual void solve(MAST::AssemblyBase& assembly);
+
+        /*!
+         *   Enables error-controlled adaptive time stepping through
+         *   adaptive_solve(). The local truncation error estimated from
+         *   a lower-order predictor is required to satisfy
+         *   \f$ \| e \| \leq atol + rtol \| x \| \f$. Enabling or
+         *   disabling the adaptivity clears the history of accepted steps.
+         */
+        void set_adaptive_time_stepping(bool f,
+                                        Real rel_tol = 1.e-4,
+                                        Real abs_tol = 1.e-8);
+
+        /*!
+         *   sets the bounds on the time step used by adaptive_solve().
+         *   An error is raised if a step smaller than \p dt_min fails to
+         *   satisfy the error tolerance.
+         */
+        void set_time_step_limits(Real dt_min, Real dt_max);
+
+        /*!
+         *   @returns true if adaptive time stepping is enabled
+         */
+        bool if_adaptive_time_stepping() const { return _if_adaptive; }
+
+        /*!
+         *   Solves the current time step with error control. The step is
+         *   solved with the current \p dt, and is rejected and retried
+         *   with a smaller step if either the local truncation error
+         *   exceeds the tolerance or the nonlinear solver fails to
+         *   converge. Upon return, \p dt is the size of the accepted step,
+         *   so that sensitivity_solve() and advance_time_step() can be
+         *   called as for a fixed step. The step size proposed by the PI
+         *   controller is applied at the beginning of the next call.
+         */
+        void adaptive_solve(MAST::AssemblyBase& assembly);
+
+        /*!
+         *   @returns the sequence of step sizes accepted by
+         *   adaptive_solve(). Sensitivity and adjoint passes that replay
+         *   the stored solutions must set \p dt from this sequence.
+         */
+        const std::vector<Real>& accepted_time_steps() const {
+            return _accepted_dt;
+        }
+
+        /*!
+         *   @returns the number of steps rejected by adaptive_solve().
+         */
+        unsigned int n_rejected_time_steps() const {
+            return _n_rejected_steps;
+        }
         
         /*!
          *    solvers the current time step for sensitivity wrt \p f
@@ -307,6 +409,47 @@ namespace MAST {
                 
     protected:
         
+        /*!
+         *   solves the current time step of a linear problem by reusing the
+         *   stored effective Jacobian and its factorization, and only
+         *   assembling the residual at the current solution estimate.
+         */
+        virtual void _linear_solve(MAST::AssemblyBase& assembly);
+
+        /*!
+         *   fills \p c with the scalars that define the effective Jacobian
+         *   of the time integration scheme for given mass, damping and
+         *   stiffness operators. A change in any of these values requires
+         *   a new Jacobian for linear problems. The default implementation
+         *   returns the time step.
+         */
+        virtual void
+        _effective_jacobian_coefficients(std::vector<Real>& c) const;
+
+        /*!
+         *   invalidates the stored Jacobian of a linear problem if the
+         *   integration coefficients or the parameter values differ from
+         *   those for which it was assembled. The current values are
+         *   returned in \p coeffs and \p params.
+         */
+        void
+        _check_linear_jacobian(std::vector<Real>& coeffs,
+                               std::map<const MAST::Parameter*, Real>& params);
+
+        /*!
+         *   computes the estimate of the local truncation error of the
+         *   current step for the solution \p sol and returns it in \p err.
+         */
+        virtual void
+        _local_truncation_error(const libMesh::NumericVector<Real>& sol,
+                                libMesh::NumericVector<Real>& err);
+
+        /*!
+         *   @returns the exponent \f$ k \f$ in \f$ e = O(\Delta t^k) \f$
+         *   for the estimate from _local_truncation_error().
+         */
+        virtual unsigned int _local_truncation_error_order() const;
+
         /*!
          *    flag to check if this is the first time step.
          */
@@ -338,6 +481,73 @@ namespace MAST {
          */
         bool   _if_highest_derivative_solution;
 
+        /*!
+         *    flag if the problem is linear, so that the effective Jacobian
+         *    can be reused across time steps.
+         */
+        bool   _if_linear;
+
+        /*!
+         *    flag if the Jacobian stored in the system matrix is the
+         *    effective Jacobian of the linear problem for the coefficients
+         *    in \p _linear_jacobian_coeffs.
+         */
+        bool   _linear_jacobian_valid;
+
+        /*!
+         *    integration coefficients for which the stored Jacobian was
+         *    assembled.
+         */
+        std::vector<Real> _linear_jacobian_coeffs;
+
+        /*!
+         *    values of the parameters of the discipline for which the
+         *    stored Jacobian was assembled.
+         */
+        std::map<const MAST::Parameter*, Real> _linear_jacobian_params;
+
+        /*!
+         *    number of times the linear solution mode assembled the Jacobian
+         */
+        unsigned int _n_linear_jacobian_assemblies;
+
+        /*!
+         *    flag if the time step is adapted in adaptive_solve()
+         */
+        bool   _if_adaptive;
+
+        /*!
+         *    relative and absolute tolerance on the local truncation error
+         */
+        Real   _adaptive_rel_tol, _adaptive_abs_tol;
+
+        /*!
+         *    bounds on the time step
+         */
+        Real   _dt_min, _dt_max;
+
+        /*!
+         *    step size proposed for the next step by the controller. This is
+         *    zero until a step has been accepted.
+         */
+        Real   _dt_next;
+
+        /*!
+         *    normalized error of the previously accepted step, used by the
+         *    proportional term of the controller.
+         */
+        Real   _prev_error_norm;
+
+        /*!
+         *    number of rejected steps
+         */
+        unsigned int _n_rejected_steps;
+
+        /*!
+         *    sequence of accepted step sizes
+         */
+        std::vector<Real> _accepted_dt;
+
     };
 
 }
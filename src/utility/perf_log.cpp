@@ -0,0 +1,344 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <fstream>
+#include <sstream>
+#include <set>
+
+// MAST includes
+#include "utility/perf_log.h"
+
+// libMesh includes
+#include "libmesh/enum_elem_type.h"
+#include "libmesh/string_to_enum.h"
+
+
+namespace MAST {
+    
+    // table of the calling thread
+    static thread_local void* _perf_log_thread_table = nullptr;
+    
+    
+    inline Real
+    _perf_log_seconds(const std::chrono::steady_clock::time_point& t0) {
+        
+        return std::chrono::duration<Real>(std::chrono::steady_clock::now() - t0).count();
+    }
+}
+
+
+
+MAST::PerfLog::PerfLog() { }
+
+
+
+MAST::PerfLog::~PerfLog() {
+    
+    for (unsigned int i=0; i<_tables.size(); i++)
+        delete _tables[i];
+}
+
+
+
+MAST::PerfLog::TableType&
+MAST::PerfLog::_thread_table() {
+    
+    // only the global log is expected, so the thread-local pointer
+    // belongs to this object
+    if (!MAST::_perf_log_thread_table) {
+        
+        TableType* t = new TableType;
+        
+        libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+        _tables.push_back(t);
+        MAST::_perf_log_thread_table = t;
+    }
+    
+    return *static_cast<TableType*>(MAST::_perf_log_thread_table);
+}
+
+
+
+void
+MAST::PerfLog::add_time(const char* label, int elem_type, Real seconds) {
+    
+    MAST::PerfLog::Entry&
+    e = _thread_table()[std::make_pair(label, elem_type)];
+    
+    e.n_calls++;
+    e.time += seconds;
+}
+
+
+
+void
+MAST::PerfLog::increment(const char* label, int elem_type, unsigned long n) {
+    
+    _thread_table()[std::make_pair(label, elem_type)].count += n;
+}
+
+
+
+void
+MAST::PerfLog::clear() {
+    
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+
+    // the tables are zeroed, not deleted, since the threads keep a pointer
+    // to their table
+    for (unsigned int i=0; i<_tables.size(); i++)
+        _tables[i]->clear();
+}
+
+
+
+void
+MAST::PerfLog::_merge(std::map<std::string, MAST::PerfLog::Entry>& data) const {
+    
+    libMesh::Threads::spin_mutex::scoped_lock lock(_mutex);
+    
+    data.clear();
+    
+    for (unsigned int i=0; i<_tables.size(); i++) {
+        
+        TableType::const_iterator
+        it   = _tables[i]->begin(),
+        end  = _tables[i]->end();
+        
+        for ( ; it != end; it++) {
+            
+            // identical labels from different translation units may have
+            // different addresses, so the data is merged by name
+            std::string nm = it->first.first;
+            if (it->first.second >= 0)
+                nm += "/" + libMesh::Utility::enum_to_string<libMesh::ElemType>
+                ((libMesh::ElemType)it->first.second);
+            
+            MAST::PerfLog::Entry& e = data[nm];
+            e.n_calls += it->second.n_calls;
+            e.count   += it->second.count;
+            e.time    += it->second.time;
+        }
+    }
+}
+
+
+
+void
+MAST::PerfLog::write(const libMesh::Parallel::Communicator& comm,
+                     std::ostream& out,
+                     OutputFormat  format) const {
+    
+    std::map<std::string, MAST::PerfLog::Entry> data;
+    this->_merge(data);
+    
+    // the ranks may have seen different events. Collect the union of
+    // the names so that the reductions operate on the same entries.
+    std::string names;
+    {
+        std::map<std::string, MAST::PerfLog::Entry>::const_iterator
+        it   = data.begin(),
+        end  = data.end();
+        for ( ; it != end; it++)
+            names += it->first + "\n";
+    }
+    
+    std::vector<std::string> all_names;
+    comm.allgather(names, all_names);
+    
+    std::set<std::string> name_set;
+    for (unsigned int i=0; i<all_names.size(); i++) {
+        
+        std::istringstream iss(all_names[i]);
+        std::string nm;
+        while (std::getline(iss, nm))
+            if (!nm.empty())
+                name_set.insert(nm);
+    }
+    
+    const unsigned int
+    n = (unsigned int)name_set.size();
+    
+    std::vector<Real>
+    n_calls  (n, 0.),
+    count    (n, 0.),
+    time     (n, 0.),
+    time_min (n, 0.),
+    time_max (n, 0.);
+    
+    {
+        std::set<std::string>::const_iterator
+        it   = name_set.begin(),
+        end  = name_set.end();
+        
+        for (unsigned int i=0; it != end; it++, i++) {
+            
+            std::map<std::string, MAST::PerfLog::Entry>::const_iterator
+            d = data.find(*it);
+            
+            if (d != data.end()) {
+                
+                n_calls[i] = d->second.n_calls;
+                count[i]   = d->second.count;
+                time[i]    = d->second.time;
+            }
+        }
+    }
+    
+    time_min = time;
+    time_max = time;
+    
+    comm.sum(n_calls);
+    comm.sum(count);
+    comm.sum(time);
+    comm.min(time_min);
+    comm.max(time_max);
+    
+    if (comm.rank() != 0)
+        return;
+    
+    std::set<std::string>::const_iterator
+    it   = name_set.begin(),
+    end  = name_set.end();
+    
+    switch (format) {
+            
+        case MAST::PerfLog::JSON: {
+            
+            out
+            << "{\n"
+            << "  \"n_ranks\": " << comm.size() << ",\n"
+            << "  \"events\": [";
+            
+            for (unsigned int i=0; it != end; it++, i++) {
+                
+                out
+                << (i?",":"") << "\n"
+                << "    {\"name\": \""      << *it         << "\", "
+                << "\"calls\": "            << n_calls[i]  << ", "
+                << "\"count\": "            << count[i]    << ", "
+                << "\"time\": "             << time[i]     << ", "
+                << "\"time_rank_min\": "    << time_min[i] << ", "
+                << "\"time_rank_max\": "    << time_max[i] << "}";
+            }
+            
+            out << "\n  ]\n}\n";
+        }
+            break;
+            
+        case MAST::PerfLog::CSV: {
+            
+            out << "name,calls,count,time,time_rank_min,time_rank_max\n";
+            
+            for (unsigned int i=0; it != end; it++, i++)
+                out
+                << *it         << ","
+                << n_calls[i]  << ","
+                << count[i]    << ","
+                << time[i]     << ","
+                << time_min[i] << ","
+                << time_max[i] << "\n";
+        }
+            break;
+    }
+}
+
+
+
+void
+MAST::PerfLog::write(const libMesh::Parallel::Communicator& comm,
+                     const std::string& nm) const {
+    
+    OutputFormat
+    format = MAST::PerfLog::JSON;
+    
+    if (nm.size() >= 4 && nm.compare(nm.size()-4, 4, ".csv") == 0)
+        format = MAST::PerfLog::CSV;
+    
+    // only rank 0 writes, but all ranks participate in the reduction
+    std::ofstream out;
+    if (comm.rank() == 0) {
+        
+        out.open(nm.c_str(), std::ofstream::out);
+        libmesh_assert(out.good());
+    }
+    
+    this->write(comm, out, format);
+}
+
+
+
+MAST::PerfLog::Scope::Scope(const char* label, int elem_type):
+_label      (label),
+_elem_type  (elem_type),
+_t0         (std::chrono::steady_clock::now()) { }
+
+
+
+MAST::PerfLog::Scope::~Scope() {
+    
+    MAST::perf_log().add_time(_label, _elem_type, MAST::_perf_log_seconds(_t0));
+}
+
+
+
+MAST::PerfLog::Stopwatch::Stopwatch():
+_label      (nullptr),
+_elem_type  (-1) { }
+
+
+
+MAST::PerfLog::Stopwatch::~Stopwatch() {
+    
+    this->stop();
+}
+
+
+
+void
+MAST::PerfLog::Stopwatch::phase(const char* label, int elem_type) {
+    
+    this->stop();
+    
+    _label     = label;
+    _elem_type = elem_type;
+    _t0        = std::chrono::steady_clock::now();
+}
+
+
+
+void
+MAST::PerfLog::Stopwatch::stop() {
+    
+    if (_label)
+        MAST::perf_log().add_time(_label, _elem_type, MAST::_perf_log_seconds(_t0));
+    
+    _label = nullptr;
+}
+
+
+
+MAST::PerfLog&
+MAST::perf_log() {
+    
+    static MAST::PerfLog log;
+    return log;
+}
@@ -0,0 +1,199 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_perf_log_h__
+#define __mast_perf_log_h__
+
+// C++ includes
+#include <map>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <ostream>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/mast_config.h"
+
+// libMesh includes
+#include "libmesh/threads.h"
+#include "libmesh/parallel.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Collects wall-clock times and event counts for the hot paths in
+     *   assembly, element calculations and solvers. Each thread writes to
+     *   its own table, so that the threaded element loops do not contend
+     *   on a lock. The tables are merged and aggregated across all ranks of
+     *   a communicator in \p write.
+     *
+     *   The instrumentation is added through the \p MAST_PERF_* macros
+     *   defined below, which expand to nothing unless MAST is configured
+     *   with \p ENABLE_PERF_LOG. A single instance is accessed through
+     *   \p MAST::perf_log().
+     */
+    class PerfLog {
+        
+    public:
+        
+        enum OutputFormat {
+            JSON,
+            CSV
+        };
+        
+        PerfLog();
+        
+        virtual ~PerfLog();
+        
+        /*!
+         *   adds \p seconds to the time of event \p label. If \p elem_type
+         *   is non-negative, it is interpreted as a \p libMesh::ElemType
+         *   and the time is recorded separately for this element type.
+         */
+        void add_time(const char* label, int elem_type, Real seconds);
+        
+        /*!
+         *   increments the counter of event \p label by \p n.
+         */
+        void increment(const char* label, int elem_type, unsigned long n);
+        
+        /*!
+         *   zeros all times and counters.
+         */
+        void clear();
+        
+        /*!
+         *   aggregates the data over all ranks of \p comm and writes it to
+         *   \p out on rank 0. This is a collective call and must not be
+         *   called while a threaded loop is adding data.
+         */
+        void write(const libMesh::Parallel::Communicator& comm,
+                   std::ostream& out,
+                   OutputFormat  format) const;
+        
+        /*!
+         *   writes the aggregated data to file \p nm on rank 0. CSV is used
+         *   if the file name ends with \p .csv, JSON otherwise.
+         */
+        void write(const libMesh::Parallel::Communicator& comm,
+                   const std::string& nm) const;
+        
+        /*!
+         *   records the time between construction and destruction of this
+         *   object.
+         */
+        class Scope {
+        public:
+            Scope(const char* label, int elem_type = -1);
+            ~Scope();
+        protected:
+            const char*                                   _label;
+            int                                           _elem_type;
+            std::chrono::steady_clock::time_point         _t0;
+        };
+        
+        /*!
+         *   records the time spent in a sequence of consecutive phases.
+         *   Each call to \p phase ends the previous phase and starts the
+         *   next. The last phase is ended by \p stop or by the destructor.
+         */
+        class Stopwatch {
+        public:
+            Stopwatch();
+            ~Stopwatch();
+            void phase(const char* label, int elem_type = -1);
+            void stop();
+        protected:
+            const char*                                   _label;
+            int                                           _elem_type;
+            std::chrono::steady_clock::time_point         _t0;
+        };
+        
+    protected:
+        
+        struct Entry {
+            Entry(): n_calls(0), count(0), time(0.) { }
+            unsigned long n_calls;
+            unsigned long count;
+            Real          time;
+        };
+        
+        typedef std::map<std::pair<const char*, int>, MAST::PerfLog::Entry> TableType;
+        
+        /*!
+         *   @returns the table of the calling thread, which is created on
+         *   first use.
+         */
+        TableType& _thread_table();
+        
+        /*!
+         *   merges the tables of all threads into \p data, keyed by the
+         *   event name.
+         */
+        void _merge(std::map<std::string, MAST::PerfLog::Entry>& data) const;
+        
+        mutable libMesh::Threads::spin_mutex   _mutex;
+        
+        std::vector<TableType*>                _tables;
+    };
+    
+    
+    /*!
+     *   @returns the global performance log.
+     */
+    MAST::PerfLog& perf_log();
+}
+
+
+#if MAST_ENABLE_PERF_LOG == 1
+
+#define MAST_PERF_JOIN_(a, b)  a##b
+#define MAST_PERF_JOIN(a, b)   MAST_PERF_JOIN_(a, b)
+
+#define MAST_PERF_SCOPE(label)                                                  \
+MAST::PerfLog::Scope MAST_PERF_JOIN(_mast_perf_scope_, __LINE__)(label)
+
+#define MAST_PERF_SCOPE_ELEM(label, type)                                       \
+MAST::PerfLog::Scope MAST_PERF_JOIN(_mast_perf_scope_, __LINE__)(label, (int)(type))
+
+#define MAST_PERF_STOPWATCH(sw)             MAST::PerfLog::Stopwatch sw
+#define MAST_PERF_PHASE(sw, label)          sw.phase(label)
+#define MAST_PERF_PHASE_ELEM(sw, label, type) sw.phase(label, (int)(type))
+#define MAST_PERF_STOP(sw)                  sw.stop()
+
+#define MAST_PERF_COUNT(label, n)           MAST::perf_log().increment(label, -1, n)
+#define MAST_PERF_COUNT_ELEM(label, type, n) MAST::perf_log().increment(label, (int)(type), n)
+
+#else
+
+#define MAST_PERF_SCOPE(label)
+#define MAST_PERF_SCOPE_ELEM(label, type)
+#define MAST_PERF_STOPWATCH(sw)
+#define MAST_PERF_PHASE(sw, label)
+#define MAST_PERF_PHASE_ELEM(sw, label, type)
+#define MAST_PERF_STOP(sw)
+#define MAST_PERF_COUNT(label, n)
+#define MAST_PERF_COUNT_ELEM(label, type, n)
+
+#endif // MAST_ENABLE_PERF_LOG
+
+#endif // __mast_perf_log_h__
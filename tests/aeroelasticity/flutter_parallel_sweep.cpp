@@ -0,0 +1,172 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <vector>
+#include <map>
+#include <cmath>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "aeroelasticity/flutter_solution_base.h"
+#include "aeroelasticity/flutter_root_base.h"
+#include "aeroelasticity/typical_section_assembly.h"
+#include "aeroelasticity/typical_section_gaf_assembly.h"
+#include "base/structural_plate_model.h"
+
+
+/*!
+ *   the typical section assemblies do not use a mesh, but the parallel
+ *   sweep needs the communicator of the structural system. Hence, the
+ *   assemblies are attached to a small plate model.
+ */
+struct FlutterParallelSweepFixture {
+    
+    FlutterParallelSweepFixture():
+    model   (libMesh::QUAD4, 2),
+    V       ("V", 0.),
+    kr      ("kr", 0.),
+    bref    ("bref", 1.),
+    basis   (2, nullptr),
+    rho     (1.),
+    V_lower (0.1),
+    V_upper (4.0),
+    n_V_divs(9),
+    kr_lower(0.),
+    kr_upper(0.4),
+    n_kr_divs(5) { }
+    
+    
+    /*!
+     *   checks that the two sweeps have the same velocities and roots
+     */
+    void
+    check_solutions(const std::map<Real, MAST::FlutterSolutionBase*>& serial,
+                    const std::map<Real, MAST::FlutterSolutionBase*>& parallel) {
+        
+        BOOST_REQUIRE_EQUAL(serial.size(), parallel.size());
+        
+        std::map<Real, MAST::FlutterSolutionBase*>::const_iterator
+        s_it  = serial.begin(),
+        p_it  = parallel.begin();
+        
+        for ( ; s_it != serial.end(); s_it++, p_it++) {
+            
+            BOOST_CHECK_EQUAL(s_it->first, p_it->first);
+            BOOST_REQUIRE_EQUAL(s_it->second->n_roots(), p_it->second->n_roots());
+            
+            // the roots are sorted against the previous solution in both
+            // sweeps, so they are compared in the same order
+            for (unsigned int i=0; i<s_it->second->n_roots(); i++) {
+                
+                const Complex
+                rs = s_it->second->get_root(i).root,
+                rp = p_it->second->get_root(i).root;
+                
+                BOOST_CHECK_SMALL(std::abs(rs - rp), 1.e-12 * (1. + std::abs(rs)));
+            }
+        }
+    }
+    
+    
+    StructuralPlateModel                         model;
+    MAST::Parameter                              V, kr, bref;
+    std::vector<libMesh::NumericVector<Real>*>   basis;
+    Real                                         rho, V_lower, V_upper;
+    unsigned int                                 n_V_divs;
+    Real                                         kr_lower, kr_upper;
+    unsigned int                                 n_kr_divs;
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (FlutterParallelSweepTests,
+                           FlutterParallelSweepFixture)
+
+BOOST_AUTO_TEST_CASE   (PKSerialAndParallelRootsMatch) {
+    
+    TypicalSectionGAFAssembly
+    assembly(kr);
+    assembly.set_discipline_and_system(*model.discipline, *model.structural_sys);
+    
+    PKFlutterSolverAccess
+    serial,
+    parallel;
+    
+    parallel.set_parallel_sweep(true);
+    
+    PKFlutterSolverAccess* solvers[2] = {&serial, &parallel};
+    
+    for (unsigned int i=0; i<2; i++) {
+        
+        solvers[i]->attach_assembly(assembly);
+        solvers[i]->initialize(V, kr, bref, rho,
+                               V_lower, V_upper, n_V_divs,
+                               kr_lower, kr_upper, n_kr_divs,
+                               basis);
+        solvers[i]->scan_for_roots();
+    }
+    
+    check_solutions(serial.solutions(), parallel.solutions());
+    BOOST_CHECK_EQUAL(serial.n_roots_found(), parallel.n_roots_found());
+    
+    for (unsigned int i=0; i<2; i++)
+        solvers[i]->clear_assembly_object();
+    assembly.clear_discipline_and_system();
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (TimeDomainSerialAndParallelRootsMatch) {
+    
+    TypicalSectionAssembly
+    assembly(V, false);
+    assembly.set_discipline_and_system(*model.discipline, *model.structural_sys);
+    
+    TimeDomainFlutterSolverAccess
+    serial,
+    parallel;
+    
+    parallel.set_parallel_sweep(true);
+    
+    TimeDomainFlutterSolverAccess* solvers[2] = {&serial, &parallel};
+    
+    for (unsigned int i=0; i<2; i++) {
+        
+        solvers[i]->attach_assembly(assembly);
+        solvers[i]->initialize(V, V_lower, V_upper, 4*n_V_divs, basis);
+        solvers[i]->scan_for_roots();
+    }
+    
+    // both sweeps solve one eigenproblem per velocity
+    BOOST_CHECK_EQUAL(serial.n_qz_solves(),   4*n_V_divs+1);
+    BOOST_CHECK_EQUAL(parallel.n_qz_solves(), 4*n_V_divs+1);
+    
+    check_solutions(serial.solutions(), parallel.solutions());
+    BOOST_CHECK_EQUAL(serial.n_roots_found(), parallel.n_roots_found());
+    
+    for (unsigned int i=0; i<2; i++)
+        solvers[i]->clear_assembly_object();
+    assembly.clear_discipline_and_system();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,254 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <vector>
+#include <map>
+#include <cstdio>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/parameter.h"
+#include "aeroelasticity/gaf_database.h"
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+
+
+extern libMesh::LibMeshInit* _mast_init;
+
+
+/*!
+ *   tabulates the GAF of a minimum-state model with two lag states
+ */
+struct GAFDatabaseFixture {
+    
+    GAFDatabaseFixture():
+    n      (3),
+    kr     ("kr", 0.),
+    A0     (RealMatrixX::Zero(n, n)),
+    A1     (RealMatrixX::Zero(n, n)),
+    A2     (RealMatrixX::Zero(n, n)),
+    D      (RealMatrixX::Zero(n, 2)),
+    E      (RealMatrixX::Zero(2, n)),
+    beta   (2) {
+        
+        A0 <<  1.0,  0.2, -0.1,
+               0.3,  2.0,  0.4,
+              -0.2,  0.1,  1.5;
+        A1 <<  0.5, -0.1,  0.0,
+               0.2,  0.3,  0.1,
+               0.0,  0.4,  0.6;
+        A2 <<  0.05, 0.0,  0.01,
+               0.0,  0.02, 0.0,
+               0.01, 0.0,  0.03;
+        D  <<  1.0, -0.5,
+               0.3,  0.8,
+              -0.2,  0.4;
+        E  <<  0.6,  0.1, -0.3,
+              -0.2,  0.7,  0.5;
+        beta[0] = 0.2;
+        beta[1] = 0.8;
+    }
+    
+    void exact(const Real k, ComplexMatrixX& q) const {
+        
+        const Complex p(0., k);
+        
+        q = A0.cast<Complex>() + p * A1.cast<Complex>() + p*p * A2.cast<Complex>();
+        for (unsigned int l=0; l<2; l++)
+            q += (p/(p + beta[l])) *
+            D.col(l).cast<Complex>() * E.row(l).cast<Complex>();
+    }
+    
+    void tabulate(MAST::GAFDatabase& db) const {
+        
+        ComplexMatrixX q;
+        
+        for (unsigned int j=0; j<=20; j++) {
+            
+            exact(0.1*j, q);
+            db.add_kr_mat(0.1*j, q);
+        }
+    }
+    
+    unsigned int       n;
+    MAST::Parameter    kr;
+    RealMatrixX        A0, A1, A2, D, E;
+    std::vector<Real>  beta;
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (GAFDatabaseTests, GAFDatabaseFixture)
+
+BOOST_AUTO_TEST_CASE   (RationalApproximationsReproduceModel) {
+    
+    MAST::GAFDatabase
+    roger (n, kr),
+    ms    (n, kr);
+    
+    tabulate(roger);
+    tabulate(ms);
+    
+    BOOST_CHECK_SMALL(roger.fit_roger_approximation(beta),       1.e-10);
+    BOOST_CHECK_SMALL(ms.fit_minimum_state_approximation(beta),  1.e-10);
+    
+    // check away from the tabulated frequencies
+    ComplexMatrixX
+    q, q_roger, q_ms;
+    
+    for (unsigned int j=0; j<10; j++) {
+        
+        const Real k = 0.037 + 0.21*j;
+        
+        exact(k, q);
+        roger.gaf(k, q_roger);
+        ms.gaf(k, q_ms);
+        
+        BOOST_CHECK_SMALL((q_roger - q).norm(), 1.e-10 * q.norm());
+        BOOST_CHECK_SMALL((q_ms    - q).norm(), 1.e-10 * q.norm());
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE   (DerivativeAndStateSpace) {
+    
+    MAST::GAFDatabase
+    db (n, kr);
+    
+    tabulate(db);
+    db.fit_minimum_state_approximation(std::vector<Real>(1, 0.5));
+    
+    // derivative with respect to reduced frequency
+    const Real
+    k  = 0.77,
+    dk = 1.e-6;
+    
+    ComplexMatrixX
+    q_p, q_m, dq;
+    
+    db.gaf(k + dk, q_p);
+    db.gaf(k - dk, q_m);
+    db.gaf_kr_derivative(k, dq);
+    
+    BOOST_CHECK_SMALL(((q_p - q_m)/(2.*dk) - dq).norm(), 1.e-7 * dq.norm());
+    
+    // the transfer function of the state-space form at s = i k V/b
+    // is the approximated GAF
+    const Real
+    V  = 3.,
+    b  = 0.5;
+    
+    RealMatrixX
+    Q0, Q1, Q2, Dm, Em, R;
+    
+    db.state_space_matrices(V, b, Q0, Q1, Q2, Dm, Em, R);
+    
+    const Complex
+    s  = Complex(0., k*V/b);
+    
+    const ComplexMatrixX
+    I  = ComplexMatrixX::Identity(R.rows(), R.cols()),
+    T  =
+    Q0.cast<Complex>() + s * Q1.cast<Complex>() + s*s * Q2.cast<Complex>() +
+    Dm.cast<Complex>() * (s*I - R.cast<Complex>()).inverse() * Em.cast<Complex>() * s;
+    
+    db.gaf(k, q_p);
+    
+    BOOST_CHECK_SMALL((T - q_p).norm(), 1.e-12 * q_p.norm());
+}
+
+
+BOOST_AUTO_TEST_CASE   (BinaryFileRoundTrip) {
+    
+    const std::string
+    nm = "gaf_database_test.bin";
+    
+    MAST::GAFDatabase
+    db      (n, kr),
+    db_read (n, kr);
+    
+    tabulate(db);
+    db.write_gaf_file(nm, _mast_init->comm());
+    _mast_init->comm().barrier();
+    
+    db_read.read_gaf_file(nm, _mast_init->comm());
+    
+    BOOST_REQUIRE_EQUAL(db_read.tabulated_values().size(),
+                        db.tabulated_values().size());
+    
+    std::map<Real, ComplexMatrixX>::const_iterator
+    it      = db.tabulated_values().begin(),
+    it_read = db_read.tabulated_values().begin(),
+    end     = db.tabulated_values().end();
+    
+    for ( ; it != end; it++, it_read++) {
+        
+        BOOST_CHECK_EQUAL(it->first, it_read->first);
+        BOOST_CHECK((it->second.array() == it_read->second.array()).all());
+    }
+    
+    _mast_init->comm().barrier();
+    if (_mast_init->comm().rank() == 0)
+        std::remove(nm.c_str());
+}
+
+
+BOOST_AUTO_TEST_CASE   (AssemblyUsesApproximation) {
+    
+    MAST::GAFDatabase
+    db (n, kr);
+    
+    MAST::Parameter
+    other ("other", 1.);
+    
+    std::vector<libMesh::NumericVector<Real>*>
+    basis (n, nullptr);
+    
+    // the approximation must be available before it is used
+    BOOST_CHECK_THROW(db.set_evaluate_mode(false), std::exception);
+    
+    tabulate(db);
+    db.fit_roger_approximation(beta);
+    db.set_evaluate_mode(false);
+    
+    ComplexMatrixX
+    q, q_ref;
+    
+    kr() = 0.45;
+    
+    db.assemble_generalized_aerodynamic_force_matrix(basis, q);
+    db.gaf(kr(), q_ref);
+    BOOST_CHECK_SMALL((q - q_ref).norm(), 1.e-14 * q_ref.norm());
+    
+    db.assemble_generalized_aerodynamic_force_matrix(basis, q, &kr);
+    db.gaf_kr_derivative(kr(), q_ref);
+    BOOST_CHECK_SMALL((q - q_ref).norm(), 1.e-14 * q_ref.norm());
+    
+    BOOST_CHECK_THROW(db.assemble_generalized_aerodynamic_force_matrix(basis, q, &other),
+                      std::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
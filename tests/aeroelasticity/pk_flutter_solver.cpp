@@ -0,0 +1,203 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+
+// C++ includes
+#include <vector>
+#include <memory>
+#include <cmath>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "aeroelasticity/flutter_solution_base.h"
+#include "aeroelasticity/flutter_root_base.h"
+#include "aeroelasticity/typical_section_gaf_assembly.h"
+
+
+struct PKFlutterSolverFixture {
+    
+    PKFlutterSolverFixture():
+    V       ("V", 0.),
+    kr      ("kr", 0.),
+    bref    ("bref", 1.),
+    basis   (2, nullptr),
+    rho     (1.),
+    V_lower (0.1),
+    V_upper (4.0),
+    n_V_divs(5),
+    kr_lower(0.),
+    kr_upper(0.4),
+    n_kr_divs(4),
+    assembly(kr) { }
+    
+    void initialize(PKFlutterSolverAccess& solver) {
+        
+        solver.attach_assembly(assembly);
+        solver.initialize(V, kr, bref, rho,
+                          V_lower, V_upper, n_V_divs,
+                          kr_lower, kr_upper, n_kr_divs,
+                          basis);
+    }
+    
+    MAST::Parameter                              V, kr, bref;
+    std::vector<libMesh::NumericVector<Real>*>   basis;
+    Real                                         rho, V_lower, V_upper;
+    unsigned int                                 n_V_divs;
+    Real                                         kr_lower, kr_upper;
+    unsigned int                                 n_kr_divs;
+    TypicalSectionGAFAssembly                    assembly;
+};
+
+
+/*!
+ *   checks that every root of \p sol has a matching root in \p ref
+ */
+void check_roots(const MAST::FlutterSolutionBase& ref,
+                 const MAST::FlutterSolutionBase& sol,
+                 const Real tol) {
+    
+    BOOST_REQUIRE_EQUAL(ref.n_roots(), sol.n_roots());
+    
+    for (unsigned int i=0; i<sol.n_roots(); i++) {
+        
+        const Complex
+        r  = sol.get_root(i).root;
+        
+        Real
+        d  = std::abs(r - ref.get_root(0).root);
+        
+        for (unsigned int j=1; j<ref.n_roots(); j++)
+            d = std::min(d, std::abs(r - ref.get_root(j).root));
+        
+        BOOST_CHECK_SMALL(d, tol * (1. + std::abs(r)));
+    }
+}
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (PKFlutterSolverTests,
+                           PKFlutterSolverFixture)
+
+BOOST_AUTO_TEST_CASE   (MatrixCacheCounts) {
+    
+    PKFlutterSolverAccess solver;
+    initialize(solver);
+    solver.scan_for_roots();
+    
+    // the structural matrices are assembled once, and the aerodynamic
+    // matrices once per reduced frequency of the sweep
+    const unsigned int
+    n_pts = (n_kr_divs+1)*(n_V_divs+1);
+    
+    BOOST_CHECK_EQUAL(solver.n_structural_matrix_assemblies(),      1);
+    BOOST_CHECK_EQUAL(solver.n_aerodynamic_matrix_assemblies(),     n_kr_divs+1);
+    BOOST_CHECK_EQUAL(solver.n_aerodynamic_matrix_reuses(),         n_pts-(n_kr_divs+1));
+    BOOST_CHECK_EQUAL(solver.n_aerodynamic_matrix_interpolations(), 0);
+    BOOST_CHECK_EQUAL(assembly.n_gaf_assemblies,                    n_kr_divs+1);
+    
+    // interpolation is off by default, so a reduced frequency between the
+    // tabulated values is assembled, and then reused
+    const Real
+    k_mid = 0.25;
+    
+    solver.analyze(k_mid, 1.);
+    BOOST_CHECK_EQUAL(solver.n_aerodynamic_matrix_assemblies(),     n_kr_divs+2);
+    BOOST_CHECK_EQUAL(solver.n_aerodynamic_matrix_interpolations(), 0);
+    
+    solver.analyze(k_mid, 2.);
+    BOOST_CHECK_EQUAL(solver.n_aerodynamic_matrix_assemblies(),     n_kr_divs+2);
+    BOOST_CHECK_EQUAL(solver.n_aerodynamic_matrix_reuses(),         n_pts-(n_kr_divs+1)+1);
+    BOOST_CHECK_EQUAL(assembly.n_gaf_assemblies,                    n_kr_divs+2);
+    
+    // the structure may change between analyses, so the structural
+    // matrices are assembled again after the solutions are cleared, while
+    // the aerodynamic matrices are reused
+    solver.clear_solutions();
+    solver.scan_for_roots();
+    BOOST_CHECK_EQUAL(solver.n_structural_matrix_assemblies(),      2);
+    BOOST_CHECK_EQUAL(solver.n_aerodynamic_matrix_assemblies(),     n_kr_divs+2);
+    BOOST_CHECK_EQUAL(assembly.n_gaf_assemblies,                    n_kr_divs+2);
+    
+    // the cache is cleared with a new initialization
+    solver.clear_assembly_object();
+    solver.clear_solutions();
+    initialize(solver);
+    BOOST_CHECK_EQUAL(solver.n_structural_matrix_assemblies(),  0);
+    BOOST_CHECK_EQUAL(solver.n_aerodynamic_matrix_assemblies(), 0);
+}
+
+
+BOOST_AUTO_TEST_CASE   (InterpolatedMatchesExact) {
+    
+    PKFlutterSolverAccess
+    exact,
+    interp,
+    limited;
+    
+    initialize(exact);
+    exact.scan_for_roots();
+    
+    interp.set_interpolate_aerodynamic_matrices(true);
+    initialize(interp);
+    interp.scan_for_roots();
+    
+    // the spacing of the sweep is 0.1, so this does not interpolate
+    limited.set_interpolate_aerodynamic_matrices(true, 0.05);
+    initialize(limited);
+    limited.scan_for_roots();
+    
+    const unsigned int
+    n_assemblies = assembly.n_gaf_assemblies;
+    
+    // points between the tabulated reduced frequencies, with two
+    // tabulated values on each side for the first, and one on the lower
+    // side for the second
+    const Real
+    k_vals[] = {0.25, 0.05},
+    v_vals[] = {0.5,  3.};
+    
+    for (unsigned int i=0; i<2; i++)
+        for (unsigned int j=0; j<2; j++) {
+            
+            std::unique_ptr<MAST::FlutterSolutionBase>
+            sol_exact  = exact.analyze(k_vals[i], v_vals[j]),
+            sol_interp = interp.analyze(k_vals[i], v_vals[j]);
+            
+            // the aerodynamic matrices are cubic in the reduced frequency,
+            // so the interpolation through four points is exact. With
+            // three points, the error is proportional to the cubic term.
+            check_roots(*sol_exact, *sol_interp, i==0? 1.e-10: 1.e-3);
+            
+            sol_interp = limited.analyze(k_vals[i], v_vals[j]);
+            check_roots(*sol_exact, *sol_interp, 1.e-10);
+        }
+    
+    BOOST_CHECK_EQUAL(interp.n_aerodynamic_matrix_interpolations(),  4);
+    BOOST_CHECK_EQUAL(interp.n_aerodynamic_matrix_assemblies(),      n_kr_divs+1);
+    BOOST_CHECK_EQUAL(exact.n_aerodynamic_matrix_assemblies(),       n_kr_divs+3);
+    BOOST_CHECK_EQUAL(limited.n_aerodynamic_matrix_interpolations(), 0);
+    BOOST_CHECK_EQUAL(limited.n_aerodynamic_matrix_assemblies(),     n_kr_divs+3);
+    BOOST_CHECK_EQUAL(assembly.n_gaf_assemblies,                     n_assemblies+4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <vector>
+#include <map>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "aeroelasticity/flutter_solution_base.h"
+#include "aeroelasticity/flutter_root_base.h"
+#include "aeroelasticity/typical_section_assembly.h"
+
+
+struct TimeDomainFlutterAffineFixture {
+    
+    TimeDomainFlutterAffineFixture():
+    V       ("V", 0.),
+    basis   (2, nullptr),
+    V_lower (0.1),
+    V_upper (4.0),
+    n_divs  (40) { }
+    
+    void scan(TimeDomainFlutterSolverAccess& solver,
+              TypicalSectionAssembly&        assembly) {
+        
+        solver.attach_assembly(assembly);
+        solver.initialize(V, V_lower, V_upper, n_divs, basis);
+        solver.scan_for_roots();
+    }
+    
+    MAST::Parameter                              V;
+    std::vector<libMesh::NumericVector<Real>*>   basis;
+    Real                                         V_lower, V_upper;
+    unsigned int                                 n_divs;
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (TimeDomainFlutterAffineTests,
+                           TimeDomainFlutterAffineFixture)
+
+BOOST_AUTO_TEST_CASE   (AffineRootsMatchDirectAssembly) {
+    
+    TypicalSectionAssembly
+    assembly(V, true);
+    
+    TimeDomainFlutterSolverAccess
+    direct,
+    affine;
+    
+    affine.set_affine_velocity_decomposition(true, 2);
+    
+    scan(direct, assembly);
+    scan(affine, assembly);
+    
+    // the direct path assembles once per velocity, and the affine path
+    // once per sample and once for the verification
+    BOOST_CHECK_EQUAL(direct.n_reduced_order_assemblies(), n_divs+1);
+    BOOST_CHECK_EQUAL(affine.n_reduced_order_assemblies(), 2+2);
+    
+    BOOST_REQUIRE_EQUAL(direct.solutions().size(), affine.solutions().size());
+    
+    std::map<Real, MAST::FlutterSolutionBase*>::const_iterator
+    it_d   = direct.solutions().begin(),
+    it_a   = affine.solutions().begin(),
+    end    = direct.solutions().end();
+    
+    for ( ; it_d != end; it_d++, it_a++) {
+        
+        BOOST_CHECK_CLOSE(it_d->first, it_a->first, 1.e-12);
+        BOOST_REQUIRE_EQUAL(it_d->second->n_roots(), it_a->second->n_roots());
+        
+        for (unsigned int i=0; i<it_d->second->n_roots(); i++) {
+            
+            const Complex
+            p_d = it_d->second->get_root(i).root,
+            p_a = it_a->second->get_root(i).root;
+            
+            BOOST_CHECK_SMALL(std::abs(p_d - p_a), 1.e-8 * (1. + std::abs(p_d)));
+        }
+    }
+    
+    // the sweep crosses the flutter boundary, and both paths find the
+    // same crossovers
+    BOOST_CHECK_EQUAL(direct.n_roots_found(), affine.n_roots_found());
+    BOOST_CHECK(direct.n_roots_found() > 0);
+    
+    // the velocity parameter is left at the last velocity of the sweep
+    BOOST_CHECK_CLOSE(V(), V_upper, 1.e-12);
+}
+
+
+BOOST_AUTO_TEST_CASE   (NonAffineOperatorIsRefused) {
+    
+    TypicalSectionAssembly
+    assembly(V, false);
+    
+    TimeDomainFlutterSolverAccess
+    affine;
+    
+    affine.set_affine_velocity_decomposition(true, 2);
+    
+    BOOST_CHECK_THROW(scan(affine, assembly), std::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,244 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <vector>
+#include <map>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "aeroelasticity/flutter_solution_base.h"
+#include "aeroelasticity/flutter_root_base.h"
+#include "aeroelasticity/typical_section_assembly.h"
+
+
+/*!
+ *   scales the mass matrix of one assembly, so that the root tracking
+ *   fails at that velocity. The assemblies are counted.
+ */
+class PerturbedTypicalSectionAssembly:
+public TypicalSectionAssembly {
+public:
+    
+    PerturbedTypicalSectionAssembly(MAST::Parameter& V):
+    TypicalSectionAssembly(V, true),
+    n_assemblies     (0),
+    perturbed_assembly(0) { }
+    
+    virtual void
+    assemble_reduced_order_quantity
+    (std::vector<libMesh::NumericVector<Real>*>& basis,
+     std::map<MAST::StructuralQuantityType, RealMatrixX*>& mat_qty_map) {
+        
+        TypicalSectionAssembly::assemble_reduced_order_quantity(basis, mat_qty_map);
+        
+        n_assemblies++;
+        
+        if (n_assemblies == perturbed_assembly)
+            *mat_qty_map[MAST::MASS] *= 1.e-4;
+    }
+    
+    unsigned int
+    n_assemblies,
+    perturbed_assembly;
+};
+
+
+struct TimeDomainFlutterTrackingFixture {
+    
+    TimeDomainFlutterTrackingFixture():
+    V       ("V", 0.),
+    basis   (2, nullptr),
+    V_lower (0.1),
+    V_upper (4.0),
+    n_divs  (40),
+    assembly(V, true) { }
+    
+    void scan(TimeDomainFlutterSolverAccess& solver) {
+        
+        solver.attach_assembly(assembly);
+        solver.initialize(V, V_lower, V_upper, n_divs, basis);
+        solver.scan_for_roots();
+    }
+    
+    MAST::Parameter                              V;
+    std::vector<libMesh::NumericVector<Real>*>   basis;
+    Real                                         V_lower, V_upper;
+    unsigned int                                 n_divs;
+    TypicalSectionAssembly                       assembly;
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (TimeDomainFlutterTrackingTests,
+                           TimeDomainFlutterTrackingFixture)
+
+BOOST_AUTO_TEST_CASE   (TrackedRootsMatchQZ) {
+    
+    TimeDomainFlutterSolverAccess
+    direct,
+    tracked;
+    
+    tracked.set_eigenvalue_tracking(true);
+    
+    scan(direct);
+    scan(tracked);
+    
+    // the tracked sweep needs a QZ solution only at the lower velocity
+    BOOST_CHECK_EQUAL(direct.n_qz_solves(),  n_divs+1);
+    BOOST_CHECK_EQUAL(tracked.n_qz_solves(), 1);
+    BOOST_CHECK_EQUAL(tracked.n_tracked_solves(), n_divs);
+    
+    // each tracked solution has the same roots as the QZ solution at
+    // that velocity, although possibly in a different order
+    unsigned int
+    n_compared = 0;
+    
+    std::map<Real, MAST::FlutterSolutionBase*>::const_iterator
+    it   = tracked.solutions().begin(),
+    end  = tracked.solutions().end();
+    
+    for ( ; it != end; it++) {
+        
+        std::map<Real, MAST::FlutterSolutionBase*>::const_iterator
+        it_d = direct.solutions().lower_bound(it->first - 1.e-10);
+        
+        if (it_d == direct.solutions().end() ||
+            std::fabs(it_d->first - it->first) > 1.e-10)
+            continue;
+        
+        n_compared++;
+        
+        const MAST::FlutterSolutionBase
+        &sol   = *it->second,
+        &sol_d = *it_d->second;
+        
+        BOOST_REQUIRE_EQUAL(sol.n_roots(), sol_d.n_roots());
+        
+        for (unsigned int i=0; i<sol.n_roots(); i++) {
+            
+            const Complex
+            p   = sol.get_root(i).root;
+            
+            Real
+            err = std::abs(p - sol_d.get_root(0).root);
+            
+            for (unsigned int j=1; j<sol_d.n_roots(); j++)
+                err = std::min(err, std::abs(p - sol_d.get_root(j).root));
+            
+            BOOST_CHECK_SMALL(err, 1.e-8 * (1. + std::abs(p)));
+        }
+    }
+    
+    BOOST_CHECK_EQUAL(n_compared, n_divs+1);
+}
+
+
+BOOST_AUTO_TEST_CASE   (TrackedCrossoverMatchesBisection) {
+    
+    const Real
+    g_tol   = 1.e-8;
+    
+    const unsigned int
+    n_iters = 50;
+    
+    TimeDomainFlutterSolverAccess
+    direct,
+    tracked;
+    
+    tracked.set_eigenvalue_tracking(true);
+    
+    scan(direct);
+    scan(tracked);
+    
+    std::pair<bool, MAST::FlutterRootBase*>
+    root_d = direct.find_critical_root(g_tol, n_iters),
+    root_t = tracked.find_critical_root(g_tol, n_iters);
+    
+    BOOST_REQUIRE(root_d.second);
+    BOOST_REQUIRE(root_t.first);
+    
+    // the Newton search converges without any QZ solution
+    BOOST_CHECK_EQUAL(tracked.n_qz_solves(), 1);
+    BOOST_CHECK_SMALL(root_t.second->root.real(), g_tol);
+    BOOST_CHECK_CLOSE(root_t.second->V, root_d.second->V, 1.e-3);
+    BOOST_CHECK_CLOSE(std::abs(root_t.second->root.imag()),
+                      std::abs(root_d.second->root.imag()), 1.e-3);
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (FailedTrackingContinuesWithBisection) {
+    
+    const Real
+    g_tol   = 1.e-8;
+    
+    const unsigned int
+    n_iters = 50;
+    
+    PerturbedTypicalSectionAssembly
+    perturbed(V);
+    
+    TimeDomainFlutterSolverAccess
+    direct,
+    tracked;
+    
+    tracked.set_eigenvalue_tracking(true);
+    
+    scan(direct);
+    
+    tracked.attach_assembly(perturbed);
+    tracked.initialize(V, V_lower, V_upper, n_divs, basis);
+    tracked.scan_for_roots();
+    
+    const unsigned int
+    n_sols    = (unsigned int)tracked.solutions().size(),
+    n_qz      = tracked.n_qz_solves(),
+    n_tracked = tracked.n_tracked_solves();
+    
+    // each step of the crossover search assembles the matrices at the
+    // new velocity, and at a perturbed velocity for the derivative. The
+    // first step is accepted and the tracking fails in the second step.
+    perturbed.perturbed_assembly = perturbed.n_assemblies + 3;
+    
+    std::pair<bool, MAST::FlutterRootBase*>
+    root_d = direct.find_critical_root(g_tol, n_iters),
+    root_t = tracked.find_critical_root(g_tol, n_iters);
+    
+    BOOST_REQUIRE(root_d.second);
+    BOOST_REQUIRE(root_t.second);
+    BOOST_REQUIRE(perturbed.n_assemblies > perturbed.perturbed_assembly);
+    
+    // the accepted step is kept, and the bisection adds one QZ solution
+    // per iteration
+    BOOST_CHECK_EQUAL(tracked.n_tracked_solves(), n_tracked+1);
+    BOOST_CHECK(tracked.n_qz_solves() > n_qz);
+    BOOST_CHECK_EQUAL(tracked.solutions().size(),
+                      n_sols + 1 + (tracked.n_qz_solves() - n_qz));
+    
+    BOOST_CHECK_CLOSE(root_t.second->V, root_d.second->V, 1.e-3);
+    BOOST_CHECK_CLOSE(std::abs(root_t.second->root.imag()),
+                      std::abs(root_d.second->root.imag()), 1.e-3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
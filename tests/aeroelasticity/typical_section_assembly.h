@@ -0,0 +1,130 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_test_typical_section_assembly_h__
+#define __mast_test_typical_section_assembly_h__
+
+// C++ includes
+#include <vector>
+#include <map>
+#include <cmath>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/parameter.h"
+#include "aeroelasticity/time_domain_flutter_solver.h"
+#include "elasticity/structural_fluid_interaction_assembly.h"
+
+
+/*!
+ *   provides the reduced-order matrices of a two degree-of-freedom typical
+ *   section with a quasi-steady aerodynamic model, so that the flutter
+ *   solver can be exercised without a mesh. If \p affine is false, the
+ *   aerodynamic stiffness is not a polynomial in velocity.
+ */
+class TypicalSectionAssembly:
+public MAST::StructuralFluidInteractionAssembly {
+public:
+    
+    TypicalSectionAssembly(MAST::Parameter& V, bool affine):
+    MAST::StructuralFluidInteractionAssembly(),
+    _V(V),
+    _affine(affine) { }
+    
+    virtual ~TypicalSectionAssembly() { }
+    
+    virtual void
+    assemble_reduced_order_quantity
+    (std::vector<libMesh::NumericVector<Real>*>& basis,
+     std::map<MAST::StructuralQuantityType, RealMatrixX*>& mat_qty_map) {
+        
+        libmesh_assert_equal_to(basis.size(), 2);
+        
+        const Real
+        V  = _V(),
+        q  = _affine? 0.5*V*V : 0.5*V*V*(1. + 0.1*std::sqrt(V));
+        
+        RealMatrixX
+        m  = RealMatrixX::Zero(2, 2),
+        c  = RealMatrixX::Zero(2, 2),
+        k  = RealMatrixX::Zero(2, 2);
+        
+        // plunge and pitch with a static imbalance
+        m << 1.0, 0.25,
+             0.25, 0.5;
+        
+        // structural damping and aerodynamic damping linear in V
+        c << 0.02 + 0.1*V,  0.,
+             0.,            0.01 + 0.02*V;
+        
+        // structural stiffness and aerodynamic stiffness in pitch,
+        // proportional to the dynamic pressure
+        k << 1.0,  0.4*q,
+             0.,   2.0 - 0.1*q;
+        
+        std::map<MAST::StructuralQuantityType, RealMatrixX*>::iterator
+        it   = mat_qty_map.begin(),
+        end  = mat_qty_map.end();
+        
+        for ( ; it != end; it++) {
+            
+            switch (it->first) {
+                case MAST::MASS:
+                    *it->second = m;
+                    break;
+                    
+                case MAST::DAMPING:
+                    *it->second = c;
+                    break;
+                    
+                case MAST::STIFFNESS:
+                    *it->second = k;
+                    break;
+                    
+                default:
+                    libmesh_error();
+            }
+        }
+    }
+    
+protected:
+    
+    MAST::Parameter& _V;
+    
+    bool             _affine;
+};
+
+
+
+/*!
+ *   provides access to the solutions of the sweep
+ */
+class TimeDomainFlutterSolverAccess:
+public MAST::TimeDomainFlutterSolver {
+public:
+    
+    const std::map<Real, MAST::FlutterSolutionBase*>& solutions() const {
+        
+        return _flutter_solutions;
+    }
+};
+
+
+#endif // __mast_test_typical_section_assembly_h__
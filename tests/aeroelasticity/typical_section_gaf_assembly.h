@@ -0,0 +1,160 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_test_typical_section_gaf_assembly_h__
+#define __mast_test_typical_section_gaf_assembly_h__
+
+// C++ includes
+#include <vector>
+#include <map>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/parameter.h"
+#include "aeroelasticity/pk_flutter_solver.h"
+#include "elasticity/fsi_generalized_aero_force_assembly.h"
+
+
+/*!
+ *   provides the reduced-order structural matrices of a two
+ *   degree-of-freedom typical section and a generalized aerodynamic force
+ *   matrix that is a cubic polynomial in the reduced frequency, so that
+ *   the PK flutter solver can be exercised without a fluid model. The
+ *   number of aerodynamic assemblies is counted.
+ */
+class TypicalSectionGAFAssembly:
+public MAST::FSIGeneralizedAeroForceAssembly {
+public:
+    
+    TypicalSectionGAFAssembly(MAST::Parameter& kr):
+    MAST::FSIGeneralizedAeroForceAssembly(),
+    n_gaf_assemblies(0),
+    _kr(kr) { }
+    
+    virtual ~TypicalSectionGAFAssembly() { }
+    
+    virtual void
+    assemble_reduced_order_quantity
+    (std::vector<libMesh::NumericVector<Real>*>& basis,
+     std::map<MAST::StructuralQuantityType, RealMatrixX*>& mat_qty_map) {
+        
+        libmesh_assert_equal_to(basis.size(), 2);
+        
+        RealMatrixX
+        m  = RealMatrixX::Zero(2, 2),
+        k  = RealMatrixX::Zero(2, 2);
+        
+        // plunge and pitch with a static imbalance
+        m << 1.0, 0.25,
+             0.25, 0.5;
+        k << 1.0, 0.,
+             0.,  2.0;
+        
+        std::map<MAST::StructuralQuantityType, RealMatrixX*>::iterator
+        it   = mat_qty_map.begin(),
+        end  = mat_qty_map.end();
+        
+        for ( ; it != end; it++) {
+            
+            switch (it->first) {
+                case MAST::MASS:
+                    *it->second = m;
+                    break;
+                    
+                case MAST::STIFFNESS:
+                    *it->second = k;
+                    break;
+                    
+                default:
+                    libmesh_error();
+            }
+        }
+    }
+    
+    
+    virtual void
+    assemble_generalized_aerodynamic_force_matrix
+    (std::vector<libMesh::NumericVector<Real>*>& basis,
+     ComplexMatrixX& mat,
+     MAST::Parameter* p = nullptr) {
+        
+        libmesh_assert_equal_to(basis.size(), 2);
+        libmesh_assert(!p);
+        
+        const Complex
+        ik(0., _kr());
+        
+        RealMatrixX
+        a0 = RealMatrixX::Zero(2, 2),
+        a1 = RealMatrixX::Zero(2, 2),
+        a2 = RealMatrixX::Zero(2, 2),
+        a3 = RealMatrixX::Zero(2, 2);
+        
+        // lift due to pitch and pitching moment, with damping and
+        // apparent mass terms
+        a0 << 0., -0.4,
+              0.,  0.1;
+        a1 << -0.2, -0.1,
+               0.05, -0.05;
+        a2 << -0.02, 0.01,
+               0.01, -0.01;
+        a3 <<  0.002, 0.,
+               0.,    0.001;
+        
+        // the solver expects the quantity on the left of R(X)=0
+        mat  = -(a0.cast<Complex>() +
+                 ik * a1.cast<Complex>() +
+                 ik * ik * a2.cast<Complex>() +
+                 ik * ik * ik * a3.cast<Complex>());
+        
+        n_gaf_assemblies++;
+    }
+    
+    unsigned int     n_gaf_assemblies;
+    
+protected:
+    
+    MAST::Parameter& _kr;
+};
+
+
+
+/*!
+ *   provides access to the solutions of the sweep and to the analysis at
+ *   a single point
+ */
+class PKFlutterSolverAccess:
+public MAST::PKFlutterSolver {
+public:
+    
+    const std::map<Real, MAST::FlutterSolutionBase*>& solutions() const {
+        
+        return _flutter_solutions;
+    }
+    
+    std::unique_ptr<MAST::FlutterSolutionBase>
+    analyze(const Real k_red, const Real v_ref) {
+        
+        return _analyze(k_red, v_ref);
+    }
+};
+
+
+#endif // __mast_test_typical_section_gaf_assembly_h__
@@ -0,0 +1,312 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/elem_workspace.h"
+#include "base/structural_plate_model.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "elasticity/structural_element_base.h"
+#include "mesh/geom_elem.h"
+#include "numerics/fem_operator_matrix.h"
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+#include "libmesh/elem.h"
+
+
+/*!
+ *   The workspace counter only sees the buffers of the workspace. To
+ *   verify that the element routines do not allocate elsewhere, the heap
+ *   allocations of the whole process are counted by interposing
+ *   \p malloc, which is used by \p operator \p new and by Eigen. This
+ *   relies on the glibc entry points and is disabled elsewhere.
+ */
+#if defined(__GLIBC__)
+#define MAST_TEST_COUNT_MALLOC 1
+
+extern "C" {
+    void* __libc_malloc(size_t n);
+    void* __libc_calloc(size_t n, size_t s);
+    void* __libc_realloc(void* p, size_t n);
+}
+
+bool          _count_malloc    = false;
+unsigned long _n_malloc        = 0;
+
+extern "C" void*
+malloc(size_t n) {
+    if (_count_malloc) _n_malloc++;
+    return __libc_malloc(n);
+}
+
+extern "C" void*
+calloc(size_t n, size_t s) {
+    if (_count_malloc) _n_malloc++;
+    return __libc_calloc(n, s);
+}
+
+extern "C" void*
+realloc(void* p, size_t n) {
+    if (_count_malloc) _n_malloc++;
+    return __libc_realloc(p, n);
+}
+#endif
+
+
+/*!
+ *   starts counting the heap allocations of the process
+ */
+inline void
+start_malloc_count() {
+#ifdef MAST_TEST_COUNT_MALLOC
+    _n_malloc     = 0;
+    _count_malloc = true;
+#endif
+}
+
+
+/*!
+ *   @returns the number of heap allocations since \p start_malloc_count()
+ */
+inline unsigned long
+stop_malloc_count() {
+#ifdef MAST_TEST_COUNT_MALLOC
+    _count_malloc = false;
+    return _n_malloc;
+#else
+    return 0;
+#endif
+}
+
+
+/*!
+ *   mimics the scratch storage requests of an element routine, including
+ *   a nested frame for a helper routine called from within the element
+ */
+void
+elem_calculations(MAST::ElemWorkspace& workspace, unsigned int n_phi) {
+    
+    MAST::ElemWorkspace::Frame
+    ws(workspace);
+    
+    RealMatrixX
+    &jac   = ws.matrix(6*n_phi, 6*n_phi);
+    
+    RealVectorX
+    &f     = ws.vector(6*n_phi);
+    
+    MAST::FEMOperatorMatrix
+    &Bmat  = ws.operator_matrix(3, 6, n_phi);
+    
+    // buffers are returned zeroed and with the requested dimensions
+    BOOST_CHECK_EQUAL(jac.rows(), 6*n_phi);
+    BOOST_CHECK_EQUAL(jac.cols(), 6*n_phi);
+    BOOST_CHECK_EQUAL(f.size(),   6*n_phi);
+    BOOST_CHECK_EQUAL(Bmat.m(),   3);
+    BOOST_CHECK_EQUAL(Bmat.n(),   6*n_phi);
+    BOOST_CHECK_EQUAL(jac.norm(), 0.);
+    BOOST_CHECK_EQUAL(f.norm(),   0.);
+    
+    jac.setOnes();
+    f.setOnes();
+    
+    {
+        // nested frame should not hand out the buffers in use
+        MAST::ElemWorkspace::Frame
+        ws_nested(workspace);
+        
+        RealVectorX
+        &phi  = ws_nested.vector(6*n_phi);
+        
+        BOOST_CHECK(&phi != &f);
+        BOOST_CHECK_EQUAL(phi.norm(), 0.);
+        phi.setOnes();
+    }
+    
+    BOOST_CHECK_EQUAL(f.sum(), 6.*n_phi);
+}
+
+
+/*!
+ *   same storage requests as \p elem_calculations, without the checks, so
+ *   that the heap allocations of the workspace alone can be counted
+ */
+void
+elem_buffers(MAST::ElemWorkspace& workspace, unsigned int n_phi) {
+    
+    MAST::ElemWorkspace::Frame
+    ws(workspace);
+    
+    RealMatrixX
+    &jac   = ws.matrix(6*n_phi, 6*n_phi);
+    
+    RealVectorX
+    &f     = ws.vector(6*n_phi);
+    
+    ws.operator_matrix(3, 6, n_phi);
+    
+    std::vector<RealMatrixX>
+    &mats  = ws.matrix_array(n_phi);
+    
+    jac.setOnes();
+    f.setOnes();
+    for (unsigned int i=0; i<n_phi; i++)
+        mats[i].setZero(3, 3);
+    
+    {
+        MAST::ElemWorkspace::Frame
+        ws_nested(workspace);
+        
+        ws_nested.vector(6*n_phi).setOnes();
+    }
+}
+
+
+
+BOOST_AUTO_TEST_SUITE  (ElemWorkspaceTests)
+
+BOOST_AUTO_TEST_CASE   (NoAllocationsInSteadyState) {
+    
+    MAST::ElemWorkspace workspace;
+    
+    // the first element allocates the buffers
+    elem_calculations(workspace, 4);
+    BOOST_CHECK_GT(workspace.n_allocations(), 0);
+    
+    // subsequent elements of the same type reuse them
+    const unsigned long
+    n_alloc = workspace.n_allocations();
+    
+    for (unsigned int i=0; i<100; i++)
+        elem_calculations(workspace, 4);
+    
+    BOOST_CHECK_EQUAL(workspace.n_allocations(), n_alloc);
+    
+    // a different element type requires resizing of the buffers
+    elem_calculations(workspace, 9);
+    BOOST_CHECK_GT(workspace.n_allocations(), n_alloc);
+    
+    workspace.reset_allocation_count();
+    BOOST_CHECK_EQUAL(workspace.n_allocations(), 0);
+}
+
+
+BOOST_AUTO_TEST_CASE   (NoHeapAllocationsInSteadyState) {
+    
+    MAST::ElemWorkspace workspace;
+    
+    elem_buffers(workspace, 4);
+    
+    // neither the frames nor the reused buffers touch the heap
+    start_malloc_count();
+    for (unsigned int i=0; i<100; i++)
+        elem_buffers(workspace, 4);
+    const unsigned long
+    n_malloc = stop_malloc_count();
+    
+    BOOST_CHECK_EQUAL(n_malloc, 0);
+}
+
+
+BOOST_AUTO_TEST_CASE   (StructuralElementAllocations) {
+    
+    StructuralPlateModel model(libMesh::QUAD4, 4);
+    model.set_solution();
+    
+    MAST::NonlinearImplicitAssembly assembly;
+    assembly.set_discipline_and_system(*model.discipline, *model.structural_sys);
+    
+    const libMesh::DofMap& dof_map = model.sys->get_dof_map();
+    std::vector<libMesh::dof_id_type> dof_ids;
+    
+    std::vector<unsigned long>
+    n_malloc;
+    
+    unsigned long
+    n_ws_alloc = 0;
+    
+    // the first pass fills the workspace, the second pass is in steady state
+    for (unsigned int pass=0; pass<2; pass++) {
+        
+        if (pass == 1)
+            n_ws_alloc = assembly.n_elem_workspace_allocations();
+        
+        libMesh::MeshBase::const_element_iterator
+        it   = model.mesh.active_local_elements_begin(),
+        end  = model.mesh.active_local_elements_end();
+        
+        for ( ; it != end; it++) {
+            
+            const libMesh::Elem* elem = *it;
+            dof_map.dof_indices(elem, dof_ids);
+            
+            MAST::GeomElem geom_elem;
+            geom_elem.init(*elem, *model.structural_sys);
+            
+            std::unique_ptr<MAST::StructuralElementBase>
+            e = MAST::build_structural_element(*model.structural_sys,
+                                               assembly,
+                                               geom_elem,
+                                               model.section);
+            
+            const unsigned int
+            n = (unsigned int)dof_ids.size();
+            
+            RealVectorX
+            sol = RealVectorX::Constant(n, 1.e-4),
+            f   = RealVectorX::Zero(n);
+            RealMatrixX
+            jac = RealMatrixX::Zero(n, n);
+            
+            e->set_solution(sol);
+            
+            start_malloc_count();
+            e->internal_residual(true, f, jac);
+            const unsigned long
+            n_call = stop_malloc_count();
+            
+            if (pass == 1)
+                n_malloc.push_back(n_call);
+        }
+    }
+    
+    // no scratch storage is requested in steady state
+    BOOST_CHECK_EQUAL(assembly.n_elem_workspace_allocations(), n_ws_alloc);
+    
+    // the finite element, bending operator and scratch storage are reused,
+    // so that the element call does not allocate in steady state
+    BOOST_REQUIRE(!n_malloc.empty());
+    for (unsigned int i=0; i<n_malloc.size(); i++)
+        BOOST_CHECK_EQUAL(n_malloc[i], 0);
+    
+    assembly.clear_discipline_and_system();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,214 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <memory>
+#include <vector>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/parameter.h"
+#include "base/constant_field_function.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "property_cards/isotropic_material_property_card.h"
+#include "property_cards/solid_2d_section_element_property_card.h"
+#include "elasticity/structural_element_base.h"
+#include "mesh/geom_elem.h"
+
+// Test includes
+#include "base/test_comparisons.h"
+#include "base/structural_plate_model.h"
+
+// libMesh includes
+#include "libmesh/elem.h"
+
+
+/*!
+ *   function that varies linearly in x, so that the section properties
+ *   differ between the quadrature points
+ */
+class LinearFieldFunction:
+public MAST::FieldFunction<Real> {
+    
+public:
+    
+    LinearFieldFunction(const std::string& nm, Real a, Real b):
+    MAST::FieldFunction<Real>(nm),
+    _a  (a),
+    _b  (b) { }
+    
+    virtual void operator() (const libMesh::Point& p,
+                             const Real t,
+                             Real& v) const {
+        v = _a + _b*p(0);
+    }
+    
+    virtual void derivative (const MAST::FunctionBase& f,
+                             const libMesh::Point& p,
+                             const Real t,
+                             Real& v) const {
+        v = 0.;
+    }
+    
+protected:
+    
+    Real _a, _b;
+};
+
+
+struct FieldFunctionEvaluateFixture {
+    
+    FieldFunctionEvaluateFixture():
+    E         ("E",   72.e9),
+    nu        ("nu",  0.33),
+    E_f       ("E",   E),
+    nu_f      ("nu",  nu) {
+        
+        material.add(E_f);
+        material.add(nu_f);
+        
+        for (unsigned int i=0; i<9; i++)
+            pts.push_back(libMesh::Point(0.1*i, 0.2*i, 0.));
+    }
+    
+    MAST::Parameter                      E, nu;
+    MAST::ConstantFieldFunction          E_f, nu_f;
+    MAST::IsotropicMaterialPropertyCard  material;
+    std::vector<libMesh::Point>          pts;
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (FieldFunctionEvaluate, FieldFunctionEvaluateFixture)
+
+BOOST_AUTO_TEST_CASE   (ConstantFunctionBroadcast) {
+    
+    std::vector<Real> v, dv;
+    
+    E_f.evaluate(pts, 0., v);
+    E_f.evaluate_derivative(E, pts, 0., dv);
+    
+    BOOST_REQUIRE_EQUAL(v.size(),  pts.size());
+    BOOST_REQUIRE_EQUAL(dv.size(), pts.size());
+    
+    for (unsigned int i=0; i<pts.size(); i++) {
+        
+        BOOST_CHECK_EQUAL(v[i],  E());
+        BOOST_CHECK_EQUAL(dv[i], 1.);
+    }
+    
+    // no dependence on the other parameter
+    E_f.evaluate_derivative(nu, pts, 0., dv);
+    for (unsigned int i=0; i<pts.size(); i++)
+        BOOST_CHECK_EQUAL(dv[i], 0.);
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (MaterialStiffnessMatchesPointwise) {
+    
+    const MAST::FieldFunction<RealMatrixX>&
+    C = material.stiffness_matrix(2);
+    
+    std::vector<RealMatrixX> m, dm;
+    RealMatrixX m0, dm0;
+    
+    C.evaluate(pts, 0., m);
+    C.evaluate_derivative(nu, pts, 0., dm);
+    
+    BOOST_REQUIRE_EQUAL(m.size(),  pts.size());
+    BOOST_REQUIRE_EQUAL(dm.size(), pts.size());
+    
+    for (unsigned int i=0; i<pts.size(); i++) {
+        
+        C(pts[i], 0., m0);
+        C.derivative(nu, pts[i], 0., dm0);
+        
+        BOOST_CHECK(MAST::compare_matrix(m0,  m[i],  1.e-12));
+        BOOST_CHECK(MAST::compare_matrix(dm0, dm[i], 1.e-12));
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (SectionStiffnessMatchesPointwise) {
+    
+    LinearFieldFunction
+    h_f    ("h",   0.01, 0.002),
+    off_f  ("off", 0.,   0.001);
+    
+    MAST::Solid2DSectionElementPropertyCard section;
+    section.add(h_f);
+    section.add(off_f);
+    section.set_material(material);
+    
+    // the section matrices are built for an element, which is taken from
+    // the plate model
+    StructuralPlateModel model(libMesh::QUAD4, 1);
+    
+    MAST::NonlinearImplicitAssembly assembly;
+    assembly.set_discipline_and_system(*model.discipline, *model.structural_sys);
+    
+    MAST::GeomElem geom_elem;
+    geom_elem.init(**model.mesh.active_local_elements_begin(), *model.structural_sys);
+    
+    std::unique_ptr<MAST::StructuralElementBase>
+    e = MAST::build_structural_element(*model.structural_sys,
+                                       assembly,
+                                       geom_elem,
+                                       section);
+    
+    std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
+    A = section.stiffness_A_matrix(*e),
+    B = section.stiffness_B_matrix(*e),
+    D = section.stiffness_D_matrix(*e);
+    
+    const MAST::FieldFunction<RealMatrixX>*
+    f[3] = {A.get(), B.get(), D.get()};
+    
+    std::vector<RealMatrixX> m;
+    RealMatrixX m0;
+    
+    for (unsigned int j=0; j<3; j++) {
+        
+        // the second evaluation reuses the matrices of the first
+        for (unsigned int k=0; k<2; k++) {
+            
+            f[j]->evaluate(pts, 0., m);
+            
+            BOOST_REQUIRE_EQUAL(m.size(), pts.size());
+            
+            for (unsigned int i=0; i<pts.size(); i++) {
+                
+                (*f[j])(pts[i], 0., m0);
+                BOOST_CHECK(MAST::compare_matrix(m0, m[i], 1.e-12));
+            }
+        }
+    }
+    
+    e.reset();
+    assembly.clear_discipline_and_system();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
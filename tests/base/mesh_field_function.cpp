@@ -0,0 +1,233 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+
+// C++ includes
+#include <vector>
+#include <cmath>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "base/mesh_field_function.h"
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/explicit_system.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/elem.h"
+#include "libmesh/fe_interface.h"
+
+
+extern libMesh::LibMeshInit* _mast_init;
+
+
+struct MeshFieldFunctionFixture {
+    
+    MeshFieldFunctionFixture():
+    mesh   (_mast_init->comm()),
+    eq_sys (nullptr),
+    sys    (nullptr) {
+        
+        libMesh::MeshTools::Generation::build_square(mesh, 32, 32,
+                                                     0., 1., 0., 1.,
+                                                     libMesh::QUAD9);
+        
+        eq_sys = new libMesh::EquationSystems(mesh);
+        sys    = &eq_sys->add_system<libMesh::ExplicitSystem>("u");
+        sys->add_variable("u", libMesh::SECOND, libMesh::LAGRANGE);
+        sys->add_variable("v", libMesh::FIRST,  libMesh::LAGRANGE);
+        eq_sys->init();
+        
+        // quadratic field for u, which is interpolated exactly, and
+        // a bilinear field for v
+        libMesh::MeshBase::const_node_iterator
+        it  = mesh.local_nodes_begin(),
+        end = mesh.local_nodes_end();
+        
+        for ( ; it != end; it++) {
+            
+            const libMesh::Node& n = **it;
+            
+            if (n.n_comp(sys->number(), 0))
+                sys->solution->set(n.dof_number(sys->number(), 0, 0),
+                                   n(0)*n(0) + 2.*n(0)*n(1));
+            if (n.n_comp(sys->number(), 1))
+                sys->solution->set(n.dof_number(sys->number(), 1, 0),
+                                   1. + n(0)*n(1));
+        }
+        sys->solution->close();
+    }
+    
+    ~MeshFieldFunctionFixture() {
+        
+        delete eq_sys;
+    }
+    
+    libMesh::ReplicatedMesh     mesh;
+    libMesh::EquationSystems   *eq_sys;
+    libMesh::ExplicitSystem    *sys;
+};
+
+
+/*!
+ *   provides the number of values stored on this processor
+ */
+class MeshFieldFunctionStorage:
+public MAST::MeshFieldFunction {
+public:
+    
+    MeshFieldFunctionStorage(libMesh::System& sys):
+    MAST::MeshFieldFunction(sys, "u") { }
+    
+    libMesh::dof_id_type n_stored_values() const {
+        
+        libmesh_assert(_sol);
+        
+        if (_ghosted)
+            return _sol->local_size() + _sys->get_dof_map().get_send_list().size();
+        else
+            return _sol->local_size();
+    }
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (MeshFieldFunctionTests, MeshFieldFunctionFixture)
+
+BOOST_AUTO_TEST_CASE   (ElementEvaluationMatchesPointEvaluation) {
+    
+    MAST::MeshFieldFunction
+    serial  (*sys, "u"),
+    ghosted (*sys, "u");
+    
+    ghosted.set_ghosted_localization(true);
+    serial.init(*sys->solution, sys->solution.get());
+    ghosted.init(*sys->solution, sys->solution.get());
+    
+    RealVectorX
+    v      = RealVectorX::Zero(2),
+    v_e    = RealVectorX::Zero(2),
+    v_ref  = RealVectorX::Zero(2),
+    dv_e   = RealVectorX::Zero(2);
+    
+    RealMatrixX
+    g      = RealMatrixX::Zero(2, 3),
+    g_e    = RealMatrixX::Zero(2, 3),
+    g_ref  = RealMatrixX::Zero(2, 3);
+    
+    // the ghosted function can be evaluated only on the local elements
+    libMesh::MeshBase::const_element_iterator
+    it  = mesh.active_local_elements_begin(),
+    end = mesh.active_local_elements_end();
+    
+    for ( ; it != end; it++) {
+        
+        const libMesh::Elem& e = **it;
+        
+        const libMesh::Point
+        p  = e.centroid() + 0.4 * (e.point(1) - e.centroid()),
+        xi = libMesh::FEInterface::inverse_map(2, sys->variable_type(0), &e, p);
+        
+        v_ref(0)    = p(0)*p(0) + 2.*p(0)*p(1);
+        v_ref(1)    = 1. + p(0)*p(1);
+        g_ref.setZero();
+        g_ref(0, 0) = 2.*p(0) + 2.*p(1);
+        g_ref(0, 1) = 2.*p(0);
+        g_ref(1, 0) = p(1);
+        g_ref(1, 1) = p(0);
+        
+        serial(e, xi, 0., v_e);
+        serial.gradient(e, xi, 0., g_e);
+        serial.perturbation(e, xi, 0., dv_e);
+        
+        BOOST_CHECK_SMALL((v_e - v_ref).norm(),  1.e-10);
+        BOOST_CHECK_SMALL((dv_e - v_ref).norm(), 1.e-10);
+        BOOST_CHECK_SMALL((g_e - g_ref).norm(),  1.e-10);
+        
+        // the ghosted function gives the same values by element and
+        // by point
+        ghosted(e, xi, 0., v_e);
+        ghosted.gradient(e, xi, 0., g_e);
+        ghosted(p, 0., v);
+        ghosted.gradient(p, 0., g);
+        
+        BOOST_CHECK_SMALL((v_e - v_ref).norm(), 1.e-10);
+        BOOST_CHECK_SMALL((v   - v_ref).norm(), 1.e-10);
+        BOOST_CHECK_SMALL((g_e - g_ref).norm(), 1.e-10);
+        BOOST_CHECK_SMALL((g   - g_ref).norm(), 1.e-10);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE   (GhostedStorageIsLocal) {
+    
+    MeshFieldFunctionStorage
+    serial  (*sys),
+    ghosted (*sys);
+    
+    ghosted.set_ghosted_localization(true);
+    serial.init(*sys->solution);
+    ghosted.init(*sys->solution);
+    
+    const libMesh::dof_id_type
+    n_serial  = serial.n_stored_values(),
+    n_ghosted = ghosted.n_stored_values(),
+    n_local   = sys->n_local_dofs();
+    
+    libMesh::dof_id_type
+    max_ghosted = n_ghosted,
+    sum_ghosted = n_ghosted;
+    mesh.comm().max(max_ghosted);
+    mesh.comm().sum(sum_ghosted);
+    
+    const unsigned int
+    n_procs = mesh.comm().size();
+    
+    libMesh::out
+    << "MeshFieldFunction values stored per processor on "
+    << n_procs << " processors:  serial: " << n_serial
+    << ",  ghosted (max): " << max_ghosted
+    << ",  ghosted (total): " << sum_ghosted << std::endl;
+    
+    // the serial copy has all dofs on each processor
+    BOOST_CHECK_EQUAL(n_serial, sys->n_dofs());
+    
+    // the ghosted copy has the local dofs and the dofs of the neighbors
+    // of the local elements
+    BOOST_CHECK_GE(n_ghosted, n_local);
+    BOOST_CHECK_LE(n_ghosted, n_serial);
+    
+    // with more processors the storage per processor is reduced, and the
+    // total storage is a fraction of the serial copies
+    if (n_procs >= 4) {
+        
+        BOOST_CHECK_LT(2 * max_ghosted, n_serial);
+        BOOST_CHECK_LT(2 * sum_ghosted, n_procs * n_serial);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
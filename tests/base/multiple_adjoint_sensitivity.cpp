@@ -0,0 +1,104 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "base/structural_plate_model.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "elasticity/structural_nonlinear_assembly.h"
+#include "elasticity/compliance_output.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+
+
+BOOST_FIXTURE_TEST_SUITE  (MultipleAdjointSensitivity, StructuralPlateModel)
+
+BOOST_AUTO_TEST_CASE   (MatchesSingleParameterSensitivity) {
+    
+    this->set_solution();
+    
+    MAST::NonlinearImplicitAssembly                 assembly;
+    MAST::StructuralNonlinearAssemblyElemOperations ops;
+    MAST::ComplianceOutput                          compliance;
+    assembly.set_discipline_and_system(*discipline, *structural_sys);
+    ops.set_discipline_and_system(*discipline, *structural_sys);
+    compliance.set_participating_elements_to_all();
+    compliance.set_discipline_and_system(*discipline, *structural_sys);
+    
+    // the compliance depends on the pressure through the load, which gives
+    // a nonzero partial sensitivity
+    std::vector<const MAST::FunctionBase*>
+    p(parameters.begin(), parameters.end());
+    p.push_back(&press);
+    
+    const unsigned int
+    n_params = (unsigned int)p.size();
+    
+    // the adjoint of the compliance is the solution, up to the sign
+    const libMesh::NumericVector<Real>
+    &X = *sys->solution;
+    
+    // sensitivities with and without the partial sensitivity of the output
+    std::vector<Real>
+    dq_dp[2];
+    
+    BOOST_REQUIRE(compliance.if_additive_over_elems());
+    
+    for (unsigned int k=0; k<2; k++) {
+        
+        const bool
+        include_partial_sens = (k == 0);
+        
+        assembly.calculate_output_adjoint_sensitivity(X, X, p, ops, compliance,
+                                                      dq_dp[k], include_partial_sens);
+        
+        BOOST_REQUIRE_EQUAL(dq_dp[k].size(), n_params);
+        
+        for (unsigned int i=0; i<n_params; i++) {
+            
+            const Real
+            ref = assembly.calculate_output_adjoint_sensitivity(X, X, *p[i],
+                                                                ops, compliance,
+                                                                include_partial_sens);
+            
+            BOOST_CHECK_SMALL(dq_dp[k][i] - ref, 1.e-10 * std::max(1., std::fabs(ref)));
+        }
+    }
+    
+    // only the pressure contributes a partial sensitivity
+    for (unsigned int i=0; i<n_params-1; i++)
+        BOOST_CHECK_SMALL(dq_dp[0][i] - dq_dp[1][i],
+                          1.e-10 * std::max(1., std::fabs(dq_dp[0][i])));
+    BOOST_CHECK_GT(std::fabs(dq_dp[0][n_params-1] - dq_dp[1][n_params-1]), 0.);
+    
+    compliance.clear_discipline_and_system();
+    ops.clear_discipline_and_system();
+    assembly.clear_discipline_and_system();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <memory>
+#include <vector>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "base/structural_plate_model.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "elasticity/structural_nonlinear_assembly.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+
+
+BOOST_FIXTURE_TEST_SUITE  (MultipleSensitivitySolve, StructuralPlateModel)
+
+BOOST_AUTO_TEST_CASE   (MatchesSingleParameterSolve) {
+    
+    this->set_solution();
+    
+    MAST::NonlinearImplicitAssembly                 assembly;
+    MAST::StructuralNonlinearAssemblyElemOperations ops;
+    assembly.set_discipline_and_system(*discipline, *structural_sys);
+    ops.set_discipline_and_system(*discipline, *structural_sys);
+    
+    const unsigned int
+    n_params = (unsigned int)parameters.size();
+    
+    // reference solutions from one solve per parameter, which use the
+    // linear solver of the system
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >
+    dsol_ref(n_params);
+    
+    for (unsigned int i=0; i<n_params; i++) {
+        
+        sys->sensitivity_solve(ops, assembly, *parameters[i]);
+        dsol_ref[i] = sys->get_sensitivity_solution(0).clone();
+    }
+    
+    std::vector<const MAST::FunctionBase*>
+    p(parameters.begin(), parameters.end());
+    
+    // the multiple right-hand side solve is repeated to check that the
+    // solver of the system can be reused
+    for (unsigned int k=0; k<2; k++) {
+        
+        std::vector<libMesh::NumericVector<Real>*>
+        dsol = sys->sensitivity_solve(ops, assembly, p);
+        
+        BOOST_REQUIRE_EQUAL(dsol.size(), n_params);
+        
+        for (unsigned int i=0; i<n_params; i++) {
+            
+            const Real
+            ref_norm = dsol_ref[i]->l2_norm();
+            
+            BOOST_CHECK_GT(ref_norm, 0.);
+            
+            std::unique_ptr<libMesh::NumericVector<Real> >
+            diff = dsol[i]->clone();
+            diff->add(-1., *dsol_ref[i]);
+            
+            BOOST_CHECK_SMALL(diff->l2_norm(), 1.e-6 * ref_norm);
+        }
+    }
+    
+    ops.clear_discipline_and_system();
+    assembly.clear_discipline_and_system();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,179 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_test_structural_plate_model_h__
+#define __mast_test_structural_plate_model_h__
+
+// C++ includes
+#include <vector>
+#include <cmath>
+
+// MAST includes
+#include "base/nonlinear_system.h"
+#include "base/physics_discipline_base.h"
+#include "base/parameter.h"
+#include "base/constant_field_function.h"
+#include "base/boundary_condition_base.h"
+#include "boundary_condition/dirichlet_boundary_condition.h"
+#include "elasticity/structural_system_initialization.h"
+#include "property_cards/isotropic_material_property_card.h"
+#include "property_cards/solid_2d_section_element_property_card.h"
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/fe_type.h"
+
+
+extern libMesh::LibMeshInit* _mast_init;
+
+
+/*!
+ *   square plate with clamped edges under uniform pressure, shared by the
+ *   tests that need a structural system with more than one element.
+ */
+struct StructuralPlateModel {
+    
+    StructuralPlateModel(libMesh::ElemType e_type = libMesh::QUAD4,
+                         unsigned int n_divs      = 8):
+    mesh              (_mast_init->comm()),
+    eq_sys            (nullptr),
+    sys               (nullptr),
+    structural_sys    (nullptr),
+    discipline        (nullptr),
+    th                ("th",       0.01),
+    E                 ("E",       72.e9),
+    nu                ("nu",       0.33),
+    kappa             ("kappa",   5./6.),
+    zero              ("zero",       0.),
+    press             ("p",        1.e4),
+    th_f              ("h",            th),
+    E_f               ("E",             E),
+    nu_f              ("nu",           nu),
+    kappa_f           ("kappa",     kappa),
+    off_f             ("off",        zero),
+    press_f           ("pressure",  press),
+    pressure          (MAST::SURFACE_PRESSURE) {
+        
+        libMesh::MeshTools::Generation::build_square(mesh, n_divs, n_divs,
+                                                     0., 1., 0., 1.,
+                                                     e_type);
+        
+        eq_sys = new libMesh::EquationSystems(mesh);
+        sys    = &eq_sys->add_system<MAST::NonlinearSystem>("structural");
+        
+        libMesh::FEType
+        fetype(e_type == libMesh::QUAD9? libMesh::SECOND: libMesh::FIRST,
+               libMesh::LAGRANGE);
+        
+        structural_sys = new MAST::StructuralSystemInitialization(*sys,
+                                                                  sys->name(),
+                                                                  fetype);
+        discipline     = new MAST::PhysicsDisciplineBase(*eq_sys);
+        
+        // all edges are clamped
+        std::vector<unsigned int>
+        vars = {0, 1, 2, 3, 4, 5};
+        for (unsigned int i=0; i<4; i++) {
+            clamped[i].init(i, vars);
+            discipline->add_dirichlet_bc(i, clamped[i]);
+        }
+        discipline->init_system_dirichlet_bc(*sys);
+        
+        eq_sys->init();
+        
+        material.add(E_f);
+        material.add(nu_f);
+        material.add(kappa_f);
+        
+        section.add(th_f);
+        section.add(off_f);
+        section.set_material(material);
+        discipline->set_property_for_subdomain(0, section);
+        
+        pressure.add(press_f);
+        discipline->add_volume_load(0, pressure);
+        
+        parameters.push_back(&th);
+        parameters.push_back(&E);
+    }
+    
+    
+    ~StructuralPlateModel() {
+        
+        delete discipline;
+        delete structural_sys;
+        delete eq_sys;
+    }
+    
+    
+    /*!
+     *   sets a smooth, nonzero displacement field in the solution vector
+     */
+    void set_solution() {
+        
+        const libMesh::dof_id_type
+        first = sys->solution->first_local_index(),
+        last  = sys->solution->last_local_index();
+        
+        for (libMesh::dof_id_type i=first; i<last; i++)
+            sys->solution->set(i, 1.e-4 * std::sin(0.37 * i));
+        sys->solution->close();
+    }
+    
+    
+    libMesh::ReplicatedMesh                     mesh;
+    libMesh::EquationSystems                   *eq_sys;
+    MAST::NonlinearSystem                      *sys;
+    MAST::StructuralSystemInitialization       *structural_sys;
+    MAST::PhysicsDisciplineBase                *discipline;
+    
+    MAST::Parameter
+    th,
+    E,
+    nu,
+    kappa,
+    zero,
+    press;
+    
+    MAST::ConstantFieldFunction
+    th_f,
+    E_f,
+    nu_f,
+    kappa_f,
+    off_f,
+    press_f;
+    
+    MAST::DirichletBoundaryCondition             clamped[4];
+    MAST::BoundaryConditionBase                  pressure;
+    MAST::IsotropicMaterialPropertyCard          material;
+    MAST::Solid2DSectionElementPropertyCard      section;
+    
+    /*!
+     *   parameters used for sensitivity tests
+     */
+    std::vector<MAST::Parameter*>                parameters;
+};
+
+
+#endif // __mast_test_structural_plate_model_h__
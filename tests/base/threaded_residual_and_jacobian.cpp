@@ -0,0 +1,132 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <memory>
+#include <vector>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "base/structural_plate_model.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "elasticity/structural_nonlinear_assembly.h"
+
+// libMesh includes
+#include "libmesh/sparse_matrix.h"
+
+
+/*!
+ *   assembles the residual and Jacobian at the current solution and copies
+ *   the local rows into \p res and \p jac.
+ */
+void
+assemble_residual_and_jacobian(StructuralPlateModel& model,
+                               MAST::NonlinearImplicitAssembly& assembly,
+                               MAST::StructuralNonlinearAssemblyElemOperations& ops,
+                               RealVectorX& res,
+                               RealMatrixX& jac) {
+    
+    MAST::NonlinearSystem& sys = *model.sys;
+    
+    assembly.set_elem_operation_object(ops);
+    assembly.residual_and_jacobian(*sys.solution, sys.rhs, sys.matrix, sys);
+    assembly.clear_elem_operation_object();
+    sys.matrix->close();
+    
+    const libMesh::dof_id_type
+    first = sys.rhs->first_local_index(),
+    last  = sys.rhs->last_local_index(),
+    n     = sys.n_dofs();
+    
+    res.setZero(last-first);
+    jac.setZero(last-first, n);
+    
+    for (libMesh::dof_id_type i=first; i<last; i++) {
+        
+        res(i-first) = (*sys.rhs)(i);
+        for (libMesh::dof_id_type j=0; j<n; j++)
+            jac(i-first, j) = (*sys.matrix)(i, j);
+    }
+}
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (ThreadedResidualAndJacobian, StructuralPlateModel)
+
+BOOST_AUTO_TEST_CASE   (ThreadedMatchesSerial) {
+    
+    this->set_solution();
+    
+    MAST::NonlinearImplicitAssembly                 assembly;
+    MAST::StructuralNonlinearAssemblyElemOperations ops;
+    assembly.set_discipline_and_system(*discipline, *structural_sys);
+    ops.set_discipline_and_system(*discipline, *structural_sys);
+    
+    RealVectorX
+    res_serial,
+    res_threaded;
+    
+    RealMatrixX
+    jac_serial,
+    jac_threaded;
+    
+    // the serial element loop is used without the per-thread objects
+    assemble_residual_and_jacobian(*this, assembly, ops, res_serial, jac_serial);
+    BOOST_CHECK_GT(res_serial.norm(), 0.);
+    
+    std::vector<std::unique_ptr<MAST::StructuralNonlinearAssemblyElemOperations> >
+    thread_ops(libMesh::n_threads());
+    std::vector<MAST::NonlinearImplicitAssemblyElemOperations*>
+    thread_ops_ptr(libMesh::n_threads(), nullptr);
+    
+    for (unsigned int i=0; i<libMesh::n_threads(); i++) {
+        
+        thread_ops[i].reset(new MAST::StructuralNonlinearAssemblyElemOperations);
+        thread_ops[i]->set_discipline_and_system(*discipline, *structural_sys);
+        thread_ops_ptr[i] = thread_ops[i].get();
+    }
+    
+    assembly.set_thread_elem_operation_objects(thread_ops_ptr);
+    
+    // the deterministic reduction adds the element quantities in the order
+    // of the serial loop, which gives identical results
+    assembly.deterministic_reduction = true;
+    assemble_residual_and_jacobian(*this, assembly, ops, res_threaded, jac_threaded);
+    
+    BOOST_CHECK_EQUAL((res_threaded - res_serial).norm(), 0.);
+    BOOST_CHECK_EQUAL((jac_threaded - jac_serial).norm(), 0.);
+    
+    // otherwise, only the order of summation may differ
+    assembly.deterministic_reduction = false;
+    assemble_residual_and_jacobian(*this, assembly, ops, res_threaded, jac_threaded);
+    
+    BOOST_CHECK_SMALL((res_threaded - res_serial).norm(), 1.e-12 * res_serial.norm());
+    BOOST_CHECK_SMALL((jac_threaded - jac_serial).norm(), 1.e-12 * jac_serial.norm());
+    
+    assembly.clear_thread_elem_operation_objects();
+    for (unsigned int i=0; i<libMesh::n_threads(); i++)
+        thread_ops[i]->clear_discipline_and_system();
+    ops.clear_discipline_and_system();
+    assembly.clear_discipline_and_system();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
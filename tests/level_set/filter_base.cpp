@@ -0,0 +1,400 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <map>
+#include <vector>
+#include <memory>
+#include <cmath>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "level_set/filter_base.h"
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/distributed_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/explicit_system.h"
+#include "libmesh/fe_type.h"
+#include "libmesh/numeric_vector.h"
+
+
+extern libMesh::LibMeshInit* _mast_init;
+
+
+namespace MAST {
+    
+    /*!
+     *   provides access to the filter coefficients
+     */
+    class FilterBaseTest:
+    public MAST::FilterBase {
+    public:
+        FilterBaseTest(libMesh::System& sys,
+                       const Real radius,
+                       const std::set<unsigned int>& dv_dof_ids):
+        MAST::FilterBase(sys, radius, dv_dof_ids) { }
+        
+        const std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>>&
+        filter_map() const { return _filter_map; }
+    };
+}
+
+
+/*!
+ *   computes the filter coefficients by comparing each pair of nodes, which
+ *   was the implementation before the binned neighbor search.
+ */
+void
+reference_filter_map(libMesh::System& sys,
+                     const Real radius,
+                     std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>>& filter_map) {
+    
+    libMesh::MeshBase& mesh = sys.get_mesh();
+    
+    libMesh::MeshBase::const_node_iterator
+    node_it_1    =  mesh.nodes_begin(),
+    node_it_2    =  mesh.nodes_begin(),
+    node_end     =  mesh.nodes_end();
+    
+    libMesh::Point
+    d;
+    
+    Real
+    d_12 = 0.,
+    sum  = 0.;
+    
+    unsigned int
+    dof_1,
+    dof_2;
+    
+    for ( ; node_it_1 != node_end; node_it_1++) {
+        
+        dof_1 = (*node_it_1)->dof_number(sys.number(), 0, 0);
+        
+        node_it_2 = mesh.nodes_begin();
+        sum       = 0.;
+        
+        for ( ; node_it_2 != node_end; node_it_2++) {
+            
+            d    = (**node_it_1) - (**node_it_2);
+            d_12 = d.norm();
+            
+            if (d_12 <= radius) {
+                
+                sum  += radius - d_12;
+                dof_2 = (*node_it_2)->dof_number(sys.number(), 0, 0);
+                
+                filter_map[dof_1].push_back(std::pair<unsigned int, Real>(dof_2, radius - d_12));
+            }
+        }
+        
+        std::vector<std::pair<unsigned int, Real>>& vec = filter_map[dof_1];
+        for (unsigned int i=0; i<vec.size(); i++)
+            vec[i].second /= sum;
+    }
+}
+
+
+
+void
+check_filter_weights(const libMesh::ElemType e_type,
+                     const unsigned int     dim) {
+    
+    libMesh::ReplicatedMesh mesh(_mast_init->comm());
+    
+    if (dim == 2)
+        libMesh::MeshTools::Generation::build_square(mesh, 15, 10,
+                                                     0., 1.5, 0., 1.,
+                                                     e_type);
+    else
+        libMesh::MeshTools::Generation::build_cube(mesh, 6, 5, 4,
+                                                   0., 1.2, 0., 1., 0., 0.8,
+                                                   e_type);
+    
+    libMesh::EquationSystems eq_sys(mesh);
+    libMesh::ExplicitSystem& sys = eq_sys.add_system<libMesh::ExplicitSystem>("level_set");
+    sys.add_variable("phi", libMesh::FEType(libMesh::FIRST, libMesh::LAGRANGE));
+    eq_sys.init();
+    
+    std::set<unsigned int> dv_dofs;
+    for (unsigned int i=0; i<sys.n_dofs(); i++)
+        dv_dofs.insert(i);
+    
+    // radii smaller than, comparable to and larger than the element size
+    const Real radii[] = {0.05, 0.21, 0.45};
+    
+    for (unsigned int r=0; r<3; r++) {
+        
+        MAST::FilterBaseTest filter(sys, radii[r], dv_dofs);
+        
+        std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>> ref;
+        reference_filter_map(sys, radii[r], ref);
+        
+        const std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>>&
+        map = filter.filter_map();
+        
+        BOOST_REQUIRE_EQUAL(map.size(), ref.size());
+        
+        std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>>::const_iterator
+        it     = map.begin(),
+        ref_it = ref.begin();
+        
+        for ( ; it != map.end(); it++, ref_it++) {
+            
+            BOOST_CHECK_EQUAL(it->first, ref_it->first);
+            BOOST_REQUIRE_EQUAL(it->second.size(), ref_it->second.size());
+            
+            // the coefficients are accumulated in the same order, so they
+            // are expected to be identical
+            for (unsigned int i=0; i<it->second.size(); i++) {
+                
+                BOOST_CHECK_EQUAL(it->second[i].first,  ref_it->second[i].first);
+                BOOST_CHECK_EQUAL(it->second[i].second, ref_it->second[i].second);
+            }
+        }
+    }
+}
+
+
+
+/*!
+ *   key used to identify a node by its location in meshes with different
+ *   node numbering
+ */
+std::pair<long, long>
+point_key(const libMesh::Point& p) {
+    
+    return std::make_pair(std::lround(p(0)*1.e6), std::lround(p(1)*1.e6));
+}
+
+
+/*!
+ *   level set values used to compare the filtered values
+ */
+Real
+phi_value(const libMesh::Point& p) {
+    
+    return 2. + std::sin(3.*p(0)) + p(1)*p(1);
+}
+
+
+
+BOOST_AUTO_TEST_SUITE  (FilterWeights)
+
+BOOST_AUTO_TEST_CASE   (Quad4) {
+    
+    check_filter_weights(libMesh::QUAD4, 2);
+}
+
+
+BOOST_AUTO_TEST_CASE   (Tri3) {
+    
+    check_filter_weights(libMesh::TRI3, 2);
+}
+
+
+BOOST_AUTO_TEST_CASE   (Hex8) {
+    
+    check_filter_weights(libMesh::HEX8, 3);
+}
+
+
+BOOST_AUTO_TEST_CASE   (MatrixProductAndTranspose) {
+    
+    libMesh::ReplicatedMesh mesh(_mast_init->comm());
+    libMesh::MeshTools::Generation::build_square(mesh, 12, 8,
+                                                 0., 1.2, 0., 0.8,
+                                                 libMesh::QUAD4);
+    
+    libMesh::EquationSystems eq_sys(mesh);
+    libMesh::ExplicitSystem& sys = eq_sys.add_system<libMesh::ExplicitSystem>("level_set");
+    sys.add_variable("phi", libMesh::FEType(libMesh::FIRST, libMesh::LAGRANGE));
+    eq_sys.init();
+    
+    // every other dof is a design variable, so that both the filtered and
+    // the identity rows are exercised
+    std::set<unsigned int> dv_dofs;
+    for (unsigned int i=0; i<sys.n_dofs(); i+=2)
+        dv_dofs.insert(i);
+    
+    MAST::FilterBase filter(sys, 0.25, dv_dofs);
+    
+    const unsigned int
+    n = sys.n_dofs();
+    
+    std::unique_ptr<libMesh::NumericVector<Real>>
+    x    (sys.solution->zero_clone().release()),
+    y    (sys.solution->zero_clone().release()),
+    Bx   (sys.solution->zero_clone().release()),
+    BTy  (sys.solution->zero_clone().release());
+    
+    std::vector<Real>
+    x_vec  (n, 0.),
+    Bx_vec (n, 0.);
+    
+    for (unsigned int i=0; i<n; i++) {
+        
+        x_vec[i] = std::sin(0.3*i) + 0.1*i;
+        
+        if (i >= x->first_local_index() && i < x->last_local_index()) {
+            x->set(i, x_vec[i]);
+            y->set(i, std::cos(0.7*i));
+        }
+    }
+    x->close();
+    y->close();
+    
+    filter.compute_filtered_values(*x, *Bx);
+    filter.compute_filtered_sensitivity_transpose(*y, *BTy);
+    
+    // the parallel product should match the serial application of the
+    // filter coefficients on the design variable rows
+    filter.compute_filtered_values(x_vec, Bx_vec);
+    
+    std::vector<Real> Bx_local;
+    Bx->localize(Bx_local);
+    
+    for (std::set<unsigned int>::const_iterator it = dv_dofs.begin();
+         it != dv_dofs.end(); it++)
+        BOOST_CHECK_CLOSE(Bx_local[*it], Bx_vec[*it], 1.e-10);
+    
+    // the non-design variable rows are identity
+    for (unsigned int i=1; i<n; i+=2)
+        BOOST_CHECK_CLOSE(Bx_local[i], x_vec[i], 1.e-10);
+    
+    // y^T (B x) = (B^T y)^T x
+    BOOST_CHECK_CLOSE(y->dot(*Bx), BTy->dot(*x), 1.e-10);
+}
+
+
+BOOST_AUTO_TEST_CASE   (DistributedMatchesPairwise) {
+    
+    const Real
+    radius = 0.21;
+    
+    // reference values from the pairwise comparison of all nodes, which
+    // requires a replicated mesh
+    std::map<std::pair<long, long>, Real> ref;
+    {
+        libMesh::ReplicatedMesh mesh(_mast_init->comm());
+        libMesh::MeshTools::Generation::build_square(mesh, 15, 10,
+                                                     0., 1.5, 0., 1.,
+                                                     libMesh::QUAD4);
+        
+        libMesh::EquationSystems eq_sys(mesh);
+        libMesh::ExplicitSystem& sys = eq_sys.add_system<libMesh::ExplicitSystem>("level_set");
+        sys.add_variable("phi", libMesh::FEType(libMesh::FIRST, libMesh::LAGRANGE));
+        eq_sys.init();
+        
+        std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>> filter_map;
+        reference_filter_map(sys, radius, filter_map);
+        
+        std::vector<Real> phi(sys.n_dofs(), 0.);
+        std::vector<libMesh::Point> pts(sys.n_dofs());
+        
+        libMesh::MeshBase::const_node_iterator
+        it   = mesh.nodes_begin(),
+        end  = mesh.nodes_end();
+        
+        for ( ; it != end; it++) {
+            const unsigned int dof = (*it)->dof_number(sys.number(), 0, 0);
+            phi[dof] = phi_value(**it);
+            pts[dof] = **it;
+        }
+        
+        std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>>::const_iterator
+        m_it   = filter_map.begin(),
+        m_end  = filter_map.end();
+        
+        for ( ; m_it != m_end; m_it++) {
+            
+            Real v = 0.;
+            for (unsigned int i=0; i<m_it->second.size(); i++)
+                v += phi[m_it->second[i].first] * m_it->second[i].second;
+            ref[point_key(pts[m_it->first])] = v;
+        }
+    }
+    
+    libMesh::DistributedMesh mesh(_mast_init->comm());
+    libMesh::MeshTools::Generation::build_square(mesh, 15, 10,
+                                                 0., 1.5, 0., 1.,
+                                                 libMesh::QUAD4);
+    
+    libMesh::EquationSystems eq_sys(mesh);
+    libMesh::ExplicitSystem& sys = eq_sys.add_system<libMesh::ExplicitSystem>("level_set");
+    sys.add_variable("phi", libMesh::FEType(libMesh::FIRST, libMesh::LAGRANGE));
+    eq_sys.init();
+    
+    std::set<unsigned int> dv_dofs;
+    for (unsigned int i=0; i<sys.n_dofs(); i++)
+        dv_dofs.insert(i);
+    
+    MAST::FilterBase filter(sys, radius, dv_dofs);
+    
+    std::unique_ptr<libMesh::NumericVector<Real>>
+    x    (sys.solution->zero_clone().release()),
+    Bx   (sys.solution->zero_clone().release());
+    
+    std::vector<Real>
+    x_vec  (sys.n_dofs(), 0.),
+    Bx_vec (sys.n_dofs(), 0.);
+    
+    libMesh::MeshBase::const_node_iterator
+    it   = mesh.local_nodes_begin(),
+    end  = mesh.local_nodes_end();
+    
+    for ( ; it != end; it++) {
+        
+        const unsigned int dof = (*it)->dof_number(sys.number(), 0, 0);
+        x_vec[dof] = phi_value(**it);
+        x->set(dof, x_vec[dof]);
+    }
+    x->close();
+    
+    // the serial vectors store all dofs on all processors
+    mesh.comm().sum(x_vec);
+    
+    filter.compute_filtered_values(*x, *Bx);
+    filter.compute_filtered_values(x_vec, Bx_vec);
+    
+    std::vector<Real> Bx_local;
+    Bx->localize(Bx_local);
+    
+    // the parallel product and the serial vector version must match the
+    // pairwise reference at every local node
+    for (it = mesh.local_nodes_begin(); it != end; it++) {
+        
+        const unsigned int dof = (*it)->dof_number(sys.number(), 0, 0);
+        
+        BOOST_REQUIRE(ref.count(point_key(**it)));
+        const Real v = ref[point_key(**it)];
+        
+        BOOST_CHECK_CLOSE(Bx_local[dof], v, 1.e-10);
+        BOOST_CHECK_CLOSE(Bx_vec[dof],   v, 1.e-10);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
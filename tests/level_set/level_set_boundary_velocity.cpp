@@ -0,0 +1,229 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <set>
+#include <vector>
+#include <memory>
+#include <cmath>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "level_set/level_set_boundary_velocity.h"
+#include "level_set/level_set_system_initialization.h"
+#include "base/nonlinear_system.h"
+#include "base/mesh_field_function.h"
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/elem.h"
+#include "libmesh/fe_interface.h"
+
+
+extern libMesh::LibMeshInit* _mast_init;
+
+
+BOOST_AUTO_TEST_SUITE  (LevelSetBoundaryVelocityTests)
+
+BOOST_AUTO_TEST_CASE   (NodalVelocitiesSumToVelocity) {
+    
+    libMesh::ReplicatedMesh mesh(_mast_init->comm());
+    libMesh::MeshTools::Generation::build_square(mesh, 8, 8,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::QUAD4);
+    
+    libMesh::EquationSystems eq_sys(mesh);
+    MAST::NonlinearSystem& sys = eq_sys.add_system<MAST::NonlinearSystem>("level_set");
+    MAST::LevelSetSystemInitialization sys_init(sys,
+                                                sys.name(),
+                                                libMesh::FEType(libMesh::FIRST,
+                                                                libMesh::LAGRANGE));
+    eq_sys.init();
+    
+    std::unique_ptr<libMesh::NumericVector<Real>>
+    dphi(sys.solution->zero_clone().release());
+    
+    // level set of a circle, and an arbitrary perturbation
+    libMesh::MeshBase::const_node_iterator
+    n_it  = mesh.local_nodes_begin(),
+    n_end = mesh.local_nodes_end();
+    
+    for ( ; n_it != n_end; n_it++) {
+        
+        const libMesh::Node& n = **n_it;
+        const libMesh::dof_id_type dof = n.dof_number(sys.number(), 0, 0);
+        
+        sys.solution->set(dof, std::sqrt(std::pow(n(0)-0.45, 2) +
+                                         std::pow(n(1)-0.55, 2)) - 0.3);
+        dphi->set(dof, std::sin(3.*n(0))*std::cos(2.*n(1)));
+    }
+    sys.solution->close();
+    dphi->close();
+    
+    std::vector<Real> dphi_local;
+    dphi->localize(dphi_local);
+    
+    MAST::LevelSetBoundaryVelocity      vel(2);
+    MAST::LevelSetNodalBoundaryVelocity nodal_vel(2);
+    vel.init(sys_init, *sys.solution, *dphi);
+    nodal_vel.init(sys_init, *sys.solution);
+    
+    std::set<libMesh::dof_id_type> dofs;
+    std::vector<libMesh::dof_id_type> elem_dofs;
+    
+    RealVectorX
+    v   = RealVectorX::Zero(2),
+    vj  = RealVectorX::Zero(2),
+    sum = RealVectorX::Zero(2);
+    
+    libMesh::MeshBase::const_element_iterator
+    e_it  = mesh.active_local_elements_begin(),
+    e_end = mesh.active_local_elements_end();
+    
+    for ( ; e_it != e_end; e_it++) {
+        
+        const libMesh::Elem& e = **e_it;
+        
+        // on the level-set mesh, only the dofs of the element are identified
+        nodal_vel.dofs_on_elem(e, dofs);
+        sys.get_dof_map().dof_indices(&e, elem_dofs, 0);
+        BOOST_CHECK(dofs == std::set<libMesh::dof_id_type>(elem_dofs.begin(),
+                                                           elem_dofs.end()));
+        
+        // the velocity is the sum of the nodal velocities weighted by the
+        // perturbation
+        const libMesh::Point
+        p = e.centroid() + 0.3 * (e.point(0) - e.centroid());
+        
+        vel(p, 0., v);
+        
+        sum.setZero();
+        std::set<libMesh::dof_id_type>::const_iterator
+        it  = dofs.begin(),
+        end = dofs.end();
+        
+        for ( ; it != end; it++) {
+            
+            nodal_vel.set_dof(*it);
+            nodal_vel(p, 0., vj);
+            sum += dphi_local[*it] * vj;
+        }
+        
+        for (unsigned int i=0; i<2; i++)
+            BOOST_CHECK_SMALL(v(i) - sum(i), 1.e-8 * (1. + std::fabs(v(i))));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE   (ElementVelocityMatchesMeshFunction) {
+    
+    libMesh::ReplicatedMesh mesh(_mast_init->comm());
+    libMesh::MeshTools::Generation::build_square(mesh, 8, 8,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::QUAD4);
+    
+    libMesh::EquationSystems eq_sys(mesh);
+    MAST::NonlinearSystem& sys = eq_sys.add_system<MAST::NonlinearSystem>("level_set");
+    MAST::LevelSetSystemInitialization sys_init(sys,
+                                                sys.name(),
+                                                libMesh::FEType(libMesh::FIRST,
+                                                                libMesh::LAGRANGE));
+    eq_sys.init();
+    
+    std::unique_ptr<libMesh::NumericVector<Real>>
+    dphi(sys.solution->zero_clone().release());
+    
+    libMesh::MeshBase::const_node_iterator
+    n_it  = mesh.local_nodes_begin(),
+    n_end = mesh.local_nodes_end();
+    
+    for ( ; n_it != n_end; n_it++) {
+        
+        const libMesh::Node& n = **n_it;
+        const libMesh::dof_id_type dof = n.dof_number(sys.number(), 0, 0);
+        
+        sys.solution->set(dof, std::sqrt(std::pow(n(0)-0.45, 2) +
+                                         std::pow(n(1)-0.55, 2)) - 0.3);
+        dphi->set(dof, std::sin(3.*n(0))*std::cos(2.*n(1)));
+    }
+    sys.solution->close();
+    dphi->close();
+    
+    // reference velocity from the interpolation of the serialized vectors
+    MAST::MeshFieldFunction phi(sys_init, "phi");
+    phi.init(*sys.solution, dphi.get());
+    
+    MAST::LevelSetBoundaryVelocity vel(2);
+    vel.init(sys_init, *sys.solution, *dphi);
+    
+    RealVectorX
+    v     = RealVectorX::Zero(2),
+    v_e   = RealVectorX::Zero(2),
+    v_p   = RealVectorX::Zero(2),
+    v_ref = RealVectorX::Zero(2),
+    dval  = RealVectorX::Zero(1);
+    
+    RealMatrixX
+    grad  = RealMatrixX::Zero(1, 2);
+    
+    // only the local elements are checked, since the velocity is
+    // available only on the elements ghosted on this processor
+    libMesh::MeshBase::const_element_iterator
+    e_it  = mesh.active_local_elements_begin(),
+    e_end = mesh.active_local_elements_end();
+    
+    for ( ; e_it != e_end; e_it++) {
+        
+        const libMesh::Elem& e = **e_it;
+        
+        const libMesh::Point
+        p  = e.centroid() + 0.3 * (e.point(0) - e.centroid()),
+        xi = libMesh::FEInterface::inverse_map(2, sys.variable_type(0), &e, p);
+        
+        phi.gradient(p, 0., grad);
+        phi.perturbation(p, 0., dval);
+        v_ref = -dval(0)/grad.row(0).squaredNorm()*grad.row(0).transpose();
+        
+        vel(p, 0., v);
+        vel.velocity(e, xi, 0., v_e);
+        vel.velocity_at_point(e, p, 0., v_p);
+        
+        for (unsigned int i=0; i<2; i++) {
+            
+            BOOST_CHECK_SMALL(v(i)   - v_ref(i), 1.e-8 * (1. + std::fabs(v_ref(i))));
+            BOOST_CHECK_SMALL(v_e(i) - v_ref(i), 1.e-8 * (1. + std::fabs(v_ref(i))));
+            BOOST_CHECK_SMALL(v_p(i) - v_ref(i), 1.e-8 * (1. + std::fabs(v_ref(i))));
+        }
+    }
+    
+    // the velocity is zero outside the level-set mesh
+    vel(libMesh::Point(1.5, 0.5), 0., v);
+    BOOST_CHECK_SMALL(v.norm(), 1.e-12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
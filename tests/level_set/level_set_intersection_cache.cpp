@@ -0,0 +1,152 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <cmath>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "level_set/level_set_intersection.h"
+#include "level_set/level_set_intersection_cache.h"
+#include "base/field_function_base.h"
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/elem.h"
+
+
+extern libMesh::LibMeshInit* _mast_init;
+
+
+namespace MAST {
+    
+    /*!
+     *   level set of a circular hole of radius \p r at \p c
+     */
+    class CircleLevelSet:
+    public MAST::FieldFunction<Real> {
+    public:
+        CircleLevelSet(const libMesh::Point& c, Real r):
+        MAST::FieldFunction<Real>("phi"), _c(c), _r(r) { }
+        
+        virtual void operator() (const libMesh::Point& p,
+                                 const Real t,
+                                 Real& v) const {
+            v = (p-_c).norm() - _r;
+        }
+        
+    protected:
+        libMesh::Point _c;
+        Real           _r;
+    };
+}
+
+
+
+void check_cached_intersections(libMesh::ReplicatedMesh& mesh,
+                                MAST::FieldFunction<Real>& phi,
+                                MAST::LevelSetIntersection& cached) {
+    
+    MAST::LevelSetIntersection direct;
+    
+    libMesh::MeshBase::const_element_iterator
+    it   = mesh.active_local_elements_begin(),
+    end  = mesh.active_local_elements_end();
+    
+    for ( ; it != end; it++) {
+        
+        const libMesh::Elem* elem = *it;
+        
+        direct.init(phi, *elem, 0., mesh.max_elem_id(), mesh.max_node_id());
+        cached.init(phi, *elem, 0., mesh.max_elem_id(), mesh.max_node_id());
+        
+        BOOST_CHECK_EQUAL(direct.get_intersection_mode(),
+                          cached.get_intersection_mode());
+        BOOST_CHECK_EQUAL(direct.if_elem_on_positive_phi(),
+                          cached.if_elem_on_positive_phi());
+        BOOST_CHECK_EQUAL(direct.if_elem_on_negative_phi(),
+                          cached.if_elem_on_negative_phi());
+        BOOST_CHECK_EQUAL(direct.if_elem_has_boundary(),
+                          cached.if_elem_has_boundary());
+        BOOST_CHECK_EQUAL(direct.get_sub_elems_positive_phi().size(),
+                          cached.get_sub_elems_positive_phi().size());
+        BOOST_CHECK_EQUAL(direct.get_sub_elems_negative_phi().size(),
+                          cached.get_sub_elems_negative_phi().size());
+        BOOST_CHECK_CLOSE(direct.get_positive_phi_volume_fraction(),
+                          cached.get_positive_phi_volume_fraction(), 1.e-10);
+        
+        for (unsigned int i=0; i<4; i++)
+            BOOST_CHECK_EQUAL(direct.get_node_phi_value(elem->node_ptr(i)),
+                              cached.get_node_phi_value(elem->node_ptr(i)));
+        
+        direct.clear();
+        cached.clear();
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE  (LevelSetIntersectionCacheTests)
+
+BOOST_AUTO_TEST_CASE   (ComputedOncePerVersion) {
+    
+    libMesh::ReplicatedMesh mesh(_mast_init->comm());
+    libMesh::MeshTools::Generation::build_square(mesh, 10, 10,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::QUAD4);
+    
+    const unsigned int
+    n_elems = mesh.n_active_local_elem();
+    
+    MAST::CircleLevelSet
+    phi1(libMesh::Point(0.5, 0.5, 0.), 0.31),
+    phi2(libMesh::Point(0.4, 0.6, 0.), 0.23);
+    
+    MAST::LevelSetIntersectionCache cache;
+    MAST::LevelSetIntersection      intersection;
+    intersection.attach_cache(cache);
+    
+    // the first pass computes and the second reuses the intersections
+    check_cached_intersections(mesh, phi1, intersection);
+    BOOST_CHECK_EQUAL(cache.n_computed(), n_elems);
+    BOOST_CHECK_EQUAL(cache.n_reused(),   0);
+    
+    check_cached_intersections(mesh, phi1, intersection);
+    BOOST_CHECK_EQUAL(cache.n_computed(), n_elems);
+    BOOST_CHECK_EQUAL(cache.n_reused(),   n_elems);
+    
+    // a new version recomputes all intersections
+    cache.increment_version();
+    check_cached_intersections(mesh, phi1, intersection);
+    BOOST_CHECK_EQUAL(cache.n_computed(), 2*n_elems);
+    
+    // so does a different level set function
+    check_cached_intersections(mesh, phi2, intersection);
+    BOOST_CHECK_EQUAL(cache.n_computed(), 3*n_elems);
+    BOOST_CHECK_EQUAL(cache.n_reused(),   n_elems);
+    
+    intersection.detach_cache();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
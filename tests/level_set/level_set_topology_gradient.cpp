@@ -0,0 +1,435 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+
+// C++ includes
+#include <set>
+#include <vector>
+#include <memory>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "level_set/level_set_topology_gradient.h"
+#include "level_set/level_set_boundary_velocity.h"
+#include "level_set/level_set_nonlinear_implicit_assembly.h"
+#include "level_set/level_set_system_initialization.h"
+#include "level_set/level_set_discipline.h"
+#include "level_set/level_set_volume_output.h"
+#include "level_set/level_set_parameter.h"
+#include "level_set/filter_base.h"
+#include "level_set/interface_dof_handler.h"
+#include "base/nonlinear_system.h"
+#include "base/mesh_field_function.h"
+#include "base/structural_plate_model.h"
+#include "elasticity/structural_nonlinear_assembly.h"
+#include "elasticity/compliance_output.h"
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/elem.h"
+#include "libmesh/point_locator_base.h"
+
+
+extern libMesh::LibMeshInit* _mast_init;
+
+
+/*!
+ *   scalar level-set function interpolated from the level-set solution
+ */
+class PhiMeshFunction:
+public MAST::FieldFunction<Real> {
+public:
+    PhiMeshFunction(MAST::SystemInitialization& sys,
+                    const libMesh::NumericVector<Real>& sol):
+    MAST::FieldFunction<Real>("phi"),
+    _phi(sys, "phi") {
+        _phi.init(sol);
+    }
+    
+    virtual ~PhiMeshFunction() { }
+    
+    virtual void operator() (const libMesh::Point& p, const Real t, Real& v) const {
+        RealVectorX v1;
+        _phi(p, t, v1);
+        v = v1(0);
+    }
+    
+protected:
+    MAST::MeshFieldFunction _phi;
+};
+
+
+BOOST_AUTO_TEST_SUITE  (LevelSetTopologyGradientTests)
+
+BOOST_AUTO_TEST_CASE   (VolumeGradientMatchesPerParameterSensitivity) {
+    
+    libMesh::ReplicatedMesh mesh(_mast_init->comm());
+    libMesh::MeshTools::Generation::build_square(mesh, 12, 12,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::QUAD4);
+    
+    libMesh::EquationSystems eq_sys(mesh);
+    MAST::NonlinearSystem& sys = eq_sys.add_system<MAST::NonlinearSystem>("level_set");
+    MAST::LevelSetSystemInitialization sys_init(sys,
+                                                sys.name(),
+                                                libMesh::FEType(libMesh::FIRST,
+                                                                libMesh::LAGRANGE));
+    MAST::LevelSetDiscipline discipline(eq_sys);
+    eq_sys.init();
+    
+    std::unique_ptr<libMesh::NumericVector<Real>>
+    phi_base(sys.solution->zero_clone().release()),
+    dphi_base(sys.solution->zero_clone().release()),
+    dphi_filtered(sys.solution->zero_clone().release()),
+    dq_ddv(sys.solution->zero_clone().release());
+    
+    // every node is a design variable, and the base level set is a circle
+    std::vector<MAST::LevelSetParameter*> dvs;
+    std::set<unsigned int> dv_dof_ids;
+    
+    libMesh::MeshBase::const_node_iterator
+    n_it  = mesh.nodes_begin(),
+    n_end = mesh.nodes_end();
+    
+    for ( ; n_it != n_end; n_it++) {
+        
+        const libMesh::Node& n = **n_it;
+        const libMesh::dof_id_type dof = n.dof_number(sys.number(), 0, 0);
+        const Real
+        val = std::sqrt(std::pow(n(0)-0.45, 2) + std::pow(n(1)-0.55, 2)) - 0.3;
+        
+        if (dof >= phi_base->first_local_index() &&
+            dof <  phi_base->last_local_index())
+            phi_base->set(dof, val);
+        
+        std::ostringstream oss;
+        oss << "dv_" << dof;
+        
+        MAST::LevelSetParameter* p = new MAST::LevelSetParameter(oss.str(), val, &n);
+        p->set_as_topology_parameter(true);
+        dvs.push_back(p);
+        dv_dof_ids.insert(dof);
+    }
+    phi_base->close();
+    
+    MAST::FilterBase filter(sys, 0.15, dv_dof_ids);
+    filter.compute_filtered_values(*phi_base, *sys.solution);
+    sys.solution->close();
+    
+    PhiMeshFunction phi(sys_init, *sys.solution);
+    MAST::LevelSetBoundaryVelocity vel(2);
+    
+    MAST::LevelSetNonlinearImplicitAssembly assembly(false);
+    assembly.set_discipline_and_system(discipline, sys_init);
+    assembly.set_level_set_function(phi, filter);
+    assembly.set_level_set_velocity_function(vel);
+    assembly.set_evaluate_output_on_negative_phi(false);
+    
+    MAST::LevelSetVolume volume(assembly.get_intersection());
+    volume.set_discipline_and_system(discipline, sys_init);
+    volume.set_participating_elements_to_all();
+    
+    // gradient for all design variables from the single sweep
+    MAST::LevelSetTopologyGradient topology_grad(sys_init, filter);
+    topology_grad.init(*sys.solution);
+    topology_grad.output_gradient(assembly, *sys.solution, volume, *dq_ddv);
+    
+    std::vector<Real> dq_ddv_local;
+    dq_ddv->localize(dq_ddv_local);
+    
+    // the reference is the direct sensitivity for a unit perturbation of
+    // each design variable, filtered and converted to a boundary velocity
+    Real
+    max_grad = 0.;
+    
+    for (unsigned int i=0; i<dvs.size(); i++) {
+        
+        const libMesh::dof_id_type
+        dof = dvs[i]->level_set_node()->dof_number(sys.number(), 0, 0);
+        
+        dphi_base->zero();
+        if (dof >= dphi_base->first_local_index() &&
+            dof <  dphi_base->last_local_index())
+            dphi_base->set(dof, 1.);
+        dphi_base->close();
+        filter.compute_filtered_values(*dphi_base, *dphi_filtered);
+        
+        vel.init(sys_init, *sys.solution, *dphi_filtered);
+        assembly.calculate_output_direct_sensitivity(*sys.solution,
+                                                     dphi_filtered.get(),
+                                                     *dvs[i],
+                                                     volume);
+        
+        const Real
+        dq = volume.output_sensitivity_total(*dvs[i]);
+        
+        max_grad = std::max(max_grad, std::fabs(dq));
+        BOOST_CHECK_SMALL(dq_ddv_local[dof] - dq, 1.e-8 * (1. + std::fabs(dq)));
+    }
+    
+    // the design variables near the boundary change the volume
+    BOOST_CHECK_GT(max_grad, 1.e-4);
+    
+    for (unsigned int i=0; i<dvs.size(); i++)
+        delete dvs[i];
+}
+
+
+BOOST_AUTO_TEST_CASE   (ComplianceAdjointGradientMatchesPerParameterSensitivity) {
+    
+    // clamped plate, and a level-set system on a separate mesh of the same
+    // square, so that the velocity is evaluated on an overlapping mesh
+    const unsigned int
+    n_divs = 8;
+    
+    StructuralPlateModel model(libMesh::QUAD4, n_divs);
+    model.set_solution();
+    
+    libMesh::ReplicatedMesh mesh(_mast_init->comm());
+    libMesh::MeshTools::Generation::build_square(mesh, n_divs, n_divs,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::QUAD4);
+    
+    libMesh::EquationSystems eq_sys(mesh);
+    MAST::NonlinearSystem& sys = eq_sys.add_system<MAST::NonlinearSystem>("level_set");
+    MAST::LevelSetSystemInitialization sys_init(sys,
+                                                sys.name(),
+                                                libMesh::FEType(libMesh::FIRST,
+                                                                libMesh::LAGRANGE));
+    eq_sys.init();
+    
+    std::unique_ptr<libMesh::NumericVector<Real>>
+    phi_base(sys.solution->zero_clone().release()),
+    dphi_base(sys.solution->zero_clone().release()),
+    dphi_filtered(sys.solution->zero_clone().release()),
+    dq_ddv(sys.solution->zero_clone().release()),
+    adjoint(model.sys->solution->zero_clone().release());
+    
+    // the sensitivities are compared for an arbitrary adjoint vector that
+    // is different from the solution
+    for (libMesh::dof_id_type i=adjoint->first_local_index();
+         i<adjoint->last_local_index(); i++)
+        adjoint->set(i, 1.e-4 * std::cos(0.53 * i));
+    adjoint->close();
+    
+    // the void is a circular hole and a slit along the nodes at x=0.625.
+    // The slit nodes have material on both sides, so the elements around
+    // them are factored by the interface dof handler.
+    std::vector<MAST::LevelSetParameter*> dvs;
+    std::set<unsigned int> dv_dof_ids;
+    
+    libMesh::MeshBase::const_node_iterator
+    n_it  = mesh.nodes_begin(),
+    n_end = mesh.nodes_end();
+    
+    for ( ; n_it != n_end; n_it++) {
+        
+        const libMesh::Node& n = **n_it;
+        const libMesh::dof_id_type dof = n.dof_number(sys.number(), 0, 0);
+        const Real
+        circle = std::sqrt(std::pow(n(0)-0.25, 2) + std::pow(n(1)-0.5, 2)) - 0.15,
+        slit   = std::fabs(n(0)-0.625) - 0.05,
+        val    = std::min(circle, slit);
+        
+        if (dof >= phi_base->first_local_index() &&
+            dof <  phi_base->last_local_index())
+            phi_base->set(dof, val);
+        
+        std::ostringstream oss;
+        oss << "dv_" << dof;
+        
+        MAST::LevelSetParameter* p = new MAST::LevelSetParameter(oss.str(), val, &n);
+        p->set_as_topology_parameter(true);
+        dvs.push_back(p);
+        dv_dof_ids.insert(dof);
+    }
+    phi_base->close();
+    
+    MAST::FilterBase filter(sys, 0.15, dv_dof_ids);
+    filter.compute_filtered_values(*phi_base, *sys.solution);
+    sys.solution->close();
+    
+    PhiMeshFunction phi(sys_init, *sys.solution);
+    MAST::LevelSetBoundaryVelocity vel(2);
+    vel.add_evaluation_mesh(sys_init, model.mesh);
+    
+    MAST::LevelSetNonlinearImplicitAssembly assembly(true);
+    assembly.set_discipline_and_system(*model.discipline, *model.structural_sys);
+    assembly.set_level_set_function(phi, filter);
+    assembly.set_level_set_velocity_function(vel);
+    
+    MAST::StructuralNonlinearAssemblyElemOperations ops;
+    ops.set_discipline_and_system(*model.discipline, *model.structural_sys);
+    
+    MAST::ComplianceOutput compliance;
+    compliance.set_participating_elements_to_all();
+    compliance.set_discipline_and_system(*model.discipline, *model.structural_sys);
+    
+    unsigned int
+    n_factored = 0;
+    
+    libMesh::MeshBase::const_element_iterator
+    e_it  = model.mesh.active_local_elements_begin(),
+    e_end = model.mesh.active_local_elements_end();
+    
+    for ( ; e_it != e_end; e_it++)
+        if (assembly.get_dof_handler().if_factor_element(**e_it))
+            n_factored++;
+    
+    model.mesh.comm().sum(n_factored);
+    BOOST_CHECK_GT(n_factored, 0);
+    
+    // gradient for all design variables from the single sweep
+    MAST::LevelSetTopologyGradient topology_grad(sys_init, filter);
+    topology_grad.add_evaluation_mesh(model.mesh);
+    topology_grad.init(*sys.solution);
+    topology_grad.output_adjoint_gradient(assembly,
+                                          *model.sys->solution,
+                                          *adjoint,
+                                          ops,
+                                          compliance,
+                                          *dq_ddv);
+    
+    std::vector<Real> dq_ddv_local;
+    dq_ddv->localize(dq_ddv_local);
+    
+    // the reference is the adjoint sensitivity for a unit perturbation of
+    // each design variable, filtered and converted to a boundary velocity
+    Real
+    max_grad = 0.;
+    
+    for (unsigned int i=0; i<dvs.size(); i++) {
+        
+        const libMesh::dof_id_type
+        dof = dvs[i]->level_set_node()->dof_number(sys.number(), 0, 0);
+        
+        dphi_base->zero();
+        if (dof >= dphi_base->first_local_index() &&
+            dof <  dphi_base->last_local_index())
+            dphi_base->set(dof, 1.);
+        dphi_base->close();
+        filter.compute_filtered_values(*dphi_base, *dphi_filtered);
+        
+        vel.init(sys_init, *sys.solution, *dphi_filtered);
+        
+        const Real
+        dq = assembly.calculate_output_adjoint_sensitivity(*model.sys->solution,
+                                                           *adjoint,
+                                                           *dvs[i],
+                                                           ops,
+                                                           compliance);
+        
+        max_grad = std::max(max_grad, std::fabs(dq));
+        BOOST_CHECK_SMALL(dq_ddv_local[dof] - dq, 1.e-8 * (1. + std::fabs(dq)));
+    }
+    
+    BOOST_CHECK_GT(max_grad, 0.);
+    
+    compliance.clear_discipline_and_system();
+    ops.clear_discipline_and_system();
+    assembly.clear_level_set_velocity_function();
+    assembly.clear_level_set_function();
+    assembly.clear_discipline_and_system();
+    
+    for (unsigned int i=0; i<dvs.size(); i++)
+        delete dvs[i];
+}
+
+
+BOOST_AUTO_TEST_CASE   (DofsOnOverlappingElemCoverSupport) {
+    
+    // fine level-set mesh and a coarse, unaligned analysis mesh, so that
+    // each analysis element overlaps several level-set elements
+    libMesh::ReplicatedMesh
+    mesh(_mast_init->comm()),
+    analysis_mesh(_mast_init->comm());
+    libMesh::MeshTools::Generation::build_square(mesh, 16, 16,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::QUAD4);
+    libMesh::MeshTools::Generation::build_square(analysis_mesh, 5, 5,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::TRI3);
+    
+    libMesh::EquationSystems eq_sys(mesh);
+    MAST::NonlinearSystem& sys = eq_sys.add_system<MAST::NonlinearSystem>("level_set");
+    MAST::LevelSetSystemInitialization sys_init(sys,
+                                                sys.name(),
+                                                libMesh::FEType(libMesh::FIRST,
+                                                                libMesh::LAGRANGE));
+    eq_sys.init();
+    
+    MAST::LevelSetNodalBoundaryVelocity nodal_vel(2);
+    nodal_vel.add_evaluation_mesh(sys_init, analysis_mesh);
+    nodal_vel.init(sys_init, *sys.solution);
+    
+    std::unique_ptr<libMesh::PointLocatorBase>
+    locator(mesh.sub_point_locator());
+    
+    std::set<libMesh::dof_id_type> dofs;
+    std::vector<libMesh::dof_id_type> elem_dofs;
+    
+    const unsigned int
+    n_samples = 10;
+    
+    libMesh::MeshBase::const_element_iterator
+    e_it  = analysis_mesh.active_local_elements_begin(),
+    e_end = analysis_mesh.active_local_elements_end();
+    
+    for ( ; e_it != e_end; e_it++) {
+        
+        const libMesh::Elem& e = **e_it;
+        
+        nodal_vel.dofs_on_elem(e, dofs);
+        
+        // the level-set elements found at interior points of the triangle
+        // have basis functions that are nonzero on the element
+        for (unsigned int i=1; i<n_samples; i++)
+            for (unsigned int j=1; i+j<n_samples; j++) {
+                
+                const Real
+                a = (1.*i)/n_samples,
+                b = (1.*j)/n_samples;
+                
+                const libMesh::Point
+                p = (1.-a-b) * e.point(0) + a * e.point(1) + b * e.point(2);
+                
+                const libMesh::Elem* ls_elem = (*locator)(p);
+                BOOST_REQUIRE(ls_elem);
+                
+                sys.get_dof_map().dof_indices(ls_elem, elem_dofs, 0);
+                
+                for (unsigned int k=0; k<elem_dofs.size(); k++)
+                    BOOST_CHECK(dofs.count(elem_dofs[k]));
+            }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
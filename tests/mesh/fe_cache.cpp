@@ -0,0 +1,123 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <memory>
+#include <vector>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "base/structural_plate_model.h"
+#include "mesh/fe_cache.h"
+#include "mesh/fe_base.h"
+#include "mesh/geom_elem.h"
+
+// libMesh includes
+#include "libmesh/threads.h"
+#include "libmesh/elem.h"
+
+
+/*!
+ *   requests the finite element data of each element from the cache and
+ *   stores the integrated area. Each element is visited several times, so
+ *   that threads look up entries created by other threads.
+ */
+class FECacheLookup {
+public:
+    
+    FECacheLookup(const std::vector<std::unique_ptr<MAST::GeomElem> >& elems,
+                  std::vector<Real>& area):
+    _elems (elems),
+    _area  (area) { }
+    
+    void operator() (const libMesh::Threads::BlockedRange<std::size_t>& range) const {
+        
+        for (std::size_t i=range.begin(); i<range.end(); i++) {
+            
+            const std::size_t
+            e = i % _elems.size();
+            
+            std::unique_ptr<MAST::FEBase>
+            fe(_elems[e]->init_fe(true, false, 0));
+            
+            const std::vector<Real>& JxW = fe->get_JxW();
+            
+            Real a = 0.;
+            for (unsigned int qp=0; qp<JxW.size(); qp++)
+                a += JxW[qp];
+            
+            // each thread writes only the entries of its range
+            _area[i] = a;
+        }
+    }
+    
+protected:
+    
+    const std::vector<std::unique_ptr<MAST::GeomElem> >& _elems;
+    std::vector<Real>&                                   _area;
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (FECacheTests, StructuralPlateModel)
+
+BOOST_AUTO_TEST_CASE   (ConcurrentLookups) {
+    
+    sys->set_use_fe_cache(true);
+    MAST::FECache& cache = *sys->fe_cache();
+    
+    std::vector<std::unique_ptr<MAST::GeomElem> > elems;
+    
+    libMesh::MeshBase::const_element_iterator
+    it  = mesh.active_local_elements_begin(),
+    end = mesh.active_local_elements_end();
+    
+    for ( ; it != end; it++) {
+        
+        elems.push_back(std::unique_ptr<MAST::GeomElem>(new MAST::GeomElem));
+        elems.back()->init(**it, *structural_sys);
+    }
+    
+    const unsigned int
+    n_passes = 4;
+    
+    std::vector<Real>
+    area(n_passes * elems.size(), 0.);
+    
+    libMesh::Threads::parallel_for
+    (libMesh::Threads::BlockedRange<std::size_t>(0, area.size(), 4),
+     FECacheLookup(elems, area));
+    
+    // one entry is created per element irrespective of the number of
+    // threads that requested it
+    BOOST_CHECK_EQUAL(cache.size(), elems.size());
+    
+    for (unsigned int i=0; i<area.size(); i++)
+        BOOST_CHECK_CLOSE(area[i],
+                          elems[i % elems.size()]->get_reference_elem().volume(),
+                          1.e-10);
+    
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,197 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE MAST_TESTS
+#include <boost/test/unit_test.hpp>
+
+// C++ includes
+#include <chrono>
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "numerics/fem_operator_matrix.h"
+
+// Test includes
+#include "base/test_comparisons.h"
+
+
+/*!
+ *   Block-pointer storage that was used by MAST::FEMOperatorMatrix before
+ *   the shape functions were moved to a contiguous buffer. This is retained
+ *   here only as a reference for the accuracy and timing comparisons.
+ */
+class LegacyFEMOperatorMatrix {
+    
+public:
+    
+    LegacyFEMOperatorMatrix():
+    _n_interpolated_vars(0), _n_discrete_vars(0), _n_dofs_per_var(0) { }
+    
+    ~LegacyFEMOperatorMatrix() { this->clear(); }
+    
+    unsigned int n() const {return _n_discrete_vars*_n_dofs_per_var;}
+    
+    void clear() {
+        
+        for (unsigned int i=0; i<_var_shape_functions.size(); i++)
+            if (_var_shape_functions[i]) delete _var_shape_functions[i];
+        _var_shape_functions.clear();
+    }
+    
+    void reinit(unsigned int n_interpolated_vars,
+                unsigned int n_discrete_vars,
+                unsigned int n_discrete_dofs_per_var) {
+        
+        this->clear();
+        _n_interpolated_vars = n_interpolated_vars;
+        _n_discrete_vars     = n_discrete_vars;
+        _n_dofs_per_var      = n_discrete_dofs_per_var;
+        _var_shape_functions.resize(_n_interpolated_vars*_n_discrete_vars, nullptr);
+    }
+    
+    void set_shape_function(unsigned int interpolated_var,
+                            unsigned int discrete_var,
+                            const RealVectorX& shape_func) {
+        
+        RealVectorX*&
+        vec = _var_shape_functions[discrete_var*_n_interpolated_vars+interpolated_var];
+        if (!vec) vec = new RealVectorX;
+        *vec = shape_func;
+    }
+    
+    void right_multiply_transpose(RealMatrixX& r, const RealMatrixX& m) const {
+        
+        r.setZero(r.rows(), r.cols());
+        for (unsigned int i=0; i<_n_interpolated_vars; i++)
+            for (unsigned int j=0; j<_n_discrete_vars; j++) {
+                const RealVectorX* v = _var_shape_functions[j*_n_interpolated_vars+i];
+                if (v)
+                    for (unsigned int l=0; l<m.cols(); l++)
+                        for (unsigned int k=0; k<_n_dofs_per_var; k++)
+                            r(j*_n_dofs_per_var+k,l) += (*v)(k) * m(i,l);
+            }
+    }
+    
+    void left_multiply(RealMatrixX& r, const RealMatrixX& m) const {
+        
+        r.setZero(r.rows(), r.cols());
+        for (unsigned int i=0; i<_n_interpolated_vars; i++)
+            for (unsigned int j=0; j<_n_discrete_vars; j++) {
+                const RealVectorX* v = _var_shape_functions[j*_n_interpolated_vars+i];
+                if (v)
+                    for (unsigned int l=0; l<m.rows(); l++)
+                        for (unsigned int k=0; k<_n_dofs_per_var; k++)
+                            r(l,j*_n_dofs_per_var+k) += (*v)(k) * m(l,i);
+            }
+    }
+    
+protected:
+    
+    unsigned int _n_interpolated_vars, _n_discrete_vars, _n_dofs_per_var;
+    std::vector<RealVectorX*> _var_shape_functions;
+};
+
+
+
+/*!
+ *   initializes the membrane strain operator of a 2D structural element
+ *   with \p n_phi shape functions, which has the same sparsity as the
+ *   operators used in the element quadrature loops.
+ */
+template <typename OpType>
+void init_membrane_operator(OpType& B,
+                            const RealVectorX& dphidx,
+                            const RealVectorX& dphidy) {
+    
+    B.reinit(3, 6, (unsigned int)dphidx.size());
+    B.set_shape_function(0, 0, dphidx);
+    B.set_shape_function(1, 1, dphidy);
+    B.set_shape_function(2, 0, dphidy);
+    B.set_shape_function(2, 1, dphidx);
+}
+
+
+BOOST_AUTO_TEST_SUITE  (FEMOperatorMatrixBenchmark)
+
+
+BOOST_AUTO_TEST_CASE   (BTDBBenchmark) {
+    
+    // operator size and number of evaluations corresponding to the
+    // quadrature loop of a 2D structural element with QUAD9 shape functions
+    const unsigned int
+    n_phi  = 9,
+    n_eval = 100000;
+    
+    RealVectorX
+    dphidx = RealVectorX::Random(n_phi),
+    dphidy = RealVectorX::Random(n_phi);
+    
+    RealMatrixX
+    D      = RealMatrixX::Random(3, 3),
+    DB     = RealMatrixX::Zero(3, 6*n_phi),
+    BtDB   = RealMatrixX::Zero(6*n_phi, 6*n_phi),
+    sum    = RealMatrixX::Zero(6*n_phi, 6*n_phi),
+    sum0   = RealMatrixX::Zero(6*n_phi, 6*n_phi);
+    
+    MAST::FEMOperatorMatrix B;
+    LegacyFEMOperatorMatrix B0;
+    
+    std::chrono::high_resolution_clock::time_point
+    t0 = std::chrono::high_resolution_clock::now();
+    
+    for (unsigned int i=0; i<n_eval; i++) {
+        
+        init_membrane_operator(B0, dphidx, dphidy);
+        B0.left_multiply(DB, D);
+        B0.right_multiply_transpose(BtDB, DB);
+        sum0 += BtDB;
+    }
+    
+    std::chrono::high_resolution_clock::time_point
+    t1 = std::chrono::high_resolution_clock::now();
+    
+    for (unsigned int i=0; i<n_eval; i++) {
+        
+        init_membrane_operator(B, dphidx, dphidy);
+        B.left_multiply(DB, D);
+        B.right_multiply_transpose(BtDB, DB);
+        sum += BtDB;
+    }
+    
+    std::chrono::high_resolution_clock::time_point
+    t2 = std::chrono::high_resolution_clock::now();
+    
+    const Real
+    dt_legacy = std::chrono::duration<Real>(t1-t0).count(),
+    dt_new    = std::chrono::duration<Real>(t2-t1).count();
+    
+    BOOST_TEST_MESSAGE("B^T D B evaluations : " << n_eval);
+    BOOST_TEST_MESSAGE("  legacy storage (s): " << dt_legacy);
+    BOOST_TEST_MESSAGE("  flat storage   (s): " << dt_new);
+    BOOST_TEST_MESSAGE("  speedup           : " << dt_legacy/dt_new);
+    
+    BOOST_CHECK(MAST::compare_matrix(sum0, sum, 1.e-10));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
+
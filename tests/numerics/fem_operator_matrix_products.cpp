@@ -0,0 +1,103 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "numerics/fem_operator_matrix.h"
+
+// Test includes
+#include "base/test_comparisons.h"
+
+
+/*!
+ *   initializes the membrane strain operator of a 2D structural element
+ *   with \p n_phi shape functions, which has the same sparsity as the
+ *   operators used in the element quadrature loops.
+ */
+template <typename OpType>
+void init_membrane_operator(OpType& B,
+                            const RealVectorX& dphidx,
+                            const RealVectorX& dphidy) {
+    
+    B.reinit(3, 6, (unsigned int)dphidx.size());
+    B.set_shape_function(0, 0, dphidx);
+    B.set_shape_function(1, 1, dphidy);
+    B.set_shape_function(2, 0, dphidy);
+    B.set_shape_function(2, 1, dphidx);
+}
+
+
+BOOST_AUTO_TEST_SUITE  (FEMOperatorMatrixTests)
+
+
+BOOST_AUTO_TEST_CASE   (BTDBAgainstDenseMatrix) {
+    
+    const unsigned int
+    n_phi = 9;
+    
+    RealVectorX
+    dphidx = RealVectorX::Random(n_phi),
+    dphidy = RealVectorX::Random(n_phi);
+    
+    RealMatrixX
+    D      = RealMatrixX::Random(3, 3),
+    Bdense = RealMatrixX::Zero(3, 6*n_phi),
+    DB     = RealMatrixX::Zero(3, 6*n_phi),
+    BtDB   = RealMatrixX::Zero(6*n_phi, 6*n_phi),
+    BtB    = RealMatrixX::Zero(6*n_phi, 6*n_phi);
+    
+    Bdense.block(0,     0, 1, n_phi) = dphidx.transpose();
+    Bdense.block(1, n_phi, 1, n_phi) = dphidy.transpose();
+    Bdense.block(2,     0, 1, n_phi) = dphidy.transpose();
+    Bdense.block(2, n_phi, 1, n_phi) = dphidx.transpose();
+    
+    MAST::FEMOperatorMatrix B;
+    init_membrane_operator(B, dphidx, dphidy);
+    
+    // reinit with unchanged dimensions should retain the values that
+    // are set again
+    init_membrane_operator(B, dphidx, dphidy);
+    
+    B.left_multiply(DB, D);
+    B.right_multiply_transpose(BtDB, DB);
+    B.right_multiply_transpose(BtB, B);
+    
+    BOOST_CHECK(MAST::compare_matrix(D*Bdense, DB, 1.e-12));
+    BOOST_CHECK(MAST::compare_matrix(Bdense.transpose()*D*Bdense, BtDB, 1.e-12));
+    BOOST_CHECK(MAST::compare_matrix(Bdense.transpose()*Bdense, BtB, 1.e-12));
+    
+    RealVectorX
+    v     = RealVectorX::Random(6*n_phi),
+    Bv    = RealVectorX::Zero(3),
+    w     = RealVectorX::Random(3),
+    Btw   = RealVectorX::Zero(6*n_phi);
+    
+    B.vector_mult(Bv, v);
+    B.vector_mult_transpose(Btw, w);
+    
+    BOOST_CHECK(MAST::compare_vector(Bdense*v, Bv, 1.e-12));
+    BOOST_CHECK(MAST::compare_vector(Bdense.transpose()*w, Btw, 1.e-12));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,294 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_test_coupled_heat_conduction_model_h__
+#define __mast_test_coupled_heat_conduction_model_h__
+
+// C++ includes
+#include <vector>
+#include <memory>
+
+// MAST includes
+#include "solver/transient_heat_conduction_model.h"
+#include "solver/first_order_newmark_transient_solver.h"
+#include "solver/multiphysics_nonlinear_solver.h"
+#include "base/elem_base.h"
+#include "mesh/geom_elem.h"
+
+// libMesh includes
+#include "libmesh/elem.h"
+#include "libmesh/dof_map.h"
+
+
+/*!
+ *   heat conduction element operations with a volumetric heat exchange
+ *   with the temperature of a second system on an identical mesh. The
+ *   residual of this system includes \f$ -c \int T_o \f$, evaluated with
+ *   a lumped mass on each element, where \f$ T_o \f$ is the temperature
+ *   of the other system. The coupling Jacobian is provided to the
+ *   multiphysics solver unless \p if_coupling_jacobian is \p false.
+ */
+class CoupledHeatConductionElemOperations:
+public MAST::HeatConductionTransientAssemblyElemOperations {
+    
+public:
+    
+    CoupledHeatConductionElemOperations():
+    MAST::HeatConductionTransientAssemblyElemOperations(),
+    coupling             (0.),
+    if_coupling_jacobian (true),
+    other_sys            (nullptr),
+    other_sol            (nullptr),
+    other_dsol           (nullptr) { }
+    
+    
+    using MAST::HeatConductionTransientAssemblyElemOperations::elem_calculations;
+    
+    virtual void elem_calculations(bool if_jac,
+                                   RealVectorX& f_m,
+                                   RealVectorX& f_x,
+                                   RealMatrixX& f_m_jac_xdot,
+                                   RealMatrixX& f_m_jac,
+                                   RealMatrixX& f_x_jac) {
+        
+        MAST::HeatConductionTransientAssemblyElemOperations::elem_calculations
+        (if_jac, f_m, f_x, f_m_jac_xdot, f_m_jac, f_x_jac);
+        
+        libmesh_assert(other_sol);
+        f_x -= _coupling_factor() * _other_values(*other_sol);
+    }
+    
+    
+    /*!
+     *   only the product with the perturbation in the other system is
+     *   computed, since the multiphysics solver uses this only for the
+     *   off-diagonal blocks.
+     */
+    virtual void
+    linearized_jacobian_solution_product(RealVectorX& f) {
+        
+        libmesh_assert(other_dsol);
+        f = -_coupling_factor() * _other_values(*other_dsol);
+    }
+    
+    
+    /*!
+     *   the residual depends on the dofs of the other system on the element
+     *   with the same id
+     */
+    virtual bool
+    elem_coupling_dofs(unsigned int j,
+                       const libMesh::Elem& elem,
+                       std::vector<libMesh::dof_id_type>& dofs) const {
+        
+        libmesh_assert(other_sys);
+        
+        other_sys->get_dof_map().dof_indices(other_sys->get_mesh().elem_ptr(elem.id()),
+                                             dofs);
+        
+        return if_coupling_jacobian;
+    }
+    
+    
+    virtual void
+    elem_coupling_jacobian(unsigned int j,
+                           RealMatrixX& m) {
+        
+        libmesh_assert_equal_to(m.rows(), m.cols());
+        m = -_coupling_factor() * RealMatrixX::Identity(m.rows(), m.cols());
+    }
+    
+    
+    Real                          coupling;
+    bool                          if_coupling_jacobian;
+    const MAST::NonlinearSystem  *other_sys;
+    const std::vector<Real>      *other_sol;
+    const std::vector<Real>      *other_dsol;
+    
+protected:
+    
+    Real _coupling_factor() const {
+        
+        const libMesh::Elem&
+        e = _physics_elem->elem().get_reference_elem();
+        
+        return coupling * e.volume() / e.n_nodes();
+    }
+    
+    
+    RealVectorX _other_values(const std::vector<Real>& v) const {
+        
+        std::vector<libMesh::dof_id_type> dofs;
+        this->elem_coupling_dofs(0, _physics_elem->elem().get_reference_elem(), dofs);
+        
+        RealVectorX
+        x = RealVectorX::Zero(dofs.size());
+        for (unsigned int i=0; i<dofs.size(); i++)
+            x(i) = v[dofs[i]];
+        
+        return x;
+    }
+};
+
+
+
+/*!
+ *   provides the solution of each system, and its perturbation, to the
+ *   element operations of the other system
+ */
+class CoupledHeatConductionUpdate:
+public MAST::MultiphysicsNonlinearSolverBase::PreResidualUpdate {
+    
+public:
+    
+    CoupledHeatConductionUpdate(CoupledHeatConductionElemOperations& ops_0,
+                                CoupledHeatConductionElemOperations& ops_1) {
+        
+        _ops[0] = &ops_0;
+        _ops[1] = &ops_1;
+    }
+    
+    
+    virtual void
+    update_at_solution(std::vector<libMesh::NumericVector<Real>*>&  sol_vecs) {
+        
+        for (unsigned int i=0; i<2; i++) {
+            
+            sol_vecs[i]->localize(_sol[i]);
+            _ops[i]->other_sol = &_sol[1-i];
+        }
+    }
+    
+    
+    virtual void
+    update_at_perturbed_solution(std::vector<libMesh::NumericVector<Real>*>&   sol_vecs,
+                                 std::vector<libMesh::NumericVector<Real>*>&  dsol_vecs) {
+        
+        this->update_at_solution(sol_vecs);
+        
+        for (unsigned int i=0; i<2; i++) {
+            
+            dsol_vecs[i]->localize(_dsol[i]);
+            _ops[i]->other_dsol = &_dsol[1-i];
+        }
+    }
+    
+protected:
+    
+    CoupledHeatConductionElemOperations*  _ops[2];
+    std::vector<Real>                     _sol[2], _dsol[2];
+};
+
+
+
+/*!
+ *   two transient heat conduction problems on identical meshes, coupled
+ *   through a volumetric heat exchange, for tests of the multiphysics
+ *   solver. The second system has twice the conductivity of the first.
+ */
+struct CoupledHeatConductionModel {
+    
+    CoupledHeatConductionModel(unsigned int n_divs = 6,
+                               Real         c      = 5.,
+                               Real         dt     = 0.01):
+    update   (elem_ops[0], elem_ops[1]) {
+        
+        for (unsigned int i=0; i<2; i++)
+            model[i].reset(new TransientHeatConductionModel(n_divs));
+        model[1]->k = 2.;
+        
+        for (unsigned int i=0; i<2; i++) {
+            
+            elem_ops[i].coupling  = c;
+            elem_ops[i].other_sys = model[1-i]->sys;
+            solver[i].dt          = dt;
+        }
+        
+        this->attach();
+    }
+    
+    
+    ~CoupledHeatConductionModel() {
+        
+        this->detach();
+    }
+    
+    
+    /*!
+     *   attaches the systems and sets the solutions, the stored transient
+     *   data and the time to zero
+     */
+    void attach() {
+        
+        for (unsigned int i=0; i<2; i++) {
+            
+            model[i]->attach(assembly[i], elem_ops[i], solver[i]);
+            model[i]->sys->time = 0.;
+        }
+    }
+    
+    
+    void detach() {
+        
+        for (unsigned int i=0; i<2; i++)
+            model[i]->detach(assembly[i], elem_ops[i], solver[i]);
+    }
+    
+    
+    /*!
+     *   restores the initial state
+     */
+    void reset() {
+        
+        this->detach();
+        this->attach();
+    }
+    
+    
+    /*!
+     *   sets the disciplines of \p s
+     */
+    void init_multiphysics_solver(MAST::MultiphysicsNonlinearSolverBase& s) {
+        
+        s.set_pre_residual_update_object(update);
+        for (unsigned int i=0; i<2; i++)
+            s.set_system_assembly(i, assembly[i]);
+    }
+    
+    
+    /*!
+     *   advances both systems to the next time step
+     */
+    void advance_time_step() {
+        
+        for (unsigned int i=0; i<2; i++)
+            solver[i].advance_time_step();
+    }
+    
+    
+    std::unique_ptr<TransientHeatConductionModel>   model[2];
+    MAST::TransientAssembly                         assembly[2];
+    CoupledHeatConductionElemOperations             elem_ops[2];
+    MAST::FirstOrderNewmarkTransientSolver          solver[2];
+    CoupledHeatConductionUpdate                     update;
+};
+
+
+#endif // __mast_test_coupled_heat_conduction_model_h__
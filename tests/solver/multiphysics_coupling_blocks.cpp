@@ -0,0 +1,237 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <vector>
+#include <memory>
+#include <cmath>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "solver/coupled_heat_conduction_model.h"
+
+// PETSc includes
+#include <petscsnes.h>
+
+
+/*!
+ *   provides access to the shell and assembled coupling blocks
+ */
+class CouplingBlockSolverAccess:
+public MAST::MultiphysicsNonlinearSolverBase {
+    
+public:
+    
+    CouplingBlockSolverAccess():
+    MAST::MultiphysicsNonlinearSolverBase(_mast_init->comm(), "coupled", 2) { }
+    
+    Mat shell_block(unsigned int i, unsigned int j) {
+        
+        return _sub_mats[i*_n_disciplines+j];
+    }
+    
+    Mat assembled_block(unsigned int i, unsigned int j) {
+        
+        return _coupling_mats[i*_n_disciplines+j];
+    }
+    
+    PetscInt n_nonlinear_iterations() {
+        
+        PetscInt n = 0;
+        SNESGetIterationNumber(_snes, &n);
+        return n;
+    }
+    
+    PetscInt n_linear_iterations() {
+        
+        PetscInt n = 0;
+        SNESGetLinearSolveIterations(_snes, &n);
+        return n;
+    }
+};
+
+
+
+struct MultiphysicsCouplingBlockFixture:
+public CoupledHeatConductionModel {
+    
+    MultiphysicsCouplingBlockFixture():
+    CoupledHeatConductionModel() {
+        
+        // the nested matrix is preconditioned by its diagonal blocks
+        PetscOptionsSetValue(nullptr, "-pc_type", "fieldsplit");
+    }
+    
+    ~MultiphysicsCouplingBlockFixture() {
+        
+        PetscOptionsClearValue(nullptr, "-pc_type");
+    }
+    
+    
+    /*!
+     *   solves one time step with coupling blocks of type \p t, and returns
+     *   the iteration counts and the solutions
+     */
+    void
+    solve_step(MAST::MultiphysicsNonlinearSolverBase::CouplingBlockType t,
+               PetscInt& n_its,
+               PetscInt& n_lin_its,
+               std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >& sols) {
+        
+        reset();
+        
+        CouplingBlockSolverAccess s;
+        init_multiphysics_solver(s);
+        s.set_coupling_block_type(t);
+        s.solve();
+        
+        n_its     = s.n_nonlinear_iterations();
+        n_lin_its = s.n_linear_iterations();
+        
+        sols.clear();
+        for (unsigned int i=0; i<2; i++)
+            sols.push_back(model[i]->solution_copy());
+    }
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (MultiphysicsCouplingBlockTests,
+                           MultiphysicsCouplingBlockFixture)
+
+BOOST_AUTO_TEST_CASE   (AssembledBlockMatchesShellProduct) {
+    
+    CouplingBlockSolverAccess s;
+    init_multiphysics_solver(s);
+    s.set_coupling_block_type(MAST::MultiphysicsNonlinearSolverBase::ASSEMBLED);
+    s.solve();
+    
+    PetscErrorCode ierr;
+    
+    for (unsigned int i=0; i<2; i++) {
+        
+        const unsigned int
+        j = 1-i;
+        
+        BOOST_CHECK(s.if_coupling_block_assembled(i, j));
+        BOOST_REQUIRE(s.assembled_block(i, j));
+        
+        // the shell product modifies the constrained entries of its
+        // argument, so each product uses its own copy
+        Vec  x, x_copy, y_shell, y_assembled;
+        ierr = MatCreateVecs(s.shell_block(i, j), &x, &y_shell);  CHKERRABORT(_mast_init->comm().get(), ierr);
+        ierr = VecDuplicate(x, &x_copy);                           CHKERRABORT(_mast_init->comm().get(), ierr);
+        ierr = VecDuplicate(y_shell, &y_assembled);                CHKERRABORT(_mast_init->comm().get(), ierr);
+        ierr = VecSetRandom(x, PETSC_NULL);                        CHKERRABORT(_mast_init->comm().get(), ierr);
+        ierr = VecCopy(x, x_copy);                                 CHKERRABORT(_mast_init->comm().get(), ierr);
+        
+        ierr = MatMult(s.assembled_block(i, j), x, y_assembled);   CHKERRABORT(_mast_init->comm().get(), ierr);
+        ierr = MatMult(s.shell_block(i, j), x_copy, y_shell);      CHKERRABORT(_mast_init->comm().get(), ierr);
+        
+        PetscReal
+        y_norm    = 0.,
+        diff_norm = 0.;
+        ierr = VecNorm(y_shell, NORM_2, &y_norm);                  CHKERRABORT(_mast_init->comm().get(), ierr);
+        ierr = VecAXPY(y_assembled, -1., y_shell);                 CHKERRABORT(_mast_init->comm().get(), ierr);
+        ierr = VecNorm(y_assembled, NORM_2, &diff_norm);           CHKERRABORT(_mast_init->comm().get(), ierr);
+        
+        BOOST_CHECK_GT(y_norm, 0.);
+        BOOST_CHECK_SMALL(diff_norm/y_norm, 1.e-12);
+        
+        VecDestroy(&x);
+        VecDestroy(&x_copy);
+        VecDestroy(&y_shell);
+        VecDestroy(&y_assembled);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE   (AssembledBlocksKeepGMRESIterations) {
+    
+    PetscInt
+    n_its[2],
+    n_lin_its[2];
+    
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >
+    sols[2];
+    
+    solve_step(MAST::MultiphysicsNonlinearSolverBase::MATRIX_FREE,
+               n_its[0], n_lin_its[0], sols[0]);
+    solve_step(MAST::MultiphysicsNonlinearSolverBase::ASSEMBLED,
+               n_its[1], n_lin_its[1], sols[1]);
+    
+    // the block-preconditioned GMRES sees the same operator
+    BOOST_CHECK_GT(n_lin_its[0], 0);
+    BOOST_CHECK_EQUAL(n_its[0],     n_its[1]);
+    BOOST_CHECK_EQUAL(n_lin_its[0], n_lin_its[1]);
+    
+    for (unsigned int i=0; i<2; i++) {
+        
+        std::unique_ptr<libMesh::NumericVector<Real> >
+        diff(sols[1][i]->clone());
+        diff->add(-1., *sols[0][i]);
+        
+        BOOST_CHECK_SMALL(diff->l2_norm()/sols[0][i]->l2_norm(), 1.e-8);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE   (AutomaticChoiceFollowsSparsity) {
+    
+    // each coupling block has the element pattern without the columns of
+    // the constrained dofs, and about 60% of the nonzeros of the diagonal
+    // block
+    {
+        reset();
+        
+        CouplingBlockSolverAccess s;
+        init_multiphysics_solver(s);
+        s.set_coupling_block_type(MAST::MultiphysicsNonlinearSolverBase::AUTOMATIC);
+        s.set_max_coupling_nnz_fraction(0.3);
+        s.solve();
+        
+        BOOST_CHECK(!s.if_coupling_block_assembled(0, 1));
+        BOOST_CHECK(!s.if_coupling_block_assembled(1, 0));
+    }
+    
+    // the block whose element operations do not provide the coupling
+    // Jacobian is applied matrix-free
+    {
+        reset();
+        elem_ops[1].if_coupling_jacobian = false;
+        
+        CouplingBlockSolverAccess s;
+        init_multiphysics_solver(s);
+        s.set_coupling_block_type(MAST::MultiphysicsNonlinearSolverBase::AUTOMATIC);
+        s.set_max_coupling_nnz_fraction(1.);
+        s.solve();
+        
+        BOOST_CHECK( s.if_coupling_block_assembled(0, 1));
+        BOOST_CHECK(!s.if_coupling_block_assembled(1, 0));
+        BOOST_CHECK(!s.assembled_block(1, 0));
+        
+        elem_ops[1].if_coupling_jacobian = true;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
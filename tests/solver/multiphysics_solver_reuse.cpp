@@ -0,0 +1,215 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <vector>
+#include <memory>
+#include <cmath>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "solver/coupled_heat_conduction_model.h"
+
+// PETSc includes
+#include <petscsnes.h>
+
+
+/*!
+ *   provides access to the PETSc objects kept by the solver
+ */
+class MultiphysicsSolverAccess:
+public MAST::MultiphysicsNonlinearSolverBase {
+    
+public:
+    
+    MultiphysicsSolverAccess():
+    MAST::MultiphysicsNonlinearSolverBase(_mast_init->comm(), "coupled", 2) { }
+    
+    SNES snes() { return _snes; }
+    
+    /*!
+     *   @returns the sub-solvers of the field-split preconditioner
+     */
+    std::vector<KSP> sub_ksps() {
+        
+        KSP       ksp;
+        PC        pc;
+        PetscInt  n   = 0;
+        KSP      *sub = nullptr;
+        
+        SNESGetKSP(_snes, &ksp);
+        KSPGetPC(ksp, &pc);
+        PCFieldSplitGetSubKSP(pc, &n, &sub);
+        
+        std::vector<KSP> v(sub, sub+n);
+        PetscFree(sub);
+        
+        return v;
+    }
+    
+    /*!
+     *   @returns the operator of the sub-solver \p ksp
+     */
+    static Mat sub_operator(KSP ksp) {
+        
+        Mat A, P;
+        KSPGetOperators(ksp, &A, &P);
+        return A;
+    }
+    
+    PetscInt n_nonlinear_iterations() {
+        
+        PetscInt n = 0;
+        SNESGetIterationNumber(_snes, &n);
+        return n;
+    }
+    
+    PetscInt n_linear_iterations() {
+        
+        PetscInt n = 0;
+        SNESGetLinearSolveIterations(_snes, &n);
+        return n;
+    }
+};
+
+
+
+struct MultiphysicsSolverReuseFixture:
+public CoupledHeatConductionModel {
+    
+    MultiphysicsSolverReuseFixture():
+    CoupledHeatConductionModel() {
+        
+        // the nested matrix is preconditioned by its diagonal blocks
+        PetscOptionsSetValue(nullptr, "-pc_type", "fieldsplit");
+    }
+    
+    ~MultiphysicsSolverReuseFixture() {
+        
+        PetscOptionsClearValue(nullptr, "-pc_type");
+    }
+    
+    
+    /*!
+     *   @returns the norm of the difference of the solutions of both systems
+     *   and \p sols relative to the norm of \p sols
+     */
+    Real rel_diff(const std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >& sols) {
+        
+        Real
+        d  = 0.,
+        n  = 0.;
+        
+        for (unsigned int i=0; i<2; i++) {
+            
+            std::unique_ptr<libMesh::NumericVector<Real> >
+            diff(model[i]->solution_copy());
+            diff->add(-1., *sols[i]);
+            
+            d += std::pow(diff->l2_norm(),    2);
+            n += std::pow(sols[i]->l2_norm(), 2);
+        }
+        
+        return std::sqrt(d/n);
+    }
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (MultiphysicsSolverReuseTests,
+                           MultiphysicsSolverReuseFixture)
+
+BOOST_AUTO_TEST_CASE   (SecondSolveReusesPetscObjects) {
+    
+    SNES              snes[2];
+    Mat               mat[2];
+    std::vector<KSP>  ksps[2];
+    std::vector<Mat>  ksp_mats[2];
+    PetscInt          n_its[2], n_lin_its[2];
+    
+    // two time steps with the objects kept between the solves
+    {
+        MultiphysicsSolverAccess s;
+        init_multiphysics_solver(s);
+        
+        for (unsigned int i=0; i<2; i++) {
+            
+            s.solve();
+            
+            snes[i]      = s.snes();
+            mat[i]       = s.mat();
+            ksps[i]      = s.sub_ksps();
+            n_its[i]     = s.n_nonlinear_iterations();
+            n_lin_its[i] = s.n_linear_iterations();
+            for (unsigned int j=0; j<ksps[i].size(); j++)
+                ksp_mats[i].push_back(MultiphysicsSolverAccess::sub_operator(ksps[i][j]));
+            
+            advance_time_step();
+        }
+    }
+    
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > > sols;
+    for (unsigned int i=0; i<2; i++)
+        sols.push_back(model[i]->solution_copy());
+    
+    // the second solve uses the same solver, nested matrix and field-split
+    // sub-solvers, which operate on the same diagonal blocks
+    BOOST_CHECK(snes[0] == snes[1]);
+    BOOST_CHECK(mat[0]  == mat[1]);
+    BOOST_REQUIRE_EQUAL(ksps[0].size(), 2);
+    BOOST_REQUIRE_EQUAL(ksps[1].size(), 2);
+    for (unsigned int j=0; j<2; j++) {
+        BOOST_CHECK(ksps[0][j]     == ksps[1][j]);
+        BOOST_CHECK(ksp_mats[0][j] == ksp_mats[1][j]);
+    }
+    
+    // the same two time steps with the objects rebuilt for the second solve
+    reset();
+    
+    PetscInt
+    fresh_n_its     = 0,
+    fresh_n_lin_its = 0;
+    
+    {
+        MultiphysicsSolverAccess s;
+        init_multiphysics_solver(s);
+        
+        s.solve();
+        BOOST_CHECK_EQUAL(s.n_nonlinear_iterations(), n_its[0]);
+        BOOST_CHECK_EQUAL(s.n_linear_iterations(),    n_lin_its[0]);
+        advance_time_step();
+        
+        s.clear_petsc_objects();
+        s.solve();
+        fresh_n_its     = s.n_nonlinear_iterations();
+        fresh_n_lin_its = s.n_linear_iterations();
+        advance_time_step();
+    }
+    
+    BOOST_CHECK_GT(n_lin_its[1], 0);
+    BOOST_CHECK_EQUAL(fresh_n_its,     n_its[1]);
+    BOOST_CHECK_EQUAL(fresh_n_lin_its, n_lin_its[1]);
+    BOOST_CHECK_SMALL(rel_diff(sols), 1.e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,448 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "solver/first_order_newmark_transient_solver.h"
+#include "solver/transient_heat_conduction_model.h"
+
+
+/*!
+ *   provides access to the truncation error estimate
+ */
+class AdaptiveNewmarkSolver:
+public MAST::FirstOrderNewmarkTransientSolver {
+public:
+    
+    void truncation_error(const libMesh::NumericVector<Real>& sol,
+                          libMesh::NumericVector<Real>& err) {
+        
+        _local_truncation_error(sol, err);
+    }
+    
+    unsigned int truncation_error_order() const {
+        
+        return _local_truncation_error_order();
+    }
+};
+
+
+
+struct TransientAdaptiveSolveFixture:
+public TransientHeatConductionModel {
+    
+    TransientAdaptiveSolveFixture():
+    TransientHeatConductionModel(),
+    t_end    (0.05),
+    dt_min   (1.e-7),
+    dt_max   (0.01) { }
+    
+    
+    /*!
+     *   integrates with the time steps in \p dts and returns the solution
+     *   after each step in \p sols. The linear solution mode is used if
+     *   \p linear is true.
+     */
+    void
+    run_fixed(const std::vector<Real>& dts,
+              bool linear,
+              std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >& sols) {
+        
+        MAST::TransientAssembly                               assembly;
+        MAST::HeatConductionTransientAssemblyElemOperations   elem_ops;
+        MAST::FirstOrderNewmarkTransientSolver                solver;
+        
+        attach(assembly, elem_ops, solver);
+        solver.set_linear_problem(linear);
+        solver.dt = dts[0];
+        
+        solver.solve_highest_derivative_and_advance_time_step(assembly);
+        
+        sols.clear();
+        for (unsigned int i=0; i<dts.size(); i++) {
+            
+            solver.dt = dts[i];
+            solver.solve(assembly);
+            solver.advance_time_step();
+            sols.push_back(solution_copy());
+        }
+        
+        detach(assembly, elem_ops, solver);
+    }
+    
+    
+    /*!
+     *   integrates with adaptive time steps up to \p t_end, starting with
+     *   \p dt0. The last step is shortened to land on \p t_end. Returns
+     *   the accepted steps in \p dts and the number of rejected steps.
+     */
+    unsigned int
+    run_adaptive(Real rel_tol,
+                 Real dt0,
+                 std::vector<Real>& dts,
+                 std::unique_ptr<libMesh::NumericVector<Real> >& sol) {
+        
+        MAST::TransientAssembly                               assembly;
+        MAST::HeatConductionTransientAssemblyElemOperations   elem_ops;
+        MAST::FirstOrderNewmarkTransientSolver                solver;
+        
+        attach(assembly, elem_ops, solver);
+        solver.set_adaptive_time_stepping(true, rel_tol, 1.e-12);
+        solver.dt = dt0;
+        
+        solver.solve_highest_derivative_and_advance_time_step(assembly);
+        
+        Real
+        t  = 0.;
+        
+        while (t_end - t > 1.e-10) {
+            
+            solver.set_time_step_limits(dt_min,
+                                        std::max(std::min(dt_max, t_end - t),
+                                                 2.*dt_min));
+            solver.adaptive_solve(assembly);
+            solver.advance_time_step();
+            t += solver.dt;
+        }
+        
+        dts = solver.accepted_time_steps();
+        sol = solution_copy();
+        
+        const unsigned int
+        n_rejected = solver.n_rejected_time_steps();
+        
+        detach(assembly, elem_ops, solver);
+        
+        return n_rejected;
+    }
+    
+    
+    /*!
+     *   @returns the norm of the difference of the two vectors relative to
+     *   the norm of \p ref
+     */
+    Real rel_diff(const libMesh::NumericVector<Real>& ref,
+                  const libMesh::NumericVector<Real>& v) {
+        
+        std::unique_ptr<libMesh::NumericVector<Real> >
+        diff(v.clone());
+        diff->add(-1., ref);
+        
+        return diff->l2_norm()/ref.l2_norm();
+    }
+    
+    
+    Real t_end, dt_min, dt_max;
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (TransientAdaptiveSolveTests,
+                           TransientAdaptiveSolveFixture)
+
+BOOST_AUTO_TEST_CASE   (ErrorTracksTolerance) {
+    
+    // reference solution with a small fixed time step
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >
+    ref;
+    run_fixed(std::vector<Real>(2000, t_end/2000.), true, ref);
+    
+    const Real
+    tol[2] = {1.e-3, 1.e-5};
+    
+    Real
+    err[2];
+    
+    unsigned int
+    n_steps[2];
+    
+    for (unsigned int i=0; i<2; i++) {
+        
+        std::vector<Real> dts;
+        std::unique_ptr<libMesh::NumericVector<Real> > sol;
+        
+        run_adaptive(tol[i], 1.e-4, dts, sol);
+        
+        Real
+        t = 0.;
+        for (unsigned int j=0; j<dts.size(); j++)
+            t += dts[j];
+        BOOST_CHECK_CLOSE(t, t_end, 1.e-3);
+        
+        err[i]     = rel_diff(*ref.back(), *sol);
+        n_steps[i] = (unsigned int)dts.size();
+        
+        // the estimate is for the lower-order predictor, so the error
+        // of the solution should be within the tolerance
+        BOOST_CHECK_LE(err[i], tol[i]);
+    }
+    
+    // a tighter tolerance needs more steps and gives a smaller error
+    BOOST_CHECK_GT(n_steps[1], n_steps[0]);
+    BOOST_CHECK_LT(err[1], err[0]);
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (RejectedStepRestoresState) {
+    
+    MAST::TransientAssembly                               assembly;
+    MAST::HeatConductionTransientAssemblyElemOperations   elem_ops;
+    AdaptiveNewmarkSolver                                 solver;
+    
+    // the initial step is too large for the tolerance
+    attach(assembly, elem_ops, solver);
+    solver.set_adaptive_time_stepping(true, 1.e-5, 1.e-12);
+    solver.set_time_step_limits(dt_min, dt_max);
+    solver.dt = dt_max;
+    
+    solver.solve_highest_derivative_and_advance_time_step(assembly);
+    solver.adaptive_solve(assembly);
+    
+    BOOST_CHECK_GT(solver.n_rejected_time_steps(), 0);
+    BOOST_REQUIRE_EQUAL(solver.accepted_time_steps().size(), 1);
+    BOOST_CHECK_LT(solver.dt, dt_max);
+    
+    const Real
+    dt_accepted = solver.dt;
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    sol(solution_copy());
+    
+    detach(assembly, elem_ops, solver);
+    
+    // the accepted step is the same as a step of that size from the
+    // initial state, so the rejected steps left no trace
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >
+    fixed;
+    run_fixed(std::vector<Real>(1, dt_accepted), false, fixed);
+    
+    BOOST_CHECK_SMALL(rel_diff(*fixed[0], *sol), 1.e-10);
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (EstimateIsPredictorDifference) {
+    
+    Real
+    est[2];
+    
+    for (unsigned int i=0; i<2; i++) {
+        
+        MAST::TransientAssembly                               assembly;
+        MAST::HeatConductionTransientAssemblyElemOperations   elem_ops;
+        AdaptiveNewmarkSolver                                 solver;
+        
+        attach(assembly, elem_ops, solver);
+        solver.dt = 1.e-5 / (1 + i);
+        
+        solver.solve_highest_derivative_and_advance_time_step(assembly);
+        solver.solve(assembly);
+        
+        std::unique_ptr<libMesh::NumericVector<Real> >
+        err(sys->solution->zero_clone()),
+        pred(sys->solution->clone());
+        
+        solver.truncation_error(*sys->solution, *err);
+        
+        // the estimate is the difference between the solution and the
+        // forward Euler predictor
+        pred->add(-1., solver.solution(1));
+        pred->add(-solver.dt, solver.velocity(1));
+        pred->close();
+        
+        BOOST_CHECK_SMALL(rel_diff(*pred, *err), 1.e-8);
+        
+        est[i] = err->l2_norm();
+        
+        detach(assembly, elem_ops, solver);
+    }
+    
+    // the estimate is of the order dt^2
+    BOOST_CHECK_CLOSE(est[0]/est[1], 4., 5.);
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (PIControllerProposesNextStep) {
+    
+    MAST::TransientAssembly                               assembly;
+    MAST::HeatConductionTransientAssemblyElemOperations   elem_ops;
+    AdaptiveNewmarkSolver                                 solver;
+    
+    const Real
+    rel_tol  = 1.e-4,
+    abs_tol  = 1.e-12,
+    order    = solver.truncation_error_order(),
+    n_dofs   = sys->n_dofs();
+    
+    BOOST_CHECK_EQUAL(order, 2.);
+    
+    attach(assembly, elem_ops, solver);
+    solver.set_adaptive_time_stepping(true, rel_tol, abs_tol);
+    solver.set_time_step_limits(dt_min, dt_max);
+    solver.dt = 1.e-4;
+    
+    solver.solve_highest_derivative_and_advance_time_step(assembly);
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    err(sys->solution->zero_clone());
+    
+    Real
+    prev_err = 1.,
+    dt_next  = 0.;
+    
+    unsigned int
+    n_checked = 0;
+    
+    for (unsigned int i=0; i<15; i++) {
+        
+        const unsigned int
+        n_rejected = solver.n_rejected_time_steps();
+        
+        solver.adaptive_solve(assembly);
+        
+        // without a rejection, the step is the one proposed after the
+        // previous step
+        if (i && solver.n_rejected_time_steps() == n_rejected) {
+            
+            BOOST_CHECK_CLOSE(solver.dt, dt_next, 1.e-10);
+            n_checked++;
+        }
+        
+        // the accepted step satisfies the tolerance
+        solver.truncation_error(*sys->solution, *err);
+        
+        const Real
+        err_norm = std::max(err->l2_norm()/std::sqrt(n_dofs) /
+                            (abs_tol + rel_tol * sys->solution->l2_norm()/std::sqrt(n_dofs)),
+                            1.e-4);
+        
+        BOOST_CHECK_LE(err_norm, 1.);
+        
+        Real
+        fac = 0.9 * std::pow(err_norm, -0.7/order) * std::pow(prev_err, 0.4/order);
+        fac = std::min(std::max(fac, 0.2), 5.);
+        
+        dt_next  = std::min(std::max(solver.dt*fac, dt_min), dt_max);
+        prev_err = err_norm;
+        
+        solver.advance_time_step();
+    }
+    
+    BOOST_CHECK_GT(n_checked, 0);
+    
+    detach(assembly, elem_ops, solver);
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (MinimumStepRaisesError) {
+    
+    MAST::TransientAssembly                               assembly;
+    MAST::HeatConductionTransientAssemblyElemOperations   elem_ops;
+    MAST::FirstOrderNewmarkTransientSolver                solver;
+    
+    attach(assembly, elem_ops, solver);
+    solver.set_adaptive_time_stepping(true, 1.e-10, 1.e-14);
+    solver.set_time_step_limits(0.5*dt_max, dt_max);
+    solver.dt = dt_max;
+    
+    solver.solve_highest_derivative_and_advance_time_step(assembly);
+    
+    BOOST_CHECK_THROW(solver.adaptive_solve(assembly), std::exception);
+    
+    detach(assembly, elem_ops, solver);
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (SensitivityMatchesFiniteDifference) {
+    
+    MAST::TransientAssembly                               assembly;
+    MAST::HeatConductionTransientAssemblyElemOperations   elem_ops;
+    MAST::FirstOrderNewmarkTransientSolver                solver;
+    
+    attach(assembly, elem_ops, solver);
+    solver.set_adaptive_time_stepping(true, 1.e-4, 1.e-12);
+    solver.set_time_step_limits(dt_min, dt_max);
+    solver.dt = 1.e-4;
+    
+    solver.solve_highest_derivative_and_advance_time_step(assembly);
+    solver.solve_highest_derivative_and_advance_time_step_with_sensitivity(assembly, k);
+    
+    // the sensitivity is solved after each accepted step, with the
+    // accepted step size
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >
+    dsols;
+    
+    for (unsigned int i=0; i<12; i++) {
+        
+        solver.adaptive_solve(assembly);
+        solver.sensitivity_solve(assembly, k);
+        dsols.push_back(solver.solution_sensitivity().clone());
+        
+        solver.advance_time_step();
+        solver.advance_time_step_with_sensitivity();
+    }
+    
+    const std::vector<Real>
+    dts = solver.accepted_time_steps();
+    
+    detach(assembly, elem_ops, solver);
+    
+    BOOST_REQUIRE_EQUAL(dts.size(), dsols.size());
+    
+    // central difference with the accepted steps
+    const Real
+    k0 = k(),
+    h  = 1.e-4 * k0;
+    
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >
+    sols_p,
+    sols_m;
+    
+    k = k0 + h;
+    run_fixed(dts, true, sols_p);
+    k = k0 - h;
+    run_fixed(dts, true, sols_m);
+    k = k0;
+    
+    for (unsigned int i=0; i<dts.size(); i++) {
+        
+        std::unique_ptr<libMesh::NumericVector<Real> >
+        fd(sols_p[i]->clone());
+        fd->add(-1., *sols_m[i]);
+        fd->scale(0.5/h);
+        fd->close();
+        
+        BOOST_CHECK_SMALL(rel_diff(*fd, *dsols[i]), 1.e-5);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
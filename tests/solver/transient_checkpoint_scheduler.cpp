@@ -0,0 +1,367 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <cmath>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "solver/transient_checkpoint_scheduler.h"
+#include "solver/first_order_newmark_transient_solver.h"
+#include "solver/transient_heat_conduction_model.h"
+
+
+/*!
+ *   replaces the solver state by the index of the current time step, so
+ *   that the schedule can be checked without a system.
+ */
+class CheckpointSchedulerMock:
+public MAST::TransientCheckpointScheduler {
+    
+public:
+    
+    CheckpointSchedulerMock(unsigned int n_steps,
+                            unsigned int n_checkpoints):
+    MAST::TransientCheckpointScheduler(n_steps, n_checkpoints),
+    state        (0),
+    solved       (false),
+    consistent   (true),
+    n_solves     (n_steps, 0) { }
+    
+    unsigned int              state;
+    bool                      solved;
+    bool                      consistent;
+    std::vector<unsigned int> n_solves;
+    
+protected:
+    
+    virtual void _store_checkpoint(unsigned int depth, unsigned int i) {
+        
+        consistent = consistent && !solved && state == i;
+        _checkpoints[depth].valid = true;
+        _checkpoints[depth].step  = i;
+    }
+    
+    virtual void _restore_checkpoint(unsigned int depth) {
+        
+        consistent = consistent && _checkpoints[depth].valid;
+        state      = _checkpoints[depth].step;
+        solved     = false;
+    }
+    
+    virtual void _solve_step(unsigned int i) {
+        
+        consistent = consistent && !solved && state == i;
+        solved     = true;
+        n_solves[i]++;
+        _n_step_solves++;
+    }
+    
+    virtual void _advance_step() {
+        
+        consistent = consistent && solved;
+        solved     = false;
+        state++;
+    }
+};
+
+
+
+class CheckpointSweepOperations:
+public MAST::TransientSweepOperations {
+    
+public:
+    
+    CheckpointSweepOperations(CheckpointSchedulerMock& s):
+    scheduler  (s),
+    next       ((int)s.n_steps()-1),
+    n_forward  (0),
+    consistent (true) { }
+    
+    virtual void forward_step(unsigned int i) {
+        
+        consistent = consistent && i == n_forward;
+        n_forward++;
+    }
+    
+    virtual void adjoint_step(unsigned int i) {
+        
+        consistent = (consistent &&
+                      (int)i == next &&
+                      scheduler.state == i &&
+                      scheduler.solved);
+        next--;
+    }
+    
+    CheckpointSchedulerMock& scheduler;
+    int                      next;
+    unsigned int             n_forward;
+    bool                     consistent;
+};
+
+
+
+BOOST_AUTO_TEST_SUITE  (transient_checkpoint_scheduler)
+
+BOOST_AUTO_TEST_CASE   (binomial_coefficients) {
+    
+    BOOST_CHECK_EQUAL(MAST::TransientCheckpointScheduler::max_steps(0, 5),  1);
+    BOOST_CHECK_EQUAL(MAST::TransientCheckpointScheduler::max_steps(3, 0),  1);
+    BOOST_CHECK_EQUAL(MAST::TransientCheckpointScheduler::max_steps(2, 3), 10);
+    BOOST_CHECK_EQUAL(MAST::TransientCheckpointScheduler::max_steps(5, 5), 252);
+}
+
+
+BOOST_AUTO_TEST_CASE   (reverse_order_and_repetitions) {
+    
+    const unsigned int
+    n_ckpts[] = {1, 2, 3, 4, 6},
+    n_steps[] = {1, 2, 5, 10, 35, 100};
+    
+    for (unsigned int i=0; i<5; i++)
+        for (unsigned int j=0; j<6; j++) {
+            
+            const unsigned int
+            s = n_ckpts[i],
+            n = n_steps[j];
+            
+            CheckpointSchedulerMock   scheduler(n, s);
+            CheckpointSweepOperations ops(scheduler);
+            
+            scheduler.forward_sweep(ops);
+            BOOST_CHECK_EQUAL(ops.n_forward, n);
+            BOOST_CHECK_EQUAL(scheduler.state, n);
+            
+            scheduler.reverse_sweep(ops);
+            
+            // every adjoint step is visited once in reverse order with the
+            // solver state of the corresponding forward step
+            BOOST_CHECK(scheduler.consistent);
+            BOOST_CHECK(ops.consistent);
+            BOOST_CHECK_EQUAL(ops.next, -1);
+            
+            // the number of solutions of any step is bounded by the
+            // binomial repetition number
+            unsigned int t = 1;
+            if (s > 1)
+                while (MAST::TransientCheckpointScheduler::max_steps(s-1, t) < n)
+                    t++;
+            else
+                t = n;
+            
+            const unsigned int
+            max_solves = *std::max_element(scheduler.n_solves.begin(),
+                                           scheduler.n_solves.end());
+            BOOST_CHECK_LE(max_solves, t+1);
+            BOOST_CHECK_EQUAL(scheduler.n_recomputed_steps(),
+                              scheduler.n_step_solves() - n);
+        }
+}
+
+
+BOOST_AUTO_TEST_CASE   (one_checkpoint_per_step) {
+    
+    // with a checkpoint for every step only the step preceding each adjoint
+    // step is solved again
+    CheckpointSchedulerMock   scheduler(20, 20);
+    CheckpointSweepOperations ops(scheduler);
+    
+    scheduler.forward_sweep(ops);
+    scheduler.reverse_sweep(ops);
+    
+    BOOST_CHECK(scheduler.consistent);
+    BOOST_CHECK(ops.consistent);
+    BOOST_CHECK_EQUAL(scheduler.n_recomputed_steps(), 20);
+    BOOST_CHECK_CLOSE(scheduler.recomputation_ratio(), 1., 1.e-12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+
+/*!
+ *   stores the solver state seen in each forward step, and compares it
+ *   with the state seen in the adjoint steps
+ */
+class NewmarkSweepOperations:
+public MAST::TransientSweepOperations {
+    
+public:
+    
+    NewmarkSweepOperations(MAST::TransientSolverBase& s,
+                           MAST::NonlinearSystem&     sys):
+    solver     (s),
+    system     (sys),
+    next       (-1),
+    max_diff   (0.),
+    max_t_diff (0.) { }
+    
+    
+    /*!
+     *   records the state at the end of step \p i, together with the
+     *   previous iterate and the time before the step is advanced
+     */
+    virtual void forward_step(unsigned int i) {
+        
+        BOOST_CHECK_EQUAL(i, sol.size());
+        sol.push_back(solver.solution(0).clone());
+        prev_sol.push_back(solver.solution(1).clone());
+        time.push_back(system.time);
+    }
+    
+    
+    virtual void adjoint_step(unsigned int i) {
+        
+        BOOST_CHECK_EQUAL((int)i, next);
+        next--;
+        
+        max_diff   = std::max(max_diff, rel_diff(*sol[i],      solver.solution(0)));
+        max_diff   = std::max(max_diff, rel_diff(*prev_sol[i], solver.solution(1)));
+        max_t_diff = std::max(max_t_diff, std::fabs(time[i] - system.time));
+    }
+    
+    
+    static Real rel_diff(const libMesh::NumericVector<Real>& ref,
+                         const libMesh::NumericVector<Real>& v) {
+        
+        std::unique_ptr<libMesh::NumericVector<Real> >
+        diff(v.clone());
+        diff->add(-1., ref);
+        
+        return diff->l2_norm()/std::max(ref.l2_norm(), 1.e-20);
+    }
+    
+    
+    MAST::TransientSolverBase&                                     solver;
+    MAST::NonlinearSystem&                                         system;
+    int                                                            next;
+    Real                                                           max_diff;
+    Real                                                           max_t_diff;
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >   sol;
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >   prev_sol;
+    std::vector<Real>                                              time;
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (TransientCheckpointNewmarkTests,
+                           TransientHeatConductionModel)
+
+BOOST_AUTO_TEST_CASE   (AdaptiveDiskCheckpointsMatchForwardRun) {
+    
+    const unsigned int
+    n_steps = 15;
+    
+    // full forward run with adaptive time steps, without checkpoints
+    std::vector<Real> ref_dts;
+    
+    MAST::TransientAssembly                               ref_assembly;
+    MAST::HeatConductionTransientAssemblyElemOperations   ref_elem_ops;
+    MAST::FirstOrderNewmarkTransientSolver                ref_solver;
+    NewmarkSweepOperations                                ref(ref_solver, *sys);
+    
+    {
+        attach(ref_assembly, ref_elem_ops, ref_solver);
+        ref_solver.set_adaptive_time_stepping(true, 1.e-4, 1.e-12);
+        ref_solver.set_time_step_limits(1.e-7, 0.01);
+        ref_solver.dt = 1.e-4;
+        sys->time     = 0.;
+        
+        ref_solver.solve_highest_derivative_and_advance_time_step(ref_assembly);
+        
+        for (unsigned int i=0; i<n_steps; i++) {
+            
+            ref_solver.adaptive_solve(ref_assembly);
+            ref.forward_step(i);
+            ref_solver.advance_time_step();
+        }
+        
+        ref_dts = ref_solver.accepted_time_steps();
+        detach(ref_assembly, ref_elem_ops, ref_solver);
+    }
+    
+    // the same integration reversed with one disk and two memory
+    // checkpoints, so that most of the states are recomputed
+    MAST::TransientAssembly                               assembly;
+    MAST::HeatConductionTransientAssemblyElemOperations   elem_ops;
+    MAST::FirstOrderNewmarkTransientSolver                solver;
+    
+    attach(assembly, elem_ops, solver);
+    solver.set_adaptive_time_stepping(true, 1.e-4, 1.e-12);
+    solver.set_time_step_limits(1.e-7, 0.01);
+    solver.dt = 1.e-4;
+    sys->time = 0.;
+    
+    solver.solve_highest_derivative_and_advance_time_step(assembly);
+    
+    MAST::TransientCheckpointScheduler
+    scheduler(n_steps, 2, 1);
+    scheduler.attach_solver(solver, assembly);
+    scheduler.set_checkpoint_directory("transient_checkpoint_scheduler_output");
+    
+    NewmarkSweepOperations
+    ops(solver, *sys);
+    
+    scheduler.forward_sweep(ops);
+    
+    // the forward sweep takes the same adaptive steps as the full run
+    BOOST_REQUIRE_EQUAL(solver.accepted_time_steps().size(), ref_dts.size());
+    for (unsigned int i=0; i<ref_dts.size(); i++)
+        BOOST_CHECK_CLOSE(solver.accepted_time_steps()[i], ref_dts[i], 1.e-10);
+    
+    // the time steps are not uniform, so the replay must use the accepted
+    // steps and not the last step size
+    BOOST_CHECK_GT(*std::max_element(ref_dts.begin(), ref_dts.end()),
+                   2. * *std::min_element(ref_dts.begin(), ref_dts.end()));
+    
+    BOOST_REQUIRE_EQUAL(ops.sol.size(), n_steps);
+    for (unsigned int i=0; i<n_steps; i++)
+        BOOST_CHECK_SMALL(NewmarkSweepOperations::rel_diff(*ref.sol[i], *ops.sol[i]),
+                          1.e-10);
+    
+    // compare the states seen by the adjoint steps with copies of the
+    // states of the full forward run
+    NewmarkSweepOperations
+    adj(solver, *sys);
+    for (unsigned int i=0; i<n_steps; i++) {
+        adj.sol.push_back(ref.sol[i]->clone());
+        adj.prev_sol.push_back(ref.prev_sol[i]->clone());
+        adj.time.push_back(ref.time[i]);
+    }
+    adj.next = (int)n_steps - 1;
+    scheduler.reverse_sweep(adj);
+    
+    BOOST_CHECK_EQUAL(adj.next, -1);
+    BOOST_CHECK_SMALL(adj.max_diff,   1.e-10);
+    BOOST_CHECK_SMALL(adj.max_t_diff, 1.e-12);
+    
+    BOOST_CHECK_GT(scheduler.n_recomputed_steps(), n_steps);
+    BOOST_CHECK_GT(scheduler.n_disk_writes(), 0);
+    BOOST_CHECK_GT(scheduler.n_disk_reads(),  0);
+    
+    detach(assembly, elem_ops, solver);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
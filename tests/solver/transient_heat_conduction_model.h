@@ -0,0 +1,191 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_test_transient_heat_conduction_model_h__
+#define __mast_test_transient_heat_conduction_model_h__
+
+// C++ includes
+#include <vector>
+#include <memory>
+
+// MAST includes
+#include "base/nonlinear_system.h"
+#include "base/physics_discipline_base.h"
+#include "base/parameter.h"
+#include "base/constant_field_function.h"
+#include "base/boundary_condition_base.h"
+#include "base/transient_assembly.h"
+#include "boundary_condition/dirichlet_boundary_condition.h"
+#include "heat_conduction/heat_conduction_system_initialization.h"
+#include "heat_conduction/heat_conduction_transient_assembly.h"
+#include "property_cards/isotropic_material_property_card.h"
+#include "property_cards/solid_2d_section_element_property_card.h"
+#include "solver/transient_solver_base.h"
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/fe_type.h"
+
+
+extern libMesh::LibMeshInit* _mast_init;
+
+
+/*!
+ *   transient heat conduction on a unit square with a uniform heat source
+ *   and zero temperature on all edges, shared by the transient solver
+ *   tests. The problem is linear, and the temperature rises from zero to
+ *   the steady state with a time constant of about 0.05.
+ */
+struct TransientHeatConductionModel {
+    
+    TransientHeatConductionModel(unsigned int n_divs = 6):
+    mesh              (_mast_init->comm()),
+    eq_sys            (nullptr),
+    sys               (nullptr),
+    sys_init          (nullptr),
+    discipline        (nullptr),
+    k                 ("k",        1.),
+    rho               ("rho",      1.),
+    cp                ("cp",       1.),
+    th                ("th",       1.),
+    q                 ("q",        1.),
+    k_f               ("k_th",          k),
+    rho_f             ("rho",         rho),
+    cp_f              ("cp",           cp),
+    th_f              ("h",            th),
+    q_f               ("heat_source",   q),
+    source            (MAST::HEAT_SOURCE) {
+        
+        libMesh::MeshTools::Generation::build_square(mesh, n_divs, n_divs,
+                                                     0., 1., 0., 1.,
+                                                     libMesh::QUAD4);
+        
+        eq_sys   = new libMesh::EquationSystems(mesh);
+        sys      = &eq_sys->add_system<MAST::NonlinearSystem>("conduction");
+        
+        sys_init = new MAST::HeatConductionSystemInitialization
+        (*sys, sys->name(), libMesh::FEType(libMesh::FIRST, libMesh::LAGRANGE));
+        discipline = new MAST::PhysicsDisciplineBase(*eq_sys);
+        
+        // the temperature is zero on all edges
+        std::vector<unsigned int>
+        vars = {0};
+        for (unsigned int i=0; i<4; i++) {
+            fixed[i].init(i, vars);
+            discipline->add_dirichlet_bc(i, fixed[i]);
+        }
+        discipline->init_system_dirichlet_bc(*sys);
+        
+        eq_sys->init();
+        
+        material.add(k_f);
+        material.add(rho_f);
+        material.add(cp_f);
+        
+        section.add(th_f);
+        section.set_material(material);
+        discipline->set_property_for_subdomain(0, section);
+        
+        source.add(q_f);
+        discipline->add_volume_load(0, source);
+    }
+    
+    
+    ~TransientHeatConductionModel() {
+        
+        delete discipline;
+        delete sys_init;
+        delete eq_sys;
+    }
+    
+    
+    /*!
+     *   attaches the discipline and system to the assembly, element
+     *   operations and solver, and sets the solution to zero.
+     */
+    void attach(MAST::TransientAssembly&                             assembly,
+                MAST::HeatConductionTransientAssemblyElemOperations& elem_ops,
+                MAST::TransientSolverBase&                           solver) {
+        
+        assembly.set_discipline_and_system(*discipline, *sys_init);
+        elem_ops.set_discipline_and_system(*discipline, *sys_init);
+        solver.set_discipline_and_system(*discipline, *sys_init);
+        solver.set_elem_operation_object(elem_ops);
+        
+        sys->solution->zero();
+        sys->solution->close();
+    }
+    
+    
+    /*!
+     *   clears the associations made by attach()
+     */
+    void detach(MAST::TransientAssembly&                             assembly,
+                MAST::HeatConductionTransientAssemblyElemOperations& elem_ops,
+                MAST::TransientSolverBase&                           solver) {
+        
+        solver.clear_elem_operation_object();
+        solver.clear_discipline_and_system();
+        elem_ops.clear_discipline_and_system();
+        assembly.clear_discipline_and_system();
+    }
+    
+    
+    /*!
+     *   @returns a copy of the current solution
+     */
+    std::unique_ptr<libMesh::NumericVector<Real> > solution_copy() const {
+        
+        return sys->solution->clone();
+    }
+    
+    
+    libMesh::ReplicatedMesh                      mesh;
+    libMesh::EquationSystems                    *eq_sys;
+    MAST::NonlinearSystem                       *sys;
+    MAST::HeatConductionSystemInitialization    *sys_init;
+    MAST::PhysicsDisciplineBase                 *discipline;
+    
+    MAST::Parameter
+    k,
+    rho,
+    cp,
+    th,
+    q;
+    
+    MAST::ConstantFieldFunction
+    k_f,
+    rho_f,
+    cp_f,
+    th_f,
+    q_f;
+    
+    MAST::DirichletBoundaryCondition             fixed[4];
+    MAST::BoundaryConditionBase                  source;
+    MAST::IsotropicMaterialPropertyCard          material;
+    MAST::Solid2DSectionElementPropertyCard      section;
+};
+
+
+#endif // __mast_test_transient_heat_conduction_model_h__
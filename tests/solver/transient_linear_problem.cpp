@@ -0,0 +1,149 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <vector>
+#include <memory>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "solver/first_order_newmark_transient_solver.h"
+#include "solver/transient_heat_conduction_model.h"
+
+
+struct TransientLinearProblemFixture:
+public TransientHeatConductionModel {
+    
+    TransientLinearProblemFixture():
+    TransientHeatConductionModel(),
+    dt       (0.01),
+    n_steps  (8),
+    k_step   (n_steps),
+    k_new    (2.) { }
+    
+    
+    /*!
+     *   integrates \p n_steps with constant time step, and returns the
+     *   solution after each step in \p sols. The conductivity is changed
+     *   to \p k_new before step \p k_step. Returns the number of Jacobian
+     *   assemblies of the linear solution mode.
+     */
+    unsigned int
+    run(bool linear,
+        std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >& sols) {
+        
+        MAST::TransientAssembly                               assembly;
+        MAST::HeatConductionTransientAssemblyElemOperations   elem_ops;
+        MAST::FirstOrderNewmarkTransientSolver                solver;
+        
+        attach(assembly, elem_ops, solver);
+        solver.dt = dt;
+        solver.set_linear_problem(linear);
+        
+        solver.solve_highest_derivative_and_advance_time_step(assembly);
+        
+        sols.clear();
+        for (unsigned int i=0; i<n_steps; i++) {
+            
+            if (i == k_step)
+                k = k_new;
+            
+            solver.solve(assembly);
+            solver.advance_time_step();
+            sols.push_back(solution_copy());
+        }
+        
+        const unsigned int
+        n_jac = solver.n_linear_jacobian_assemblies();
+        
+        detach(assembly, elem_ops, solver);
+        k = 1.;
+        
+        return n_jac;
+    }
+    
+    
+    /*!
+     *   checks that the two trajectories are the same
+     */
+    void
+    check_trajectories
+    (const std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >& ref,
+     const std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >& sols) {
+        
+        BOOST_REQUIRE_EQUAL(ref.size(), sols.size());
+        
+        for (unsigned int i=0; i<ref.size(); i++) {
+            
+            std::unique_ptr<libMesh::NumericVector<Real> >
+            diff(sols[i]->clone());
+            diff->add(-1., *ref[i]);
+            
+            BOOST_CHECK_SMALL(diff->l2_norm(), 1.e-6 * ref[i]->l2_norm());
+        }
+    }
+    
+    
+    Real         dt;
+    unsigned int n_steps, k_step;
+    Real         k_new;
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (TransientLinearProblemTests,
+                           TransientLinearProblemFixture)
+
+BOOST_AUTO_TEST_CASE   (LinearTrajectoryMatchesNewton) {
+    
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >
+    newton,
+    linear;
+    
+    run(false, newton);
+    
+    // the Jacobian is assembled once for a constant time step
+    BOOST_CHECK_EQUAL(run(true, linear), 1);
+    
+    // the temperature should have risen from zero
+    BOOST_REQUIRE(newton.back()->l2_norm() > 0.);
+    check_trajectories(newton, linear);
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (ParameterChangeRebuildsJacobian) {
+    
+    // the conductivity is changed halfway without telling the solver
+    k_step = n_steps/2;
+    
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >
+    newton,
+    linear;
+    
+    run(false, newton);
+    BOOST_CHECK_EQUAL(run(true, linear), 2);
+    
+    check_trajectories(newton, linear);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
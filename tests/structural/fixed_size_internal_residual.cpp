@@ -0,0 +1,123 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <memory>
+#include <vector>
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "base/structural_plate_model.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "elasticity/structural_element_2d.h"
+#include "mesh/geom_elem.h"
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+#include "libmesh/elem.h"
+
+
+/*!
+ *   compares the internal residual and Jacobian from the fixed-size kernel
+ *   with the generic kernel on the first element of a plate model.
+ */
+void
+check_fixed_size_internal_residual(libMesh::ElemType e_type,
+                                   MAST::StrainType strain) {
+    
+    const Real
+    tol   = 1.e-12;
+    
+    StructuralPlateModel model(e_type, 1);
+    model.section.set_strain(strain);
+    
+    MAST::NonlinearImplicitAssembly assembly;
+    assembly.set_discipline_and_system(*model.discipline, *model.structural_sys);
+    
+    const libMesh::Elem& elem = **model.mesh.active_local_elements_begin();
+    
+    MAST::GeomElem geom_elem;
+    geom_elem.init(elem, *model.structural_sys);
+    
+    std::unique_ptr<MAST::StructuralElementBase>
+    e = MAST::build_structural_element(*model.structural_sys,
+                                       assembly,
+                                       geom_elem,
+                                       model.section);
+    
+    MAST::StructuralElement2D&
+    e2d = dynamic_cast<MAST::StructuralElement2D&>(*e);
+    
+    std::vector<libMesh::dof_id_type> dof_ids;
+    model.sys->get_dof_map().dof_indices(&elem, dof_ids);
+    
+    const unsigned int
+    n_dofs = (unsigned int)dof_ids.size();
+    
+    // displacements of the order of the thickness activate the nonlinear
+    // strain terms
+    RealVectorX
+    sol    = 1.e-3 * RealVectorX::Random(n_dofs),
+    f_fix  = RealVectorX::Zero(n_dofs),
+    f_gen  = RealVectorX::Zero(n_dofs);
+    
+    RealMatrixX
+    j_fix  = RealMatrixX::Zero(n_dofs, n_dofs),
+    j_gen  = RealMatrixX::Zero(n_dofs, n_dofs);
+    
+    e2d.set_solution(sol);
+    
+    e2d.use_fixed_size_kernels = true;
+    e2d.internal_residual(true, f_fix, j_fix);
+    
+    e2d.use_fixed_size_kernels = false;
+    e2d.internal_residual(true, f_gen, j_gen);
+    
+    BOOST_CHECK_GT(f_gen.norm(), 0.);
+    BOOST_CHECK_GT(j_gen.norm(), 0.);
+    BOOST_CHECK_SMALL((f_fix - f_gen).norm(), tol * f_gen.norm());
+    BOOST_CHECK_SMALL((j_fix - j_gen).norm(), tol * j_gen.norm());
+    
+    e.reset();
+    assembly.clear_discipline_and_system();
+}
+
+
+
+BOOST_AUTO_TEST_SUITE  (FixedSizeInternalResidual)
+
+BOOST_AUTO_TEST_CASE   (LinearStrain) {
+    
+    check_fixed_size_internal_residual(libMesh::TRI3,  MAST::LINEAR_STRAIN);
+    check_fixed_size_internal_residual(libMesh::QUAD4, MAST::LINEAR_STRAIN);
+    check_fixed_size_internal_residual(libMesh::QUAD9, MAST::LINEAR_STRAIN);
+}
+
+
+BOOST_AUTO_TEST_CASE   (NonlinearStrain) {
+    
+    check_fixed_size_internal_residual(libMesh::TRI3,  MAST::NONLINEAR_STRAIN);
+    check_fixed_size_internal_residual(libMesh::QUAD4, MAST::NONLINEAR_STRAIN);
+    check_fixed_size_internal_residual(libMesh::QUAD9, MAST::NONLINEAR_STRAIN);
+}
+
+BOOST_AUTO_TEST_SUITE_END()